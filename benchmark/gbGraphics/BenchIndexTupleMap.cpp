@@ -0,0 +1,125 @@
+#include <gbGraphics/detail/IndexTupleMap.hpp>
+
+#include <Throughput.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+using GHULBUS_GRAPHICS_NAMESPACE::detail::IndexTuple;
+using GHULBUS_GRAPHICS_NAMESPACE::detail::IndexTupleMap;
+using GhulbusGraphicsBenchmark::reportThroughput;
+
+/** The hash used by ObjParser before the switch to IndexTupleMap.
+ */
+struct XorShiftIndexTupleHash
+{
+    std::size_t operator()(IndexTuple const& t) const {
+        return (t.vertexIndex) ^ (t.normalIndex << 16) ^ (t.textureIndex << 21);
+    }
+};
+
+/** Index tuples as they occur when flattening a triangulated grid with per-vertex normals and texture
+ * coordinates: Every vertex is referenced by up to six faces.
+ */
+std::vector<IndexTuple> generateGridTuples(std::int32_t grid_size)
+{
+    std::vector<IndexTuple> ret;
+    ret.reserve(static_cast<std::size_t>(grid_size) * grid_size * 6);
+    auto const tuple = [grid_size](std::int32_t x, std::int32_t y) {
+        std::int32_t const i = y * (grid_size + 1) + x + 1;
+        return IndexTuple(i, i, i);
+    };
+    for (std::int32_t y = 0; y < grid_size; ++y) {
+        for (std::int32_t x = 0; x < grid_size; ++x) {
+            ret.push_back(tuple(x, y));
+            ret.push_back(tuple(x + 1, y));
+            ret.push_back(tuple(x + 1, y + 1));
+            ret.push_back(tuple(x, y));
+            ret.push_back(tuple(x + 1, y + 1));
+            ret.push_back(tuple(x, y + 1));
+        }
+    }
+    return ret;
+}
+
+/** Index tuples with unrelated position, normal and texture indices, as found in meshes with
+ * flat shading or many texture seams.
+ */
+std::vector<IndexTuple> generateRandomTuples(std::size_t n, std::int32_t max_index)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::int32_t> dist(1, max_index);
+    std::vector<IndexTuple> ret;
+    ret.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ret.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+    return ret;
+}
+
+template<typename Map>
+std::int64_t dedupUnorderedMap(std::vector<IndexTuple> const& tuples)
+{
+    Map map;
+    std::int64_t checksum = 0;
+    for (auto const& t : tuples) {
+        auto const [it, was_inserted] = map.try_emplace(t, static_cast<std::int32_t>(map.size()));
+        checksum += it->second;
+    }
+    return checksum;
+}
+
+std::int64_t dedupIndexTupleMap(std::vector<IndexTuple> const& tuples, std::size_t expected_size)
+{
+    IndexTupleMap map(expected_size);
+    std::int64_t checksum = 0;
+    for (auto const& t : tuples) {
+        checksum += map.tryEmplace(t, static_cast<std::int32_t>(map.size())).first;
+    }
+    return checksum;
+}
+}
+
+TEST_CASE("Index Tuple Deduplication")
+{
+    using StdMap = std::unordered_map<IndexTuple, std::int32_t, XorShiftIndexTupleHash>;
+    using StdMapStrongHash = std::unordered_map<IndexTuple, std::int32_t, GHULBUS_GRAPHICS_NAMESPACE::detail::IndexTupleHash>;
+
+    SECTION("Smooth grid, 2M faces")
+    {
+        std::vector<IndexTuple> const tuples = generateGridTuples(1000);
+        std::int64_t const reference = dedupUnorderedMap<StdMap>(tuples);
+        REQUIRE(dedupIndexTupleMap(tuples, 0) == reference);
+
+        BENCHMARK("std::unordered_map, xor hash") { return dedupUnorderedMap<StdMap>(tuples); };
+        BENCHMARK("std::unordered_map, mixing hash") { return dedupUnorderedMap<StdMapStrongHash>(tuples); };
+        BENCHMARK("IndexTupleMap") { return dedupIndexTupleMap(tuples, 0); };
+        BENCHMARK("IndexTupleMap, pre-sized") { return dedupIndexTupleMap(tuples, tuples.size() / 6); };
+
+        std::cout << "\n";
+        reportThroughput("IndexTupleMap, smooth grid", tuples.size() * sizeof(IndexTuple), tuples.size(),
+                         [&tuples]() { return dedupIndexTupleMap(tuples, 0); });
+    }
+
+    SECTION("Unrelated indices, 2M tuples")
+    {
+        std::vector<IndexTuple> const tuples = generateRandomTuples(2'000'000, 1 << 18);
+        std::int64_t const reference = dedupUnorderedMap<StdMap>(tuples);
+        REQUIRE(dedupIndexTupleMap(tuples, 0) == reference);
+
+        BENCHMARK("std::unordered_map, xor hash") { return dedupUnorderedMap<StdMap>(tuples); };
+        BENCHMARK("std::unordered_map, mixing hash") { return dedupUnorderedMap<StdMapStrongHash>(tuples); };
+        BENCHMARK("IndexTupleMap") { return dedupIndexTupleMap(tuples, 0); };
+        BENCHMARK("IndexTupleMap, pre-sized") { return dedupIndexTupleMap(tuples, tuples.size()); };
+
+        std::cout << "\n";
+        reportThroughput("IndexTupleMap, unrelated indices", tuples.size() * sizeof(IndexTuple), tuples.size(),
+                         [&tuples]() { return dedupIndexTupleMap(tuples, 0); });
+    }
+}
@@ -0,0 +1,140 @@
+#include <SyntheticObj.hpp>
+#include <Throughput.hpp>
+
+#include <gbGraphics/MeshCache.hpp>
+#include <gbGraphics/ObjParser.hpp>
+
+#include <gbBase/Finally.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace GhulbusGraphicsBenchmark;
+using GHULBUS_GRAPHICS_NAMESPACE::MeshCache;
+using GHULBUS_GRAPHICS_NAMESPACE::ObjParser;
+
+void benchmarkObjParser(SyntheticObjParameters const& parameters)
+{
+    std::string const obj = generateSyntheticObj(parameters);
+    std::span<char const> const obj_data(obj.data(), obj.size());
+    std::filesystem::path const tmp_dir = std::filesystem::temp_directory_path();
+    std::string const obj_filename = (tmp_dir / "gbGraphics_BenchObjParser.obj").string();
+    std::string const cache_filename = (tmp_dir / "gbGraphics_BenchObjParser.gbmesh").string();
+    auto const guard_files = Ghulbus::finally([&]() {
+            std::filesystem::remove(obj_filename);
+            std::filesystem::remove(cache_filename);
+        });
+    {
+        std::ofstream fout(obj_filename, std::ios_base::binary);
+        fout.write(obj.data(), obj.size());
+    }
+
+    ObjParser reference;
+    reference.readData(obj_data);
+    REQUIRE(static_cast<std::uint64_t>(reference.numberOfVertices()) == parameters.numberOfVertices());
+    REQUIRE(static_cast<std::uint64_t>(reference.numberOfFacesTotal()) == parameters.numberOfFaces());
+    REQUIRE(static_cast<std::uint64_t>(reference.numberOfFlatVertices()) == parameters.numberOfVertices());
+    MeshCache::write(cache_filename.c_str(), reference, obj_filename.c_str());
+
+    auto const read_data = [&obj_data]() {
+        ObjParser parser;
+        parser.readData(obj_data);
+        return parser.numberOfFlatFaces();
+    };
+    auto const read_data_single_thread = [&obj_data]() {
+        ObjParser parser;
+        parser.setMaxThreads(1);
+        parser.readData(obj_data);
+        return parser.numberOfFlatFaces();
+    };
+    std::vector<ObjParser::VertexEntryFlat> flat_vertices;
+    std::vector<ObjParser::IndexType> flat_indices;
+    auto const read_data_external_storage = [&obj_data, &flat_vertices, &flat_indices]() {
+        ObjParser parser;
+        parser.readData(obj_data, [&flat_vertices, &flat_indices](std::size_t n_vertices, std::size_t n_indices) {
+                flat_vertices.resize(n_vertices);
+                flat_indices.resize(n_indices);
+                return ObjParser::FlatStorage{ flat_vertices, flat_indices };
+            });
+        return flat_indices.size();
+    };
+    auto const read_file = [&obj_filename]() {
+        ObjParser parser;
+        parser.readFile(obj_filename.c_str());
+        return parser.numberOfFlatFaces();
+    };
+    auto const read_file_streaming = [&obj_filename]() {
+        std::uint64_t checksum = 0;
+        ObjParser::readFileStreaming(obj_filename.c_str(), [&checksum](ObjParser::FlatBatch const& b) {
+                checksum += b.indices.size();
+            });
+        return checksum;
+    };
+    auto const load_mesh_cache = [&cache_filename]() {
+        MeshCache const cache(cache_filename.c_str());
+        std::uint64_t checksum = 0;
+        for (std::uint32_t i : cache.getIndexData()) { checksum += i; }
+        return checksum;
+    };
+
+    BENCHMARK("readData") { return read_data(); };
+    BENCHMARK("readData, single thread") { return read_data_single_thread(); };
+    BENCHMARK("readData, external storage") { return read_data_external_storage(); };
+    BENCHMARK("readFile") { return read_file(); };
+    BENCHMARK("readFileStreaming") { return read_file_streaming(); };
+    BENCHMARK("MeshCache load") { return load_mesh_cache(); };
+
+    std::cout << "\n" << obj.size() / (1 << 20) << " MB, " << parameters.numberOfVertices() << " vertices, "
+              << parameters.numberOfFaces() << " faces:\n";
+    std::uint64_t const vertices = parameters.numberOfVertices();
+    reportThroughput("readData", obj.size(), vertices, read_data);
+    reportThroughput("readData, single thread", obj.size(), vertices, read_data_single_thread);
+    reportThroughput("readData, external storage", obj.size(), vertices, read_data_external_storage);
+    reportThroughput("readFile", obj.size(), vertices, read_file);
+    reportThroughput("readFileStreaming", obj.size(), vertices, read_file_streaming);
+    reportThroughput("MeshCache load (relative to OBJ size)", obj.size(), vertices, load_mesh_cache);
+}
+}
+
+TEST_CASE("Obj Parser Throughput")
+{
+    SyntheticObjParameters parameters;
+    parameters.gridWidth = 512;
+    parameters.gridHeight = 512;
+
+    SECTION("Triangles, v/vt/vn")
+    {
+        parameters.layout = SyntheticObjLayout::PositionTexCoordNormal;
+        benchmarkObjParser(parameters);
+    }
+
+    SECTION("Triangles, v//vn, 64 groups")
+    {
+        parameters.layout = SyntheticObjLayout::PositionNormal;
+        parameters.numberOfGroups = 64;
+        benchmarkObjParser(parameters);
+    }
+
+    SECTION("Quads, v, 16 groups")
+    {
+        parameters.layout = SyntheticObjLayout::Position;
+        parameters.quads = true;
+        parameters.numberOfGroups = 16;
+        benchmarkObjParser(parameters);
+    }
+
+    SECTION("Quads, v/vt")
+    {
+        parameters.layout = SyntheticObjLayout::PositionTexCoord;
+        parameters.quads = true;
+        benchmarkObjParser(parameters);
+    }
+}
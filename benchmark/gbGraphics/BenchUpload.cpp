@@ -0,0 +1,73 @@
+#include <Throughput.hpp>
+
+#include <gbGraphics/GraphicsInstance.hpp>
+#include <gbGraphics/MemoryBuffer.hpp>
+
+#include <gbVk/Device.hpp>
+#include <gbVk/Fence.hpp>
+#include <gbVk/PhysicalDevice.hpp>
+#include <gbVk/Queue.hpp>
+#include <gbVk/SubmitStaging.hpp>
+
+#include <catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace GhulbusGraphicsBenchmark;
+using GHULBUS_GRAPHICS_NAMESPACE::GraphicsInstance;
+using GHULBUS_GRAPHICS_NAMESPACE::MemoryBuffer;
+using GHULBUS_GRAPHICS_NAMESPACE::MemoryUsage;
+
+void benchmarkBufferUpload(GraphicsInstance& instance, VkDeviceSize size)
+{
+    std::vector<std::byte> const data(size, std::byte{ 0x5a });
+    MemoryBuffer staged_buffer(instance, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               MemoryUsage::GpuOnly);
+    MemoryBuffer direct_buffer(instance, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               MemoryUsage::GpuOnlyDirectUpload);
+
+    // measures until the data is available on the device, including the submission
+    auto const upload = [&instance, &data](MemoryBuffer& buffer) {
+        GhulbusVulkan::SubmitStaging submit_staging = buffer.setDataAsynchronously(data.data());
+        GhulbusVulkan::Fence fence = instance.getVulkanDevice().createFence();
+        instance.getTransferQueue().submit(submit_staging, fence);
+        fence.wait();
+        submit_staging.performCleanup();
+        return buffer.getSize();
+    };
+
+    std::cout << "\n" << size / (1 << 20) << " MB"
+              << (direct_buffer.isDirectUpload() ? "" : " (no host-visible device memory, both use staging)")
+              << ":\n";
+    reportThroughput("setDataAsynchronously, GpuOnly", size, [&]() { return upload(staged_buffer); });
+    reportThroughput("setDataAsynchronously, GpuOnlyDirectUpload", size, [&]() { return upload(direct_buffer); });
+}
+}
+
+// hidden, as it needs a Vulkan device; run with gbGraphics_Bench [gpu]
+TEST_CASE("Buffer Upload Throughput", "[.][gpu]")
+{
+    GraphicsInstance instance;
+    std::cout << "Device local memory is host visible: " << std::boolalpha
+              << instance.getVulkanPhysicalDevice().isDeviceLocalMemoryHostVisible() << "\n";
+
+    SECTION("1 MB")
+    {
+        benchmarkBufferUpload(instance, VkDeviceSize{ 1 } << 20);
+    }
+
+    SECTION("16 MB")
+    {
+        benchmarkBufferUpload(instance, VkDeviceSize{ 16 } << 20);
+    }
+
+    SECTION("64 MB")
+    {
+        benchmarkBufferUpload(instance, VkDeviceSize{ 64 } << 20);
+    }
+}
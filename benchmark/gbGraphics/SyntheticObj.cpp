@@ -0,0 +1,93 @@
+#include <SyntheticObj.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+namespace GhulbusGraphicsBenchmark
+{
+namespace
+{
+void appendLine(std::string& out, char const* format, auto... args)
+{
+    char buffer[128];
+    int const n = std::snprintf(buffer, sizeof(buffer), format, args...);
+    out.append(buffer, static_cast<std::size_t>(n));
+}
+
+void appendFaceVertex(std::string& out, SyntheticObjLayout layout, std::uint64_t i)
+{
+    unsigned long long const index = i + 1;
+    switch (layout) {
+    case SyntheticObjLayout::Position:               appendLine(out, " %llu", index); break;
+    case SyntheticObjLayout::PositionTexCoord:       appendLine(out, " %llu/%llu", index, index); break;
+    case SyntheticObjLayout::PositionNormal:         appendLine(out, " %llu//%llu", index, index); break;
+    case SyntheticObjLayout::PositionTexCoordNormal: appendLine(out, " %llu/%llu/%llu", index, index, index); break;
+    }
+}
+}
+
+std::uint64_t SyntheticObjParameters::numberOfVertices() const
+{
+    return static_cast<std::uint64_t>(gridWidth + 1) * (gridHeight + 1);
+}
+
+std::uint64_t SyntheticObjParameters::numberOfFaces() const
+{
+    return static_cast<std::uint64_t>(gridWidth) * gridHeight * (quads ? 1 : 2);
+}
+
+std::string generateSyntheticObj(SyntheticObjParameters const& parameters)
+{
+    bool const has_texcoord = (parameters.layout == SyntheticObjLayout::PositionTexCoord) ||
+                              (parameters.layout == SyntheticObjLayout::PositionTexCoordNormal);
+    bool const has_normal = (parameters.layout == SyntheticObjLayout::PositionNormal) ||
+                            (parameters.layout == SyntheticObjLayout::PositionTexCoordNormal);
+    std::uint32_t const w = parameters.gridWidth;
+    std::uint32_t const h = parameters.gridHeight;
+
+    std::string ret;
+    ret.reserve(static_cast<std::size_t>(parameters.numberOfVertices() * 80 + parameters.numberOfFaces() * 40));
+    appendLine(ret, "# synthetic grid %ux%u\n", w, h);
+    // std::mt19937 output is fully specified by the standard, unlike the standard distributions
+    std::mt19937 rng(parameters.seed);
+    for (std::uint32_t y = 0; y <= h; ++y) {
+        for (std::uint32_t x = 0; x <= w; ++x) {
+            double const height = static_cast<double>(rng() % 100000) / 100000.0;
+            appendLine(ret, "v %.4f %.6f %.4f\n", static_cast<double>(x) / w, height, static_cast<double>(y) / h);
+            if (has_texcoord) {
+                appendLine(ret, "vt %.6f %.6f\n", static_cast<double>(x) / w, static_cast<double>(y) / h);
+            }
+            if (has_normal) {
+                double const nx = static_cast<double>(rng() % 1000) / 10000.0;
+                double const nz = static_cast<double>(rng() % 1000) / 10000.0;
+                appendLine(ret, "vn %.4f %.4f %.4f\n", nx, 1.0 - nx - nz, nz);
+            }
+        }
+    }
+    std::uint32_t const n_groups = std::clamp(parameters.numberOfGroups, 1u, std::max(h, 1u));
+    for (std::uint32_t y = 0; y < h; ++y) {
+        if ((static_cast<std::uint64_t>(y) * n_groups) % h < n_groups) {
+            appendLine(ret, "g group%u\n", static_cast<unsigned>((static_cast<std::uint64_t>(y) * n_groups) / h));
+        }
+        for (std::uint32_t x = 0; x < w; ++x) {
+            std::uint64_t const i00 = static_cast<std::uint64_t>(y) * (w + 1) + x;
+            std::uint64_t const i10 = i00 + 1;
+            std::uint64_t const i01 = i00 + w + 1;
+            std::uint64_t const i11 = i01 + 1;
+            if (parameters.quads) {
+                ret += 'f';
+                for (std::uint64_t i : { i00, i10, i11, i01 }) { appendFaceVertex(ret, parameters.layout, i); }
+                ret += '\n';
+            } else {
+                ret += 'f';
+                for (std::uint64_t i : { i00, i10, i11 }) { appendFaceVertex(ret, parameters.layout, i); }
+                ret += "\nf";
+                for (std::uint64_t i : { i00, i11, i01 }) { appendFaceVertex(ret, parameters.layout, i); }
+                ret += '\n';
+            }
+        }
+    }
+    return ret;
+}
+}
@@ -0,0 +1,46 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_BENCHMARK_SYNTHETIC_OBJ_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_BENCHMARK_SYNTHETIC_OBJ_HPP
+
+/** @file
+*
+* @brief Deterministic generator for synthetic OBJ files.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <cstdint>
+#include <string>
+
+namespace GhulbusGraphicsBenchmark
+{
+/** Per-vertex data referenced by the faces of a synthetic OBJ.
+ */
+enum class SyntheticObjLayout {
+    Position,                       ///< 'f v v v'
+    PositionTexCoord,               ///< 'f v/vt v/vt v/vt'
+    PositionNormal,                 ///< 'f v//vn v//vn v//vn'
+    PositionTexCoordNormal          ///< 'f v/vt/vn v/vt/vn v/vt/vn'
+};
+
+/** Parameters for generateSyntheticObj().
+ * The mesh is a height field over a grid of gridWidth x gridHeight cells with (gridWidth+1) x (gridHeight+1)
+ * vertices. Texture coordinates and normals are specified per vertex, so that every vertex is shared by
+ * all faces adjacent to it.
+ */
+struct SyntheticObjParameters {
+    std::uint32_t gridWidth = 256;
+    std::uint32_t gridHeight = 256;
+    SyntheticObjLayout layout = SyntheticObjLayout::PositionTexCoordNormal;
+    bool quads = false;                 ///< One quad per cell if true, two triangles otherwise
+    std::uint32_t numberOfGroups = 1;   ///< Cells are split into this many face groups of consecutive rows
+    std::uint32_t seed = 42;            ///< Seed for the height values
+
+    std::uint64_t numberOfVertices() const;
+    std::uint64_t numberOfFaces() const;
+};
+
+/** Generate the contents of an OBJ file.
+ * The output only depends on the parameters; it is identical across platforms and standard libraries.
+ */
+std::string generateSyntheticObj(SyntheticObjParameters const& parameters);
+}
+#endif
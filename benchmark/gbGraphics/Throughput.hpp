@@ -0,0 +1,68 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_BENCHMARK_THROUGHPUT_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_BENCHMARK_THROUGHPUT_HPP
+
+/** @file
+*
+* @brief Throughput reporting for benchmarks.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+
+namespace GhulbusGraphicsBenchmark
+{
+/** Run a function repeatedly and return the duration of the fastest run in seconds.
+ * @param[in] f Function to measure. Must return a value computed from its results,
+ *              to keep the compiler from optimizing the work away.
+ * @param[in] runs Number of invocations.
+ */
+template<typename F>
+double measureFastestRun(F&& f, int runs)
+{
+    using Clock = std::chrono::steady_clock;
+    Clock::duration best = Clock::duration::max();
+    for (int i = 0; i < runs; ++i) {
+        auto const t0 = Clock::now();
+        [[maybe_unused]] auto volatile result = f();
+        best = std::min(best, Clock::now() - t0);
+    }
+    return std::max(std::chrono::duration<double>(best).count(), 1e-9);
+}
+
+/** Run a function repeatedly and print its throughput, based on the fastest run.
+ * Catch only reports timings; This puts them in relation to the amount of input processed,
+ * which is comparable across input sizes.
+ * @param[in] name Name printed in the report.
+ * @param[in] bytes Number of input bytes processed by one invocation of f.
+ * @param[in] vertices Number of vertices processed by one invocation of f.
+ * @param[in] f Function to measure. Must return a value computed from its results,
+ *              to keep the compiler from optimizing the work away.
+ * @param[in] runs Number of invocations.
+ */
+template<typename F>
+void reportThroughput(std::string_view name, std::uint64_t bytes, std::uint64_t vertices, F&& f, int runs = 5)
+{
+    double const seconds = measureFastestRun(f, runs);
+    std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << (static_cast<double>(bytes) / seconds / (1 << 20)) << " MB/s"
+              << std::setw(10) << (static_cast<double>(vertices) / seconds / 1e6) << " Mvertices/s"
+              << std::setw(10) << (seconds * 1e3) << " ms\n";
+}
+
+/** Run a function repeatedly and print its throughput in bytes only, based on the fastest run.
+ */
+template<typename F>
+void reportThroughput(std::string_view name, std::uint64_t bytes, F&& f, int runs = 5)
+{
+    double const seconds = measureFastestRun(f, runs);
+    std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << (static_cast<double>(bytes) / seconds / (1 << 20)) << " MB/s"
+              << std::setw(10) << (seconds * 1e3) << " ms\n";
+}
+}
+#endif
@@ -264,9 +264,13 @@ int main()
     GhulbusGraphics::AnyMesh mesh(GhulbusGraphics::Mesh(graphics_instance, mesh_sphere.m_vertexData, mesh_sphere.m_indexData, img_loader));
     /*/
     GhulbusGraphics::ObjParser obj_parser;
-    obj_parser.readFile("chalet.obj");
     GhulbusGraphics::ImageLoader img_loader("chalet.jpg");
-    GhulbusGraphics::Mesh mesh(graphics_instance, obj_parser, img_loader);
+    auto mesh = GhulbusGraphics::Mesh<>::fromObjFile(graphics_instance, obj_parser, "chalet.obj", img_loader);
+    // alternatively, with 16-bit indices:
+    // obj_parser.readFile("chalet.obj");
+    // GhulbusGraphics::AnyMesh mesh(GhulbusGraphics::Mesh<GhulbusGraphics::ObjParser::VertexDataFlat,
+    //                                                      GhulbusGraphics::ObjParser::IndexData16>(
+    //     graphics_instance, obj_parser.getFlatData16(), img_loader));
     //*/
     auto& vertex_buffer = mesh.getVertexBuffer();
     auto& index_buffer = mesh.getIndexBuffer();
@@ -342,12 +346,18 @@ int main()
         auto sync_command_buffers = graphics_instance.getCommandPoolRegistry().allocateCommandBuffersGraphics_Transient(1);
         auto& sync_command_buffer = sync_command_buffers.getCommandBuffer(0);
         sync_command_buffer.begin();
-        vertex_buffer.getBuffer().transitionAcquire(sync_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                                                    VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
-                                                    graphics_instance.getTransferQueueFamilyIndex());
-        index_buffer.getBuffer().transitionAcquire(sync_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                                                   VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT,
-                                                   graphics_instance.getTransferQueueFamilyIndex());
+        // direct upload buffers are written through a mapping and never owned by the transfer queue
+        if (!vertex_buffer.isDirectUpload()) {
+            vertex_buffer.getBuffer().transitionAcquire(sync_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                                        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                                        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+                                                        graphics_instance.getTransferQueueFamilyIndex());
+        }
+        if (!index_buffer.isDirectUpload()) {
+            index_buffer.getBuffer().transitionAcquire(sync_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                                       VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT,
+                                                       graphics_instance.getTransferQueueFamilyIndex());
+        }
         texture.getImage().transitionAcquire(sync_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
                                              VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
                                              graphics_instance.getTransferQueueFamilyIndex(),
@@ -456,9 +466,11 @@ int main()
             VkDeviceSize offsets[] = { 0 };
             vkCmdBindVertexBuffers(command_buffer.getVkCommandBuffer(), 0, 1, vertexBuffers, offsets);
             vkCmdBindIndexBuffer(command_buffer.getVkCommandBuffer(), index_buffer.getBuffer().getVkBuffer(),
-                0, VK_INDEX_TYPE_UINT32);
-            auto const nindices = mesh.getNumberOfIndices();
-            vkCmdDrawIndexed(command_buffer.getVkCommandBuffer(), nindices, 1, 0, 0, 0);
+                0, mesh.getIndexType());
+            for (auto const& range : mesh.getDrawRanges()) {
+                vkCmdDrawIndexed(command_buffer.getVkCommandBuffer(), range.indexCount, 1,
+                                 range.firstIndex, range.vertexOffset, 0);
+            }
         });
     renderer.copyDrawCommands(0, 0, 1);
     renderer.setClearColor(GhulbusMath::Color4f(0.8f, 0.8f, 0.8f));
@@ -0,0 +1,146 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_ASSET_LOADER_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_ASSET_LOADER_HPP
+
+/** @file
+*
+* @brief Loading of assets on background threads.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/ImageLoader.hpp>
+#include <gbGraphics/Mesh.hpp>
+#include <gbGraphics/ObjParser.hpp>
+#include <gbGraphics/UploadBatch.hpp>
+
+#include <gbVk/Fence.hpp>
+#include <gbVk/SubmitStaging.hpp>
+
+#include <gbBase/AnyInvocable.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+class GraphicsInstance;
+
+/** Loads assets on a pool of worker threads.
+ * Parsing, decoding and recording of the uploads happen on the workers. Command buffers are taken from
+ * the worker's own transfer pool in the CommandPoolRegistry. Since the queues are not synchronized,
+ * the uploads are submitted by poll(), which has to be called regularly from the thread that uses the
+ * transfer queue, usually once per frame from the render loop:
+ * @code
+ * std::future<Mesh<>> mesh = asset_loader.loadMesh("chalet.obj", "chalet.jpg");
+ * while (rendering) {
+ *     asset_loader.poll();
+ *     if (mesh.valid() && (mesh.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+ *         meshes.emplace_back(mesh.get());
+ *     }
+ *     // ...
+ * }
+ * @endcode
+ * The futures of assets that need uploads become ready once the transfer queue has completed the upload.
+ * Exceptions thrown while loading are delivered through the future.
+ */
+class AssetLoader {
+private:
+    using Job = Ghulbus::AnyInvocable<void(std::size_t)>;
+    struct PendingUpload {
+        std::size_t worker;                                     ///< Worker that recorded the upload
+        GhulbusVulkan::SubmitStaging submitStaging;
+        Ghulbus::AnyInvocable<void()> onCompletion;             ///< Fulfills the promise
+    };
+    struct InFlightUpload {
+        GhulbusVulkan::Fence fence;
+        PendingUpload upload;
+    };
+    GraphicsInstance* m_instance;
+    std::mutex m_mtx;
+    std::condition_variable m_condition;
+    std::deque<Job> m_jobs;
+    std::vector<PendingUpload> m_uploadsToSubmit;
+    std::vector<std::vector<PendingUpload>> m_completedUploads;     ///< One entry per worker
+    std::list<InFlightUpload> m_uploadsInFlight;                    ///< Only accessed by poll()
+    std::atomic<uint32_t> m_numberOfPendingLoads;
+    bool m_isStopping;
+    std::vector<std::thread> m_workers;
+public:
+    explicit AssetLoader(GraphicsInstance& instance, uint32_t number_of_threads = 2);
+
+    /** Destructor.
+     * Waits for all pending loads to complete.
+     */
+    ~AssetLoader();
+
+    AssetLoader(AssetLoader const&) = delete;
+    AssetLoader& operator=(AssetLoader const&) = delete;
+
+    /** Decode an image file.
+     */
+    std::future<ImageLoader> loadImage(std::string filename);
+
+    /** Parse an OBJ file and decode its texture and upload both to a Mesh.
+     */
+    template<typename Mesh_T = Mesh<>>
+    std::future<Mesh_T> loadMesh(std::string obj_filename, std::string texture_filename);
+
+    /** Submit the uploads recorded by the workers and complete the loads whose uploads have finished.
+     * Must be called from the thread that submits to the transfer queue.
+     */
+    void poll();
+
+    /** Number of loads whose future is not ready yet.
+     */
+    uint32_t getNumberOfPendingLoads() const;
+
+    /** Call poll() until all loads have completed.
+     */
+    void waitIdle();
+private:
+    void enqueue(Job job);
+    void submitUpload(std::size_t worker, GhulbusVulkan::SubmitStaging&& submit_staging,
+                      Ghulbus::AnyInvocable<void()> on_completion);
+    void loadCompleted();
+    void workerMain(std::size_t worker);
+};
+
+template<typename Mesh_T>
+inline std::future<Mesh_T> AssetLoader::loadMesh(std::string obj_filename, std::string texture_filename)
+{
+    auto promise = std::make_shared<std::promise<Mesh_T>>();
+    std::future<Mesh_T> ret = promise->get_future();
+    enqueue([this, promise, obj_filename = std::move(obj_filename),
+             texture_filename = std::move(texture_filename)](std::size_t worker)
+        {
+            try {
+                ObjParser obj;
+                obj.readFile(obj_filename.c_str());
+                ImageLoader const texture(texture_filename.c_str());
+                UploadBatch upload_batch(*m_instance, m_instance->getGraphicsQueueFamilyIndex());
+                Mesh_T mesh(upload_batch, obj, texture);
+                // the mesh is kept alive by the completion handler until the upload has finished
+                submitUpload(worker, upload_batch.finish(),
+                             [promise, mesh = std::move(mesh)]() mutable { promise->set_value(std::move(mesh)); });
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+                loadCompleted();
+            }
+        });
+    return ret;
+}
+}
+#endif
@@ -9,7 +9,9 @@
 
 #include <gbGraphics/config.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <type_traits>
 #include <vector>
 
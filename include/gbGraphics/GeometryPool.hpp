@@ -0,0 +1,164 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_GEOMETRY_POOL_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_GEOMETRY_POOL_HPP
+
+/** @file
+*
+* @brief Shared vertex and index buffers for many meshes.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/MemoryBuffer.hpp>
+#include <gbGraphics/Mesh.hpp>
+#include <gbGraphics/UploadBatch.hpp>
+#include <gbGraphics/VertexFormat.hpp>
+#include <gbGraphics/detail/RangeAllocator.hpp>
+
+#include <gbVk/ForwardDecl.hpp>
+#include <gbVk/SubmitStaging.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+class GraphicsInstance;
+
+/** Vertex and index data of many meshes, sub-allocated from one vertex buffer and one index buffer.
+ * All meshes of a pool share a vertex format and use 32 bit indices. A mesh in the pool is identified
+ * by a MeshId and drawn through its MeshDrawRange, whose vertexOffset locates the mesh's vertices in
+ * the shared vertex buffer. As the buffers only need to be bound once, all meshes of the pool can be
+ * drawn with a single vkCmdDrawIndexedIndirect, see getDrawCommand().
+ */
+class GeometryPool {
+public:
+    using IndexType = uint32_t;
+    using MeshId = uint32_t;
+private:
+    struct MeshEntry {
+        uint64_t vertexOffset;          ///< Offset in vertices
+        uint32_t vertexCount;
+        uint64_t firstIndex;            ///< Offset in indices
+        uint32_t indexCount;
+        bool isLive;
+    };
+    GraphicsInstance* m_instance;
+    std::unique_ptr<VertexFormatBase> m_vertexFormat;
+    std::size_t m_vertexStride;
+    std::optional<MemoryBuffer> m_vertexBuffer;
+    std::optional<MemoryBuffer> m_indexBuffer;
+    detail::RangeAllocator m_vertexAllocator;
+    detail::RangeAllocator m_indexAllocator;
+    std::vector<MeshEntry> m_meshes;
+    std::vector<MeshId> m_freeIds;
+public:
+    /** Constructor.
+     * @param[in] vertex_format Format of the vertices of all meshes.
+     * @param[in] vertex_capacity Number of vertices in the vertex buffer.
+     * @param[in] index_capacity Number of indices in the index buffer.
+     */
+    GeometryPool(GraphicsInstance& instance, VertexFormatBase const& vertex_format,
+                 uint32_t vertex_capacity, uint32_t index_capacity);
+
+    VertexFormatBase const& getVertexFormat() const;
+
+    /** Reserve room for a mesh.
+     * @return Id of the new mesh or std::nullopt if the pool has no free range large enough.
+     */
+    std::optional<MeshId> allocate(uint32_t number_of_vertices, uint32_t number_of_indices);
+
+    /** Return the ranges of a mesh to the pool.
+     * @pre The mesh is no longer in use by the device.
+     */
+    void free(MeshId mesh);
+
+    /** Record the upload of the vertex and index data of a mesh.
+     * @param[in] vertex_data Vertices in the pool's vertex format.
+     * @param[in] index_data 32 bit indices, relative to the first vertex of the mesh.
+     */
+    void upload(UploadBatch& upload_batch, MeshId mesh, std::byte const* vertex_data, std::byte const* index_data);
+
+    /** Allocate a mesh and record the upload of its data.
+     * @return Id of the new mesh or std::nullopt if the pool has no free range large enough.
+     */
+    template<typename VertexData_T, typename IndexData_T>
+    std::optional<MeshId> addMesh(UploadBatch& upload_batch, VertexData_T const& vertex_data,
+                                  IndexData_T const& index_data);
+
+    uint32_t getNumberOfMeshes() const;
+
+    MeshDrawRange getDrawRange(MeshId mesh) const;
+
+    /** Indirect draw command for a mesh, to be written to an indirect buffer.
+     */
+    VkDrawIndexedIndirectCommand getDrawCommand(MeshId mesh, uint32_t instance_count = 1,
+                                                uint32_t first_instance = 0) const;
+
+    /** Bind the vertex buffer to binding and the index buffer.
+     */
+    void bind(GhulbusVulkan::CommandBuffer& command_buffer, uint32_t binding);
+
+    /** Draw a single mesh.
+     * @pre bind() was recorded before.
+     */
+    void recordDraw(GhulbusVulkan::CommandBuffer& command_buffer, MeshId mesh);
+
+    /** Draw meshes with draw commands from an indirect buffer.
+     * @param[in] indirect_buffer Buffer with usage VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, holding draw_count
+     *                            tightly packed commands obtained from getDrawCommand().
+     * @pre bind() was recorded before.
+     * @pre draw_count is at most 1, unless the multiDrawIndirect device feature is enabled.
+     */
+    void recordMultiDraw(GhulbusVulkan::CommandBuffer& command_buffer, MemoryBuffer& indirect_buffer,
+                         uint32_t draw_count);
+
+    /** Ratio of free space in the vertex and index buffers that is not usable for the largest allocation.
+     * @see detail::RangeAllocator::getFragmentation()
+     */
+    float getFragmentation() const;
+
+    /** Move all meshes to the start of new vertex and index buffers, closing the gaps left by freed meshes.
+     * The MeshIds stay valid, but their draw ranges change, so draw commands have to be recorded again.
+     * The old buffers are kept alive until the cleanup of the returned submission.
+     * The copies are recorded for the queue family owning the buffers, so that no ownership transfers are
+     * required; the returned submission has to be staged on the graphics queue if target_queue is the graphics
+     * queue family, on the compute queue if it is the compute queue family, and on the transfer queue otherwise.
+     * @param[in] target_queue Queue family the meshes were released to by the UploadBatch passed to upload();
+     *                         The new buffers are owned by this queue family as well.
+     *                         If not set, the buffers are owned by the transfer queue family.
+     * @pre The pool is not in use by the device.
+     */
+    GhulbusVulkan::SubmitStaging defragment(std::optional<uint32_t> target_queue = std::nullopt);
+
+    MemoryBuffer& getVertexBuffer();
+    MemoryBuffer& getIndexBuffer();
+private:
+    MeshEntry const& getEntry(MeshId mesh) const;
+    MemoryBuffer createVertexBuffer(uint64_t vertex_capacity);
+    MemoryBuffer createIndexBuffer(uint64_t index_capacity);
+};
+
+template<typename VertexData_T, typename IndexData_T>
+inline std::optional<GeometryPool::MeshId> GeometryPool::addMesh(UploadBatch& upload_batch,
+                                                                 VertexData_T const& vertex_data,
+                                                                 IndexData_T const& index_data)
+{
+    static_assert(std::is_same_v<typename IndexData_T::IndexType::ValueType, IndexType>,
+                  "Geometry pool uses 32 bit indices.");
+    GHULBUS_PRECONDITION(sizeof(typename VertexData_T::Storage) == m_vertexStride);
+    std::optional<MeshId> const ret = allocate(static_cast<uint32_t>(vertex_data.size()),
+                                               static_cast<uint32_t>(index_data.size()));
+    if (ret) {
+        upload(upload_batch, *ret, vertex_data.data(), index_data.data());
+    }
+    return ret;
+}
+}
+#endif
@@ -18,7 +18,9 @@
 namespace GHULBUS_GRAPHICS_NAMESPACE
 {
 class CommandPoolRegistry;
+class MipmapGenerator;
 class Reactor;
+class StagingRing;
 
 struct ApplicationVersion {
     uint16_t major;
@@ -41,6 +43,8 @@ private:
     std::unique_ptr<Pimpl> m_pimpl;
     std::unique_ptr<CommandPoolRegistry> m_commandPoolRegistry;
     std::unique_ptr<Reactor> m_reactor;
+    std::unique_ptr<StagingRing> m_stagingRing;
+    std::unique_ptr<MipmapGenerator> m_mipmapGenerator;
     std::mutex m_mtx;
 public:
     GraphicsInstance();
@@ -81,6 +85,14 @@ public:
 
     Reactor& getReactor();
 
+    /** Staging memory shared by all uploads.
+     */
+    StagingRing& getStagingRing();
+
+    /** Generation of mip chains, shared by all images.
+     */
+    MipmapGenerator& getMipmapGenerator();
+
     template<typename F>
     void threadSafeDeviceAccess(F&& f)
     {
@@ -22,16 +22,35 @@ namespace GHULBUS_GRAPHICS_NAMESPACE
 using GhulbusVulkan::MemoryUsage;
 
 class GraphicsInstance;
+class ImageContainerLoader;
 
 class Image2d {
 public:
     struct NoDeviceMemory_T {};
     static constexpr NoDeviceMemory_T noDeviceMemory = {};
+    struct FullMipChain_T {};
+    static constexpr FullMipChain_T fullMipChain = {};
 private:
     GhulbusGraphics::GenericImage m_genImage;
 public:
     Image2d(GraphicsInstance& instance, uint32_t width, uint32_t height);
 
+    /** Constructor for an image with mip levels down to 1x1.
+     * The mip levels are generated on the device by setDataAsynchronously(), with the method that
+     * MipmapGenerator selects for format.
+     * @param[in] format An uncompressed color format.
+     * @throw Exceptions::InvalidArgument If mip levels cannot be generated for the format.
+     */
+    Image2d(GraphicsInstance& instance, uint32_t width, uint32_t height, FullMipChain_T,
+            VkFormat format = VK_FORMAT_R8G8B8A8_UNORM);
+
+    /** Constructor for an image with the size, format and mip levels of an image container.
+     * If the device cannot sample the format of image_data, the image uses the format that the texels
+     * are decompressed to instead. Upload the texels with UploadBatch::addImageUpload().
+     * @throw Exceptions::NotImplemented If the format is neither supported by the device nor can be decompressed.
+     */
+    Image2d(GraphicsInstance& instance, ImageContainerLoader const& image_data);
+
     Image2d(GraphicsInstance& instance, uint32_t width, uint32_t height, VkImageTiling tiling,
             VkImageUsageFlags image_usage, MemoryUsage memory_usage);
 
@@ -41,6 +60,13 @@ public:
 
     uint32_t getWidth() const;
     uint32_t getHeight() const;
+    uint32_t getMipLevels() const;
+    VkFormat getFormat() const;
+
+    /** Whether images of a format can be sampled on the device.
+     * Block-compressed formats additionally require the textureCompressionBC device feature.
+     */
+    static bool isFormatSupported(GraphicsInstance& instance, VkFormat format);
 
     bool isMappable() const;
 
@@ -50,6 +76,13 @@ public:
 
     GhulbusVulkan::ImageView createImageView();
 
+    /** Upload the texels of the first mip level.
+     * The texels are tightly packed in the format of the image.
+     * For images with more than one mip level, the other levels are generated from the first one on the device.
+     * The commands then use the graphics queue family and have to be submitted to the graphics queue;
+     * otherwise they use the transfer queue family.
+     * @param[in] target_queue If set, the image is released to this queue family.
+     */
     GhulbusVulkan::SubmitStaging setDataAsynchronously(std::byte const* data,
                                                        std::optional<uint32_t> target_queue = std::nullopt);
 
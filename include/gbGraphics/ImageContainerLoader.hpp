@@ -0,0 +1,71 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_IMAGE_CONTAINER_LOADER_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_IMAGE_CONTAINER_LOADER_HPP
+
+/** @file
+*
+* @brief Loading of KTX2 and DDS image containers.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+/** Loads 2D images with all of their mip levels from KTX2 or DDS files.
+ * Unlike ImageLoader, the texels are not converted. Pre-compressed block formats like BC1, BC3, BC5 and BC7
+ * are kept compressed, so they can be uploaded as is. Formats the device cannot sample can be decompressed
+ * to RGBA8 on the host with decompress().
+ * Supercompressed KTX2 files, cube maps, array images and 3D images are not supported.
+ */
+class ImageContainerLoader {
+public:
+    /** Location of a mip level in the tightly packed data of all levels.
+     */
+    struct MipLevel {
+        VkDeviceSize offset;
+        VkDeviceSize size;
+        uint32_t width;
+        uint32_t height;
+    };
+private:
+    std::vector<std::byte> m_data;
+    std::vector<MipLevel> m_mipLevels;          ///< Largest level first
+    VkFormat m_format;
+public:
+    /** Load a file.
+     * The container format is detected from the file contents.
+     * @throw Exceptions::IOError If the file cannot be read or is not a valid KTX2 or DDS file, or if the
+     *                            width or height of the image exceeds 16384 texels.
+     * @throw Exceptions::NotImplemented If the file uses an unsupported feature or format.
+     */
+    explicit ImageContainerLoader(char const* filename);
+
+    VkFormat getFormat() const;
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+    uint32_t getMipLevels() const;
+    MipLevel const& getMipLevel(uint32_t level) const;
+
+    /** Texels of all mip levels, largest level first.
+     */
+    std::byte const* getData() const;
+    VkDeviceSize getDataSize() const;
+
+    /** Decompress all mip levels on the host.
+     * @return Image in the format given by detail::getDecompressedFormat().
+     * @throw Exceptions::NotImplemented If decompression of the format is not supported.
+     */
+    ImageContainerLoader decompress() const;
+private:
+    ImageContainerLoader(VkFormat format, uint32_t width, uint32_t height, uint32_t mip_levels);
+    void loadKtx2(char const* data, std::size_t size, char const* filename);
+    void loadDds(char const* data, std::size_t size, char const* filename);
+};
+}
+#endif
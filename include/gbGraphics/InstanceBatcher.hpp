@@ -0,0 +1,129 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_INSTANCE_BATCHER_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_INSTANCE_BATCHER_HPP
+
+/** @file
+*
+* @brief Merging of draws into instanced draws.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/MemoryBuffer.hpp>
+#include <gbGraphics/VertexFormat.hpp>
+#include <gbGraphics/detail/InstanceBatchList.hpp>
+
+#include <gbVk/ForwardDecl.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+class AnyMesh;
+class GraphicsInstance;
+
+/** Collects draws of meshes and merges all draws sharing a mesh and a pipeline into one instanced draw.
+ * Each draw contributes one instance with per-instance data in the instance format. Instance data of all
+ * batches is written to a host-visible instance buffer, which has to be bound to a vertex binding
+ * added with Program::addVertexBinding(binding, instance_format, VK_VERTEX_INPUT_RATE_INSTANCE).
+ * There is one instance buffer per frame in flight, so that the instance data of a frame can be written
+ * while the device is still reading that of the previous frames. With the Renderer, frames are identified
+ * by the swapchain image; frames_in_flight is Window::getNumberOfImagesInSwapchain() and the frame index
+ * is the target index passed to the draw recording callback.
+ * Usage for one frame:
+ *  - clear()
+ *  - addInstance() for each draw
+ *  - upload() for the frame index
+ *  - recordDrawCommands() from within the Renderer draw recording callback of each pipeline
+ *
+ * As the Renderer records its command buffers once, the draw commands have to be recorded again
+ * (by recreating the pipelines) whenever the number of instances in a batch changes.
+ * Instance data of unchanged batches can be updated by calling upload() again.
+ */
+class InstanceBatcher {
+public:
+    /** All instances of one mesh drawn with one pipeline.
+     * firstInstance is the index of the first instance in the instance buffer and is valid after upload().
+     */
+    using Batch = detail::InstanceBatchList<AnyMesh>::Batch;
+private:
+    GraphicsInstance* m_instance;
+    std::unique_ptr<VertexFormatBase> m_instanceFormat;
+    uint32_t m_maxInstances;
+    std::vector<MemoryBuffer> m_instanceBuffers;                    ///< one buffer per frame in flight
+    detail::InstanceBatchList<AnyMesh> m_batches;
+public:
+    /** Constructor.
+     * @param[in] instance_format Format of the per-instance data.
+     * @param[in] max_instances Capacity of each instance buffer.
+     * @param[in] frames_in_flight Number of frames the device may be working on.
+     */
+    InstanceBatcher(GraphicsInstance& instance, VertexFormatBase const& instance_format, uint32_t max_instances,
+                    uint32_t frames_in_flight);
+
+    VertexFormatBase const& getInstanceFormat() const;
+    uint32_t getMaxInstances() const;
+    uint32_t getNumberOfInstances() const;
+    uint32_t getFramesInFlight() const;
+
+    /** Add a draw of mesh with pipeline_index.
+     * @param[in] instance_data Per-instance data of the draw; getInstanceFormat().getStride() bytes.
+     * @pre There is room for another instance in the instance buffer.
+     */
+    void addInstance(uint32_t pipeline_index, AnyMesh& mesh, std::byte const* instance_data);
+
+    /** Add a draw of mesh with pipeline_index.
+     * @param[in] instance_data Per-instance data of the draw, usually the Storage of a VertexData
+     *                          matching the instance format.
+     */
+    template<typename T>
+    void addInstance(uint32_t pipeline_index, AnyMesh& mesh, T const& instance_data);
+
+    /** Remove all batches.
+     */
+    void clear();
+
+    /** Write the instance data of all batches to the instance buffer of a frame.
+     * The instances of each batch are stored contiguously, starting at the batch's firstInstance.
+     * @param[in] frame_index Frame whose instance buffer is written.
+     * @pre frame_index < getFramesInFlight()
+     * @pre The device has completed all work of the last frame that used frame_index.
+     */
+    void upload(uint32_t frame_index);
+
+    std::span<Batch const> getBatches() const;
+
+    /** Number of draw calls issued by recordDrawCommands() for all pipelines.
+     * One for each draw range of each batch's mesh.
+     */
+    uint32_t getNumberOfDrawCalls() const;
+
+    GhulbusGraphics::MemoryBuffer& getInstanceBuffer(uint32_t frame_index);
+
+    /** Record instanced draws for all batches of a pipeline.
+     * Binds the vertex and index buffers of each mesh and the instance buffer of the frame.
+     * @param[in] frame_index Frame whose instance buffer is read by the draws.
+     * @param[in] mesh_binding Vertex binding for the mesh's vertex buffer.
+     * @param[in] instance_binding Vertex binding for the instance buffer.
+     * @pre frame_index < getFramesInFlight()
+     */
+    void recordDrawCommands(uint32_t pipeline_index, GhulbusVulkan::CommandBuffer& command_buffer,
+                            uint32_t frame_index, uint32_t mesh_binding, uint32_t instance_binding);
+};
+
+template<typename T>
+inline void InstanceBatcher::addInstance(uint32_t pipeline_index, AnyMesh& mesh, T const& instance_data)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Instance data must be trivially copyable.");
+    GHULBUS_PRECONDITION(sizeof(T) == m_batches.getInstanceStride());
+    addInstance(pipeline_index, mesh, reinterpret_cast<std::byte const*>(&instance_data));
+}
+}
+#endif
@@ -11,12 +11,14 @@
 
 #include <gbVk/Buffer.hpp>
 #include <gbVk/DeviceMemory.hpp>
+#include <gbVk/ForwardDecl.hpp>
 #include <gbVk/MappedMemory.hpp>
 #include <gbVk/MemoryUsage.hpp>
 #include <gbVk/SubmitStaging.hpp>
 
 #include <cstdint>
 #include <optional>
+#include <span>
 
 namespace GHULBUS_GRAPHICS_NAMESPACE
 {
@@ -25,6 +27,13 @@ using GhulbusVulkan::MemoryUsage;
 class GraphicsInstance;
 
 class MemoryBuffer {
+public:
+    /** A byte range of the buffer.
+     */
+    struct Range {
+        VkDeviceSize offset;
+        VkDeviceSize size;
+    };
 private:
     GhulbusVulkan::Buffer m_buffer;
     GhulbusVulkan::DeviceMemory m_deviceMemory;
@@ -32,6 +41,7 @@ private:
     VkDeviceSize m_size;
     VkBufferUsageFlags m_bufferUsage;
     MemoryUsage m_memoryUsage;
+    bool m_isDirectUpload;
 public:
     MemoryBuffer(GraphicsInstance& instance, VkDeviceSize size,
                  VkBufferUsageFlags buffer_usage, MemoryUsage memory_usage);
@@ -44,6 +54,13 @@ public:
     MemoryBuffer(MemoryBuffer&&) = default;
 
     bool isMappable() const;
+
+    /** Whether data is written directly to the buffer's memory, instead of being copied from staging memory.
+     * True for buffers with MemoryUsage::GpuOnlyDirectUpload that were placed in host-visible device memory.
+     * The setData functions of such buffers write through a mapping and return an empty submission.
+     * @pre The buffer is not in use by the device when setting data.
+     */
+    bool isDirectUpload() const;
     VkBufferUsageFlags getBufferUsage() const;
     MemoryUsage getMemoryUsage() const;
 
@@ -51,12 +68,65 @@ public:
 
     GhulbusVulkan::MappedMemory map(VkDeviceSize offset, VkDeviceSize size);
 
+    /** Copy data to this buffer.
+     * The data is staged in the GraphicsInstance's StagingRing if it has room for the complete buffer,
+     * otherwise in a dedicated staging buffer. The staging memory is kept until the submission has been cleaned up.
+     */
     GhulbusVulkan::SubmitStaging setDataAsynchronously(std::byte const* data,
                                                        std::optional<uint32_t> target_queue = std::nullopt);
 
+    /** Copy data to a range of this buffer.
+     * @param[in] data The size bytes to be written to the range starting at offset.
+     */
+    GhulbusVulkan::SubmitStaging setDataAsynchronously(std::byte const* data, VkDeviceSize offset, VkDeviceSize size,
+                                                       std::optional<uint32_t> target_queue = std::nullopt);
+
+    /** Copy the dirty ranges of a host copy of this buffer to the buffer.
+     * All ranges are packed into one staging allocation and copied by a single vkCmdCopyBuffer.
+     * Overlapping and adjacent ranges are merged.
+     * @param[in] data Host copy of the complete buffer; only the bytes in ranges are read.
+     */
+    GhulbusVulkan::SubmitStaging setDataAsynchronously(std::byte const* data, std::span<Range const> ranges,
+                                                       std::optional<uint32_t> target_queue = std::nullopt);
+
+    /** Copy the complete contents of a staging buffer to this buffer.
+     * Allows filling the staging memory in place, instead of copying from an intermediate host buffer.
+     * @param[in] staging_buffer Mappable buffer with usage VK_BUFFER_USAGE_TRANSFER_SRC_BIT and the same size
+     *                           as this buffer. It is kept alive until the submission has been processed.
+     */
+    GhulbusVulkan::SubmitStaging setDataAsynchronously(MemoryBuffer&& staging_buffer,
+                                                       std::optional<uint32_t> target_queue = std::nullopt);
+
+    /** Copy data to this buffer in chunks through the GraphicsInstance's StagingRing.
+     * Needs no more staging memory than the capacity of the ring, regardless of the size of the buffer.
+     * The chunks are submitted to the transfer queue directly; all of them have completed once
+     * the function returns.
+     */
+    void setDataChunked(std::byte const* data, std::optional<uint32_t> target_queue = std::nullopt);
+
+    /** Write the dirty ranges of a host copy of this buffer through a mapping.
+     * Only the written ranges are flushed, so this is also correct for memory that is not host coherent.
+     * @param[in] data Host copy of the complete buffer; only the bytes in ranges are read.
+     * @pre The buffer is mappable and not in use by the device.
+     */
+    void setDataMapped(std::byte const* data, std::span<Range const> ranges);
+
+    /** Write data to a range of this buffer through a mapping.
+     * @param[in] data The size bytes to be written to the range starting at offset.
+     * @pre The buffer is mappable and not in use by the device.
+     */
+    void setDataMapped(std::byte const* data, VkDeviceSize offset, VkDeviceSize size);
+
     VkDeviceSize getSize() const;
 
     GhulbusVulkan::Buffer& getBuffer();
+private:
+    void writeRangesMapped(std::byte const* data, VkDeviceSize data_offset, std::span<Range const> ranges);
+    GhulbusVulkan::SubmitStaging stageRanges(std::byte const* data, VkDeviceSize data_offset,
+                                             std::span<Range const> ranges, std::optional<uint32_t> target_queue);
+    GhulbusVulkan::CommandBuffers recordCopyFromStaging(GhulbusVulkan::Buffer& staging_buffer,
+                                                        std::span<VkBufferCopy const> regions,
+                                                        std::optional<uint32_t> target_queue);
 };
 }
 #endif
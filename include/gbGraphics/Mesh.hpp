@@ -9,20 +9,32 @@
 
 #include <gbGraphics/config.hpp>
 
+#include <gbGraphics/Exceptions.hpp>
 #include <gbGraphics/GraphicsInstance.hpp>
 #include <gbGraphics/GenericIndexData.hpp>
 #include <gbGraphics/Image2d.hpp>
 #include <gbGraphics/ImageLoader.hpp>
 #include <gbGraphics/MemoryBuffer.hpp>
+#include <gbGraphics/MeshCache.hpp>
 #include <gbGraphics/ObjParser.hpp>
+#include <gbGraphics/UploadBatch.hpp>
+#include <gbGraphics/VertexConversion.hpp>
 #include <gbGraphics/VertexData.hpp>
+#include <gbGraphics/detail/MappedFile.hpp>
 
+#include <gbVk/MappedMemory.hpp>
 #include <gbVk/Queue.hpp>
 
 #include <gbMath/Vector2.hpp>
 #include <gbMath/Vector3.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace GHULBUS_GRAPHICS_NAMESPACE
 {
@@ -30,6 +42,21 @@ class GraphicsInstance;
 class ImageLoader;
 class ObjParser;
 
+/** Range of the index buffer of a Mesh that is drawn with a single indexed draw.
+ */
+struct MeshDrawRange {
+    uint32_t firstIndex;                ///< Position of the first index in the index buffer
+    uint32_t indexCount;                ///< Number of indices
+    int32_t vertexOffset;               ///< Added to every index to obtain the vertex
+};
+
+/** Vertex buffer, index buffer and texture of a drawable mesh.
+ * Unless stated otherwise, the constructors allocate the vertex and index buffers with
+ * MemoryUsage::GpuOnlyDirectUpload. Buffers for which MemoryBuffer::isDirectUpload() is true are written
+ * through a mapping and are never released to the graphics queue family, so they must not be acquired
+ * from the transfer queue family. Buffers that are not direct upload and the texture are released
+ * to the graphics queue family by the upload and have to be acquired there before use.
+ */
 template<typename VertexData_T = VertexData<
         VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>,
         VertexComponent<GhulbusMath::Normal3f, VertexComponentSemantics::Normal>,
@@ -44,58 +71,250 @@ private:
     GhulbusGraphics::MemoryBuffer m_vertexBuffer;
     GhulbusGraphics::MemoryBuffer m_indexBuffer;
     GhulbusGraphics::Image2d m_texture;
+    std::vector<MeshDrawRange> m_drawRanges;
 public:
+    /** Constructor.
+     * The flat vertices of obj are converted to VertexFormat, see VertexConversion.
+     * There is one draw range for each face group of obj.
+     */
     Mesh(GraphicsInstance& instance, ObjParser const& obj, ImageLoader const& texture_loader);
+    /** Constructor.
+     * Records the uploads into upload_batch instead of staging a submission of its own.
+     * The mesh must not be used before the submission of the batch has completed.
+     */
+    Mesh(UploadBatch& upload_batch, ObjParser const& obj, ImageLoader const& texture_loader);
+    /** Constructor.
+     * There is one draw range for each chunk of flat_data.
+     * @note Requires VertexData to be ObjParser::VertexDataFlat and IndexData to be ObjParser::IndexData16.
+     */
+    Mesh(GraphicsInstance& instance, ObjParser::FlatData16 const& flat_data, ImageLoader const& texture_loader);
+    /** Constructor.
+     * Vertex and index data are uploaded directly from the memory-mapped cache file.
+     * There is one draw range for each face group of the cache.
+     * @throw Exceptions::InvalidArgument If the cached vertex data does not match VertexFormat.
+     */
+    Mesh(GraphicsInstance& instance, MeshCache const& cache, ImageLoader const& texture_loader);
+    /** Constructor.
+     * Records the uploads into upload_batch instead of staging a submission of its own.
+     * The mesh must not be used before the submission of the batch has completed.
+     */
+    Mesh(UploadBatch& upload_batch, MeshCache const& cache, ImageLoader const& texture_loader);
     Mesh(GraphicsInstance& instance, VertexData const& vertex_data,
          IndexData const& index_data, ImageLoader const& texture_loader);
+    /** Constructor.
+     * Records the uploads into upload_batch instead of staging a submission of its own.
+     * The mesh must not be used before the submission of the batch has completed.
+     */
+    Mesh(UploadBatch& upload_batch, VertexData const& vertex_data,
+         IndexData const& index_data, ImageLoader const& texture_loader);
+    /** Constructor.
+     * The vertex and index buffers are allocated with MemoryUsage::GpuOnly and always have to be acquired.
+     * @param[in] vertex_staging Staging buffer holding the complete vertex data.
+     * @param[in] index_staging Staging buffer holding the complete index data.
+     */
+    Mesh(GraphicsInstance& instance, MemoryBuffer&& vertex_staging,
+         MemoryBuffer&& index_staging, ImageLoader const& texture_loader);
+
+    /** Load a mesh from an OBJ file.
+     * The flattened vertices and indices are written by the parser straight into mapped staging memory,
+     * which is then copied to the device. Unlike reading the file with obj first and constructing
+     * the Mesh from it, this does not require any intermediate host copy of the flat data.
+     * @param[in,out] obj Parser used for reading the file. Receives the face groups of the mesh,
+     *                    but no flat data.
+     * @param[in] filename Full path to the OBJ file.
+     */
+    static Mesh fromObjFile(GraphicsInstance& instance, ObjParser& obj, char const* filename,
+                            ImageLoader const& texture_loader);
 
     uint32_t getNumberOfIndices() const;
     uint32_t getNumberOfVertices() const;
+    VkIndexType getIndexType() const;
+
+    /** Get the ranges of the index buffer to draw.
+     * Each range is drawn with a separate indexed draw.
+     * Unless stated otherwise by the constructor, there is a single range covering the whole index buffer.
+     */
+    std::span<MeshDrawRange const> getDrawRanges() const;
 
     GhulbusGraphics::MemoryBuffer& getVertexBuffer();
     GhulbusGraphics::MemoryBuffer& getIndexBuffer();
     GhulbusGraphics::Image2d& getTexture();
+private:
+    void addUploads(UploadBatch& upload_batch, std::byte const* vertex_data, std::byte const* index_data,
+                    ImageLoader const& texture_loader);
+    void addUploads(UploadBatch& upload_batch, ObjParser const& obj, ImageLoader const& texture_loader);
+    void addDrawRanges(MeshCache const& cache);
+    void addDrawRanges(ObjParser const& obj);
 };
 
 template<typename V_T, typename I_T>
 inline Mesh<V_T, I_T>::Mesh(GraphicsInstance& instance, ObjParser const& obj, ImageLoader const& texture_loader)
-    : m_vertexBuffer(instance,  obj.numberOfFlatVertices() * sizeof(ObjParser::VertexEntryFlat),
-                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly),
+    : m_vertexBuffer(instance,  obj.numberOfFlatVertices() * sizeof(typename VertexData::Storage),
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    MemoryUsage::GpuOnlyDirectUpload),
       m_indexBuffer(instance, obj.numberOfFlatFaces() * 3 * sizeof(ObjParser::IndexType),
-                   VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly),
+                   VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                   MemoryUsage::GpuOnlyDirectUpload),
       m_texture(instance, texture_loader.getWidth(), texture_loader.getHeight())
 {
-    GhulbusVulkan::Queue& transfer_queue = instance.getTransferQueue();
-    transfer_queue.stageSubmission(
-        m_vertexBuffer.setDataAsynchronously(reinterpret_cast<std::byte const*>(obj.getFlatVertices().data()),
-                                             instance.getGraphicsQueueFamilyIndex()));
-    transfer_queue.stageSubmission(
-        m_indexBuffer.setDataAsynchronously(reinterpret_cast<std::byte const*>(obj.getFlatIndices().data()),
-                                            instance.getGraphicsQueueFamilyIndex()));
-    transfer_queue.stageSubmission(
-        m_texture.setDataAsynchronously(reinterpret_cast<std::byte const*>(texture_loader.getData()),
-                                        instance.getGraphicsQueueFamilyIndex()));
+    UploadBatch upload_batch(instance, instance.getGraphicsQueueFamilyIndex());
+    addUploads(upload_batch, obj, texture_loader);
+    instance.getTransferQueue().stageSubmission(upload_batch.finish());
+    addDrawRanges(obj);
+}
+
+template<typename V_T, typename I_T>
+inline Mesh<V_T, I_T>::Mesh(UploadBatch& upload_batch, ObjParser const& obj, ImageLoader const& texture_loader)
+    : m_vertexBuffer(upload_batch.getInstance(),  obj.numberOfFlatVertices() * sizeof(typename VertexData::Storage),
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    MemoryUsage::GpuOnlyDirectUpload),
+      m_indexBuffer(upload_batch.getInstance(), obj.numberOfFlatFaces() * 3 * sizeof(ObjParser::IndexType),
+                   VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                   MemoryUsage::GpuOnlyDirectUpload),
+      m_texture(upload_batch.getInstance(), texture_loader.getWidth(), texture_loader.getHeight())
+{
+    addUploads(upload_batch, obj, texture_loader);
+    addDrawRanges(obj);
+}
+
+template<typename V_T, typename I_T>
+inline Mesh<V_T, I_T>::Mesh(GraphicsInstance& instance, ObjParser::FlatData16 const& flat_data,
+                            ImageLoader const& texture_loader)
+    :Mesh(instance, flat_data.vertices, flat_data.indices, texture_loader)
+{
+    m_drawRanges.clear();
+    for (auto const& chunk : flat_data.chunks) {
+        m_drawRanges.push_back(MeshDrawRange{ static_cast<uint32_t>(chunk.firstIndex),
+                                              static_cast<uint32_t>(chunk.indexCount), chunk.vertexOffset });
+    }
+}
+
+template<typename V_T, typename I_T>
+inline Mesh<V_T, I_T>::Mesh(GraphicsInstance& instance, MeshCache const& cache, ImageLoader const& texture_loader)
+    : m_vertexBuffer(instance, cache.getVertexData().size(),
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    MemoryUsage::GpuOnlyDirectUpload),
+      m_indexBuffer(instance, cache.getIndexData().size_bytes(),
+                   VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                   MemoryUsage::GpuOnlyDirectUpload),
+      m_texture(instance, texture_loader.getWidth(), texture_loader.getHeight())
+{
+    static_assert(std::is_same_v<typename IndexData::IndexType::ValueType, std::uint32_t>,
+                  "Cached indices are 32 bit.");
+    if (!cache.template hasVertexFormat<VertexFormat>()) {
+        GHULBUS_THROW(Exceptions::InvalidArgument{}, "Cached vertex data does not match vertex format.");
+    }
+    UploadBatch upload_batch(instance, instance.getGraphicsQueueFamilyIndex());
+    addUploads(upload_batch, cache.getVertexData().data(),
+               reinterpret_cast<std::byte const*>(cache.getIndexData().data()), texture_loader);
+    instance.getTransferQueue().stageSubmission(upload_batch.finish());
+    addDrawRanges(cache);
+}
+
+template<typename V_T, typename I_T>
+inline Mesh<V_T, I_T>::Mesh(UploadBatch& upload_batch, MeshCache const& cache, ImageLoader const& texture_loader)
+    : m_vertexBuffer(upload_batch.getInstance(), cache.getVertexData().size(),
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    MemoryUsage::GpuOnlyDirectUpload),
+      m_indexBuffer(upload_batch.getInstance(), cache.getIndexData().size_bytes(),
+                   VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                   MemoryUsage::GpuOnlyDirectUpload),
+      m_texture(upload_batch.getInstance(), texture_loader.getWidth(), texture_loader.getHeight())
+{
+    static_assert(std::is_same_v<typename IndexData::IndexType::ValueType, std::uint32_t>,
+                  "Cached indices are 32 bit.");
+    if (!cache.template hasVertexFormat<VertexFormat>()) {
+        GHULBUS_THROW(Exceptions::InvalidArgument{}, "Cached vertex data does not match vertex format.");
+    }
+    addUploads(upload_batch, cache.getVertexData().data(),
+               reinterpret_cast<std::byte const*>(cache.getIndexData().data()), texture_loader);
+    addDrawRanges(cache);
 }
 
 template<typename V_T, typename I_T>
 inline Mesh<V_T, I_T>::Mesh(GraphicsInstance& instance, VertexData const& vertex_data,
                             IndexData const& index_data, ImageLoader const& texture_loader)
     :m_vertexBuffer(instance, vertex_data.size() * sizeof(typename VertexData::Storage),
-                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly),
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    MemoryUsage::GpuOnlyDirectUpload),
     m_indexBuffer(instance, index_data.size() * sizeof(typename IndexData::IndexType),
+                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                  MemoryUsage::GpuOnlyDirectUpload),
+    m_texture(instance, texture_loader.getWidth(), texture_loader.getHeight())
+{
+    UploadBatch upload_batch(instance, instance.getGraphicsQueueFamilyIndex());
+    addUploads(upload_batch, vertex_data.data(), index_data.data(), texture_loader);
+    instance.getTransferQueue().stageSubmission(upload_batch.finish());
+    m_drawRanges.push_back(MeshDrawRange{ 0, getNumberOfIndices(), 0 });
+}
+
+template<typename V_T, typename I_T>
+inline Mesh<V_T, I_T>::Mesh(UploadBatch& upload_batch, VertexData const& vertex_data,
+                            IndexData const& index_data, ImageLoader const& texture_loader)
+    :m_vertexBuffer(upload_batch.getInstance(), vertex_data.size() * sizeof(typename VertexData::Storage),
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    MemoryUsage::GpuOnlyDirectUpload),
+    m_indexBuffer(upload_batch.getInstance(), index_data.size() * sizeof(typename IndexData::IndexType),
+                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                  MemoryUsage::GpuOnlyDirectUpload),
+    m_texture(upload_batch.getInstance(), texture_loader.getWidth(), texture_loader.getHeight())
+{
+    addUploads(upload_batch, vertex_data.data(), index_data.data(), texture_loader);
+    m_drawRanges.push_back(MeshDrawRange{ 0, getNumberOfIndices(), 0 });
+}
+
+template<typename V_T, typename I_T>
+inline Mesh<V_T, I_T>::Mesh(GraphicsInstance& instance, MemoryBuffer&& vertex_staging,
+                            MemoryBuffer&& index_staging, ImageLoader const& texture_loader)
+    :m_vertexBuffer(instance, vertex_staging.getSize(),
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly),
+    m_indexBuffer(instance, index_staging.getSize(),
                   VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly),
     m_texture(instance, texture_loader.getWidth(), texture_loader.getHeight())
 {
-    GhulbusVulkan::Queue& transfer_queue = instance.getTransferQueue();
-    transfer_queue.stageSubmission(
-        m_vertexBuffer.setDataAsynchronously(vertex_data.data(),
-                                             instance.getGraphicsQueueFamilyIndex()));
-    transfer_queue.stageSubmission(
-        m_indexBuffer.setDataAsynchronously(index_data.data(),
-                                            instance.getGraphicsQueueFamilyIndex()));
-    transfer_queue.stageSubmission(
-        m_texture.setDataAsynchronously(reinterpret_cast<std::byte const*>(texture_loader.getData()),
-                                        instance.getGraphicsQueueFamilyIndex()));
+    UploadBatch upload_batch(instance, instance.getGraphicsQueueFamilyIndex());
+    upload_batch.addBufferUpload(m_vertexBuffer, std::move(vertex_staging));
+    upload_batch.addBufferUpload(m_indexBuffer, std::move(index_staging));
+    upload_batch.addImageUpload(m_texture, reinterpret_cast<std::byte const*>(texture_loader.getData()));
+    instance.getTransferQueue().stageSubmission(upload_batch.finish());
+    m_drawRanges.push_back(MeshDrawRange{ 0, getNumberOfIndices(), 0 });
+}
+
+template<typename V_T, typename I_T>
+inline Mesh<V_T, I_T> Mesh<V_T, I_T>::fromObjFile(GraphicsInstance& instance, ObjParser& obj, char const* filename,
+                                                  ImageLoader const& texture_loader)
+{
+    static_assert(std::is_same_v<typename VertexData::Storage, ObjParser::VertexEntryFlat>,
+                  "Vertex format must match the flat vertices of ObjParser.");
+    static_assert(sizeof(typename IndexData::IndexType::ValueType) == sizeof(ObjParser::IndexType),
+                  "Index type must match the flat indices of ObjParser.");
+    detail::MappedFile const file(filename);
+    std::optional<MemoryBuffer> vertex_staging;
+    std::optional<MemoryBuffer> index_staging;
+    // declared after the buffers, so that the memory is always unmapped before the buffers are destroyed
+    std::optional<GhulbusVulkan::MappedMemory> vertex_mapped;
+    std::optional<GhulbusVulkan::MappedMemory> index_mapped;
+    obj.readData(file.getSpan(), [&](std::size_t number_of_vertices, std::size_t number_of_indices) {
+            vertex_staging.emplace(instance, number_of_vertices * sizeof(ObjParser::VertexEntryFlat),
+                                   VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CpuOnly);
+            index_staging.emplace(instance, number_of_indices * sizeof(ObjParser::IndexType),
+                                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CpuOnly);
+            vertex_mapped.emplace(vertex_staging->map());
+            index_mapped.emplace(index_staging->map());
+            return ObjParser::FlatStorage{
+                std::span<ObjParser::VertexEntryFlat>(
+                    reinterpret_cast<ObjParser::VertexEntryFlat*>(static_cast<std::byte*>(*vertex_mapped)),
+                    number_of_vertices),
+                std::span<ObjParser::IndexType>(
+                    reinterpret_cast<ObjParser::IndexType*>(static_cast<std::byte*>(*index_mapped)),
+                    number_of_indices) };
+        });
+    vertex_mapped.reset();
+    index_mapped.reset();
+    Mesh ret(instance, std::move(*vertex_staging), std::move(*index_staging), texture_loader);
+    ret.m_drawRanges.clear();
+    ret.addDrawRanges(obj);
+    return ret;
 }
 
 template<typename VertexData_T, typename IndexData_T>
@@ -110,6 +329,20 @@ inline uint32_t Mesh<VertexData_T, IndexData_T>::getNumberOfVertices() const
     return static_cast<uint32_t>(m_vertexBuffer.getSize() / sizeof(typename VertexData::Storage));
 }
 
+template<typename VertexData_T, typename IndexData_T>
+inline VkIndexType Mesh<VertexData_T, IndexData_T>::getIndexType() const
+{
+    using ValueType = typename IndexData::IndexType::ValueType;
+    static_assert(std::is_same_v<ValueType, uint16_t> || std::is_same_v<ValueType, uint32_t>);
+    return std::is_same_v<ValueType, uint16_t> ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
+
+template<typename VertexData_T, typename IndexData_T>
+inline std::span<MeshDrawRange const> Mesh<VertexData_T, IndexData_T>::getDrawRanges() const
+{
+    return m_drawRanges;
+}
+
 template<typename VertexData_T, typename IndexData_T>
 inline GhulbusGraphics::MemoryBuffer& Mesh<VertexData_T, IndexData_T>::getVertexBuffer()
 {
@@ -128,6 +361,69 @@ inline GhulbusGraphics::Image2d& Mesh<VertexData_T, IndexData_T>::getTexture()
     return m_texture;
 }
 
+template<typename VertexData_T, typename IndexData_T>
+inline void Mesh<VertexData_T, IndexData_T>::addUploads(UploadBatch& upload_batch, std::byte const* vertex_data,
+                                                        std::byte const* index_data,
+                                                        ImageLoader const& texture_loader)
+{
+    upload_batch.addBufferUpload(m_vertexBuffer, vertex_data);
+    upload_batch.addBufferUpload(m_indexBuffer, index_data);
+    upload_batch.addImageUpload(m_texture, reinterpret_cast<std::byte const*>(texture_loader.getData()));
+}
+
+template<typename VertexData_T, typename IndexData_T>
+inline void Mesh<VertexData_T, IndexData_T>::addUploads(UploadBatch& upload_batch, ObjParser const& obj,
+                                                        ImageLoader const& texture_loader)
+{
+    if constexpr (std::is_same_v<typename VertexData::Storage, ObjParser::VertexEntryFlat>) {
+        upload_batch.addBufferUpload(m_vertexBuffer, obj.getFlatVertices().data());
+    } else {
+        auto const convert_vertices = [&obj](GhulbusVulkan::MappedMemory& mapped) {
+            VertexConversion::convertVertices<VertexData, ObjParser::VertexDataFlat>(
+                obj.getFlatVertices().getStorage(),
+                std::span<typename VertexData::Storage>(
+                    reinterpret_cast<typename VertexData::Storage*>(static_cast<std::byte*>(mapped)),
+                    obj.numberOfFlatVertices()));
+        };
+        if (m_vertexBuffer.isDirectUpload()) {
+            GhulbusVulkan::MappedMemory mapped = m_vertexBuffer.map();
+            convert_vertices(mapped);
+            mapped.flush();
+        } else {
+            // convert straight into staging memory
+            MemoryBuffer vertex_staging(upload_batch.getInstance(), m_vertexBuffer.getSize(),
+                                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CpuOnly);
+            {
+                GhulbusVulkan::MappedMemory mapped = vertex_staging.map();
+                convert_vertices(mapped);
+            }
+            upload_batch.addBufferUpload(m_vertexBuffer, std::move(vertex_staging));
+        }
+    }
+    upload_batch.addBufferUpload(m_indexBuffer, reinterpret_cast<std::byte const*>(obj.getFlatIndices().data()));
+    upload_batch.addImageUpload(m_texture, reinterpret_cast<std::byte const*>(texture_loader.getData()));
+}
+
+template<typename VertexData_T, typename IndexData_T>
+inline void Mesh<VertexData_T, IndexData_T>::addDrawRanges(MeshCache const& cache)
+{
+    for (std::size_t i = 0; i < cache.getNumberOfGroups(); ++i) {
+        MeshCache::GroupInfo const group = cache.getGroup(i);
+        m_drawRanges.push_back(MeshDrawRange{ static_cast<uint32_t>(group.firstIndex),
+                                              static_cast<uint32_t>(group.indexCount), 0 });
+    }
+}
+
+template<typename VertexData_T, typename IndexData_T>
+inline void Mesh<VertexData_T, IndexData_T>::addDrawRanges(ObjParser const& obj)
+{
+    for (ObjParser::IndexType i = 0; i < obj.numberOfGroups(); ++i) {
+        ObjParser::SubmeshRange const& range = obj.getGroupRange(i);
+        m_drawRanges.push_back(MeshDrawRange{ static_cast<uint32_t>(range.firstIndex),
+                                              static_cast<uint32_t>(range.indexCount), 0 });
+    }
+}
+
 
 class AnyMesh {
 private:
@@ -137,6 +433,8 @@ private:
         virtual MeshConcept* moveInto(std::byte*) = 0;
         virtual uint32_t getNumberOfIndices() const = 0;
         virtual uint32_t getNumberOfVertices() const = 0;
+        virtual VkIndexType getIndexType() const = 0;
+        virtual std::span<MeshDrawRange const> getDrawRanges() const = 0;
         virtual GhulbusGraphics::MemoryBuffer& getVertexBuffer() = 0;
         virtual GhulbusGraphics::MemoryBuffer& getIndexBuffer() = 0;
         virtual GhulbusGraphics::Image2d& getTexture() = 0;
@@ -164,6 +462,12 @@ private:
         uint32_t getNumberOfVertices() const override {
             return m_mesh.getNumberOfVertices();
         }
+        VkIndexType getIndexType() const override {
+            return m_mesh.getIndexType();
+        }
+        std::span<MeshDrawRange const> getDrawRanges() const override {
+            return m_mesh.getDrawRanges();
+        }
         GhulbusGraphics::MemoryBuffer& getVertexBuffer() override {
             return m_mesh.getVertexBuffer();
         }
@@ -226,6 +530,12 @@ public:
     uint32_t getNumberOfVertices() const {
         return m_mesh->getNumberOfVertices();
     }
+    VkIndexType getIndexType() const {
+        return m_mesh->getIndexType();
+    }
+    std::span<MeshDrawRange const> getDrawRanges() const {
+        return m_mesh->getDrawRanges();
+    }
 
     GhulbusGraphics::MemoryBuffer& getVertexBuffer() {
         return m_mesh->getVertexBuffer();
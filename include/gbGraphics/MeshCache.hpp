@@ -0,0 +1,119 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_MESH_CACHE_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_MESH_CACHE_HPP
+
+/** @file
+*
+* @brief Binary cache for parsed mesh data.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/VertexFormat.hpp>
+#include <gbGraphics/detail/MappedFile.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+class ObjParser;
+
+/** Flattened mesh data stored in a binary file.
+ * The file holds the flat vertex and index data of an ObjParser, together with the vertex component layout,
+ * the face group metadata and size, timestamp and content hash of the source file it was cooked from.
+ * Cache files are memory-mapped on load; vertex and index data are used in place without parsing or copying.
+ * @note Cache files use the native byte order and are not meant to be portable between platforms.
+ */
+class MeshCache {
+public:
+    /** Current version of the file format.
+     * Files with a different version are rejected on load.
+     */
+    static constexpr std::uint32_t formatVersion = 2;
+
+    /** Checks performed by isUpToDate().
+     */
+    enum class Validation {
+        Timestamp,          ///< Compare size and last modification time of the source file
+        ContentHash         ///< Additionally compare a hash of the complete source file
+    };
+
+    /** Metadata for a face group of the cached mesh.
+     */
+    struct GroupInfo {
+        std::string_view name;              ///< Name of the face group
+        std::uint64_t numberOfFaces;        ///< Number of faces in the source file
+        std::uint64_t firstIndex;           ///< Position of the first flat index of the group
+        std::uint64_t indexCount;           ///< Number of flat indices of the group
+        std::uint64_t firstVertex;          ///< Smallest flat vertex index referenced by the group
+        std::uint64_t vertexCount;          ///< Number of flat vertices from firstVertex up to the largest referenced
+        int verticesPerFace;                ///< Number of vertices per face in the source file
+        bool hasNormal;                     ///< true iff the group has per-vertex normals
+        bool hasTexCoord;                   ///< true iff the group has texture coordinates
+    };
+private:
+    detail::MappedFile m_file;
+public:
+    /** Load a cache file.
+     * @param[in] filename Full path to the cache file.
+     * @throw Exceptions::IOError If the file cannot be mapped, is not a valid cache file,
+     *                            or was written with a different formatVersion.
+     */
+    explicit MeshCache(char const* filename);
+
+    /** Write a cache file.
+     * The file is written to a temporary location first and then moved to its final place,
+     * so concurrent readers never observe a partially written file.
+     * @param[in] filename Full path to the cache file.
+     * @param[in] obj Parser holding the mesh data.
+     * @param[in] source_filename Full path to the OBJ file that obj was read from.
+     */
+    static void write(char const* filename, ObjParser const& obj, char const* source_filename);
+
+    /** Check whether the cache was cooked from the current version of a source file.
+     * @param[in] source_filename Full path to the OBJ file.
+     * @param[in] validation Checks to perform.
+     * @return true iff the source file exists and matches the information stored in the cache.
+     */
+    bool isUpToDate(char const* source_filename, Validation validation = Validation::Timestamp) const;
+
+    std::uint64_t getNumberOfVertices() const;
+    std::uint64_t getNumberOfIndices() const;
+
+    /** Get the flat vertex data.
+     * @return getNumberOfVertices() vertices of getVertexStride() bytes each.
+     */
+    std::span<std::byte const> getVertexData() const;
+
+    /** Get the flat index data.
+     * @return Flat indices (each 3 indices form a face).
+     */
+    std::span<std::uint32_t const> getIndexData() const;
+
+    std::size_t getVertexStride() const;
+    std::size_t getNumberOfComponents() const;
+    VertexComponentInfo getComponentInfo(std::size_t index) const;
+
+    /** Check whether the cached vertex data has the layout of a vertex format.
+     */
+    template<typename VertexFormat_T>
+    bool hasVertexFormat() const;
+
+    std::size_t getNumberOfGroups() const;
+    GroupInfo getGroup(std::size_t index) const;
+
+private:
+    bool hasVertexFormat(VertexFormatBase const& format) const;
+};
+
+template<typename VertexFormat_T>
+inline bool MeshCache::hasVertexFormat() const
+{
+    VertexFormat_T const format;
+    return hasVertexFormat(format);
+}
+}
+#endif
@@ -0,0 +1,179 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_MESH_OPTIMIZER_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_MESH_OPTIMIZER_HPP
+
+/** @file
+*
+* @brief Mesh Optimization.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/GenericIndexData.hpp>
+#include <gbGraphics/VertexData.hpp>
+
+#include <gbMath/Vector3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+/** Reordering of triangle list index data and vertex data for faster rendering.
+ * All functions operate on triangle lists. Index spans hold three indices per triangle.
+ * Optimizing a mesh only changes the order of triangles and vertices, never the rendered result
+ * (apart from the order in which overlapping triangles are blended).
+ */
+namespace MeshOptimizer
+{
+/** Default size of the simulated post-transform vertex cache used by analyzeVertexCache().
+ */
+std::size_t constexpr defaultCacheSize = 16;
+
+/** Marks vertices in a vertex fetch remap table that are not referenced by any index.
+ */
+std::uint32_t constexpr unreferencedVertex = std::numeric_limits<std::uint32_t>::max();
+
+/** Efficiency of index data with regard to the post-transform vertex cache.
+ */
+struct VertexCacheStatistics {
+    std::size_t verticesTransformed;    ///< Number of vertex shader invocations
+    std::size_t triangles;              ///< Number of triangles
+    std::size_t vertices;               ///< Number of distinct vertices referenced
+    float acmr;                         ///< Average cache miss ratio: Vertices transformed per triangle (0.5 - 3)
+    float atvr;                         ///< Average transformed vertex ratio: Vertices transformed per vertex (>= 1)
+};
+
+/** Statistics before and after optimizeMesh().
+ */
+struct OptimizationReport {
+    VertexCacheStatistics before;
+    VertexCacheStatistics after;
+};
+
+/** Simulate a FIFO post-transform vertex cache.
+ * @param[in] indices Index data.
+ * @param[in] number_of_vertices Number of vertices referenced by indices.
+ * @param[in] cache_size Number of entries in the simulated cache.
+ */
+template<typename Index_T>
+VertexCacheStatistics analyzeVertexCache(std::span<Index_T const> indices, std::size_t number_of_vertices,
+                                         std::size_t cache_size = defaultCacheSize);
+
+/** Reorder triangles for better use of the post-transform vertex cache.
+ * Implements Tom Forsyth's linear-speed vertex cache optimization, which does not depend on a
+ * particular cache size and works well with both FIFO and LRU caches.
+ * @param[in,out] indices Index data; triangles are reordered in place.
+ * @param[in] number_of_vertices Number of vertices referenced by indices.
+ */
+template<typename Index_T>
+void optimizeVertexCache(std::span<Index_T> indices, std::size_t number_of_vertices);
+
+/** Reorder clusters of triangles to reduce overdraw.
+ * The triangles are split into clusters at the points where the simulated vertex cache has to start over,
+ * so the vertex cache efficiency of indices is retained. Clusters facing away from the center of the mesh
+ * are then moved to the front, as they are likely to occlude the others.
+ * @param[in,out] indices Index data, usually ordered by optimizeVertexCache() before; clusters are reordered in place.
+ * @param[in] positions Vertex positions.
+ * @param[in] cache_size Size of the simulated vertex cache used for finding the clusters.
+ */
+template<typename Index_T>
+void optimizeOverdraw(std::span<Index_T> indices, std::span<GhulbusMath::Point3f const> positions,
+                      std::size_t cache_size = defaultCacheSize);
+
+/** Renumber vertices in the order of their first use by indices, for better locality of vertex fetches.
+ * @param[in,out] indices Index data; indices are renumbered in place.
+ * @param[in] number_of_vertices Number of vertices referenced by indices.
+ * @return The new index of each vertex; unreferencedVertex for vertices that are not used by any index.
+ *         Referenced vertices are numbered consecutively from 0.
+ */
+template<typename Index_T>
+std::vector<std::uint32_t> optimizeVertexFetch(std::span<Index_T> indices, std::size_t number_of_vertices);
+
+/** Get the indices of a GenericIndexData as a flat span.
+ */
+template<typename Index_T>
+inline std::span<Index_T> getIndices(GenericIndexData<IndexFormatBase::PrimitiveTopology::TriangleList, Index_T>& index_data)
+{
+    static_assert(sizeof(IndexComponent::Triangle<Index_T>) == 3 * sizeof(Index_T));
+    return std::span<Index_T>(reinterpret_cast<Index_T*>(index_data.getStorage().data()), index_data.size() * 3);
+}
+
+/** Apply a vertex fetch remap table to vertex data.
+ * @param[in,out] vertex_data Vertex data; unreferenced vertices are removed.
+ * @param[in] remap Remap table returned by optimizeVertexFetch().
+ */
+template<typename... Ts>
+inline void remapVertices(VertexData<Ts...>& vertex_data, std::span<std::uint32_t const> remap)
+{
+    auto& storage = vertex_data.getStorage();
+    std::size_t number_of_referenced_vertices = 0;
+    for (std::uint32_t new_index : remap) {
+        if (new_index != unreferencedVertex) { ++number_of_referenced_vertices; }
+    }
+    std::vector<typename VertexData<Ts...>::Storage> remapped(number_of_referenced_vertices);
+    for (std::size_t i = 0; i < remap.size(); ++i) {
+        if (remap[i] != unreferencedVertex) { remapped[remap[i]] = storage[i]; }
+    }
+    storage = std::move(remapped);
+}
+
+/** Optimize a mesh for rendering.
+ * Reorders triangles with optimizeVertexCache(), followed by optimizeOverdraw() if the vertices have
+ * 3d positions, and reorders vertices with optimizeVertexFetch().
+ * @param[in,out] vertex_data Vertex data.
+ * @param[in,out] index_data Index data.
+ * @return Vertex cache statistics before and after optimization.
+ */
+template<typename... Ts, typename Index_T>
+inline OptimizationReport optimizeMesh(VertexData<Ts...>& vertex_data,
+    GenericIndexData<IndexFormatBase::PrimitiveTopology::TriangleList, Index_T>& index_data)
+{
+    using Format = typename VertexData<Ts...>::Format;
+    using Position = GetComponentBySemantics_t<VertexFormatBase::ComponentSemantics::Position, Format>;
+    using PositionVec = typename Position::Layout;
+
+    std::span<Index_T> const indices = getIndices(index_data);
+    OptimizationReport ret;
+    ret.before = analyzeVertexCache<Index_T>(indices, vertex_data.size());
+    optimizeVertexCache(indices, vertex_data.size());
+    if constexpr (GhulbusMath::VectorTraits::IsVector3<PositionVec>::value) {
+        std::vector<GhulbusMath::Point3f> positions;
+        positions.reserve(vertex_data.size());
+        for (std::size_t i = 0; i < vertex_data.size(); ++i) {
+            auto const& p = get<VertexFormatBase::ComponentSemantics::Position>(vertex_data, i);
+            positions.emplace_back(static_cast<float>(p.x), static_cast<float>(p.y), static_cast<float>(p.z));
+        }
+        optimizeOverdraw<Index_T>(indices, positions);
+    }
+    std::vector<std::uint32_t> const remap = optimizeVertexFetch(indices, vertex_data.size());
+    remapVertices(vertex_data, remap);
+    ret.after = analyzeVertexCache<Index_T>(indices, vertex_data.size());
+    return ret;
+}
+
+extern template VertexCacheStatistics analyzeVertexCache<std::uint16_t>(std::span<std::uint16_t const>,
+                                                                        std::size_t, std::size_t);
+extern template VertexCacheStatistics analyzeVertexCache<std::uint32_t>(std::span<std::uint32_t const>,
+                                                                        std::size_t, std::size_t);
+extern template VertexCacheStatistics analyzeVertexCache<std::int32_t>(std::span<std::int32_t const>,
+                                                                       std::size_t, std::size_t);
+extern template void optimizeVertexCache<std::uint16_t>(std::span<std::uint16_t>, std::size_t);
+extern template void optimizeVertexCache<std::uint32_t>(std::span<std::uint32_t>, std::size_t);
+extern template void optimizeVertexCache<std::int32_t>(std::span<std::int32_t>, std::size_t);
+extern template void optimizeOverdraw<std::uint16_t>(std::span<std::uint16_t>,
+                                                     std::span<GhulbusMath::Point3f const>, std::size_t);
+extern template void optimizeOverdraw<std::uint32_t>(std::span<std::uint32_t>,
+                                                     std::span<GhulbusMath::Point3f const>, std::size_t);
+extern template void optimizeOverdraw<std::int32_t>(std::span<std::int32_t>,
+                                                    std::span<GhulbusMath::Point3f const>, std::size_t);
+extern template std::vector<std::uint32_t> optimizeVertexFetch<std::uint16_t>(std::span<std::uint16_t>, std::size_t);
+extern template std::vector<std::uint32_t> optimizeVertexFetch<std::uint32_t>(std::span<std::uint32_t>, std::size_t);
+extern template std::vector<std::uint32_t> optimizeVertexFetch<std::int32_t>(std::span<std::int32_t>, std::size_t);
+}
+}
+#endif
@@ -0,0 +1,85 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_MIPMAP_GENERATOR_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_MIPMAP_GENERATOR_HPP
+
+/** @file
+*
+* @brief Generation of mip chains on the device.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/detail/MipChain.hpp>
+
+#include <gbVk/DescriptorSetLayout.hpp>
+#include <gbVk/ForwardDecl.hpp>
+#include <gbVk/Pipeline.hpp>
+#include <gbVk/PipelineLayout.hpp>
+#include <gbVk/Sampler.hpp>
+#include <gbVk/ShaderModule.hpp>
+
+#include <cstdint>
+#include <optional>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+class GenericImage;
+class GraphicsInstance;
+
+/** Generates the mip levels of an image from its first level.
+ * Formats that support linear blits are downsampled with a chain of vkCmdBlitImage, one per level.
+ * Other formats fall back to a compute shader that averages 2x2 texels, which requires storage image
+ * support for the format and the shaderStorageImageWriteWithoutFormat device feature.
+ * Images need the usage flags from getRequiredImageUsage() for their format.
+ */
+class MipmapGenerator {
+public:
+    using Method = detail::MipmapMethod;
+private:
+    struct ComputePipeline {
+        GhulbusVulkan::ShaderModule shaderModule;
+        GhulbusVulkan::DescriptorSetLayout descriptorSetLayout;
+        GhulbusVulkan::PipelineLayout pipelineLayout;
+        GhulbusVulkan::Pipeline pipeline;
+        GhulbusVulkan::Sampler sampler;                 ///< Unfiltered; the shader only uses texelFetch
+    };
+    GraphicsInstance* m_instance;
+    std::optional<ComputePipeline> m_computePipeline;   ///< Created on first use
+public:
+    explicit MipmapGenerator(GraphicsInstance& instance);
+
+    /** Number of mip levels down to 1x1 for an image of the given size.
+     */
+    static uint32_t getFullMipChainLength(uint32_t width, uint32_t height);
+
+    /** Method used for images of a format.
+     * @return std::nullopt if mip levels cannot be generated for the format.
+     */
+    std::optional<Method> selectMethod(VkFormat format);
+
+    /** Image usage flags needed for generating the mip levels of an image.
+     * @throw Exceptions::InvalidArgument If mip levels cannot be generated for the format.
+     */
+    VkImageUsageFlags getRequiredImageUsage(VkFormat format);
+
+    /** Record the generation of all mip levels of image from its first level.
+     * All array layers are processed by the blit path; the compute path only supports single-layer images.
+     * @param[in] command_buffer Command buffer of the graphics queue family, in recording state.
+     * @param[in] target_queue If set, the image is released to this queue family.
+     * @param[in,out] submit_staging Adopts the resources that have to be kept alive until the commands
+     *                               have executed.
+     * @pre The first mip level is in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL and was written by transfer commands
+     *      recorded before. The contents of all other levels are discarded.
+     * @post All mip levels are in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL and visible to fragment shaders.
+     * @throw Exceptions::InvalidArgument If mip levels cannot be generated for the format of image.
+     */
+    void recordGeneration(GhulbusVulkan::CommandBuffer& command_buffer, GenericImage& image,
+                          std::optional<uint32_t> target_queue, GhulbusVulkan::SubmitStaging& submit_staging);
+private:
+    void recordBlitChain(GhulbusVulkan::CommandBuffer& command_buffer, GenericImage& image);
+    void recordComputeChain(GhulbusVulkan::CommandBuffer& command_buffer, GenericImage& image,
+                            GhulbusVulkan::SubmitStaging& submit_staging);
+    ComputePipeline& getComputePipeline();
+};
+}
+#endif
@@ -0,0 +1,140 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_MULTI_STREAM_MESH_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_MULTI_STREAM_MESH_HPP
+
+/** @file
+*
+* @brief Triangle Mesh with one vertex buffer per vertex stream.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/GenericIndexData.hpp>
+#include <gbGraphics/GraphicsInstance.hpp>
+#include <gbGraphics/MemoryBuffer.hpp>
+#include <gbGraphics/Mesh.hpp>
+#include <gbGraphics/UploadBatch.hpp>
+#include <gbGraphics/VertexStreams.hpp>
+
+#include <gbVk/Buffer.hpp>
+#include <gbVk/Queue.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+/** Triangle mesh that keeps each stream of a VertexStreams in a separate vertex buffer.
+ * Use Program::addVertexBindings() to create the matching vertex bindings. A pass that only
+ * reads some streams, like a depth-only pass reading positions, only binds the buffers of those streams.
+ * Unlike Mesh, a MultiStreamMesh does not own a texture.
+ */
+template<typename VertexStreams_T,
+         typename IndexData_T = GenericIndexData<IndexFormatBase::PrimitiveTopology::TriangleList, uint32_t>>
+class MultiStreamMesh {
+public:
+    using VertexStreams = VertexStreams_T;
+    using IndexData = IndexData_T;
+    static constexpr std::size_t numberOfStreams = VertexStreams::numberOfStreams;
+private:
+    std::vector<GhulbusGraphics::MemoryBuffer> m_vertexBuffers;
+    GhulbusGraphics::MemoryBuffer m_indexBuffer;
+    std::vector<MeshDrawRange> m_drawRanges;
+    uint32_t m_numberOfVertices;
+public:
+    MultiStreamMesh(GraphicsInstance& instance, VertexStreams const& vertex_streams, IndexData const& index_data);
+
+    uint32_t getNumberOfIndices() const;
+    uint32_t getNumberOfVertices() const;
+    VkIndexType getIndexType() const;
+
+    /** Get the ranges of the index buffer to draw.
+     * There is a single range covering the whole index buffer.
+     */
+    std::span<MeshDrawRange const> getDrawRanges() const;
+
+    GhulbusGraphics::MemoryBuffer& getVertexBuffer(std::size_t stream);
+    GhulbusGraphics::MemoryBuffer& getIndexBuffer();
+
+    /** The vertex buffers of all streams, in the order expected by vkCmdBindVertexBuffers().
+     */
+    std::array<VkBuffer, numberOfStreams> getVkVertexBuffers();
+};
+
+template<typename VS_T, typename I_T>
+inline MultiStreamMesh<VS_T, I_T>::MultiStreamMesh(GraphicsInstance& instance, VertexStreams const& vertex_streams,
+                                                   IndexData const& index_data)
+    :m_indexBuffer(instance, index_data.size() * sizeof(typename IndexData::IndexType),
+                   VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuOnly),
+     m_numberOfVertices(vertex_streams.getNumberOfVertices())
+{
+    UploadBatch upload_batch(instance, instance.getGraphicsQueueFamilyIndex());
+    m_vertexBuffers.reserve(numberOfStreams);
+    for (std::size_t i = 0; i < numberOfStreams; ++i) {
+        m_vertexBuffers.emplace_back(instance, vertex_streams.getStreamSize(i),
+                                     VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                     MemoryUsage::GpuOnly);
+        upload_batch.addBufferUpload(m_vertexBuffers.back(), vertex_streams.data(i));
+    }
+    upload_batch.addBufferUpload(m_indexBuffer, index_data.data());
+    instance.getTransferQueue().stageSubmission(upload_batch.finish());
+    m_drawRanges.push_back(MeshDrawRange{ 0, getNumberOfIndices(), 0 });
+}
+
+template<typename VS_T, typename I_T>
+inline uint32_t MultiStreamMesh<VS_T, I_T>::getNumberOfIndices() const
+{
+    return static_cast<uint32_t>(m_indexBuffer.getSize() / sizeof(typename IndexData::IndexType::ValueType));
+}
+
+template<typename VS_T, typename I_T>
+inline uint32_t MultiStreamMesh<VS_T, I_T>::getNumberOfVertices() const
+{
+    return m_numberOfVertices;
+}
+
+template<typename VS_T, typename I_T>
+inline VkIndexType MultiStreamMesh<VS_T, I_T>::getIndexType() const
+{
+    using ValueType = typename IndexData::IndexType::ValueType;
+    static_assert(std::is_same_v<ValueType, uint16_t> || std::is_same_v<ValueType, uint32_t>);
+    return std::is_same_v<ValueType, uint16_t> ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
+
+template<typename VS_T, typename I_T>
+inline std::span<MeshDrawRange const> MultiStreamMesh<VS_T, I_T>::getDrawRanges() const
+{
+    return m_drawRanges;
+}
+
+template<typename VS_T, typename I_T>
+inline GhulbusGraphics::MemoryBuffer& MultiStreamMesh<VS_T, I_T>::getVertexBuffer(std::size_t stream)
+{
+    GHULBUS_PRECONDITION(stream < numberOfStreams);
+    return m_vertexBuffers[stream];
+}
+
+template<typename VS_T, typename I_T>
+inline GhulbusGraphics::MemoryBuffer& MultiStreamMesh<VS_T, I_T>::getIndexBuffer()
+{
+    return m_indexBuffer;
+}
+
+template<typename VS_T, typename I_T>
+inline std::array<VkBuffer, MultiStreamMesh<VS_T, I_T>::numberOfStreams>
+MultiStreamMesh<VS_T, I_T>::getVkVertexBuffers()
+{
+    std::array<VkBuffer, numberOfStreams> ret;
+    for (std::size_t i = 0; i < numberOfStreams; ++i) {
+        ret[i] = m_vertexBuffers[i].getBuffer().getVkBuffer();
+    }
+    return ret;
+}
+}
+#endif
@@ -8,18 +8,25 @@
  */
 #include <gbGraphics/config.hpp>
 
+#include <gbGraphics/GenericIndexData.hpp>
 #include <gbGraphics/VertexData.hpp>
 
 #include <gbMath/Vector2.hpp>
 #include <gbMath/Vector3.hpp>
 
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace GHULBUS_GRAPHICS_NAMESPACE {
 /** Parser for Alias OBJ Files.
  * @todo The following features are currently unsupported:
- *       - Offset-based indexing unsupported (entry: 'f -1 -2 -3')
  *       - Multiple face group assignments (entry: 'g group1 group2')
  *       - Non-2d texture coordinates
  *       - Support for smoothing groups
@@ -38,10 +45,9 @@ public:
     using IndexType = int32_t;
 
     /** Storage for mesh face index data.
-     * @note Indices are 1-based if positive and offset-based if negative.
-     *       The corresponding vertex lies at (index-1) in the respective
-     *       VertexData list.
-     * @attention Currently, offset-based indices are not supported.
+     * @note Indices are 1-based. The corresponding vertex lies at (index-1) in the
+     *       respective VertexData list. Offset-based indices in the file (entry: 'f -1 -2 -3')
+     *       are resolved to 1-based indices while parsing.
      */
     struct FaceData {
         std::vector<IndexType> faceVertex;              ///< Geometry indices
@@ -65,6 +71,35 @@ public:
      */
     using FaceGroupNames = std::vector<std::string>;
 
+    /** Transparent hash for looking up group names by std::string_view.
+     */
+    struct GroupNameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
+    /** Type for looking up the index of a face group in FaceGroups by its name.
+     */
+    using FaceGroupIndices = std::unordered_map<std::string, IndexType, GroupNameHash, std::equal_to<>>;
+
+    /** Range of the flat data covered by a face group.
+     * The flat indices of each face group are stored consecutively, so that every group can be drawn with
+     * a single indexed draw from the complete flat vertex and index data.
+     * @note Groups share flat vertices if their faces share index tuples; vertex ranges may overlap.
+     */
+    struct SubmeshRange {
+        IndexType firstIndex;                           ///< Position of the first flat index of the group
+        IndexType indexCount;                           ///< Number of flat indices of the group
+        IndexType firstVertex;                          ///< Smallest flat vertex index referenced by the group
+        IndexType vertexCount;                          ///< Number of flat vertices from firstVertex up to
+                                                        ///  the largest flat vertex index referenced by the group
+    };
+
+    /** Type for storing the SubmeshRange of each face group.
+     * @note Each entry holds the range for the FaceData at the same index in FaceGroups.
+     */
+    using SubmeshRanges = std::vector<SubmeshRange>;
+
     /** Container for flat vertex data.
      */
     using VertexDataFlat = ::GHULBUS_GRAPHICS_NAMESPACE::VertexData<
@@ -78,12 +113,75 @@ public:
     /** Container for flat index data.
      */
     using IndexDataFlat = std::vector<IndexType>;
+
+    /** Container for flat index data with 16-bit indices.
+     */
+    using IndexData16 = GenericIndexData<IndexFormatBase::PrimitiveTopology::TriangleList, std::uint16_t>;
+
+    /** Range of IndexData16 that is drawn with a single indexed draw.
+     */
+    struct IndexChunk16 {
+        IndexType group;                                ///< Face group of all faces in the chunk
+        IndexType firstIndex;                           ///< Position of the first index of the chunk
+        IndexType indexCount;                           ///< Number of indices in the chunk
+        IndexType vertexOffset;                         ///< Added to every index of the chunk to obtain the vertex
+    };
+
+    /** Flat mesh data with 16-bit indices, as returned by getFlatData16().
+     */
+    struct FlatData16 {
+        VertexDataFlat vertices;                        ///< Flat vertices
+        IndexData16 indices;                            ///< Flat indices, relative to the vertexOffset of their chunk
+        std::vector<IndexChunk16> chunks;               ///< Chunks covering all indices, in order of the face groups
+    };
+
+    /** Caller-provided destination for flattened mesh data.
+     */
+    struct FlatStorage {
+        std::span<VertexEntryFlat> vertices;            ///< Receives the flat vertices
+        std::span<IndexType> indices;                   ///< Receives the flat indices
+    };
+
+    /** Provides the FlatStorage for a mesh with the given number of flat vertices and indices.
+     */
+    using FlatStorageProvider = std::function<FlatStorage(std::size_t number_of_vertices,
+                                                          std::size_t number_of_indices)>;
+
+    /** A batch of flattened mesh data, as passed to the sink of readFileStreaming().
+     * @note Vertices are only deduplicated within a batch. Data is only valid for the duration of the sink call.
+     */
+    struct FlatBatch {
+        std::span<VertexEntryFlat const> vertices;      ///< Flat vertices
+        std::span<std::uint32_t const> indices;         ///< Flat indices into vertices (each 3 indices form a face)
+        std::uint64_t firstVertex;                      ///< Number of flat vertices in all preceding batches
+        std::uint64_t firstIndex;                       ///< Number of flat indices in all preceding batches
+        std::string_view groupName;                     ///< Face group of all faces in the batch
+    };
+
+    /** Receiver for the batches produced by readFileStreaming().
+     */
+    using FlatBatchSink = std::function<void(FlatBatch const&)>;
+
+    /** Totals for a file read by readFileStreaming().
+     */
+    struct StreamStatistics {
+        std::uint64_t vertices = 0;                     ///< Number of geometry vertex entries
+        std::uint64_t normals = 0;                      ///< Number of normal entries
+        std::uint64_t texCoords = 0;                    ///< Number of texture coordinate entries
+        std::uint64_t faces = 0;                        ///< Number of face entries
+        std::uint64_t flatVertices = 0;                 ///< Number of flat vertices in all batches
+        std::uint64_t flatIndices = 0;                  ///< Number of flat indices in all batches
+        std::uint64_t batches = 0;                      ///< Number of batches passed to the sink
+    };
 private:
     VertexData     m_vertexData;            ///< Vertex data
     FaceGroups     m_faceGroups;            ///< Grouped Index data
     FaceGroupNames m_faceGroupNames;        ///< Group Names
+    FaceGroupIndices m_faceGroupIndices;    ///< Group indices by name
+    SubmeshRanges  m_submeshRanges;         ///< Flat data ranges of the groups
     VertexDataFlat m_vertexDataFlat;        ///< Flattened vertex data
     IndexDataFlat  m_indexDataFlat;         ///< Flattened index data
+    unsigned int   m_maxThreads;            ///< Maximum number of threads used for parsing
 public:
     /** Constructor.
      */
@@ -98,9 +196,61 @@ public:
 
     /** Read in data from OBJ file.
      * @param[in] filename Full path to OBJ file.
+     * @note The file is memory-mapped and parsed in place; its contents are never copied to an intermediate buffer.
      */
     void readFile(char const* filename);
 
+    /** Read in OBJ data that is already in memory.
+     * @param[in] obj_data Contents of an OBJ file. Need not be null-terminated.
+     *                     Only needs to remain valid for the duration of the call.
+     */
+    void readData(std::span<char const> obj_data);
+
+    /** Read in OBJ data and write the flattened mesh to caller-provided storage.
+     * This allows writing the flat data directly to its final location, for instance mapped staging memory,
+     * without an intermediate copy.
+     * @param[in] obj_data Contents of an OBJ file. Need not be null-terminated.
+     *                     Only needs to remain valid for the duration of the call.
+     * @param[in] flat_storage Invoked exactly once, as soon as the number of flat vertices and indices is known
+     *                         and before any flat data is written. The returned spans must be at least as large
+     *                         as requested and remain valid for the duration of the call.
+     * @note The flat data of the parser itself remains empty; getFlatVertices() and getFlatIndices() do not
+     *       return any data.
+     */
+    void readData(std::span<char const> obj_data, FlatStorageProvider const& flat_storage);
+
+    /** Read an OBJ file in fixed-size windows and pass the flattened mesh to a sink in batches.
+     * Unlike readFile(), neither the file contents nor the face data or the complete flattened mesh are held
+     * in memory, and counts are not limited by IndexType. By default, the vertex, normal and texture coordinate
+     * entries are retained though, as faces may refer to any entry preceding them in the file, so memory use
+     * grows with the number of those entries. If max_vertex_memory is given, the entries are not retained:
+     * a first pass over the file records where they are located, and the entries referenced by the faces are
+     * read again from the file, in blocks of consecutive entries that are cached within max_vertex_memory.
+     * The parser object itself is not modified.
+     * @param[in] filename Full path to OBJ file.
+     * @param[in] sink Receives the batches, in file order. A new batch is started whenever the face group changes.
+     * @param[in] window_size Size in bytes of the read buffer. Grows if a single line does not fit.
+     * @param[in] max_batch_vertices Maximum number of vertices per batch; A batch holds at most
+     *                               6*max_batch_vertices indices. Must be at least 4.
+     * @param[in] max_vertex_memory Maximum size in bytes of the memory used for the vertex, normal and
+     *                              texture coordinate entries. The default retains all entries without a limit.
+     * @return Totals for the complete file.
+     * @throw Exceptions::IOError If max_vertex_memory does not even fit the locations of the entries and
+     *                            a single block of entries.
+     */
+    static StreamStatistics readFileStreaming(char const* filename,
+                                              FlatBatchSink const& sink,
+                                              std::size_t window_size = 16u << 20,
+                                              std::uint32_t max_batch_vertices = 1u << 16,
+                                              std::size_t max_vertex_memory = std::numeric_limits<std::size_t>::max());
+
+    /** Set the maximum number of threads used for parsing.
+     * Large files are split into chunks that are parsed concurrently. The result does not depend on
+     * the number of threads.
+     * @param[in] max_threads Maximum number of threads; 0 uses one thread per hardware thread (the default).
+     */
+    void setMaxThreads(unsigned int max_threads);
+
     /** Check whether a face group has texture coordinates.
      * @param[in] i Index of the face group.
      * @return True iff the face group has texture coordinates.
@@ -171,12 +321,34 @@ public:
      */
     IndexDataFlat const& getFlatIndices() const;
 
+    /** Get the flat data with 16-bit indices.
+     * If there are no more than 65536 flat vertices, the vertices are the same as in getFlatVertices()
+     * and there is one chunk per face group.
+     * Otherwise the faces of each group are split into chunks of at most 65536 vertices each.
+     * Vertices referenced by more than one chunk are duplicated.
+     * @pre The flat data was read into the parser, not into external storage.
+     * @return Flat data with 16-bit indices.
+     */
+    FlatData16 getFlatData16() const;
+
     /** Get the name of a face group.
      * @param[in] i Index of the face group.
      * @return Name of the face group.
      */
     char const* getGroupName(IndexType i) const;
 
+    /** Find a face group by its name.
+     * @param[in] name Name of the face group.
+     * @return Index of the face group; std::nullopt if there is no group of that name.
+     */
+    std::optional<IndexType> findGroup(std::string_view name) const;
+
+    /** Get the range of the flat data covered by a face group.
+     * @param[in] i Index of the face group.
+     * @return Flat index and vertex range of the group.
+     */
+    SubmeshRange const& getGroupRange(IndexType i) const;
+
 private:
     /** Clear all internal mesh data.
      */
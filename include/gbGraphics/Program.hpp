@@ -10,6 +10,7 @@
 #include <gbGraphics/config.hpp>
 
 #include <gbGraphics/VertexFormat.hpp>
+#include <gbGraphics/VertexStreams.hpp>
 
 #include <gbVk/ForwardDecl.hpp>
 #include <gbVk/ShaderModule.hpp>
@@ -42,7 +43,17 @@ public:
     VkPipelineShaderStageCreateInfo const* getShaderStageCreateInfos() const;
     uint32_t getNumberOfShaderStages() const;
 
-    void addVertexBinding(uint32_t binding, VertexFormatBase const& vertex_input_format);
+    /** Add a vertex binding.
+     * @param[in] input_rate VK_VERTEX_INPUT_RATE_INSTANCE for per-instance data, which advances once per instance
+     *                       instead of once per vertex.
+     */
+    void addVertexBinding(uint32_t binding, VertexFormatBase const& vertex_input_format,
+                          VkVertexInputRate input_rate = VK_VERTEX_INPUT_RATE_VERTEX);
+    /** Add one vertex binding for each stream.
+     * Stream i is bound to binding first_binding + i.
+     */
+    template<typename... T_Streams>
+    void addVertexBindings(uint32_t first_binding, VertexStreams<T_Streams...> const& vertex_streams);
     void bindVertexInput(VertexFormatBase::ComponentSemantics component_semantic, uint32_t binding, uint32_t location);
     void bindVertexInputByName(VertexFormatBase::ComponentSemantics component_semantic, uint32_t binding, char const* name);
 
@@ -53,5 +64,13 @@ private:
     VertexComponentInfo const& getVertexComponentInfoBySemantic(uint32_t binding,
         VertexFormatBase::ComponentSemantics component_semantic) const;
 };
+
+template<typename... T_Streams>
+inline void Program::addVertexBindings(uint32_t first_binding, VertexStreams<T_Streams...> const&)
+{
+    for (std::size_t i = 0; i < VertexStreams<T_Streams...>::numberOfStreams; ++i) {
+        addVertexBinding(first_binding + static_cast<uint32_t>(i), VertexStreams<T_Streams...>::getStreamFormat(i));
+    }
+}
 }
 #endif
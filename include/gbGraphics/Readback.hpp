@@ -0,0 +1,132 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_READBACK_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_READBACK_HPP
+
+/** @file
+*
+* @brief Asynchronous copies from device memory to the host.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/MemoryBuffer.hpp>
+
+#include <gbVk/CommandBuffers.hpp>
+#include <gbVk/Fence.hpp>
+#include <gbVk/ForwardDecl.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+class GenericImage;
+class GraphicsInstance;
+
+/** Reads back buffer and image contents from the device without blocking.
+ * Each readback records a copy into a GpuToCpu buffer and stages it on the graphics queue.
+ * It therefore executes after all work that was staged on the graphics queue before it and is submitted
+ * together with that work, e.g. by the Renderer when presenting the next frame. To read back the result
+ * of a frame, request the readback after the frame was rendered.
+ * poll() tracks the submitted readbacks with fences, checks the fences without waiting and fulfills
+ * the futures of the readbacks that have completed. It has to be called regularly from the thread that
+ * submits to the graphics queue, usually once per frame from the render loop:
+ * @code
+ * Image2d offscreen_target(instance, width, height, VK_IMAGE_TILING_OPTIMAL,
+ *                          VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+ *                          MemoryUsage::GpuOnly);
+ * renderOffscreen(offscreen_target);      // leaves the image in VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+ * std::future<Readback::Data> pixels =
+ *     readback.readImage(offscreen_target, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+ * while (rendering) {
+ *     renderer.render(pipeline_index, window);
+ *     readback.poll();
+ *     if (pixels.valid() && (pixels.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+ *         process(pixels.get());
+ *     }
+ *     // ...
+ * }
+ * @endcode
+ * Readback buffers and fences are recycled once their readback has completed, so reading back
+ * the same amount of data every frame does not allocate device memory.
+ * Resources owned by a different queue family have to be released to the graphics queue family first.
+ * Swapchain images can only be read back while they are still acquired, before they are presented,
+ * and only if the swapchain was created with VK_IMAGE_USAGE_TRANSFER_SRC_BIT.
+ */
+class Readback {
+public:
+    using Data = std::vector<std::byte>;
+private:
+    struct Pending {
+        GhulbusVulkan::Fence fence;
+        bool fenceSubmitted;                        ///< fence is submitted once the staged copy was submitted
+        std::shared_ptr<bool> isSubmitted;          ///< set by the cleanup of the staged submission
+        GhulbusVulkan::CommandBuffers commandBuffers;
+        MemoryBuffer buffer;
+        VkDeviceSize size;
+        std::promise<Data> promise;
+    };
+    static constexpr std::size_t maxFreeBuffers = 8;
+    GraphicsInstance* m_instance;
+    std::list<Pending> m_pending;                   ///< Oldest first
+    std::list<MemoryBuffer> m_freeBuffers;
+    std::list<GhulbusVulkan::Fence> m_freeFences;
+public:
+    explicit Readback(GraphicsInstance& instance);
+
+    /** Destructor.
+     * Waits for all pending readbacks to complete.
+     */
+    ~Readback();
+
+    Readback(Readback const&) = delete;
+    Readback& operator=(Readback const&) = delete;
+
+    /** Read back a range of a buffer.
+     * @param[in] source Buffer with usage VK_BUFFER_USAGE_TRANSFER_SRC_BIT.
+     * @return The size bytes of the range, once the copy has completed.
+     */
+    std::future<Data> readBuffer(MemoryBuffer& source, VkDeviceSize offset, VkDeviceSize size);
+
+    /** Read back a region of one subresource of an image.
+     * The texels are returned tightly packed, row by row.
+     * @param[in] source Image with usage VK_IMAGE_USAGE_TRANSFER_SRC_BIT and a format supported by
+     *                   detail::getTexelBlockInfo().
+     * @param[in] layout Layout of the image when the readback executes. The image is returned to this
+     *                   layout after the copy.
+     * @param[in] aspect A single aspect of the image.
+     */
+    std::future<Data> readImage(GenericImage& source, VkImageLayout layout, VkOffset3D offset, VkExtent3D extent,
+                                uint32_t mip_level = 0, uint32_t array_layer = 0,
+                                VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT);
+
+    /** Read back the first mip level and layer of a color image.
+     */
+    std::future<Data> readImage(GenericImage& source, VkImageLayout layout);
+
+    /** Complete the readbacks that have finished on the device.
+     * Never blocks. Readbacks whose staged submission has not been submitted and cleared from the
+     * graphics queue yet remain pending.
+     */
+    void poll();
+
+    uint32_t getNumberOfPendingReadbacks() const;
+
+    /** Block until all pending readbacks have completed.
+     * If readbacks are still staged, all submissions staged on the graphics queue are submitted and cleared.
+     */
+    void waitIdle();
+private:
+    MemoryBuffer acquireBuffer(VkDeviceSize size);
+    GhulbusVulkan::Fence acquireFence();
+    std::future<Data> stage(GhulbusVulkan::CommandBuffers&& command_buffers, MemoryBuffer&& buffer,
+                            VkDeviceSize size);
+    void submitFences();
+    void complete(Pending& pending);
+};
+}
+#endif
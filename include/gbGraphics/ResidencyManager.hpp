@@ -0,0 +1,338 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_RESIDENCY_MANAGER_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_RESIDENCY_MANAGER_HPP
+
+/** @file
+*
+* @brief Keeping meshes and textures within a device memory budget.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/Image2d.hpp>
+#include <gbGraphics/ImageLoader.hpp>
+#include <gbGraphics/Mesh.hpp>
+#include <gbGraphics/MeshCache.hpp>
+#include <gbGraphics/UploadBatch.hpp>
+#include <gbGraphics/detail/ResidencyTracker.hpp>
+
+#include <gbVk/Buffer.hpp>
+#include <gbVk/CommandBuffer.hpp>
+#include <gbVk/Fence.hpp>
+#include <gbVk/Image.hpp>
+#include <gbVk/SubmitStaging.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+class GraphicsInstance;
+
+/** Keeps the device memory used by meshes and textures within a budget.
+ * Resources are registered with the manager and accessed through use(), which restores them to device
+ * memory if needed. Once per frame, beginFrame() evicts the least recently used resources until the
+ * resident resources fit the budget again. Evicted resources keep their data on the host or on disk,
+ * depending on the resource:
+ * @code
+ * ResidencyManager residency(instance);
+ * auto const id = residency.add(std::make_unique<ResidentMesh<>>("chalet.cache", "chalet.jpg"));
+ * while (rendering) {
+ *     // ... wait for the device to complete the frame from frames_in_flight frames ago
+ *     residency.beginFrame();
+ *     Mesh<>& mesh = residency.use<ResidentMesh<>>(id).getMesh();
+ *     // ...
+ * }
+ * @endcode
+ * The budget is the configured budget, capped by what the device-local memory heaps have left for
+ * the resources of the manager. The device budget comes from VK_EXT_memory_budget where available,
+ * otherwise it is estimated from the heap sizes.
+ * The upload of a restored resource is submitted to the transfer queue right away and signals a semaphore.
+ * A submission that waits for the semaphore and acquires the resource for the graphics queue family is
+ * staged on the graphics queue, so the resource can be drawn by any graphics work that is submitted after
+ * it, e.g. by Renderer::render() in the same frame. The manager therefore has to be used from the thread
+ * that submits to the transfer and graphics queues.
+ */
+class ResidencyManager {
+public:
+    using ResourceId = detail::ResidencyTracker::ResourceId;
+
+    /** A resource whose device memory can be released and recreated.
+     */
+    class Resource {
+    public:
+        virtual ~Resource() = default;
+
+        /** Size of the device memory of the resource.
+         * @pre The resource is resident.
+         */
+        virtual VkDeviceSize getDeviceMemorySize() const = 0;
+
+        /** Release the device memory of the resource.
+         * @pre The resource is resident and not in use by the device.
+         */
+        virtual void evict() = 0;
+
+        /** Recreate the device memory of the resource and record the upload of its data.
+         * The resource is released to the graphics queue family by upload_batch.
+         * @pre The resource is not resident.
+         */
+        virtual void restore(UploadBatch& upload_batch) = 0;
+
+        /** Record the acquisition of the resource by the graphics queue family after restore().
+         * Only called if the transfer queue family is not the graphics queue family.
+         * @param[in] src_stage Source stage of the acquire barriers, which have to form a dependency
+         *                      chain with the wait for the upload.
+         * @param[in] src_queue_family Queue family of the transfer queue that released the resource.
+         */
+        virtual void recordAcquire(GhulbusVulkan::CommandBuffer& command_buffer, VkPipelineStageFlags src_stage,
+                                   uint32_t src_queue_family) = 0;
+    };
+
+    /** Device memory usage and budget of the device-local memory heaps.
+     */
+    struct DeviceBudget {
+        VkDeviceSize usage;
+        VkDeviceSize budget;
+    };
+private:
+    struct PendingRestore {
+        GhulbusVulkan::Fence fence;
+        GhulbusVulkan::SubmitStaging submitStaging;
+    };
+    GraphicsInstance* m_instance;
+    detail::ResidencyTracker m_tracker;
+    std::list<PendingRestore> m_pendingRestores;            ///< Uploads submitted to the transfer queue
+    std::vector<std::unique_ptr<Resource>> m_resources;     ///< Indexed by ResourceId
+    std::optional<VkDeviceSize> m_budget;
+    uint32_t m_framesInFlight;
+public:
+    /** Constructor.
+     * @param[in] frames_in_flight Number of frames the device may be working on. Resources used in one
+     *                             of the last frames_in_flight frames are never evicted.
+     */
+    explicit ResidencyManager(GraphicsInstance& instance, uint32_t frames_in_flight = 2);
+
+    ~ResidencyManager();
+
+    ResidencyManager(ResidencyManager const&) = delete;
+    ResidencyManager& operator=(ResidencyManager const&) = delete;
+
+    /** Register a resource.
+     * The resource is not resident until it is used for the first time.
+     */
+    ResourceId add(std::unique_ptr<Resource> resource);
+
+    /** Unregister and destroy a resource.
+     * @pre The resource is not in use by the device.
+     */
+    void remove(ResourceId id);
+
+    /** Mark a resource as used in the current frame, restoring it to device memory if it was evicted.
+     * If the device runs out of memory while restoring, all resources not in use by the device are
+     * evicted before trying again.
+     * A restored resource may only be used by graphics queue submissions that are staged or submitted
+     * after this call.
+     */
+    Resource& use(ResourceId id);
+
+    template<typename Resource_T>
+    Resource_T& use(ResourceId id);
+
+    bool isResident(ResourceId id) const;
+
+    /** Start a new frame and evict least recently used resources until the resident resources fit the budget.
+     * Also frees the staging memory of restore uploads that have completed.
+     * @pre The device has completed all work of the frame frames_in_flight frames ago.
+     */
+    void beginFrame();
+
+    /** Set the maximum device memory for the resources of the manager.
+     * @param[in] budget Budget in bytes or std::nullopt for using all memory the device has available.
+     */
+    void setBudget(std::optional<VkDeviceSize> budget);
+
+    /** Effective budget for the resources of the manager.
+     */
+    VkDeviceSize getBudget();
+
+    /** Combined device memory size of all resident resources.
+     */
+    VkDeviceSize getResidentSize() const;
+
+    DeviceBudget queryDeviceBudget();
+private:
+    void restore(ResourceId id);
+    void submitRestore(Resource& resource, UploadBatch& upload_batch);
+    void retireCompletedRestores();
+    void evict(std::vector<ResourceId> const& ids);
+};
+
+template<typename Resource_T>
+inline Resource_T& ResidencyManager::use(ResourceId id)
+{
+    return dynamic_cast<Resource_T&>(use(id));
+}
+
+/** Mesh that can be evicted from device memory.
+ * The data of an evicted mesh is kept either as a host copy or as the files it was loaded from.
+ */
+template<typename Mesh_T = Mesh<>>
+class ResidentMesh : public ResidencyManager::Resource {
+public:
+    using VertexData = typename Mesh_T::VertexData;
+    using IndexData = typename Mesh_T::IndexData;
+private:
+    struct HostData {
+        VertexData vertexData;
+        IndexData indexData;
+        ImageLoader texture;
+    };
+    struct FileData {
+        std::string meshCacheFilename;
+        std::string textureFilename;
+    };
+    std::optional<HostData> m_hostData;
+    std::optional<FileData> m_fileData;
+    std::optional<Mesh_T> m_mesh;
+    VkDeviceSize m_deviceMemorySize;
+public:
+    /** Constructor.
+     * The data is kept on the host while the mesh is evicted.
+     */
+    ResidentMesh(VertexData vertex_data, IndexData index_data, ImageLoader texture);
+
+    /** Constructor.
+     * The files are loaded again each time the mesh is restored.
+     * @param[in] mesh_cache_filename MeshCache file with the vertex and index data.
+     * @param[in] texture_filename Image file with the texture.
+     */
+    ResidentMesh(std::string mesh_cache_filename, std::string texture_filename);
+
+    /** Get the mesh.
+     * @pre The mesh is resident.
+     */
+    Mesh_T& getMesh();
+
+    VkDeviceSize getDeviceMemorySize() const override;
+    void evict() override;
+    void restore(UploadBatch& upload_batch) override;
+    void recordAcquire(GhulbusVulkan::CommandBuffer& command_buffer, VkPipelineStageFlags src_stage,
+                       uint32_t src_queue_family) override;
+};
+
+/** Texture that can be evicted from device memory.
+ * The texels of an evicted texture are kept either as a host copy or as the file they were loaded from.
+ */
+class ResidentImage : public ResidencyManager::Resource {
+private:
+    std::optional<ImageLoader> m_hostData;
+    std::string m_filename;
+    std::optional<Image2d> m_image;
+    VkDeviceSize m_deviceMemorySize;
+public:
+    /** Constructor.
+     * The texels are kept on the host while the image is evicted.
+     */
+    explicit ResidentImage(ImageLoader image_data);
+
+    /** Constructor.
+     * The file is loaded again each time the image is restored.
+     */
+    explicit ResidentImage(std::string filename);
+
+    /** Get the image.
+     * @pre The image is resident.
+     */
+    Image2d& getImage();
+
+    VkDeviceSize getDeviceMemorySize() const override;
+    void evict() override;
+    void restore(UploadBatch& upload_batch) override;
+    void recordAcquire(GhulbusVulkan::CommandBuffer& command_buffer, VkPipelineStageFlags src_stage,
+                       uint32_t src_queue_family) override;
+};
+
+template<typename Mesh_T>
+inline ResidentMesh<Mesh_T>::ResidentMesh(VertexData vertex_data, IndexData index_data, ImageLoader texture)
+    :m_hostData(HostData{ std::move(vertex_data), std::move(index_data), std::move(texture) }), m_deviceMemorySize(0)
+{
+}
+
+template<typename Mesh_T>
+inline ResidentMesh<Mesh_T>::ResidentMesh(std::string mesh_cache_filename, std::string texture_filename)
+    :m_fileData(FileData{ std::move(mesh_cache_filename), std::move(texture_filename) }), m_deviceMemorySize(0)
+{
+    static_assert(std::is_same_v<typename IndexData::IndexType::ValueType, std::uint32_t>,
+                  "Cached indices are 32 bit.");
+}
+
+template<typename Mesh_T>
+inline Mesh_T& ResidentMesh<Mesh_T>::getMesh()
+{
+    GHULBUS_PRECONDITION(m_mesh);
+    return *m_mesh;
+}
+
+template<typename Mesh_T>
+inline VkDeviceSize ResidentMesh<Mesh_T>::getDeviceMemorySize() const
+{
+    GHULBUS_PRECONDITION(m_mesh);
+    return m_deviceMemorySize;
+}
+
+template<typename Mesh_T>
+inline void ResidentMesh<Mesh_T>::evict()
+{
+    GHULBUS_PRECONDITION(m_mesh);
+    m_mesh.reset();
+}
+
+template<typename Mesh_T>
+inline void ResidentMesh<Mesh_T>::restore(UploadBatch& upload_batch)
+{
+    GHULBUS_PRECONDITION(!m_mesh);
+    if (m_hostData) {
+        m_mesh.emplace(upload_batch, m_hostData->vertexData, m_hostData->indexData, m_hostData->texture);
+    } else {
+        // only meshes with 32 bit indices can be constructed from a cache
+        if constexpr (std::is_same_v<typename IndexData::IndexType::ValueType, std::uint32_t>) {
+            MeshCache const cache(m_fileData->meshCacheFilename.c_str());
+            ImageLoader const texture(m_fileData->textureFilename.c_str());
+            m_mesh.emplace(upload_batch, cache, texture);
+        }
+    }
+    m_deviceMemorySize = m_mesh->getVertexBuffer().getSize() + m_mesh->getIndexBuffer().getSize() +
+        m_mesh->getTexture().getImage().getMemoryRequirements().size;
+}
+
+template<typename Mesh_T>
+inline void ResidentMesh<Mesh_T>::recordAcquire(GhulbusVulkan::CommandBuffer& command_buffer,
+                                                VkPipelineStageFlags src_stage, uint32_t src_queue_family)
+{
+    GHULBUS_PRECONDITION(m_mesh);
+    // direct upload buffers are written through a mapping and never released by the transfer queue
+    if (!m_mesh->getVertexBuffer().isDirectUpload()) {
+        m_mesh->getVertexBuffer().getBuffer().transitionAcquire(command_buffer, src_stage,
+                                                                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                                                VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, src_queue_family);
+    }
+    if (!m_mesh->getIndexBuffer().isDirectUpload()) {
+        m_mesh->getIndexBuffer().getBuffer().transitionAcquire(command_buffer, src_stage,
+                                                               VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                                               VK_ACCESS_INDEX_READ_BIT, src_queue_family);
+    }
+    m_mesh->getTexture().getImage().transitionAcquire(command_buffer, src_stage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                                      VK_ACCESS_SHADER_READ_BIT, src_queue_family,
+                                                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+}
+#endif
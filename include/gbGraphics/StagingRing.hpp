@@ -0,0 +1,138 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_STAGING_RING_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_STAGING_RING_HPP
+
+/** @file
+*
+* @brief Ring buffer for staging memory shared by all uploads.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/MemoryBuffer.hpp>
+
+#include <gbVk/Fence.hpp>
+#include <gbVk/ForwardDecl.hpp>
+#include <gbVk/MappedMemory.hpp>
+#include <gbVk/SubmitStaging.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+class GraphicsInstance;
+
+/** Persistently mapped host-visible buffer from which staging memory for uploads is sub-allocated.
+ * Allocations are handed out in FIFO order and retired in the same order, once the upload
+ * that reads from them has completed. Completion is tracked either by a fence owned by the ring
+ * (for uploads submitted by the ring itself) or by the cleanup or destruction of the SubmitStaging
+ * that reads the allocation (for uploads that are staged on a queue by the caller).
+ *
+ * Uploads larger than the ring are split into chunks by uploadBuffer(), so the amount of staging
+ * memory is bounded by the ring capacity, independent of the size of the upload.
+ */
+class StagingRing {
+public:
+    static constexpr VkDeviceSize defaultCapacity = 64ull << 20;
+    static constexpr VkDeviceSize defaultAlignment = 16;
+
+    /** A range of the ring buffer.
+     */
+    struct Allocation {
+        uint64_t id;                ///< Identifies the allocation for release()
+        VkDeviceSize offset;        ///< Offset into getBuffer()
+        VkDeviceSize size;          ///< Size in bytes
+        std::byte* data;            ///< Mapped host memory of the range
+    };
+
+    /** Releases an allocation when destroyed.
+     */
+    class ReleaseGuard {
+    private:
+        StagingRing* m_ring;
+        Allocation m_allocation;
+    public:
+        ReleaseGuard(StagingRing& ring, Allocation const& allocation);
+        ~ReleaseGuard();
+        ReleaseGuard(ReleaseGuard const&) = delete;
+        ReleaseGuard& operator=(ReleaseGuard const&) = delete;
+        ReleaseGuard(ReleaseGuard&& rhs) noexcept;
+        ReleaseGuard& operator=(ReleaseGuard&&) = delete;
+    };
+private:
+    struct Region {
+        uint64_t id;
+        VkDeviceSize begin;         ///< Start of the region, including padding skipped at the end of the ring
+        VkDeviceSize end;
+        bool isReleased;
+        std::shared_ptr<GhulbusVulkan::Fence> fence;    ///< Shared with threads waiting without holding m_mtx
+    };
+    GraphicsInstance* m_instance;
+    MemoryBuffer m_buffer;
+    GhulbusVulkan::MappedMemory m_mappedMemory;
+    std::mutex m_mtx;
+    std::deque<Region> m_regions;       ///< Live regions, oldest first
+    VkDeviceSize m_head;                ///< Offset at which the next allocation starts
+    uint64_t m_nextId;
+public:
+    explicit StagingRing(GraphicsInstance& instance, VkDeviceSize capacity = defaultCapacity);
+
+    ~StagingRing();
+
+    StagingRing(StagingRing const&) = delete;
+    StagingRing& operator=(StagingRing const&) = delete;
+
+    VkDeviceSize getCapacity() const;
+
+    MemoryBuffer& getBuffer();
+
+    /** Allocate staging memory without blocking.
+     * @return The allocation or std::nullopt if the ring currently has no room for size bytes.
+     */
+    std::optional<Allocation> tryAllocate(VkDeviceSize size, VkDeviceSize alignment = defaultAlignment);
+
+    /** Allocate staging memory, waiting for uploads submitted by the ring to complete if necessary.
+     * @return The allocation or std::nullopt if size exceeds the capacity or the room is held by
+     *         uploads that were staged by the caller and have not been cleaned up yet.
+     */
+    std::optional<Allocation> allocate(VkDeviceSize size, VkDeviceSize alignment = defaultAlignment);
+
+    /** Mark an allocation as no longer in use.
+     */
+    void release(Allocation const& allocation);
+
+    /** Release the allocation once the cleanup of submit_staging has been performed
+     * or submit_staging is destroyed, whichever happens first.
+     */
+    void releaseOnCleanup(Allocation const& allocation, GhulbusVulkan::SubmitStaging& submit_staging);
+
+    /** Copy data to a buffer through the ring.
+     * The data is split into chunks that each fit into the ring. Each chunk is submitted
+     * to the transfer queue right away, so copying a chunk overlaps with filling the next one.
+     * Returns once all chunks have completed. The command buffers of the chunks are allocated from
+     * and freed on the calling thread only, as required by the thread-local pools of CommandPoolRegistry.
+     * @param[in] target_buffer Buffer with usage VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+     * @param[in] target_offset Offset into target_buffer in bytes.
+     * @param[in] target_queue If set, the buffer is released to the target queue family after the last chunk.
+     */
+    void uploadBuffer(GhulbusVulkan::Buffer& target_buffer, VkDeviceSize target_offset,
+                      std::byte const* data, VkDeviceSize size,
+                      std::optional<uint32_t> target_queue = std::nullopt);
+
+    /** Wait for all uploads submitted by the ring to complete.
+     */
+    void waitIdle();
+private:
+    /// @pre m_mtx is locked.
+    std::optional<Allocation> allocateRegion(VkDeviceSize size, VkDeviceSize alignment);
+    /// @pre m_mtx is locked.
+    void retireCompletedRegions();
+    void attachFence(Allocation const& allocation, std::shared_ptr<GhulbusVulkan::Fence> const& fence);
+};
+}
+#endif
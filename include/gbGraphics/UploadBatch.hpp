@@ -0,0 +1,133 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_UPLOAD_BATCH_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_UPLOAD_BATCH_HPP
+
+/** @file
+*
+* @brief Batching of many uploads into a single submission.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/MemoryBuffer.hpp>
+#include <gbGraphics/StagingRing.hpp>
+
+#include <gbVk/CommandBuffers.hpp>
+#include <gbVk/Fence.hpp>
+#include <gbVk/ForwardDecl.hpp>
+#include <gbVk/SubmitStaging.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+class GraphicsInstance;
+class Image2d;
+class ImageContainerLoader;
+
+/** Records the copies of many buffer and image uploads into a single transfer command buffer.
+ * The queue ownership transfers of all uploaded resources are recorded as one pipeline barrier
+ * at the end of the command buffer. submit() submits all uploads with a single vkQueueSubmit2,
+ * so loading a scene needs only one submission and one fence:
+ * @code
+ * UploadBatch upload_batch(instance, instance.getGraphicsQueueFamilyIndex());
+ * for (auto const& m : scene) { meshes.emplace_back(upload_batch, m.vertices, m.indices, m.texture); }
+ * GhulbusVulkan::SubmitStaging submitted = upload_batch.submit(fence);
+ * fence.wait();
+ * submitted.performCleanup();
+ * @endcode
+ * Alternatively, the SubmitStaging returned by finish() can be staged on the transfer queue together
+ * with other work.
+ * Source data is copied to staging memory immediately, so it does not need to outlive the batch.
+ * Staging memory is taken from the GraphicsInstance's StagingRing when possible.
+ */
+class UploadBatch {
+private:
+    GraphicsInstance* m_instance;
+    std::optional<uint32_t> m_targetQueue;
+    GhulbusVulkan::CommandBuffers m_commandBuffers;
+    std::vector<StagingRing::Allocation> m_ringAllocations;
+    std::vector<MemoryBuffer> m_stagingBuffers;         ///< Dedicated staging memory for uploads not fitting the ring
+    std::vector<VkBufferMemoryBarrier> m_bufferBarriers;
+    std::vector<VkImageMemoryBarrier> m_imageBarriers;
+    uint32_t m_numberOfUploads;
+    bool m_isFinished;
+public:
+    /** Constructor.
+     * @param[in] target_queue If set, all uploaded resources are released to this queue family.
+     */
+    explicit UploadBatch(GraphicsInstance& instance, std::optional<uint32_t> target_queue = std::nullopt);
+
+    ~UploadBatch();
+
+    UploadBatch(UploadBatch const&) = delete;
+    UploadBatch& operator=(UploadBatch const&) = delete;
+
+    GraphicsInstance& getInstance();
+
+    /** Number of uploads added to the batch.
+     */
+    uint32_t getNumberOfUploads() const;
+
+    /** Upload the complete contents of target.
+     * @param[in] data Source data of target.getSize() bytes.
+     */
+    void addBufferUpload(MemoryBuffer& target, std::byte const* data);
+
+    /** Upload a range of target.
+     * If target is a direct upload buffer, the data is written to it right away.
+     * @param[in] target_offset Offset into target in bytes.
+     * @param[in] data Source data of size bytes.
+     */
+    void addBufferUpload(MemoryBuffer& target, VkDeviceSize target_offset, std::byte const* data, VkDeviceSize size);
+
+    /** Upload the complete contents of target from a staging buffer.
+     * @param[in] staging_buffer Mappable buffer with usage VK_BUFFER_USAGE_TRANSFER_SRC_BIT and the same size
+     *                           as target. It is kept alive until the submission has been processed.
+     */
+    void addBufferUpload(MemoryBuffer& target, MemoryBuffer&& staging_buffer);
+
+    /** Upload the complete image.
+     * @param[in] data Source texels in the format of target.
+     * @pre target has a single mip level. Images with a mip chain are uploaded with
+     *      Image2d::setDataAsynchronously(), which generates the other levels on the graphics queue.
+     */
+    void addImageUpload(Image2d& target, std::byte const* data);
+
+    /** Upload all mip levels of an image container.
+     * If target was created with the decompressed format because the device does not support the format
+     * of image_data, the texels are decompressed on the host first.
+     * @pre target has the size and number of mip levels of image_data.
+     */
+    void addImageUpload(Image2d& target, ImageContainerLoader const& image_data);
+
+    /** Finish recording.
+     * @return Submission of all uploads of the batch. Staging memory is freed on its cleanup.
+     * @pre finish() has not been called before.
+     */
+    GhulbusVulkan::SubmitStaging finish();
+
+    /** Finish recording and submit the batch to the transfer queue right away.
+     * @param[in] fence Signaled once all uploads of the batch have completed.
+     * @return The submitted batch. Its cleanup, which frees the staging memory, has to be performed
+     *         by the caller once fence has been signaled.
+     * @pre finish() has not been called before.
+     */
+    GhulbusVulkan::SubmitStaging submit(GhulbusVulkan::Fence& fence);
+private:
+    struct StagingRange {
+        GhulbusVulkan::Buffer* buffer;
+        VkDeviceSize offset;
+    };
+    StagingRange stageData(std::byte const* data, VkDeviceSize size);
+    void recordBufferCopy(MemoryBuffer& target, VkDeviceSize target_offset, VkDeviceSize size,
+                          GhulbusVulkan::Buffer& source, VkDeviceSize source_offset);
+    void addImageBarrier(GhulbusVulkan::Image& image, uint32_t mip_levels);
+    bool isTargetQueueSameAsTransferQueue();
+    bool isTransferQueueGraphicsQueue();
+};
+}
+#endif
@@ -0,0 +1,342 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_VERTEX_CONVERSION_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_VERTEX_CONVERSION_HPP
+
+/** @file
+*
+* @brief Conversion between vertex formats.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/VertexData.hpp>
+#include <gbGraphics/VertexEncoding.hpp>
+#include <gbGraphics/VertexFormat.hpp>
+
+#include <gbMath/Color4.hpp>
+#include <gbMath/Vector2.hpp>
+#include <gbMath/Vector3.hpp>
+#include <gbMath/Vector4.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+/** Conversion of vertex data between VertexData types.
+ * Components of the target are matched to components of the source by their semantics. The matching is
+ * resolved at compile time, so converting a vertex only touches the source components that are needed.
+ * - Components with identical layouts are copied.
+ * - Components with differing layouts are converted by an overload of convertComponent(). Float vectors can
+ *   be converted to the compact layouts from VertexComponentLayout, and back.
+ * - Components missing from the source get a default value: Opaque white for Color, zero for everything else.
+ * - Padding components are zero.
+ */
+namespace VertexConversion
+{
+template<typename TagS_T, typename TagT_T>
+inline void convertComponent(GhulbusMath::Vector2Impl<float, TagS_T> const& source,
+                             GhulbusMath::Vector2Impl<float, TagT_T>& target)
+{
+    target = GhulbusMath::Vector2Impl<float, TagT_T>(source.x, source.y);
+}
+
+template<typename TagS_T, typename TagT_T>
+inline void convertComponent(GhulbusMath::Vector3Impl<float, TagS_T> const& source,
+                             GhulbusMath::Vector3Impl<float, TagT_T>& target)
+{
+    target = GhulbusMath::Vector3Impl<float, TagT_T>(source.x, source.y, source.z);
+}
+
+/** The w of 3d vectors that are widened to 4 elements: 1 for points, 0 for directions.
+ */
+template<typename VectorTag_T>
+inline constexpr float homogeneousW()
+{
+    return std::is_same_v<VectorTag_T, GhulbusMath::VectorTag::Point> ? 1.f : 0.f;
+}
+
+template<typename Tag_T>
+inline void convertComponent(GhulbusMath::Vector3Impl<float, Tag_T> const& source, GhulbusMath::Vector4<float>& target)
+{
+    target = GhulbusMath::Vector4<float>(source.x, source.y, source.z, homogeneousW<Tag_T>());
+}
+
+template<typename Tag_T>
+inline void convertComponent(GhulbusMath::Vector4<float> const& source, GhulbusMath::Vector3Impl<float, Tag_T>& target)
+{
+    target = GhulbusMath::Vector3Impl<float, Tag_T>(source.x, source.y, source.z);
+}
+
+inline void convertComponent(GhulbusMath::Color4<float> const& source, GhulbusMath::Vector4<float>& target)
+{
+    target = GhulbusMath::Vector4<float>(source.r, source.g, source.b, source.a);
+}
+
+inline void convertComponent(GhulbusMath::Vector4<float> const& source, GhulbusMath::Color4<float>& target)
+{
+    target = GhulbusMath::Color4<float>(source.x, source.y, source.z, source.w);
+}
+
+// float to half
+template<typename Tag_T>
+inline void convertComponent(GhulbusMath::Vector2Impl<float, Tag_T> const& source, VertexComponentLayout::Half<2>& target)
+{
+    target = VertexEncoding::encodeHalf(source);
+}
+
+template<typename Tag_T>
+inline void convertComponent(GhulbusMath::Vector3Impl<float, Tag_T> const& source, VertexComponentLayout::Half<4>& target)
+{
+    target = VertexEncoding::encodeHalf(source, homogeneousW<Tag_T>());
+}
+
+inline void convertComponent(GhulbusMath::Vector4<float> const& source, VertexComponentLayout::Half<4>& target)
+{
+    target = VertexEncoding::encodeHalf(source);
+}
+
+inline void convertComponent(GhulbusMath::Color4<float> const& source, VertexComponentLayout::Half<4>& target)
+{
+    target = VertexEncoding::encodeHalf(source);
+}
+
+// float to normalized
+template<typename Tag_T, typename T>
+inline void convertComponent(GhulbusMath::Vector2Impl<float, Tag_T> const& source,
+                             VertexComponentLayout::Normalized<T, 2>& target)
+{
+    target = VertexEncoding::encodeNormalized<T>(source);
+}
+
+template<typename Tag_T, typename T>
+inline void convertComponent(GhulbusMath::Vector3Impl<float, Tag_T> const& source,
+                             VertexComponentLayout::Normalized<T, 4>& target)
+{
+    target = VertexEncoding::encodeNormalized<T>(source, homogeneousW<Tag_T>());
+}
+
+template<typename T>
+inline void convertComponent(GhulbusMath::Vector4<float> const& source, VertexComponentLayout::Normalized<T, 4>& target)
+{
+    target = VertexEncoding::encodeNormalized<T>(source);
+}
+
+template<typename T>
+inline void convertComponent(GhulbusMath::Color4<float> const& source, VertexComponentLayout::Normalized<T, 4>& target)
+{
+    target = VertexEncoding::encodeNormalized<T>(source);
+}
+
+/** Normals are stored in two components with octahedral encoding.
+ */
+inline void convertComponent(GhulbusMath::Normal3f const& source,
+                             VertexComponentLayout::Normalized<std::int16_t, 2>& target)
+{
+    target = VertexEncoding::encodeOctahedral(source);
+}
+
+// float to packed
+template<typename Tag_T>
+inline void convertComponent(GhulbusMath::Vector3Impl<float, Tag_T> const& source,
+                             VertexComponentLayout::SNorm10_10_10_2& target)
+{
+    target = VertexEncoding::encodeSNorm10_10_10_2(source, homogeneousW<Tag_T>());
+}
+
+inline void convertComponent(GhulbusMath::Vector4<float> const& source, VertexComponentLayout::SNorm10_10_10_2& target)
+{
+    target = VertexEncoding::encodeSNorm10_10_10_2(source);
+}
+
+inline void convertComponent(GhulbusMath::Vector4<float> const& source, VertexComponentLayout::UNorm10_10_10_2& target)
+{
+    target = VertexEncoding::encodeUNorm10_10_10_2(source);
+}
+
+inline void convertComponent(GhulbusMath::Color4<float> const& source, VertexComponentLayout::UNorm10_10_10_2& target)
+{
+    target = VertexEncoding::encodeUNorm10_10_10_2(GhulbusMath::Vector4<float>(source.r, source.g, source.b, source.a));
+}
+
+// compact to float
+template<typename Tag_T>
+inline void convertComponent(VertexComponentLayout::Half<2> const& source, GhulbusMath::Vector2Impl<float, Tag_T>& target)
+{
+    target = GhulbusMath::Vector2Impl<float, Tag_T>(VertexEncoding::halfToFloat(source.value[0]),
+                                                    VertexEncoding::halfToFloat(source.value[1]));
+}
+
+template<typename Tag_T>
+inline void convertComponent(VertexComponentLayout::Half<4> const& source, GhulbusMath::Vector3Impl<float, Tag_T>& target)
+{
+    target = GhulbusMath::Vector3Impl<float, Tag_T>(VertexEncoding::halfToFloat(source.value[0]),
+                                                    VertexEncoding::halfToFloat(source.value[1]),
+                                                    VertexEncoding::halfToFloat(source.value[2]));
+}
+
+inline void convertComponent(VertexComponentLayout::Half<4> const& source, GhulbusMath::Vector4<float>& target)
+{
+    target = GhulbusMath::Vector4<float>(VertexEncoding::halfToFloat(source.value[0]),
+                                         VertexEncoding::halfToFloat(source.value[1]),
+                                         VertexEncoding::halfToFloat(source.value[2]),
+                                         VertexEncoding::halfToFloat(source.value[3]));
+}
+
+template<typename T, typename Tag_T>
+inline void convertComponent(VertexComponentLayout::Normalized<T, 2> const& source,
+                             GhulbusMath::Vector2Impl<float, Tag_T>& target)
+{
+    target = GhulbusMath::Vector2Impl<float, Tag_T>(VertexEncoding::decodeNormalized(source.value[0]),
+                                                    VertexEncoding::decodeNormalized(source.value[1]));
+}
+
+template<typename T, typename Tag_T>
+inline void convertComponent(VertexComponentLayout::Normalized<T, 4> const& source,
+                             GhulbusMath::Vector3Impl<float, Tag_T>& target)
+{
+    target = GhulbusMath::Vector3Impl<float, Tag_T>(VertexEncoding::decodeNormalized(source.value[0]),
+                                                    VertexEncoding::decodeNormalized(source.value[1]),
+                                                    VertexEncoding::decodeNormalized(source.value[2]));
+}
+
+template<typename T>
+inline void convertComponent(VertexComponentLayout::Normalized<T, 4> const& source, GhulbusMath::Vector4<float>& target)
+{
+    target = GhulbusMath::Vector4<float>(VertexEncoding::decodeNormalized(source.value[0]),
+                                         VertexEncoding::decodeNormalized(source.value[1]),
+                                         VertexEncoding::decodeNormalized(source.value[2]),
+                                         VertexEncoding::decodeNormalized(source.value[3]));
+}
+
+inline void convertComponent(VertexComponentLayout::Normalized<std::int16_t, 2> const& source,
+                             GhulbusMath::Normal3f& target)
+{
+    target = VertexEncoding::decodeOctahedral(source);
+}
+
+template<typename Tag_T>
+inline void convertComponent(VertexComponentLayout::SNorm10_10_10_2 const& source,
+                             GhulbusMath::Vector3Impl<float, Tag_T>& target)
+{
+    GhulbusMath::Vector4<float> const v = VertexEncoding::decode(source);
+    target = GhulbusMath::Vector3Impl<float, Tag_T>(v.x, v.y, v.z);
+}
+
+inline void convertComponent(VertexComponentLayout::SNorm10_10_10_2 const& source, GhulbusMath::Vector4<float>& target)
+{
+    target = VertexEncoding::decode(source);
+}
+
+inline void convertComponent(VertexComponentLayout::UNorm10_10_10_2 const& source, GhulbusMath::Vector4<float>& target)
+{
+    target = VertexEncoding::decode(source);
+}
+
+template<typename Source_T, typename Target_T>
+concept ConvertibleComponent = std::is_same_v<Source_T, Target_T> ||
+    requires(Source_T const& source, Target_T& target) { convertComponent(source, target); };
+
+namespace detail
+{
+template<typename T_VertexComponent>
+inline constexpr VertexFormatBase::ComponentSemantics componentSemantics =
+    decltype(getVertexComponentSemantics(std::declval<typename T_VertexComponent::Semantics>()))::value;
+
+template<typename Source_T, typename Target_T>
+inline void convertOrCopy(Source_T const& source, Target_T& target)
+{
+    if constexpr (std::is_same_v<Source_T, Target_T>) {
+        target = source;
+    } else {
+        convertComponent(source, target);
+    }
+}
+
+template<VertexFormatBase::ComponentSemantics Semantics, typename Layout_T>
+inline Layout_T getDefaultValue()
+{
+    Layout_T ret{};
+    if constexpr ((Semantics == VertexFormatBase::ComponentSemantics::Color) &&
+                  ConvertibleComponent<GhulbusMath::Color4<float>, Layout_T>)
+    {
+        convertOrCopy(GhulbusMath::Color4<float>(1.f, 1.f, 1.f, 1.f), ret);
+    }
+    return ret;
+}
+
+/** Convert the target component with index I for all vertices.
+ * Converting one component at a time keeps the inner loop free of branches and lets the compiler
+ * vectorize it for the plain copies and float conversions.
+ */
+template<std::size_t I, typename TargetData_T, typename SourceData_T>
+inline void convertComponentStream(std::span<typename SourceData_T::Storage const> source,
+                                   std::span<typename TargetData_T::Storage> target)
+{
+    using SourceFormat = typename SourceData_T::Format;
+    using TargetComponent = std::tuple_element_t<I, typename TargetData_T::Components>;
+    using TargetLayout = typename TargetComponent::Layout;
+    VertexFormatBase::ComponentSemantics constexpr semantics = componentSemantics<TargetComponent>;
+
+    if constexpr ((semantics == VertexFormatBase::ComponentSemantics::Padding) ||
+                  (!SourceFormat::getIndexForSemantics(semantics).has_value()))
+    {
+        TargetLayout const default_value = getDefaultValue<semantics, TargetLayout>();
+        for (auto& v : target) { get<I>(v) = default_value; }
+    } else {
+        std::size_t constexpr source_index = *SourceFormat::getIndexForSemantics(semantics);
+        using SourceLayout = std::tuple_element_t<source_index, typename SourceData_T::Storage>;
+        static_assert(ConvertibleComponent<SourceLayout, TargetLayout>,
+                      "No conversion between the vertex component layouts.");
+        for (std::size_t i = 0; i < source.size(); ++i) {
+            convertOrCopy(get<source_index>(source[i]), get<I>(target[i]));
+        }
+    }
+}
+
+template<typename TargetData_T, typename SourceData_T, std::size_t... Is>
+inline void convertVertices(std::span<typename SourceData_T::Storage const> source,
+                            std::span<typename TargetData_T::Storage> target,
+                            std::index_sequence<Is...>)
+{
+    (convertComponentStream<Is, TargetData_T, SourceData_T>(source, target), ...);
+}
+}
+
+/** Convert vertices between the storage of two VertexData types.
+ * @param[in] source Source vertices.
+ * @param[out] target Receives the converted vertices; must have the same size as source.
+ */
+template<typename TargetData_T, typename SourceData_T>
+inline void convertVertices(std::span<typename SourceData_T::Storage const> source,
+                            std::span<typename TargetData_T::Storage> target)
+{
+    GHULBUS_PRECONDITION(source.size() == target.size());
+    // identical storage alone is not enough: components have to agree in semantics as well
+    if constexpr (std::is_same_v<typename TargetData_T::Format, typename SourceData_T::Format>) {
+        std::memcpy(target.data(), source.data(), source.size_bytes());
+    } else {
+        detail::convertVertices<TargetData_T, SourceData_T>(source, target,
+            std::make_index_sequence<std::tuple_size_v<typename TargetData_T::Storage>>{});
+    }
+}
+
+/** Convert vertex data to a different VertexData type.
+ */
+template<typename TargetData_T, typename SourceData_T>
+inline TargetData_T convertVertexData(SourceData_T const& source)
+{
+    TargetData_T ret;
+    ret.getStorage().resize(source.size());
+    convertVertices<TargetData_T, SourceData_T>(source.getStorage(), ret.getStorage());
+    return ret;
+}
+}
+}
+#endif
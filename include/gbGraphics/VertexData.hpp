@@ -13,6 +13,7 @@
 #include <gbGraphics/VertexDataStorage.hpp>
 
 #include <initializer_list>
+#include <tuple>
 #include <vector>
 
 namespace GHULBUS_GRAPHICS_NAMESPACE
@@ -21,6 +22,7 @@ template<typename... T_VertexComponents>
 class VertexData {
 public:
     using Format = VertexFormat<T_VertexComponents...>;
+    using Components = std::tuple<T_VertexComponents...>;
     using Storage = VertexDataStorage<typename T_VertexComponents::Layout...>;
     static_assert(std::is_standard_layout_v<Storage>, "Vertex data must only consist of standard layout types.");
     static_assert(sizeof(Storage) == Format::getStrideStatic(),
@@ -70,6 +72,13 @@ get(VertexData<Ts...>& v, std::size_t vertex_index) noexcept {
     return get<component_index>(v.getStorage()[vertex_index]);
 }
 
+template<VertexFormatBase::ComponentSemantics Semantics, typename... Ts>
+inline constexpr decltype(auto)
+get(VertexData<Ts...> const& v, std::size_t vertex_index) noexcept {
+    size_t constexpr component_index = *VertexData<Ts...>::Format::getIndexForSemantics(Semantics);
+    return get<component_index>(v.getStorage()[vertex_index]);
+}
+
 template<typename T>
 struct VertexDataFromFormat;
 
@@ -0,0 +1,162 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_VERTEX_ENCODING_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_VERTEX_ENCODING_HPP
+
+/** @file
+*
+* @brief Encoding of float vertex data to compact vertex component layouts.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/VertexFormat.hpp>
+
+#include <gbMath/Color4.hpp>
+#include <gbMath/Vector2.hpp>
+#include <gbMath/Vector3.hpp>
+#include <gbMath/Vector4.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+/** Conversion between float vertex data and the compact layouts from VertexComponentLayout.
+ * Encoding is lossy. Values outside the representable range are clamped,
+ * all other values are rounded to the nearest representable value.
+ */
+namespace VertexEncoding
+{
+/** Convert a float to a 16-bit IEEE 754 half float.
+ * Rounds to nearest even. Values too large for a half become infinity.
+ */
+std::uint16_t floatToHalf(float f);
+
+/** Convert a 16-bit IEEE 754 half float to float.
+ * The conversion is exact.
+ */
+float halfToFloat(std::uint16_t h);
+
+/** Convert a float to a normalized integer.
+ * Signed T maps [-1, 1] to [-max, max], unsigned T maps [0, 1] to [0, max].
+ */
+template<typename T>
+inline T encodeNormalized(float f)
+{
+    static_assert(std::is_integral_v<T>);
+    float constexpr max_value = static_cast<float>(std::numeric_limits<T>::max());
+    float const min_range = std::is_signed_v<T> ? -1.f : 0.f;
+    return static_cast<T>(std::round(std::clamp(f, min_range, 1.f) * max_value));
+}
+
+/** Convert a normalized integer to float.
+ * For signed T, both the minimum and the minimum plus one of T map to -1.
+ */
+template<typename T>
+inline float decodeNormalized(T v)
+{
+    static_assert(std::is_integral_v<T>);
+    float constexpr max_value = static_cast<float>(std::numeric_limits<T>::max());
+    return std::max(static_cast<float>(v) / max_value, -1.f);
+}
+
+template<typename VectorTag_T>
+inline VertexComponentLayout::Half<2> encodeHalf(GhulbusMath::Vector2Impl<float, VectorTag_T> const& v)
+{
+    return VertexComponentLayout::Half<2>{ floatToHalf(v.x), floatToHalf(v.y) };
+}
+
+/** Encode a 3d vector to a half vector.
+ * As there is no 3-element half layout, the vector is padded with w.
+ */
+template<typename VectorTag_T>
+inline VertexComponentLayout::Half<4> encodeHalf(GhulbusMath::Vector3Impl<float, VectorTag_T> const& v, float w = 1.f)
+{
+    return VertexComponentLayout::Half<4>{ floatToHalf(v.x), floatToHalf(v.y), floatToHalf(v.z), floatToHalf(w) };
+}
+
+inline VertexComponentLayout::Half<4> encodeHalf(GhulbusMath::Vector4<float> const& v)
+{
+    return VertexComponentLayout::Half<4>{ floatToHalf(v.x), floatToHalf(v.y), floatToHalf(v.z), floatToHalf(v.w) };
+}
+
+inline VertexComponentLayout::Half<4> encodeHalf(GhulbusMath::Color4<float> const& c)
+{
+    return VertexComponentLayout::Half<4>{ floatToHalf(c.r), floatToHalf(c.g), floatToHalf(c.b), floatToHalf(c.a) };
+}
+
+template<typename T, typename VectorTag_T>
+inline VertexComponentLayout::Normalized<T, 2> encodeNormalized(GhulbusMath::Vector2Impl<float, VectorTag_T> const& v)
+{
+    return VertexComponentLayout::Normalized<T, 2>{ encodeNormalized<T>(v.x), encodeNormalized<T>(v.y) };
+}
+
+/** Encode a 3d vector to a normalized vector.
+ * As there is no 3-element normalized layout, the vector is padded with w.
+ */
+template<typename T, typename VectorTag_T>
+inline VertexComponentLayout::Normalized<T, 4> encodeNormalized(GhulbusMath::Vector3Impl<float, VectorTag_T> const& v,
+                                                                float w = 0.f)
+{
+    return VertexComponentLayout::Normalized<T, 4>{ encodeNormalized<T>(v.x), encodeNormalized<T>(v.y),
+                                                    encodeNormalized<T>(v.z), encodeNormalized<T>(w) };
+}
+
+template<typename T>
+inline VertexComponentLayout::Normalized<T, 4> encodeNormalized(GhulbusMath::Vector4<float> const& v)
+{
+    return VertexComponentLayout::Normalized<T, 4>{ encodeNormalized<T>(v.x), encodeNormalized<T>(v.y),
+                                                    encodeNormalized<T>(v.z), encodeNormalized<T>(v.w) };
+}
+
+template<typename T>
+inline VertexComponentLayout::Normalized<T, 4> encodeNormalized(GhulbusMath::Color4<float> const& c)
+{
+    return VertexComponentLayout::Normalized<T, 4>{ encodeNormalized<T>(c.r), encodeNormalized<T>(c.g),
+                                                    encodeNormalized<T>(c.b), encodeNormalized<T>(c.a) };
+}
+
+/** Encode a vector in [-1, 1] to the packed 10:10:10:2 signed normalized layout.
+ * The 2-bit w can only represent -1, 0 and 1.
+ */
+VertexComponentLayout::SNorm10_10_10_2 encodeSNorm10_10_10_2(GhulbusMath::Vector4<float> const& v);
+
+/** Encode a vector in [0, 1] to the packed 10:10:10:2 unsigned normalized layout.
+ * The 2-bit w can only represent 0, 1/3, 2/3 and 1.
+ */
+VertexComponentLayout::UNorm10_10_10_2 encodeUNorm10_10_10_2(GhulbusMath::Vector4<float> const& v);
+
+GhulbusMath::Vector4<float> decode(VertexComponentLayout::SNorm10_10_10_2 const& v);
+
+GhulbusMath::Vector4<float> decode(VertexComponentLayout::UNorm10_10_10_2 const& v);
+
+template<typename VectorTag_T>
+inline VertexComponentLayout::SNorm10_10_10_2 encodeSNorm10_10_10_2(
+    GhulbusMath::Vector3Impl<float, VectorTag_T> const& v, float w = 0.f)
+{
+    return encodeSNorm10_10_10_2(GhulbusMath::Vector4<float>(v.x, v.y, v.z, w));
+}
+
+/** Encode a unit length normal with octahedral mapping.
+ * The normal is projected onto an octahedron, which is unfolded onto the [-1, 1] square.
+ * Two 16-bit components keep the angular error below 0.01 degrees, at a third of the size of a Normal3f.
+ * The shader has to decode the normal, see decodeOctahedral().
+ */
+VertexComponentLayout::Normalized<std::int16_t, 2> encodeOctahedral(GhulbusMath::Normal3f const& n);
+
+/** Decode a normal encoded by encodeOctahedral().
+ * The equivalent GLSL is:
+ * @code
+ * vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+ * float t = max(-n.z, 0.0);
+ * n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+ * n = normalize(n);
+ * @endcode
+ */
+GhulbusMath::Normal3f decodeOctahedral(VertexComponentLayout::Normalized<std::int16_t, 2> const& e);
+}
+}
+#endif
@@ -62,7 +62,19 @@ public:
         t_mat4x3,
         t_mat2x4,
         t_mat3x4,
-        t_mat4x4
+        t_mat4x4,
+        t_half2,
+        t_half4,
+        t_snorm8x2,
+        t_snorm8x4,
+        t_unorm8x2,
+        t_unorm8x4,
+        t_snorm16x2,
+        t_snorm16x4,
+        t_unorm16x2,
+        t_unorm16x4,
+        t_snorm10_10_10_2,
+        t_unorm10_10_10_2
     };
 
     enum class ComponentSemantics {
@@ -137,6 +149,42 @@ namespace VertexComponentLayout {
     struct Padding {
         std::byte padding[N];
     };
+
+    /** N 16-bit floating point values.
+     * Appears as a float vector of size N in the shader.
+     */
+    template<size_t N>
+    struct Half {
+        static_assert((N == 2) || (N == 4), "Half vectors must have 2 or 4 elements.");
+        std::array<std::uint16_t, N> value;
+    };
+
+    /** N normalized integer values.
+     * Appears as a float vector of size N in the shader. Signed T maps [-1, 1], unsigned T maps [0, 1]
+     * to the full range of T.
+     */
+    template<typename T, size_t N>
+    struct Normalized {
+        static_assert(std::is_same_v<T, std::int8_t> || std::is_same_v<T, std::uint8_t> ||
+                      std::is_same_v<T, std::int16_t> || std::is_same_v<T, std::uint16_t>,
+                      "Normalized values must be 8 or 16 bit integers.");
+        static_assert((N == 2) || (N == 4), "Normalized vectors must have 2 or 4 elements.");
+        std::array<T, N> value;
+    };
+
+    /** Three signed normalized 10-bit values and one signed normalized 2-bit value, packed into 32 bits.
+     * x occupies the least significant bits. Appears as a float vector of size 3 or 4 in the shader.
+     */
+    struct SNorm10_10_10_2 {
+        std::uint32_t value;
+    };
+
+    /** Three unsigned normalized 10-bit values and one unsigned normalized 2-bit value, packed into 32 bits.
+     * x occupies the least significant bits. Appears as a float vector of size 3 or 4 in the shader.
+     */
+    struct UNorm10_10_10_2 {
+        std::uint32_t value;
+    };
 }
 
 template<size_t N>
@@ -157,6 +205,42 @@ getVertexComponentType(GhulbusMath::Vector3Impl<float, VectorTag_T> const&);
 constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_vec4>
 getVertexComponentType(GhulbusMath::Vector4<float> const&);
 
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_half2>
+getVertexComponentType(VertexComponentLayout::Half<2> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_half4>
+getVertexComponentType(VertexComponentLayout::Half<4> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_snorm8x2>
+getVertexComponentType(VertexComponentLayout::Normalized<std::int8_t, 2> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_snorm8x4>
+getVertexComponentType(VertexComponentLayout::Normalized<std::int8_t, 4> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_unorm8x2>
+getVertexComponentType(VertexComponentLayout::Normalized<std::uint8_t, 2> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_unorm8x4>
+getVertexComponentType(VertexComponentLayout::Normalized<std::uint8_t, 4> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_snorm16x2>
+getVertexComponentType(VertexComponentLayout::Normalized<std::int16_t, 2> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_snorm16x4>
+getVertexComponentType(VertexComponentLayout::Normalized<std::int16_t, 4> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_unorm16x2>
+getVertexComponentType(VertexComponentLayout::Normalized<std::uint16_t, 2> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_unorm16x4>
+getVertexComponentType(VertexComponentLayout::Normalized<std::uint16_t, 4> const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_snorm10_10_10_2>
+getVertexComponentType(VertexComponentLayout::SNorm10_10_10_2 const&);
+
+constexpr std::integral_constant<VertexFormatBase::ComponentType, VertexFormatBase::ComponentType::t_unorm10_10_10_2>
+getVertexComponentType(VertexComponentLayout::UNorm10_10_10_2 const&);
+
 template<typename T>
 struct InvalidLayout {
     static constexpr VertexFormatBase::ComponentType invalid() {
@@ -0,0 +1,175 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_VERTEX_STREAMS_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_VERTEX_STREAMS_HPP
+
+/** @file
+*
+* @brief Vertex data split into multiple streams.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbGraphics/VertexData.hpp>
+#include <gbGraphics/VertexFormat.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+/** Vertex data stored as multiple streams of interleaved VertexData.
+ * Each stream is uploaded to a separate vertex buffer and bound to a separate vertex binding.
+ * Passes that only need some of the components only fetch the streams containing them.
+ * For example, splitting the position from the remaining attributes allows depth-only passes
+ * to fetch 12 bytes per vertex instead of the full interleaved vertex:
+ * @code
+ * using PositionStream = VertexData<VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>>;
+ * using AttributeStream = VertexData<VertexComponent<GhulbusMath::Normal3f, VertexComponentSemantics::Normal>,
+ *                                    VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Texture>>;
+ * using Streams = VertexStreams<PositionStream, AttributeStream>;
+ * @endcode
+ * All streams hold the same number of vertices. Each semantic may only appear in one stream.
+ */
+template<typename... T_Streams>
+class VertexStreams {
+public:
+    static_assert(sizeof...(T_Streams) > 0, "Vertex streams need at least one stream.");
+    static constexpr std::size_t numberOfStreams = sizeof...(T_Streams);
+
+    template<std::size_t I>
+    using Stream = std::tuple_element_t<I, std::tuple<T_Streams...>>;
+private:
+    std::tuple<T_Streams...> m_streams;
+public:
+    VertexStreams() = default;
+
+    /** Constructor.
+     * @param[in] number_of_vertices Number of value-initialized vertices in each stream.
+     */
+    explicit VertexStreams(std::size_t number_of_vertices)
+    {
+        resize(number_of_vertices);
+    }
+
+    /** Split interleaved vertex data into streams.
+     * Every component of the streams, other than padding, is copied from the component
+     * with the same semantics in vertex_data.
+     */
+    template<typename... T_VertexComponents>
+    static VertexStreams fromInterleaved(VertexData<T_VertexComponents...> const& vertex_data);
+
+    template<std::size_t I>
+    Stream<I>& getStream() {
+        return std::get<I>(m_streams);
+    }
+
+    template<std::size_t I>
+    Stream<I> const& getStream() const {
+        return std::get<I>(m_streams);
+    }
+
+    /** Index of the stream containing a component with the requested semantics.
+     */
+    static constexpr std::optional<std::size_t> getStreamIndexForSemantics(VertexFormatBase::ComponentSemantics semantics) {
+        std::array<std::optional<std::size_t>, numberOfStreams> const component_indices{
+            T_Streams::Format::getIndexForSemantics(semantics)...
+        };
+        for (std::size_t i = 0; i < numberOfStreams; ++i) {
+            if (component_indices[i]) { return i; }
+        }
+        return std::nullopt;
+    }
+
+    /** Format of a single stream.
+     */
+    static VertexFormatBase const& getStreamFormat(std::size_t stream) {
+        GHULBUS_PRECONDITION(stream < numberOfStreams);
+        static std::tuple<typename T_Streams::Format...> const formats;
+        return *std::apply([](auto const&... f) {
+                return std::array<VertexFormatBase const*, numberOfStreams>{ &f... };
+            }, formats)[stream];
+    }
+
+    /** Raw data of a single stream.
+     */
+    std::byte const* data(std::size_t stream) const {
+        GHULBUS_PRECONDITION(stream < numberOfStreams);
+        return std::apply([](auto const&... s) {
+                return std::array<std::byte const*, numberOfStreams>{ s.data()... };
+            }, m_streams)[stream];
+    }
+
+    /** Size of the raw data of a single stream in bytes.
+     */
+    std::size_t getStreamSize(std::size_t stream) const {
+        return size() * getStreamFormat(stream).getStride();
+    }
+
+    std::size_t size() const {
+        return std::get<0>(m_streams).size();
+    }
+
+    bool empty() const {
+        return std::get<0>(m_streams).empty();
+    }
+
+    uint32_t getNumberOfVertices() const {
+        return static_cast<uint32_t>(size());
+    }
+
+    /** Resize all streams.
+     */
+    void resize(std::size_t number_of_vertices) {
+        std::apply([number_of_vertices](auto&... s) { (s.getStorage().resize(number_of_vertices), ...); }, m_streams);
+    }
+private:
+    template<typename T_VertexComponent, typename Stream_T, typename Source_T>
+    static void copyComponent(Stream_T& stream, Source_T const& source, std::size_t vertex_index) {
+        VertexFormatBase::ComponentSemantics constexpr semantics =
+            decltype(getVertexComponentSemantics(std::declval<typename T_VertexComponent::Semantics>()))::value;
+        if constexpr (semantics != VertexFormatBase::ComponentSemantics::Padding) {
+            static_assert(Source_T::Format::getIndexForSemantics(semantics).has_value(),
+                          "Stream component semantics not found in interleaved vertex data.");
+            get<semantics>(stream, vertex_index) = get<semantics>(source, vertex_index);
+        }
+    }
+
+    template<typename... T_StreamComponents, typename Source_T>
+    static void copyStream(VertexData<T_StreamComponents...>& stream, Source_T const& source) {
+        for (std::size_t i = 0; i < source.size(); ++i) {
+            (copyComponent<T_StreamComponents>(stream, source, i), ...);
+        }
+    }
+};
+
+template<typename... T_Streams>
+template<typename... T_VertexComponents>
+inline VertexStreams<T_Streams...>
+VertexStreams<T_Streams...>::fromInterleaved(VertexData<T_VertexComponents...> const& vertex_data)
+{
+    VertexStreams ret(vertex_data.size());
+    std::apply([&vertex_data](auto&... s) { (copyStream(s, vertex_data), ...); }, ret.m_streams);
+    return ret;
+}
+
+template<VertexFormatBase::ComponentSemantics Semantics, typename... Ts>
+inline constexpr decltype(auto)
+get(VertexStreams<Ts...>& v, std::size_t vertex_index) noexcept {
+    std::size_t constexpr stream_index = *VertexStreams<Ts...>::getStreamIndexForSemantics(Semantics);
+    return get<Semantics>(v.template getStream<stream_index>(), vertex_index);
+}
+
+template<VertexFormatBase::ComponentSemantics Semantics, typename... Ts>
+inline constexpr decltype(auto)
+get(VertexStreams<Ts...> const& v, std::size_t vertex_index) noexcept {
+    std::size_t constexpr stream_index = *VertexStreams<Ts...>::getStreamIndexForSemantics(Semantics);
+    return get<Semantics>(v.template getStream<stream_index>(), vertex_index);
+}
+}
+#endif
@@ -0,0 +1,46 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_BLOCK_DECOMPRESSION_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_BLOCK_DECOMPRESSION_HPP
+
+/** @file
+*
+* @brief CPU decompression of block-compressed image formats.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+/** Uncompressed format that texels of a block-compressed format are decompressed to.
+ * Supports the unsigned normalized BC1, BC2, BC3, BC4, BC5 and BC7 formats. Channels missing from the
+ * compressed format are filled in as the device does when sampling: 0 for color, 1 for alpha.
+ * @return VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB for sRGB formats, or std::nullopt if
+ *         decompression of format is not supported.
+ */
+std::optional<VkFormat> getDecompressedFormat(VkFormat format);
+
+/** Decompress a single 4x4 block.
+ * @param[in] block Compressed block of 8 or 16 bytes, depending on the format.
+ * @param[out] texels 16 RGBA8 texels, row by row.
+ * @pre getDecompressedFormat(format) is not empty.
+ */
+void decompressBlock(VkFormat format, std::byte const* block, std::byte* texels);
+
+/** Decompress a tightly packed image.
+ * Texels of partial blocks outside of the image at the right and bottom edges are dropped.
+ * @param[in] blocks Compressed blocks, row by row.
+ * @param[out] texels width * height tightly packed RGBA8 texels.
+ * @pre getDecompressedFormat(format) is not empty.
+ */
+void decompressImage(VkFormat format, std::byte const* blocks, uint32_t width, uint32_t height, std::byte* texels);
+}
+}
+#endif
@@ -25,6 +25,7 @@ struct ShaderData {
 
 ShaderData draw2dVertex();
 ShaderData draw2dFragment();
+ShaderData downsampleCompute();
 }
 }
 }
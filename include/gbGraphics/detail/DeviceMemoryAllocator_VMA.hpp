@@ -14,12 +14,22 @@
 
 #include <vk_mem_alloc.h>
 
+#include <vector>
+
 namespace GHULBUS_GRAPHICS_NAMESPACE
 {
 using GhulbusVulkan::MemoryUsage;
 namespace detail
 {
 class DeviceMemoryAllocator_VMA : public GhulbusVulkan::DeviceMemoryAllocator {
+public:
+    /** Memory usage of a memory heap.
+     */
+    struct HeapBudget {
+        VkDeviceSize usage;             ///< Bytes allocated from the heap by this process
+        VkDeviceSize budget;            ///< Bytes this process can allocate from the heap without overcommitting
+        VkMemoryHeapFlags flags;
+    };
 private:
     class HandleModel : public DeviceMemoryAllocator::HandleConcept {
     private:
@@ -35,6 +45,7 @@ private:
         VkDeviceMemory getVkDeviceMemory() const override;
         VkDeviceSize getOffset() const override;
         VkDeviceSize getSize() const override;
+        VkMemoryPropertyFlags getMemoryPropertyFlags() const override;
         void* mapMemory(VkDeviceSize offset, VkDeviceSize size) override;
         void unmapMemory(void* mapped_memory) override;
         void flush(VkDeviceSize offset, VkDeviceSize size) override;
@@ -44,8 +55,14 @@ private:
     };
 private:
     VmaAllocator m_allocator;
+    bool m_isDeviceLocalMemoryHostVisible;
 public:
-    DeviceMemoryAllocator_VMA(GhulbusVulkan::Instance& instance, GhulbusVulkan::Device& device);
+    /** Constructor.
+     * @param[in] enable_memory_budget Use VK_EXT_memory_budget for getHeapBudgets().
+     *                                 The extension must have been enabled on the device.
+     */
+    DeviceMemoryAllocator_VMA(GhulbusVulkan::Instance& instance, GhulbusVulkan::Device& device,
+                              bool enable_memory_budget);
 
     ~DeviceMemoryAllocator_VMA() override;
 
@@ -66,6 +83,12 @@ public:
     DeviceMemory allocateMemoryForImage(GhulbusVulkan::Image& image, MemoryUsage usage) override;
     DeviceMemory allocateMemoryForImage(GhulbusVulkan::Image& image,
                                         VkMemoryPropertyFlags required_flags) override;
+
+    /** Usage and budget of all memory heaps, indexed by heap index.
+     * Without VK_EXT_memory_budget, the usage only counts the memory allocated through this allocator and
+     * the budget is estimated from the heap size.
+     */
+    std::vector<HeapBudget> getHeapBudgets() const;
 private:
     static VmaMemoryUsage translateUsage(MemoryUsage usage);
 };
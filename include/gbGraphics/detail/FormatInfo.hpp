@@ -0,0 +1,42 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_FORMAT_INFO_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_FORMAT_INFO_HPP
+
+/** @file
+*
+* @brief Memory layout of image formats.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <optional>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+/** Size of a block of texels of an image format, as laid out in buffer memory by buffer-image copies.
+ * Uncompressed formats have blocks of a single texel.
+ */
+struct TexelBlockInfo {
+    uint32_t size;          ///< Bytes per block
+    uint32_t width;         ///< Texels per block in x direction
+    uint32_t height;        ///< Texels per block in y direction
+};
+
+/** Look up the texel block of one aspect of a format.
+ * The depth and stencil aspects of combined formats are copied separately and have different sizes.
+ * @return Block info or std::nullopt if the format is not supported.
+ */
+std::optional<TexelBlockInfo> getTexelBlockInfo(VkFormat format, VkImageAspectFlags aspect);
+
+/** Number of bytes of a tightly packed region of an image in buffer memory.
+ * @pre The format is supported by getTexelBlockInfo().
+ */
+VkDeviceSize getImageRegionSize(VkFormat format, VkImageAspectFlags aspect, VkExtent3D extent);
+}
+}
+#endif
@@ -0,0 +1,169 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_INDEX_TUPLE_MAP_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_INDEX_TUPLE_MAP_HPP
+
+/** @file
+*
+* @brief Hash table for deduplicating OBJ face index tuples.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+/** Index Tuple type used for face flattening
+ */
+template<typename Index_T>
+struct BasicIndexTuple {
+    using IndexType = Index_T;
+    IndexType vertexIndex;
+    IndexType normalIndex;
+    IndexType textureIndex;
+public:
+    BasicIndexTuple()
+        : vertexIndex(0), normalIndex(0), textureIndex(0)
+    {}
+    BasicIndexTuple(IndexType v, IndexType n, IndexType t)
+        : vertexIndex(v), normalIndex(n), textureIndex(t)
+    {}
+};
+
+template<typename Index_T>
+inline bool operator==(BasicIndexTuple<Index_T> const& lhs, BasicIndexTuple<Index_T> const& rhs) {
+    return ((lhs.vertexIndex == rhs.vertexIndex) &&
+            (lhs.normalIndex == rhs.normalIndex) &&
+            (lhs.textureIndex == rhs.textureIndex));
+}
+
+template<typename Index_T>
+inline bool operator<(BasicIndexTuple<Index_T> const& lhs, BasicIndexTuple<Index_T> const& rhs) {
+    return std::tie(lhs.vertexIndex, lhs.normalIndex, lhs.textureIndex) <
+           std::tie(rhs.vertexIndex, rhs.normalIndex, rhs.textureIndex);
+}
+
+/** Hash for BasicIndexTuple.
+ * All three indices are combined into 64 bits and passed through the MurmurHash3 finalizer,
+ * so that every input bit affects every bit of the hash.
+ */
+template<typename Index_T>
+struct BasicIndexTupleHash
+{
+    inline std::size_t operator()(BasicIndexTuple<Index_T> const& t) const {
+        using UnsignedIndex = std::make_unsigned_t<Index_T>;
+        std::uint64_t constexpr k = 0x9e3779b97f4a7c15ull;
+        std::uint64_t h = static_cast<UnsignedIndex>(t.vertexIndex);
+        h = (h * k) ^ static_cast<UnsignedIndex>(t.normalIndex);
+        h = (h * k) ^ static_cast<UnsignedIndex>(t.textureIndex);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+};
+
+/** Map from BasicIndexTuple to a non-negative index.
+ * Open addressing with linear probing over a single flat array, so lookups touch a single cache line
+ * in the common case and inserts never allocate unless the table has to grow.
+ * @note Only supports insertion. Mapped values must be non-negative.
+ */
+template<typename Index_T>
+class BasicIndexTupleMap {
+public:
+    using IndexType = Index_T;
+    using IndexTuple = BasicIndexTuple<Index_T>;
+    using IndexTupleHash = BasicIndexTupleHash<Index_T>;
+private:
+    struct Slot {
+        IndexTuple key;
+        IndexType value;            ///< Negative for empty slots
+    };
+    std::vector<Slot> m_slots;      ///< Size is zero or a power of two
+    std::size_t m_size;
+public:
+    BasicIndexTupleMap();
+
+    /** Constructor.
+     * @param[in] expected_size Number of elements that can be inserted without the table growing.
+     */
+    explicit BasicIndexTupleMap(std::size_t expected_size);
+
+    /** Grow the table so that expected_size elements can be inserted without further growth.
+     */
+    void reserve(std::size_t expected_size);
+
+    /** Insert a new element if no element with the given key exists.
+     * @param[in] key Key of the new element.
+     * @param[in] value Mapped value for the new element.
+     * @return The mapped value of the element with key and true if it was newly inserted,
+     *         false if it existed before.
+     */
+    std::pair<IndexType, bool> tryEmplace(IndexTuple const& key, IndexType value)
+    {
+        if ((m_size + 1) * 4 > m_slots.size() * 3) { grow(); }
+        std::size_t const mask = m_slots.size() - 1;
+        for (std::size_t i = IndexTupleHash{}(key) & mask; ; i = (i + 1) & mask) {
+            Slot& slot = m_slots[i];
+            if (slot.value < 0) {
+                slot.key = key;
+                slot.value = value;
+                ++m_size;
+                return std::make_pair(value, true);
+            } else if (slot.key == key) {
+                return std::make_pair(slot.value, false);
+            }
+        }
+    }
+
+    /** Find the mapped value for a key.
+     * @return The mapped value, or -1 if no element with key exists.
+     */
+    IndexType find(IndexTuple const& key) const
+    {
+        if (m_size == 0) { return -1; }
+        std::size_t const mask = m_slots.size() - 1;
+        for (std::size_t i = IndexTupleHash{}(key) & mask; ; i = (i + 1) & mask) {
+            Slot const& slot = m_slots[i];
+            if (slot.value < 0) {
+                return -1;
+            } else if (slot.key == key) {
+                return slot.value;
+            }
+        }
+    }
+
+    std::size_t size() const;
+
+    bool empty() const;
+
+    void clear();
+
+private:
+    void rehash(std::size_t n_slots);
+    void grow();
+};
+
+extern template class BasicIndexTupleMap<std::int32_t>;
+extern template class BasicIndexTupleMap<std::int64_t>;
+
+using IndexTuple = BasicIndexTuple<std::int32_t>;
+using IndexTupleHash = BasicIndexTupleHash<std::int32_t>;
+using IndexTupleMap = BasicIndexTupleMap<std::int32_t>;
+
+/** Index tuples for files exceeding the 32-bit index range.
+ */
+using IndexTuple64 = BasicIndexTuple<std::int64_t>;
+using IndexTupleMap64 = BasicIndexTupleMap<std::int64_t>;
+}
+}
+#endif
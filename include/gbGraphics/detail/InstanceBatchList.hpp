@@ -0,0 +1,148 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_INSTANCE_BATCH_LIST_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_INSTANCE_BATCH_LIST_HPP
+
+/** @file
+*
+* @brief Grouping of per-instance data into batches of instanced draws.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+/** Groups instances by pipeline and mesh.
+ * This is the host-side bookkeeping of InstanceBatcher; the mesh type is a template parameter,
+ * so that it can be used without a device.
+ * @tparam Mesh_T Type providing getDrawRanges(), returning a range of elements with members
+ *                firstIndex, indexCount and vertexOffset.
+ */
+template<typename Mesh_T>
+class InstanceBatchList {
+public:
+    /** All instances of one mesh drawn with one pipeline.
+     */
+    struct Batch {
+        uint32_t pipelineIndex;         ///< Index of the pipeline in the Renderer
+        Mesh_T* mesh;                   ///< Mesh that is drawn
+        uint32_t firstInstance;         ///< Index of the first instance in the instance data;
+                                        ///  valid after writeInstanceData()
+        uint32_t instanceCount;         ///< Number of instances
+    };
+private:
+    std::size_t m_instanceStride;
+    uint32_t m_numberOfInstances;
+    std::vector<Batch> m_batches;                                   ///< in order of their first instance
+    std::vector<std::vector<std::byte>> m_batchInstanceData;        ///< one vector per batch
+    std::map<std::pair<uint32_t, Mesh_T*>, std::size_t> m_batchLookup;
+public:
+    /** Constructor.
+     * @param[in] instance_stride Size of the per-instance data of a single instance in bytes.
+     */
+    explicit InstanceBatchList(std::size_t instance_stride)
+        :m_instanceStride(instance_stride), m_numberOfInstances(0)
+    {}
+
+    std::size_t getInstanceStride() const
+    {
+        return m_instanceStride;
+    }
+
+    uint32_t getNumberOfInstances() const
+    {
+        return m_numberOfInstances;
+    }
+
+    /** Add an instance of mesh drawn with pipeline_index.
+     * A new batch is started on the first instance of each combination of pipeline and mesh.
+     * @param[in] instance_data Per-instance data of the draw; getInstanceStride() bytes.
+     */
+    void addInstance(uint32_t pipeline_index, Mesh_T& mesh, std::byte const* instance_data)
+    {
+        auto const [it, is_new_batch] =
+            m_batchLookup.try_emplace(std::make_pair(pipeline_index, &mesh), m_batches.size());
+        if (is_new_batch) {
+            m_batches.push_back(Batch{ pipeline_index, &mesh, 0, 0 });
+            m_batchInstanceData.emplace_back();
+        }
+        std::size_t const batch_index = it->second;
+        std::vector<std::byte>& batch_data = m_batchInstanceData[batch_index];
+        batch_data.insert(batch_data.end(), instance_data, instance_data + m_instanceStride);
+        ++m_batches[batch_index].instanceCount;
+        ++m_numberOfInstances;
+    }
+
+    /** Remove all batches.
+     */
+    void clear()
+    {
+        m_batches.clear();
+        m_batchInstanceData.clear();
+        m_batchLookup.clear();
+        m_numberOfInstances = 0;
+    }
+
+    /** Assign the firstInstance of all batches and write their instance data.
+     * The instances of each batch are stored contiguously, with the batches in order of getBatches().
+     * @param[out] destination Receives getNumberOfInstances() * getInstanceStride() bytes.
+     */
+    void writeInstanceData(std::byte* destination)
+    {
+        uint32_t first_instance = 0;
+        for (std::size_t i = 0; i < m_batches.size(); ++i) {
+            Batch& batch = m_batches[i];
+            batch.firstInstance = first_instance;
+            std::memcpy(destination + (first_instance * m_instanceStride),
+                        m_batchInstanceData[i].data(), m_batchInstanceData[i].size());
+            first_instance += batch.instanceCount;
+        }
+        GHULBUS_ASSERT(first_instance == m_numberOfInstances);
+    }
+
+    std::span<Batch const> getBatches() const
+    {
+        return m_batches;
+    }
+
+    /** Number of instanced draws for all pipelines.
+     * One for each draw range of each batch's mesh.
+     */
+    uint32_t getNumberOfDrawCalls() const
+    {
+        uint32_t ret = 0;
+        for (Batch const& batch : m_batches) {
+            ret += static_cast<uint32_t>(std::size(batch.mesh->getDrawRanges()));
+        }
+        return ret;
+    }
+
+    /** Invoke f(batch, draw_range) for each instanced draw of a pipeline.
+     * Batches are visited in order of getBatches(), the draw ranges of each batch in order of its mesh.
+     */
+    template<typename F>
+    void forEachDraw(uint32_t pipeline_index, F&& f) const
+    {
+        for (Batch const& batch : m_batches) {
+            if (batch.pipelineIndex != pipeline_index) { continue; }
+            for (auto const& range : batch.mesh->getDrawRanges()) {
+                f(batch, range);
+            }
+        }
+    }
+};
+}
+}
+#endif
@@ -0,0 +1,48 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_MAPPED_FILE_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_MAPPED_FILE_HPP
+
+/** @file
+*
+* @brief Read-only memory-mapped file.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <cstddef>
+#include <span>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+/** Maps the complete contents of a file read-only into the address space of the process.
+ * The pages are populated lazily by the operating system, so mapping a file does not copy its contents.
+ * @note Mapped data is not null-terminated.
+ */
+class MappedFile {
+private:
+    char const* m_data;
+    std::size_t m_size;
+public:
+    /** Map a file.
+     * @param[in] filename Full path to the file.
+     * @throw Exceptions::IOError If the file cannot be opened or mapped, or if it is empty.
+     */
+    explicit MappedFile(char const* filename);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    MappedFile(MappedFile&& rhs) noexcept;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    char const* getData() const;
+    std::size_t getSize() const;
+    std::span<char const> getSpan() const;
+};
+}
+}
+#endif
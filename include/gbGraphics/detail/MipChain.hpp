@@ -0,0 +1,46 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_MIP_CHAIN_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_MIP_CHAIN_HPP
+
+/** @file
+*
+* @brief Mip level sizes and the selection of the mip generation method.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <optional>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+enum class MipmapMethod {
+    Blit,           ///< Chain of linear filtered vkCmdBlitImage
+    Compute         ///< Compute shader averaging 2x2 texels
+};
+
+/** Number of mip levels down to 1x1 for an image of the given size.
+ */
+uint32_t getFullMipChainLength(uint32_t width, uint32_t height);
+
+/** Size of a mip level of a 2d image.
+ * Each level halves the size of the previous one, rounding down, but is at least one texel wide and high.
+ */
+VkExtent2D getMipLevelExtent(uint32_t width, uint32_t height, uint32_t level);
+
+/** Method for generating the mip levels of images of a format.
+ * Blits are preferred; the compute shader is the fallback for formats that can be used as storage images.
+ * @param[in] optimal_tiling_features Features of the format for images with optimal tiling.
+ * @param[in] storage_write_without_format Whether the shaderStorageImageWriteWithoutFormat device feature
+ *                                         is enabled.
+ * @return std::nullopt if mip levels cannot be generated for the format.
+ */
+std::optional<MipmapMethod> selectMipmapMethod(VkFormatFeatureFlags optimal_tiling_features,
+                                               bool storage_write_without_format);
+}
+}
+#endif
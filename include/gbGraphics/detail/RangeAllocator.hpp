@@ -0,0 +1,64 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_RANGE_ALLOCATOR_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_RANGE_ALLOCATOR_HPP
+
+/** @file
+*
+* @brief Free-list allocator for ranges of a linear address space.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+/** Hands out ranges of [0, capacity) from a free list.
+ * Allocation picks the smallest free range that fits (best fit). Freed ranges are merged
+ * with adjacent free ranges, so the free list never contains two neighbouring ranges.
+ * The allocator only manages offsets; it does not own any memory.
+ */
+class RangeAllocator {
+private:
+    uint64_t m_capacity;
+    uint64_t m_freeSize;
+    std::map<uint64_t, uint64_t> m_freeByOffset;            ///< offset -> size
+    std::multimap<uint64_t, uint64_t> m_freeBySize;         ///< size -> offset
+public:
+    explicit RangeAllocator(uint64_t capacity);
+
+    /** Allocate a range.
+     * @return Offset of the range or std::nullopt if there is no free range of at least size elements.
+     * @pre size > 0
+     */
+    std::optional<uint64_t> allocate(uint64_t size);
+
+    /** Return a range to the free list.
+     * @pre [offset, offset + size) was allocated and has not been freed since.
+     */
+    void free(uint64_t offset, uint64_t size);
+
+    /** Free all ranges.
+     */
+    void reset();
+
+    uint64_t getCapacity() const;
+    uint64_t getFreeSize() const;
+    uint64_t getLargestFreeRange() const;
+    uint64_t getNumberOfFreeRanges() const;
+
+    /** Ratio of free space that is not part of the largest free range.
+     * 0 if all free space is contiguous, approaching 1 for heavily fragmented free space.
+     */
+    float getFragmentation() const;
+private:
+    void insertFreeRange(uint64_t offset, uint64_t size);
+    void eraseFreeRange(std::map<uint64_t, uint64_t>::iterator it);
+};
+}
+}
+#endif
@@ -0,0 +1,89 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_RESIDENCY_TRACKER_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_GRAPHICS_DETAIL_RESIDENCY_TRACKER_HPP
+
+/** @file
+*
+* @brief Bookkeeping of resident resources for least-recently-used eviction.
+* @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+*/
+
+#include <gbGraphics/config.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+/** Tracks the size and the frame of last use of resources that can be evicted from device memory.
+ * The tracker only does the bookkeeping; evicting and restoring the resources is up to the user.
+ */
+class ResidencyTracker {
+public:
+    using ResourceId = uint32_t;
+private:
+    struct Entry {
+        uint64_t size;                  ///< Size in device memory while resident
+        uint64_t lastUseFrame;
+        bool isResident;
+        bool isLive;
+    };
+    std::vector<Entry> m_entries;
+    std::vector<ResourceId> m_freeIds;
+    uint64_t m_currentFrame;
+    uint64_t m_residentSize;
+public:
+    ResidencyTracker();
+
+    /** Start tracking a resource.
+     * New resources are not resident.
+     */
+    ResourceId add();
+
+    /** Stop tracking a resource.
+     */
+    void remove(ResourceId id);
+
+    /** Mark a resource as used in the current frame.
+     */
+    void markUsed(ResourceId id);
+
+    /** Mark a resource as resident.
+     * @param[in] size Size of the resource in device memory.
+     * @pre The resource is not resident.
+     */
+    void setResident(ResourceId id, uint64_t size);
+
+    /** Mark a resource as evicted.
+     * @pre The resource is resident.
+     */
+    void setEvicted(ResourceId id);
+
+    bool isResident(ResourceId id) const;
+    uint64_t getLastUseFrame(ResourceId id) const;
+
+    /** Combined size of all resident resources.
+     */
+    uint64_t getResidentSize() const;
+
+    uint64_t getCurrentFrame() const;
+
+    /** Advance the current frame.
+     */
+    void nextFrame();
+
+    /** Select resident resources whose eviction brings the resident size down to budget.
+     * Resources that were used in one of the last frames_in_flight frames, including the current one,
+     * may still be in use by the device and are never selected. The remaining resources are selected
+     * least recently used first.
+     * @return Resources to evict. If the budget cannot be met, all resources that may be evicted.
+     */
+    std::vector<ResourceId> selectEvictions(uint64_t budget, uint32_t frames_in_flight) const;
+private:
+    Entry& getEntry(ResourceId id);
+    Entry const& getEntry(ResourceId id) const;
+};
+}
+}
+#endif
@@ -31,6 +31,8 @@ public:
 
     void addSampler(uint32_t binding, VkShaderStageFlags flags);
 
+    void addStorageImage(uint32_t binding, VkShaderStageFlags flags);
+
     DescriptorSetLayout create();
 };
 }
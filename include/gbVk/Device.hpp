@@ -119,6 +119,9 @@ public:
 
     PipelineBuilder createGraphicsPipelineBuilder(uint32_t viewport_width, uint32_t viewport_height);
 
+    Pipeline createComputePipeline(PipelineLayout& layout, ShaderModule& shader_module,
+                                   char const* entry_point = "main");
+
     void waitIdle();
 };
 }
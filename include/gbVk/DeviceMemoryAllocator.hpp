@@ -28,6 +28,7 @@ protected:
         virtual VkDeviceMemory getVkDeviceMemory() const = 0;
         virtual VkDeviceSize getOffset() const = 0;
         virtual VkDeviceSize getSize() const = 0;
+        virtual VkMemoryPropertyFlags getMemoryPropertyFlags() const = 0;
         virtual void* mapMemory(VkDeviceSize offset, VkDeviceSize size) = 0;
         virtual void unmapMemory(void* mapped_memory) = 0;
         virtual void flush(VkDeviceSize offset, VkDeviceSize size) = 0;
@@ -86,6 +87,7 @@ public:
     VkDeviceMemory getVkDeviceMemory() const;
     VkDeviceSize getOffset() const;
     VkDeviceSize getSize() const;
+    VkMemoryPropertyFlags getMemoryPropertyFlags() const;
 
     MappedMemory map();
     MappedMemory map(VkDeviceSize offset, VkDeviceSize size);
@@ -114,6 +116,16 @@ public:
 
     void flush();
     void invalidate();
+
+    /** Flush a range of non-coherent memory.
+     * @param[in] offset Offset in bytes from the start of the memory, not from the start of the mapped range.
+     */
+    void flush(VkDeviceSize offset, VkDeviceSize size);
+
+    /** Invalidate a range of non-coherent memory.
+     * @param[in] offset Offset in bytes from the start of the memory, not from the start of the mapped range.
+     */
+    void invalidate(VkDeviceSize offset, VkDeviceSize size);
 };
 
 }
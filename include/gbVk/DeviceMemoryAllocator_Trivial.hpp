@@ -23,22 +23,29 @@ private:
         VkDeviceMemory m_memory;
         VkDevice m_device;
         VkDeviceSize m_size;
+        VkMemoryPropertyFlags m_propertyFlags;
+        VkDeviceSize m_nonCoherentAtomSize;
     public:
-        HandleModel(VkDevice device, VkDeviceMemory memory, VkDeviceSize size);
+        HandleModel(VkDevice device, VkDeviceMemory memory, VkDeviceSize size, VkMemoryPropertyFlags property_flags,
+                    VkDeviceSize non_coherent_atom_size);
         ~HandleModel() override;
         VkDeviceMemory getVkDeviceMemory() const override;
         VkDeviceSize getOffset() const override;
         VkDeviceSize getSize() const override;
+        VkMemoryPropertyFlags getMemoryPropertyFlags() const override;
         void* mapMemory(VkDeviceSize offset, VkDeviceSize size) override;
         void unmapMemory(void* mapped_memory) override;
         void flush(VkDeviceSize offset, VkDeviceSize size) override;
         void invalidate(VkDeviceSize offset, VkDeviceSize size) override;
         void bindBuffer(VkBuffer buffer) override;
         void bindImage(VkImage image) override;
+    private:
+        VkMappedMemoryRange getAlignedRange(VkDeviceSize offset, VkDeviceSize size) const;
     };
 private:
     VkDevice m_device;
     VkPhysicalDevice m_physicalDevice;
+    VkDeviceSize m_nonCoherentAtomSize;
 public:
     DeviceMemoryAllocator_Trivial(VkDevice logical_device, VkPhysicalDevice physical_device);
 
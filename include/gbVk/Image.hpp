@@ -79,8 +79,11 @@ public:
     ImageView createImageViewDepthBuffer();
     ImageView createImageView2D(VkImageAspectFlags aspect_flags);
     ImageView createImageView(VkImageViewType view_type, VkImageAspectFlags aspect_flags);
+    ImageView createImageView(VkImageViewType view_type, VkImageSubresourceRange const& subresource_range);
 
     static void copy(CommandBuffer& command_buffer, Buffer& source_buffer, Image& destination_image);
+    static void copy(CommandBuffer& command_buffer, Buffer& source_buffer, VkDeviceSize source_offset,
+                     Image& destination_image);
     static void copy(CommandBuffer& command_buffer, Image& source_image, Image& destination_image);
     static void blit(CommandBuffer& command_buffer, Image& source_image, Image& destination_image);
 };
@@ -13,6 +13,12 @@ namespace GHULBUS_VULKAN_NAMESPACE
 {
 enum class MemoryUsage {
     GpuOnly,
+    /** Device-local memory that is written directly through a mapping, without a staging copy.
+     * Only used if the device's main memory is host visible, as on devices with unified memory and
+     * discrete devices with resizable BAR. Behaves like GpuOnly otherwise.
+     * @see PhysicalDevice::isDeviceLocalMemoryHostVisible()
+     */
+    GpuOnlyDirectUpload,
     CpuOnly,
     CpuToGpu,
     GpuToCpu
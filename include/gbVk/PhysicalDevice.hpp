@@ -37,6 +37,12 @@ public:
 
     VkPhysicalDeviceMemoryProperties getMemoryProperties();
 
+    /** Checks whether the host can map the largest device-local memory heap.
+     * This is the case on devices with unified memory and on discrete devices with resizable BAR.
+     * The small host-visible window into device memory that discrete devices expose otherwise does not count.
+     */
+    bool isDeviceLocalMemoryHostVisible();
+
     std::vector<VkQueueFamilyProperties> getQueueFamilyProperties();
 
     VkFormatProperties getFormatProperties(VkFormat format);
@@ -63,6 +69,8 @@ public:
 
     std::vector<VkExtensionProperties> enumerateDeviceExtensionProperties(VkLayerProperties layer);
 
+    bool isDeviceExtensionSupported(char const* extension_name);
+
     DeviceBuilder createDeviceBuilder(NoSwapchainSupport_T const&);
 
     DeviceBuilder createDeviceBuilder();
@@ -37,6 +37,8 @@ public:
 
     void submit(CommandBuffers& command_buffers, Fence& fence);
 
+    void submit(SubmitStaging const& staging, Fence& fence);
+
     void stageSubmission(SubmitStaging staging);
 
     void submitAllStaged();
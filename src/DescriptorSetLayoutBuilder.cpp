@@ -34,6 +34,17 @@ void DescriptorSetLayoutBuilder::addSampler(uint32_t binding, VkShaderStageFlags
     sampler_layout_binding.pImmutableSamplers = nullptr;
 }
 
+void DescriptorSetLayoutBuilder::addStorageImage(uint32_t binding, VkShaderStageFlags flags)
+{
+    bindings.emplace_back();
+    VkDescriptorSetLayoutBinding& image_layout_binding = bindings.back();
+    image_layout_binding.binding = binding;
+    image_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    image_layout_binding.descriptorCount = 1;
+    image_layout_binding.stageFlags = flags;
+    image_layout_binding.pImmutableSamplers = nullptr;
+}
+
 DescriptorSetLayout DescriptorSetLayoutBuilder::create()
 {
     VkDescriptorSetLayoutCreateInfo create_info;
@@ -13,7 +13,9 @@
 #include <gbVk/Image.hpp>
 #include <gbVk/ImageView.hpp>
 #include <gbVk/PhysicalDevice.hpp>
+#include <gbVk/Pipeline.hpp>
 #include <gbVk/PipelineBuilder.hpp>
+#include <gbVk/PipelineLayout.hpp>
 #include <gbVk/PipelineLayoutBuilder.hpp>
 #include <gbVk/Queue.hpp>
 #include <gbVk/RenderPass.hpp>
@@ -268,7 +270,7 @@ inline Sampler Device::createSampler(VkFilter min_mag_filter, VkSamplerAddressMo
 {
     return createSampler(min_mag_filter, min_mag_filter, VK_SAMPLER_MIPMAP_MODE_LINEAR,
                          address_mode, address_mode, address_mode,
-                         0.f, max_anisotropy, 0.f, 0.f, VK_BORDER_COLOR_INT_OPAQUE_BLACK);
+                         0.f, max_anisotropy, 0.f, VK_LOD_CLAMP_NONE, VK_BORDER_COLOR_INT_OPAQUE_BLACK);
 }
 
 inline Sampler Device::createSampler(VkFilter min_filter, VkFilter mag_filter, VkSamplerMipmapMode mipmap_mode,
@@ -428,6 +430,28 @@ PipelineBuilder Device::createGraphicsPipelineBuilder(uint32_t viewport_width, u
     return PipelineBuilder(m_device, viewport_width, viewport_height);
 }
 
+Pipeline Device::createComputePipeline(PipelineLayout& layout, ShaderModule& shader_module, char const* entry_point)
+{
+    VkComputePipelineCreateInfo create_info;
+    create_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    create_info.pNext = nullptr;
+    create_info.flags = 0;
+    create_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    create_info.stage.pNext = nullptr;
+    create_info.stage.flags = 0;
+    create_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    create_info.stage.module = shader_module.getVkShaderModule();
+    create_info.stage.pName = entry_point;
+    create_info.stage.pSpecializationInfo = nullptr;
+    create_info.layout = layout.getVkPipelineLayout();
+    create_info.basePipelineHandle = VK_NULL_HANDLE;
+    create_info.basePipelineIndex = -1;
+    VkPipeline pipeline;
+    VkResult res = vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &create_info, nullptr, &pipeline);
+    checkVulkanError(res, "Error in vkCreateComputePipelines.");
+    return Pipeline(m_device, pipeline);
+}
+
 void Device::waitIdle()
 {
     VkResult res = vkDeviceWaitIdle(m_device);
@@ -40,6 +40,11 @@ VkDeviceSize DeviceMemory::getSize() const
     return m_handle->getSize();
 }
 
+VkMemoryPropertyFlags DeviceMemory::getMemoryPropertyFlags() const
+{
+    return m_handle->getMemoryPropertyFlags();
+}
+
 auto DeviceMemory::map() -> MappedMemory
 {
     return map(0, VK_WHOLE_SIZE);
@@ -113,4 +118,14 @@ void MappedMemory::invalidate()
 {
     m_handle->invalidate(0, VK_WHOLE_SIZE);
 }
+
+void MappedMemory::flush(VkDeviceSize offset, VkDeviceSize size)
+{
+    m_handle->flush(offset, size);
+}
+
+void MappedMemory::invalidate(VkDeviceSize offset, VkDeviceSize size)
+{
+    m_handle->invalidate(offset, size);
+}
 }
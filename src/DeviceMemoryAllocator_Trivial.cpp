@@ -9,8 +9,11 @@
 
 namespace GHULBUS_VULKAN_NAMESPACE
 {
-DeviceMemoryAllocator_Trivial::HandleModel::HandleModel(VkDevice device, VkDeviceMemory memory, VkDeviceSize size)
-    :m_memory(memory), m_device(device), m_size(size)
+DeviceMemoryAllocator_Trivial::HandleModel::HandleModel(VkDevice device, VkDeviceMemory memory, VkDeviceSize size,
+                                                    VkMemoryPropertyFlags property_flags,
+                                                    VkDeviceSize non_coherent_atom_size)
+    :m_memory(memory), m_device(device), m_size(size), m_propertyFlags(property_flags),
+     m_nonCoherentAtomSize(non_coherent_atom_size)
 {}
 
 DeviceMemoryAllocator_Trivial::HandleModel::~HandleModel()
@@ -35,6 +38,11 @@ VkDeviceSize DeviceMemoryAllocator_Trivial::HandleModel::getSize() const
     return m_size;
 }
 
+VkMemoryPropertyFlags DeviceMemoryAllocator_Trivial::HandleModel::getMemoryPropertyFlags() const
+{
+    return m_propertyFlags;
+}
+
 void* DeviceMemoryAllocator_Trivial::HandleModel::mapMemory(VkDeviceSize offset, VkDeviceSize size)
 {
     void* ret;
@@ -51,24 +59,14 @@ void DeviceMemoryAllocator_Trivial::HandleModel::unmapMemory(void* mapped_memory
 
 void DeviceMemoryAllocator_Trivial::HandleModel::flush(VkDeviceSize offset, VkDeviceSize size)
 {
-    VkMappedMemoryRange range;
-    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-    range.pNext = nullptr;
-    range.memory = m_memory;
-    range.offset = offset;
-    range.size = size;
+    VkMappedMemoryRange const range = getAlignedRange(offset, size);
     VkResult res = vkFlushMappedMemoryRanges(m_device, 1, &range);
     checkVulkanError(res, "Error in vkFlushMappedMemoryRanges.");
 }
 
 void DeviceMemoryAllocator_Trivial::HandleModel::invalidate(VkDeviceSize offset, VkDeviceSize size)
 {
-    VkMappedMemoryRange range;
-    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-    range.pNext = nullptr;
-    range.memory = m_memory;
-    range.offset = offset;
-    range.size = size;
+    VkMappedMemoryRange const range = getAlignedRange(offset, size);
     VkResult res = vkInvalidateMappedMemoryRanges(m_device, 1, &range);
     checkVulkanError(res, "Error in vkInvalidateMappedMemoryRanges.");
 }
@@ -85,14 +83,34 @@ void DeviceMemoryAllocator_Trivial::HandleModel::bindImage(VkImage image)
     checkVulkanError(res, "Error in vkBindImageMemory.");
 }
 
+VkMappedMemoryRange DeviceMemoryAllocator_Trivial::HandleModel::getAlignedRange(VkDeviceSize offset,
+                                                                                VkDeviceSize size) const
+{
+    // flushed ranges have to start and end on a multiple of nonCoherentAtomSize, unless they end at the
+    // end of the memory. the atom size is a power of two.
+    VkMappedMemoryRange range;
+    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.pNext = nullptr;
+    range.memory = m_memory;
+    range.offset = offset & ~(m_nonCoherentAtomSize - 1);
+    if (size == VK_WHOLE_SIZE) {
+        range.size = VK_WHOLE_SIZE;
+    } else {
+        VkDeviceSize const end = (offset + size + m_nonCoherentAtomSize - 1) & ~(m_nonCoherentAtomSize - 1);
+        range.size = (end < m_size) ? (end - range.offset) : VK_WHOLE_SIZE;
+    }
+    return range;
+}
+
 DeviceMemoryAllocator_Trivial::DeviceMemoryAllocator_Trivial(VkDevice logical_device, VkPhysicalDevice physical_device)
-    : m_device(logical_device), m_physicalDevice(physical_device)
+    : m_device(logical_device), m_physicalDevice(physical_device),
+      m_nonCoherentAtomSize(PhysicalDevice(physical_device).getProperties().limits.nonCoherentAtomSize)
 {}
 
 DeviceMemoryAllocator_Trivial::~DeviceMemoryAllocator_Trivial() = default;
 
 DeviceMemoryAllocator_Trivial::DeviceMemoryAllocator_Trivial(DeviceMemoryAllocator_Trivial&& rhs)
-    :m_device(rhs.m_device), m_physicalDevice(rhs.m_physicalDevice)
+    :m_device(rhs.m_device), m_physicalDevice(rhs.m_physicalDevice), m_nonCoherentAtomSize(rhs.m_nonCoherentAtomSize)
 {
     rhs.m_device = nullptr;
     rhs.m_physicalDevice = nullptr;
@@ -100,7 +118,8 @@ DeviceMemoryAllocator_Trivial::DeviceMemoryAllocator_Trivial(DeviceMemoryAllocat
 
 auto DeviceMemoryAllocator_Trivial::allocateMemory(size_t requested_size, VkMemoryPropertyFlags flags) -> DeviceMemory
 {
-    auto const memory_type_index = PhysicalDevice(m_physicalDevice).findMemoryTypeIndex(flags);
+    PhysicalDevice physical_device(m_physicalDevice);
+    auto const memory_type_index = physical_device.findMemoryTypeIndex(flags);
     if(!memory_type_index) {
         GHULBUS_THROW(Exceptions::ProtocolViolation(), "No matching memory type available.");
     }
@@ -113,13 +132,17 @@ auto DeviceMemoryAllocator_Trivial::allocateMemory(size_t requested_size, VkMemo
     VkDeviceMemory mem;
     VkResult res = vkAllocateMemory(m_device, &alloc_info, nullptr, &mem);
     checkVulkanError(res, "Error in vkAllocateMemory.");
-    return DeviceMemory(std::make_unique<HandleModel>(m_device, mem, requested_size));
+    VkMemoryPropertyFlags const property_flags =
+        physical_device.getMemoryProperties().memoryTypes[*memory_type_index].propertyFlags;
+    return DeviceMemory(std::make_unique<HandleModel>(m_device, mem, requested_size, property_flags,
+                                                      m_nonCoherentAtomSize));
 }
 
 auto DeviceMemoryAllocator_Trivial::allocateMemory(VkMemoryRequirements const& requirements,
                                                    VkMemoryPropertyFlags required_flags) -> DeviceMemory
 {
-    auto const memory_type_index = PhysicalDevice(m_physicalDevice).findMemoryTypeIndex(required_flags, requirements);
+    PhysicalDevice physical_device(m_physicalDevice);
+    auto const memory_type_index = physical_device.findMemoryTypeIndex(required_flags, requirements);
     if(!memory_type_index) {
         GHULBUS_THROW(Exceptions::ProtocolViolation(), "No matching memory type available.");
     }
@@ -132,7 +155,10 @@ auto DeviceMemoryAllocator_Trivial::allocateMemory(VkMemoryRequirements const& r
     VkDeviceMemory mem;
     VkResult res = vkAllocateMemory(m_device, &alloc_info, nullptr, &mem);
     checkVulkanError(res, "Error in vkAllocateMemory.");
-    return DeviceMemory(std::make_unique<HandleModel>(m_device, mem, requirements.size));
+    VkMemoryPropertyFlags const property_flags =
+        physical_device.getMemoryProperties().memoryTypes[*memory_type_index].propertyFlags;
+    return DeviceMemory(std::make_unique<HandleModel>(m_device, mem, requirements.size, property_flags,
+                                                      m_nonCoherentAtomSize));
 }
 
 auto DeviceMemoryAllocator_Trivial::allocateMemoryForBuffer(Buffer& buffer, MemoryUsage usage) -> DeviceMemory
@@ -166,6 +192,7 @@ VkMemoryPropertyFlags DeviceMemoryAllocator_Trivial::translateUsage(MemoryUsage
     switch (usage)
     {
     case MemoryUsage::GpuOnly: return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    case MemoryUsage::GpuOnlyDirectUpload: return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
     case MemoryUsage::CpuOnly: return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
     case MemoryUsage::CpuToGpu: return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
     case MemoryUsage::GpuToCpu: return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
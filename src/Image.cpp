@@ -223,6 +223,17 @@ ImageView Image::createImageView2D(VkImageAspectFlags aspect_flags)
 }
 
 ImageView Image::createImageView(VkImageViewType view_type, VkImageAspectFlags aspect_flags)
+{
+    VkImageSubresourceRange range;
+    range.aspectMask = aspect_flags;
+    range.baseMipLevel = 0;
+    range.levelCount = 1;
+    range.baseArrayLayer = 0;
+    range.layerCount = 1;
+    return createImageView(view_type, range);
+}
+
+ImageView Image::createImageView(VkImageViewType view_type, VkImageSubresourceRange const& subresource_range)
 {
     VkImageViewCreateInfo image_view_ci;
     image_view_ci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -235,11 +246,7 @@ ImageView Image::createImageView(VkImageViewType view_type, VkImageAspectFlags a
     image_view_ci.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
     image_view_ci.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
     image_view_ci.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-    image_view_ci.subresourceRange.aspectMask = aspect_flags;
-    image_view_ci.subresourceRange.baseMipLevel = 0;
-    image_view_ci.subresourceRange.levelCount = 1;
-    image_view_ci.subresourceRange.baseArrayLayer = 0;
-    image_view_ci.subresourceRange.layerCount = 1;
+    image_view_ci.subresourceRange = subresource_range;
     VkImageView image_view;
     VkResult res = vkCreateImageView(m_device, &image_view_ci, nullptr, &image_view);
     checkVulkanError(res, "Error in vkCreateImageView.");
@@ -247,11 +254,17 @@ ImageView Image::createImageView(VkImageViewType view_type, VkImageAspectFlags a
 }
 
 void Image::copy(CommandBuffer& command_buffer, Buffer& source_buffer, Image& destination_image)
+{
+    copy(command_buffer, source_buffer, 0, destination_image);
+}
+
+void Image::copy(CommandBuffer& command_buffer, Buffer& source_buffer, VkDeviceSize source_offset,
+                 Image& destination_image)
 {
     GHULBUS_PRECONDITION(command_buffer.getCurrentState() == CommandBuffer::State::Recording);
 
     VkBufferImageCopy region;
-    region.bufferOffset = 0;
+    region.bufferOffset = source_offset;
     region.bufferRowLength = 0;
     region.bufferImageHeight = 0;
     region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
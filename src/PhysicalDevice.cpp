@@ -6,6 +6,9 @@
 
 #include <gbBase/Assert.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 namespace GHULBUS_VULKAN_NAMESPACE
 {
 
@@ -40,6 +43,32 @@ VkPhysicalDeviceMemoryProperties PhysicalDevice::getMemoryProperties()
     return mem_props;
 }
 
+bool PhysicalDevice::isDeviceLocalMemoryHostVisible()
+{
+    auto const mem_props = getMemoryProperties();
+    std::optional<uint32_t> largest_heap;
+    for (uint32_t i = 0; i < mem_props.memoryHeapCount; ++i) {
+        VkMemoryHeap const& heap = mem_props.memoryHeaps[i];
+        if (((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0) &&
+            ((!largest_heap) || (heap.size > mem_props.memoryHeaps[*largest_heap].size)))
+        {
+            largest_heap = i;
+        }
+    }
+    if (!largest_heap) { return false; }
+    VkMemoryPropertyFlags const requested_properties =
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    for (uint32_t i = 0; i < mem_props.memoryTypeCount; ++i) {
+        VkMemoryType const& type = mem_props.memoryTypes[i];
+        if ((type.heapIndex == *largest_heap) &&
+            ((type.propertyFlags & requested_properties) == requested_properties))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::vector<VkQueueFamilyProperties> PhysicalDevice::getQueueFamilyProperties()
 {
     uint32_t queue_family_count = 0;
@@ -164,6 +193,15 @@ std::vector<VkExtensionProperties> PhysicalDevice::enumerateDeviceExtensionPrope
     return enumerateDeviceExtensionProperties_impl(m_physicalDevice, layer.layerName);
 }
 
+bool PhysicalDevice::isDeviceExtensionSupported(char const* extension_name)
+{
+    auto const extensions = enumerateDeviceExtensionProperties();
+    return std::any_of(extensions.begin(), extensions.end(),
+                       [extension_name](VkExtensionProperties const& ext) {
+                           return std::strcmp(ext.extensionName, extension_name) == 0;
+                       });
+}
+
 namespace {
 std::optional<uint32_t> determineDefaultQueueFamily(PhysicalDevice& pd)
 {
@@ -50,6 +50,13 @@ void Queue::submit(CommandBuffers& command_buffers, Fence& fence)
     queue_submit(m_queue, command_buffers.getVkCommandBuffers(), command_buffers.size(), fence.getVkFence());
 }
 
+void Queue::submit(SubmitStaging const& staging, Fence& fence)
+{
+    VkSubmitInfo2 const submit_info = staging.getVkSubmitInfo();
+    VkResult const res = vkQueueSubmit2(m_queue, 1, &submit_info, fence.getVkFence());
+    checkVulkanError(res, "Error in vkQueueSubmit.");
+}
+
 void Queue::stageSubmission(SubmitStaging staging)
 {
     m_staged.emplace_back(std::move(staging));
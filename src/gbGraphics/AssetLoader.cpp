@@ -0,0 +1,150 @@
+#include <gbGraphics/AssetLoader.hpp>
+
+#include <gbGraphics/GraphicsInstance.hpp>
+
+#include <gbVk/Device.hpp>
+#include <gbVk/Queue.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <chrono>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+AssetLoader::AssetLoader(GraphicsInstance& instance, uint32_t number_of_threads)
+    :m_instance(&instance), m_completedUploads(number_of_threads), m_numberOfPendingLoads(0), m_isStopping(false)
+{
+    GHULBUS_PRECONDITION(number_of_threads > 0);
+    m_workers.reserve(number_of_threads);
+    for (std::size_t i = 0; i < number_of_threads; ++i) {
+        m_workers.emplace_back([this, i]() { workerMain(i); });
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    waitIdle();
+    {
+        std::scoped_lock lk(m_mtx);
+        m_isStopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& t : m_workers) {
+        t.join();
+    }
+}
+
+std::future<ImageLoader> AssetLoader::loadImage(std::string filename)
+{
+    auto promise = std::make_shared<std::promise<ImageLoader>>();
+    std::future<ImageLoader> ret = promise->get_future();
+    enqueue([this, promise, filename = std::move(filename)](std::size_t)
+        {
+            try {
+                promise->set_value(ImageLoader(filename.c_str()));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+            loadCompleted();
+        });
+    return ret;
+}
+
+void AssetLoader::poll()
+{
+    std::vector<PendingUpload> uploads_to_submit;
+    {
+        std::scoped_lock lk(m_mtx);
+        uploads_to_submit.swap(m_uploadsToSubmit);
+    }
+    GhulbusVulkan::Queue& transfer_queue = m_instance->getTransferQueue();
+    for (auto& upload : uploads_to_submit) {
+        GhulbusVulkan::Fence fence = m_instance->getVulkanDevice().createFence();
+        transfer_queue.submit(upload.submitStaging, fence);
+        m_uploadsInFlight.push_back(InFlightUpload{ std::move(fence), std::move(upload) });
+    }
+
+    bool has_completed_uploads = false;
+    for (auto it = m_uploadsInFlight.begin(); it != m_uploadsInFlight.end(); ) {
+        if (it->fence.getStatus() == GhulbusVulkan::Fence::Status::Ready) {
+            {
+                // cleanup frees the command buffers, which has to happen on the thread owning their pool
+                std::scoped_lock lk(m_mtx);
+                m_completedUploads[it->upload.worker].push_back(std::move(it->upload));
+            }
+            has_completed_uploads = true;
+            it = m_uploadsInFlight.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (has_completed_uploads) {
+        m_condition.notify_all();
+    }
+}
+
+uint32_t AssetLoader::getNumberOfPendingLoads() const
+{
+    return m_numberOfPendingLoads;
+}
+
+void AssetLoader::waitIdle()
+{
+    while (m_numberOfPendingLoads > 0) {
+        poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void AssetLoader::enqueue(Job job)
+{
+    ++m_numberOfPendingLoads;
+    {
+        std::scoped_lock lk(m_mtx);
+        m_jobs.emplace_back(std::move(job));
+    }
+    m_condition.notify_one();
+}
+
+void AssetLoader::submitUpload(std::size_t worker, GhulbusVulkan::SubmitStaging&& submit_staging,
+                               Ghulbus::AnyInvocable<void()> on_completion)
+{
+    std::scoped_lock lk(m_mtx);
+    m_uploadsToSubmit.push_back(PendingUpload{ worker, std::move(submit_staging), std::move(on_completion) });
+}
+
+void AssetLoader::loadCompleted()
+{
+    --m_numberOfPendingLoads;
+}
+
+void AssetLoader::workerMain(std::size_t worker)
+{
+    for (;;) {
+        std::vector<PendingUpload> completed_uploads;
+        std::optional<Job> job;
+        {
+            std::unique_lock lk(m_mtx);
+            m_condition.wait(lk, [this, worker]() {
+                    return m_isStopping || !m_jobs.empty() || !m_completedUploads[worker].empty();
+                });
+            completed_uploads.swap(m_completedUploads[worker]);
+            if (!m_jobs.empty()) {
+                job.emplace(std::move(m_jobs.front()));
+                m_jobs.pop_front();
+            } else if (completed_uploads.empty()) {
+                GHULBUS_ASSERT(m_isStopping);
+                return;
+            }
+        }
+        for (auto& upload : completed_uploads) {
+            upload.submitStaging.performCleanup();
+            upload.onCompletion();
+            loadCompleted();
+        }
+        if (job) {
+            (*job)(worker);
+        }
+    }
+}
+}
@@ -88,7 +88,13 @@ GhulbusVulkan::MappedMemory GenericImage::map(VkDeviceSize offset, VkDeviceSize
 
 GhulbusVulkan::ImageView GenericImage::createImageView(VkImageViewType view_type, VkImageAspectFlags aspect_flags)
 {
-    return m_image.createImageView(view_type, aspect_flags);
+    VkImageSubresourceRange range;
+    range.aspectMask = aspect_flags;
+    range.baseMipLevel = 0;
+    range.levelCount = m_mipLevels;
+    range.baseArrayLayer = 0;
+    range.layerCount = 1;
+    return m_image.createImageView(view_type, range);
 }
 
 GhulbusGraphics::GraphicsInstance& GenericImage::getInstance()
@@ -0,0 +1,227 @@
+#include <gbGraphics/GeometryPool.hpp>
+
+#include <gbGraphics/CommandPoolRegistry.hpp>
+#include <gbGraphics/GraphicsInstance.hpp>
+
+#include <gbVk/Buffer.hpp>
+#include <gbVk/CommandBuffer.hpp>
+#include <gbVk/CommandBuffers.hpp>
+#include <gbVk/Device.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <algorithm>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+GeometryPool::GeometryPool(GraphicsInstance& instance, VertexFormatBase const& vertex_format,
+                           uint32_t vertex_capacity, uint32_t index_capacity)
+    :m_instance(&instance), m_vertexFormat(vertex_format.clone()), m_vertexStride(vertex_format.getStride()),
+     m_vertexAllocator(vertex_capacity), m_indexAllocator(index_capacity)
+{
+    GHULBUS_PRECONDITION((vertex_capacity > 0) && (index_capacity > 0));
+    m_vertexBuffer.emplace(createVertexBuffer(vertex_capacity));
+    m_indexBuffer.emplace(createIndexBuffer(index_capacity));
+}
+
+VertexFormatBase const& GeometryPool::getVertexFormat() const
+{
+    return *m_vertexFormat;
+}
+
+std::optional<GeometryPool::MeshId> GeometryPool::allocate(uint32_t number_of_vertices, uint32_t number_of_indices)
+{
+    GHULBUS_PRECONDITION((number_of_vertices > 0) && (number_of_indices > 0));
+    std::optional<uint64_t> const vertex_offset = m_vertexAllocator.allocate(number_of_vertices);
+    if (!vertex_offset) { return std::nullopt; }
+    std::optional<uint64_t> const first_index = m_indexAllocator.allocate(number_of_indices);
+    if (!first_index) {
+        m_vertexAllocator.free(*vertex_offset, number_of_vertices);
+        return std::nullopt;
+    }
+    MeshEntry const entry{ *vertex_offset, number_of_vertices, *first_index, number_of_indices, true };
+    if (!m_freeIds.empty()) {
+        MeshId const ret = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_meshes[ret] = entry;
+        return ret;
+    }
+    m_meshes.push_back(entry);
+    return static_cast<MeshId>(m_meshes.size() - 1);
+}
+
+void GeometryPool::free(MeshId mesh)
+{
+    MeshEntry& entry = m_meshes[mesh];
+    GHULBUS_PRECONDITION(entry.isLive);
+    m_vertexAllocator.free(entry.vertexOffset, entry.vertexCount);
+    m_indexAllocator.free(entry.firstIndex, entry.indexCount);
+    entry.isLive = false;
+    m_freeIds.push_back(mesh);
+}
+
+void GeometryPool::upload(UploadBatch& upload_batch, MeshId mesh,
+                          std::byte const* vertex_data, std::byte const* index_data)
+{
+    MeshEntry const& entry = getEntry(mesh);
+    upload_batch.addBufferUpload(*m_vertexBuffer, entry.vertexOffset * m_vertexStride,
+                                 vertex_data, entry.vertexCount * m_vertexStride);
+    upload_batch.addBufferUpload(*m_indexBuffer, entry.firstIndex * sizeof(IndexType),
+                                 index_data, entry.indexCount * sizeof(IndexType));
+}
+
+uint32_t GeometryPool::getNumberOfMeshes() const
+{
+    return static_cast<uint32_t>(m_meshes.size() - m_freeIds.size());
+}
+
+MeshDrawRange GeometryPool::getDrawRange(MeshId mesh) const
+{
+    MeshEntry const& entry = getEntry(mesh);
+    return MeshDrawRange{ static_cast<uint32_t>(entry.firstIndex), entry.indexCount,
+                          static_cast<int32_t>(entry.vertexOffset) };
+}
+
+VkDrawIndexedIndirectCommand GeometryPool::getDrawCommand(MeshId mesh, uint32_t instance_count,
+                                                          uint32_t first_instance) const
+{
+    MeshDrawRange const range = getDrawRange(mesh);
+    VkDrawIndexedIndirectCommand ret;
+    ret.indexCount = range.indexCount;
+    ret.instanceCount = instance_count;
+    ret.firstIndex = range.firstIndex;
+    ret.vertexOffset = range.vertexOffset;
+    ret.firstInstance = first_instance;
+    return ret;
+}
+
+void GeometryPool::bind(GhulbusVulkan::CommandBuffer& command_buffer, uint32_t binding)
+{
+    VkBuffer const vertex_buffer = m_vertexBuffer->getBuffer().getVkBuffer();
+    VkDeviceSize const offset = 0;
+    vkCmdBindVertexBuffers(command_buffer.getVkCommandBuffer(), binding, 1, &vertex_buffer, &offset);
+    vkCmdBindIndexBuffer(command_buffer.getVkCommandBuffer(), m_indexBuffer->getBuffer().getVkBuffer(), 0,
+                         VK_INDEX_TYPE_UINT32);
+}
+
+void GeometryPool::recordDraw(GhulbusVulkan::CommandBuffer& command_buffer, MeshId mesh)
+{
+    MeshDrawRange const range = getDrawRange(mesh);
+    vkCmdDrawIndexed(command_buffer.getVkCommandBuffer(), range.indexCount, 1, range.firstIndex,
+                     range.vertexOffset, 0);
+}
+
+void GeometryPool::recordMultiDraw(GhulbusVulkan::CommandBuffer& command_buffer, MemoryBuffer& indirect_buffer,
+                                   uint32_t draw_count)
+{
+    GHULBUS_PRECONDITION((indirect_buffer.getBufferUsage() & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT) != 0);
+    GHULBUS_PRECONDITION(draw_count * sizeof(VkDrawIndexedIndirectCommand) <= indirect_buffer.getSize());
+    GHULBUS_PRECONDITION((draw_count <= 1) ||
+                         (m_instance->getVulkanDevice().getEnabledFeatures().multiDrawIndirect == VK_TRUE));
+    vkCmdDrawIndexedIndirect(command_buffer.getVkCommandBuffer(), indirect_buffer.getBuffer().getVkBuffer(), 0,
+                             draw_count, sizeof(VkDrawIndexedIndirectCommand));
+}
+
+float GeometryPool::getFragmentation() const
+{
+    return std::max(m_vertexAllocator.getFragmentation(), m_indexAllocator.getFragmentation());
+}
+
+GhulbusVulkan::SubmitStaging GeometryPool::defragment(std::optional<uint32_t> target_queue)
+{
+    MemoryBuffer new_vertex_buffer = createVertexBuffer(m_vertexAllocator.getCapacity());
+    MemoryBuffer new_index_buffer = createIndexBuffer(m_indexAllocator.getCapacity());
+    m_vertexAllocator.reset();
+    m_indexAllocator.reset();
+
+    // the allocators are empty, so allocating in the order of the old offsets packs the meshes tightly
+    // while keeping their relative order
+    std::vector<MeshId> live_meshes;
+    for (MeshId i = 0; i < m_meshes.size(); ++i) {
+        if (m_meshes[i].isLive) { live_meshes.push_back(i); }
+    }
+    std::sort(live_meshes.begin(), live_meshes.end(),
+              [this](MeshId lhs, MeshId rhs) { return m_meshes[lhs].vertexOffset < m_meshes[rhs].vertexOffset; });
+
+    std::vector<VkBufferCopy> vertex_copies;
+    std::vector<VkBufferCopy> index_copies;
+    for (MeshId const id : live_meshes) {
+        MeshEntry& entry = m_meshes[id];
+        uint64_t const vertex_offset = *m_vertexAllocator.allocate(entry.vertexCount);
+        uint64_t const first_index = *m_indexAllocator.allocate(entry.indexCount);
+        vertex_copies.push_back(VkBufferCopy{ entry.vertexOffset * m_vertexStride, vertex_offset * m_vertexStride,
+                                              entry.vertexCount * m_vertexStride });
+        index_copies.push_back(VkBufferCopy{ entry.firstIndex * sizeof(IndexType), first_index * sizeof(IndexType),
+                                             entry.indexCount * sizeof(IndexType) });
+        entry.vertexOffset = vertex_offset;
+        entry.firstIndex = first_index;
+    }
+
+    // the old buffers are read on the queue family owning them, so they need no ownership transfer
+    CommandPoolRegistry& command_pools = m_instance->getCommandPoolRegistry();
+    bool const is_graphics_queue = (target_queue == m_instance->getGraphicsQueueFamilyIndex());
+    auto command_buffers = is_graphics_queue ? command_pools.allocateCommandBuffersGraphics_Transient(1) :
+                           ((target_queue == m_instance->getComputeQueueFamilyIndex()) ?
+                            command_pools.allocateCommandBuffersCompute_Transient(1) :
+                            command_pools.allocateCommandBuffersTransfer_Transient(1));
+    auto& command_buffer = command_buffers.getCommandBuffer(0);
+    GHULBUS_PRECONDITION((!target_queue) || (*target_queue == command_buffer.getQueueFamilyIndex()));
+    command_buffer.begin();
+    if (!vertex_copies.empty()) {
+        vkCmdCopyBuffer(command_buffer.getVkCommandBuffer(), m_vertexBuffer->getBuffer().getVkBuffer(),
+                        new_vertex_buffer.getBuffer().getVkBuffer(),
+                        static_cast<uint32_t>(vertex_copies.size()), vertex_copies.data());
+        vkCmdCopyBuffer(command_buffer.getVkCommandBuffer(), m_indexBuffer->getBuffer().getVkBuffer(),
+                        new_index_buffer.getBuffer().getVkBuffer(),
+                        static_cast<uint32_t>(index_copies.size()), index_copies.data());
+    }
+    if (is_graphics_queue) {
+        // make the copies visible to the draws reading the new buffers
+        VkMemoryBarrier memory_barr;
+        memory_barr.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memory_barr.pNext = nullptr;
+        memory_barr.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        memory_barr.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+        vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &memory_barr, 0, nullptr, 0, nullptr);
+    }
+    command_buffer.end();
+
+    GhulbusVulkan::SubmitStaging ret;
+    ret.addCommandBuffers(command_buffers);
+    ret.adoptResources(std::move(command_buffers), std::move(*m_vertexBuffer), std::move(*m_indexBuffer));
+    m_vertexBuffer.emplace(std::move(new_vertex_buffer));
+    m_indexBuffer.emplace(std::move(new_index_buffer));
+    return ret;
+}
+
+MemoryBuffer& GeometryPool::getVertexBuffer()
+{
+    return *m_vertexBuffer;
+}
+
+MemoryBuffer& GeometryPool::getIndexBuffer()
+{
+    return *m_indexBuffer;
+}
+
+GeometryPool::MeshEntry const& GeometryPool::getEntry(MeshId mesh) const
+{
+    GHULBUS_PRECONDITION((mesh < m_meshes.size()) && (m_meshes[mesh].isLive));
+    return m_meshes[mesh];
+}
+
+MemoryBuffer GeometryPool::createVertexBuffer(uint64_t vertex_capacity)
+{
+    return MemoryBuffer(*m_instance, vertex_capacity * m_vertexStride,
+                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::GpuOnly);
+}
+
+MemoryBuffer GeometryPool::createIndexBuffer(uint64_t index_capacity)
+{
+    return MemoryBuffer(*m_instance, index_capacity * sizeof(IndexType),
+                        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::GpuOnly);
+}
+}
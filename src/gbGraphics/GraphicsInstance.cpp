@@ -2,7 +2,9 @@
 
 #include <gbGraphics/CommandPoolRegistry.hpp>
 #include <gbGraphics/Exceptions.hpp>
+#include <gbGraphics/MipmapGenerator.hpp>
 #include <gbGraphics/Reactor.hpp>
+#include <gbGraphics/StagingRing.hpp>
 #include <gbGraphics/detail/DeviceMemoryAllocator_VMA.hpp>
 #include <gbGraphics/detail/QueueSelection.hpp>
 
@@ -136,7 +138,9 @@ std::unique_ptr<GraphicsInstance::Pimpl> initializeVulkanInstance(char const* ap
     GhulbusVulkan::Instance instance =
         GhulbusVulkan::Instance::createInstance(application_name, application_version, layers, extensions);
     auto [device, queues] = initializeVulkanDevice(instance);
-    detail::DeviceMemoryAllocator_VMA allocator(instance, device);
+    bool const enable_memory_budget =
+        device.getPhysicalDevice().isDeviceExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    detail::DeviceMemoryAllocator_VMA allocator(instance, device, enable_memory_budget);
 
     return std::make_unique<GraphicsInstance::Pimpl>(std::move(instance), std::move(device), std::move(queues),
                                                      std::move(allocator));
@@ -249,10 +253,21 @@ std::tuple<GhulbusVulkan::Device, detail::DeviceQueues> initializeVulkanDevice(G
     detail::DeviceQueues queues = detail::selectQueues(winner, physical_device.getQueueFamilyProperties());
     for (auto const& q : detail::uniqueQueues(queues)) { device_builder.addQueues(q.queue_family_index, 1); }
     for (auto const& ext : required_extensions) { device_builder.addExtension(ext); }
+    // optional: used by the allocator for querying the memory budget
+    if (physical_device.isDeviceExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+        device_builder.addExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
 
     // add requested features
     device_builder.requested_features.fillModeNonSolid = VK_TRUE;      // wireframe drawing
     device_builder.requested_features.samplerAnisotropy = VK_TRUE;     // anisotropic filtering
+    // optional: GeometryPool::recordMultiDraw() with more than one draw
+    device_builder.requested_features.multiDrawIndirect = physical_device.getFeatures().multiDrawIndirect;
+    // optional: compute fallback of MipmapGenerator
+    device_builder.requested_features.shaderStorageImageWriteWithoutFormat =
+        physical_device.getFeatures().shaderStorageImageWriteWithoutFormat;
+    // optional: block-compressed textures; ImageContainerLoader images are decompressed on the host otherwise
+    device_builder.requested_features.textureCompressionBC = physical_device.getFeatures().textureCompressionBC;
 
     return std::make_tuple(device_builder.create(), queues);
 }
@@ -283,6 +298,8 @@ GraphicsInstance::GraphicsInstance(char const* application_name, ApplicationVers
 
     m_commandPoolRegistry = std::make_unique<CommandPoolRegistry>(*this);
     m_reactor = std::make_unique<Reactor>(*this);
+    m_stagingRing = std::make_unique<StagingRing>(*this);
+    m_mipmapGenerator = std::make_unique<MipmapGenerator>(*this);
 
 #ifndef NDEBUG
     setDebugLoggingEnabled(true);
@@ -296,6 +313,9 @@ GraphicsInstance::~GraphicsInstance()
     m_pimpl->queue_graphics.clearAllStaged();
     m_pimpl->queue_compute.clearAllStaged();
     m_pimpl->queue_transfer.clearAllStaged();
+    // staging ring holds command buffers of in-flight uploads
+    m_stagingRing.reset();
+    m_mipmapGenerator.reset();
     m_commandPoolRegistry.reset();
     // reset pimpl manually to ensure Vulkan shuts down before glfw
     m_pimpl.reset();
@@ -432,4 +452,14 @@ Reactor& GraphicsInstance::getReactor()
 {
     return *m_reactor;
 }
+
+StagingRing& GraphicsInstance::getStagingRing()
+{
+    return *m_stagingRing;
+}
+
+MipmapGenerator& GraphicsInstance::getMipmapGenerator()
+{
+    return *m_mipmapGenerator;
+}
 }
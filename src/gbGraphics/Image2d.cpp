@@ -1,24 +1,60 @@
 #include <gbGraphics/Image2d.hpp>
 
 #include <gbGraphics/CommandPoolRegistry.hpp>
+#include <gbGraphics/Exceptions.hpp>
 #include <gbGraphics/GraphicsInstance.hpp>
+#include <gbGraphics/ImageContainerLoader.hpp>
 #include <gbGraphics/MemoryBuffer.hpp>
+#include <gbGraphics/MipmapGenerator.hpp>
+#include <gbGraphics/StagingRing.hpp>
+#include <gbGraphics/detail/BlockDecompression.hpp>
+#include <gbGraphics/detail/FormatInfo.hpp>
 
 #include <gbVk/CommandBuffer.hpp>
 #include <gbVk/CommandBuffers.hpp>
 #include <gbVk/Device.hpp>
 #include <gbVk/ImageView.hpp>
+#include <gbVk/PhysicalDevice.hpp>
 
 #include <gbBase/Assert.hpp>
 
 namespace GHULBUS_GRAPHICS_NAMESPACE
 {
+namespace
+{
+VkFormat selectContainerImageFormat(GraphicsInstance& instance, VkFormat format)
+{
+    if (Image2d::isFormatSupported(instance, format)) { return format; }
+    std::optional<VkFormat> const decompressed_format = detail::getDecompressedFormat(format);
+    if (!decompressed_format) {
+        GHULBUS_THROW(Exceptions::NotImplemented{}, "Image format not supported by the device.");
+    }
+    return *decompressed_format;
+}
+}
 
 Image2d::Image2d(GraphicsInstance& instance, uint32_t width, uint32_t height)
     : Image2d(instance, width, height, VK_IMAGE_TILING_OPTIMAL,
               VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, MemoryUsage::GpuOnly)
 {}
 
+Image2d::Image2d(GraphicsInstance& instance, uint32_t width, uint32_t height, FullMipChain_T, VkFormat format)
+    : m_genImage(instance, VkExtent3D{ width, height, 1 }, format,
+                 MipmapGenerator::getFullMipChainLength(width, height), 1, VK_SAMPLE_COUNT_1_BIT,
+                 VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                     instance.getMipmapGenerator().getRequiredImageUsage(format),
+                 MemoryUsage::GpuOnly)
+{
+}
+
+Image2d::Image2d(GraphicsInstance& instance, ImageContainerLoader const& image_data)
+    : m_genImage(instance, VkExtent3D{ image_data.getWidth(), image_data.getHeight(), 1 },
+                 selectContainerImageFormat(instance, image_data.getFormat()), image_data.getMipLevels(), 1,
+                 VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_TILING_OPTIMAL,
+                 VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, MemoryUsage::GpuOnly)
+{
+}
+
 Image2d::Image2d(GraphicsInstance& instance, uint32_t width, uint32_t height, VkImageTiling tiling,
                  VkImageUsageFlags image_usage, MemoryUsage memory_usage)
     : m_genImage(instance, VkExtent3D{ width, height, 1 }, VK_FORMAT_R8G8B8A8_UNORM, 1, 1, VK_SAMPLE_COUNT_1_BIT,
@@ -41,6 +77,30 @@ uint32_t Image2d::getHeight() const
     return m_genImage.getExtent().height;
 }
 
+uint32_t Image2d::getMipLevels() const
+{
+    return m_genImage.getMipLevels();
+}
+
+VkFormat Image2d::getFormat() const
+{
+    return m_genImage.getFormat();
+}
+
+bool Image2d::isFormatSupported(GraphicsInstance& instance, VkFormat format)
+{
+    GhulbusVulkan::Device& device = instance.getVulkanDevice();
+    std::optional<detail::TexelBlockInfo> const block_info =
+        detail::getTexelBlockInfo(format, VK_IMAGE_ASPECT_COLOR_BIT);
+    bool const is_block_compressed = block_info && (block_info->width > 1);
+    if (is_block_compressed && (device.getEnabledFeatures().textureCompressionBC != VK_TRUE)) {
+        return false;
+    }
+    VkFormatFeatureFlags const format_features =
+        device.getPhysicalDevice().getFormatProperties(format).optimalTilingFeatures;
+    return (format_features & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+}
+
 bool Image2d::isMappable() const
 {
     return m_genImage.isMappable();
@@ -64,20 +124,25 @@ GhulbusVulkan::ImageView Image2d::createImageView()
 GhulbusVulkan::SubmitStaging Image2d::setDataAsynchronously(std::byte const* data,
                                                             std::optional<uint32_t> target_queue)
 {
-    GHULBUS_ASSERT(m_genImage.getFormat() == VK_FORMAT_R8G8B8A8_UNORM);
-    VkExtent3D const image_extent = m_genImage.getExtent();
-    auto const texture_width = image_extent.width;
-    auto const texture_height = image_extent.height;
-    VkDeviceSize const texture_size = texture_width * texture_height * 4;
+    VkDeviceSize const texture_size =
+        detail::getImageRegionSize(m_genImage.getFormat(), VK_IMAGE_ASPECT_COLOR_BIT, m_genImage.getExtent());
 
     GhulbusGraphics::GraphicsInstance& instance = m_genImage.getInstance();
-    GhulbusGraphics::MemoryBuffer staging_buffer(instance, texture_size,
-                                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CpuOnly);
-    {
-        auto mapped_mem = staging_buffer.map();
+    StagingRing& staging_ring = instance.getStagingRing();
+    std::optional<StagingRing::Allocation> const allocation = staging_ring.tryAllocate(texture_size);
+    std::optional<GhulbusGraphics::MemoryBuffer> staging_buffer;
+    if (allocation) {
+        std::memcpy(allocation->data, data, texture_size);
+    } else {
+        staging_buffer.emplace(instance, texture_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CpuOnly);
+        auto mapped_mem = staging_buffer->map();
         std::memcpy(mapped_mem, data, texture_size);
     }
-    auto command_buffers = instance.getCommandPoolRegistry().allocateCommandBuffersTransfer_Transient(1);
+    // blits for generating the mip levels are only supported by graphics queues
+    bool const generate_mips = (m_genImage.getMipLevels() > 1);
+    auto command_buffers = (generate_mips) ?
+        instance.getCommandPoolRegistry().allocateCommandBuffersGraphics_Transient(1) :
+        instance.getCommandPoolRegistry().allocateCommandBuffersTransfer_Transient(1);
     auto& command_buffer = command_buffers.getCommandBuffer(0);
 
     GhulbusVulkan::Image& image = m_genImage.getImage();
@@ -86,9 +151,16 @@ GhulbusVulkan::SubmitStaging Image2d::setDataAsynchronously(std::byte const* dat
     image.transitionLayout(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
                              0, VK_ACCESS_TRANSFER_WRITE_BIT,
                              VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    GhulbusVulkan::Image::copy(command_buffer, staging_buffer.getBuffer(), image);
+    if (allocation) {
+        GhulbusVulkan::Image::copy(command_buffer, staging_ring.getBuffer().getBuffer(), allocation->offset, image);
+    } else {
+        GhulbusVulkan::Image::copy(command_buffer, staging_buffer->getBuffer(), image);
+    }
 
-    if ((!target_queue) || (*target_queue == command_buffer.getQueueFamilyIndex())) {
+    GhulbusVulkan::SubmitStaging ret;
+    if (generate_mips) {
+        instance.getMipmapGenerator().recordGeneration(command_buffer, m_genImage, target_queue, ret);
+    } else if ((!target_queue) || (*target_queue == command_buffer.getQueueFamilyIndex())) {
         image.transitionLayout(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
                                  VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
@@ -99,9 +171,11 @@ GhulbusVulkan::SubmitStaging Image2d::setDataAsynchronously(std::byte const* dat
     }
     command_buffer.end();
 
-    GhulbusVulkan::SubmitStaging ret;
     ret.addCommandBuffers(command_buffers);
     ret.adoptResources(std::move(command_buffers), std::move(staging_buffer));
+    if (allocation) {
+        staging_ring.releaseOnCleanup(*allocation, ret);
+    }
     return ret;
 }
 }
@@ -0,0 +1,363 @@
+#include <gbGraphics/ImageContainerLoader.hpp>
+
+#include <gbGraphics/Exceptions.hpp>
+#include <gbGraphics/detail/BlockDecompression.hpp>
+#include <gbGraphics/detail/FormatInfo.hpp>
+#include <gbGraphics/detail/MappedFile.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace
+{
+unsigned char constexpr ktx2_identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+struct Ktx2Header {
+    unsigned char identifier[12];
+    std::uint32_t vkFormat;
+    std::uint32_t typeSize;
+    std::uint32_t pixelWidth;
+    std::uint32_t pixelHeight;
+    std::uint32_t pixelDepth;
+    std::uint32_t layerCount;
+    std::uint32_t faceCount;
+    std::uint32_t levelCount;
+    std::uint32_t supercompressionScheme;
+    std::uint32_t dfdByteOffset;
+    std::uint32_t dfdByteLength;
+    std::uint32_t kvdByteOffset;
+    std::uint32_t kvdByteLength;
+    std::uint64_t sgdByteOffset;
+    std::uint64_t sgdByteLength;
+};
+static_assert(sizeof(Ktx2Header) == 80);
+
+struct Ktx2LevelIndexEntry {
+    std::uint64_t byteOffset;
+    std::uint64_t byteLength;
+    std::uint64_t uncompressedByteLength;
+};
+
+char constexpr dds_magic[4] = { 'D', 'D', 'S', ' ' };
+
+struct DdsPixelFormat {
+    std::uint32_t size;
+    std::uint32_t flags;
+    std::uint32_t fourCC;
+    std::uint32_t rgbBitCount;
+    std::uint32_t rBitMask;
+    std::uint32_t gBitMask;
+    std::uint32_t bBitMask;
+    std::uint32_t aBitMask;
+};
+
+struct DdsHeader {
+    std::uint32_t size;
+    std::uint32_t flags;
+    std::uint32_t height;
+    std::uint32_t width;
+    std::uint32_t pitchOrLinearSize;
+    std::uint32_t depth;
+    std::uint32_t mipMapCount;
+    std::uint32_t reserved1[11];
+    DdsPixelFormat pixelFormat;
+    std::uint32_t caps;
+    std::uint32_t caps2;
+    std::uint32_t caps3;
+    std::uint32_t caps4;
+    std::uint32_t reserved2;
+};
+static_assert(sizeof(DdsHeader) == 124);
+
+struct DdsHeaderDxt10 {
+    std::uint32_t dxgiFormat;
+    std::uint32_t resourceDimension;
+    std::uint32_t miscFlag;
+    std::uint32_t arraySize;
+    std::uint32_t miscFlags2;
+};
+
+std::uint32_t constexpr dds_flag_mipmap_count = 0x20000;
+std::uint32_t constexpr dds_pixel_format_fourcc = 0x04;
+std::uint32_t constexpr dds_pixel_format_rgb = 0x40;
+std::uint32_t constexpr dds_caps2_cubemap = 0x200;
+std::uint32_t constexpr dds_caps2_volume = 0x200000;
+std::uint32_t constexpr dxgi_resource_dimension_texture2d = 3;
+std::uint32_t constexpr dxgi_misc_flag_texturecube = 0x04;
+
+constexpr std::uint32_t makeFourCC(char const (&code)[5])
+{
+    return static_cast<std::uint32_t>(code[0]) | (static_cast<std::uint32_t>(code[1]) << 8) |
+           (static_cast<std::uint32_t>(code[2]) << 16) | (static_cast<std::uint32_t>(code[3]) << 24);
+}
+
+std::optional<VkFormat> translateFourCC(std::uint32_t fourcc)
+{
+    switch (fourcc) {
+    case makeFourCC("DXT1"): return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    case makeFourCC("DXT2"): [[fallthrough]];
+    case makeFourCC("DXT3"): return VK_FORMAT_BC2_UNORM_BLOCK;
+    case makeFourCC("DXT4"): [[fallthrough]];
+    case makeFourCC("DXT5"): return VK_FORMAT_BC3_UNORM_BLOCK;
+    case makeFourCC("ATI1"): [[fallthrough]];
+    case makeFourCC("BC4U"): return VK_FORMAT_BC4_UNORM_BLOCK;
+    case makeFourCC("BC4S"): return VK_FORMAT_BC4_SNORM_BLOCK;
+    case makeFourCC("ATI2"): [[fallthrough]];
+    case makeFourCC("BC5U"): return VK_FORMAT_BC5_UNORM_BLOCK;
+    case makeFourCC("BC5S"): return VK_FORMAT_BC5_SNORM_BLOCK;
+    default: return std::nullopt;
+    }
+}
+
+std::optional<VkFormat> translateDxgiFormat(std::uint32_t dxgi_format)
+{
+    switch (dxgi_format) {
+    case 28: return VK_FORMAT_R8G8B8A8_UNORM;
+    case 29: return VK_FORMAT_R8G8B8A8_SRGB;
+    case 71: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    case 72: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+    case 74: return VK_FORMAT_BC2_UNORM_BLOCK;
+    case 75: return VK_FORMAT_BC2_SRGB_BLOCK;
+    case 77: return VK_FORMAT_BC3_UNORM_BLOCK;
+    case 78: return VK_FORMAT_BC3_SRGB_BLOCK;
+    case 80: return VK_FORMAT_BC4_UNORM_BLOCK;
+    case 81: return VK_FORMAT_BC4_SNORM_BLOCK;
+    case 83: return VK_FORMAT_BC5_UNORM_BLOCK;
+    case 84: return VK_FORMAT_BC5_SNORM_BLOCK;
+    case 87: return VK_FORMAT_B8G8R8A8_UNORM;
+    case 91: return VK_FORMAT_B8G8R8A8_SRGB;
+    case 95: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+    case 96: return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+    case 98: return VK_FORMAT_BC7_UNORM_BLOCK;
+    case 99: return VK_FORMAT_BC7_SRGB_BLOCK;
+    default: return std::nullopt;
+    }
+}
+
+/** Largest width and height accepted from files.
+ * This is the maxImageDimension2D of current desktop devices; it bounds the memory needed for an image,
+ * before the size of the image is checked against the size of the file.
+ */
+std::uint32_t constexpr max_image_dimension = 16384;
+
+bool isValidMipChain(std::uint32_t width, std::uint32_t height, std::uint32_t mip_levels)
+{
+    return (mip_levels > 0) && (mip_levels <= 32) && ((std::max(width, height) >> (mip_levels - 1)) != 0);
+}
+
+bool isValidImageSize(std::uint32_t width, std::uint32_t height, std::uint32_t mip_levels)
+{
+    return (width <= max_image_dimension) && (height <= max_image_dimension) &&
+           isValidMipChain(width, height, mip_levels);
+}
+
+VkDeviceSize getMipLevelSize(VkFormat format, std::uint32_t width, std::uint32_t height)
+{
+    return detail::getImageRegionSize(format, VK_IMAGE_ASPECT_COLOR_BIT, VkExtent3D{ width, height, 1 });
+}
+
+VkDeviceSize getMipChainSize(VkFormat format, std::uint32_t width, std::uint32_t height, std::uint32_t mip_levels)
+{
+    VkDeviceSize ret = 0;
+    for (uint32_t level = 0; level < mip_levels; ++level) {
+        ret += getMipLevelSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+    }
+    return ret;
+}
+}
+
+ImageContainerLoader::ImageContainerLoader(char const* filename)
+    :m_format(VK_FORMAT_UNDEFINED)
+{
+    detail::MappedFile const file(filename);
+    if ((file.getSize() >= sizeof(ktx2_identifier)) &&
+        (std::memcmp(file.getData(), ktx2_identifier, sizeof(ktx2_identifier)) == 0))
+    {
+        loadKtx2(file.getData(), file.getSize(), filename);
+    } else if ((file.getSize() >= sizeof(dds_magic)) &&
+               (std::memcmp(file.getData(), dds_magic, sizeof(dds_magic)) == 0))
+    {
+        loadDds(file.getData(), file.getSize(), filename);
+    } else {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Unknown image container.");
+    }
+}
+
+ImageContainerLoader::ImageContainerLoader(VkFormat format, uint32_t width, uint32_t height, uint32_t mip_levels)
+    :m_format(format)
+{
+    GHULBUS_PRECONDITION(isValidMipChain(width, height, mip_levels));
+    m_mipLevels.reserve(mip_levels);
+    VkDeviceSize offset = 0;
+    for (uint32_t level = 0; level < mip_levels; ++level) {
+        uint32_t const level_width = std::max(width >> level, 1u);
+        uint32_t const level_height = std::max(height >> level, 1u);
+        VkDeviceSize const level_size = getMipLevelSize(format, level_width, level_height);
+        m_mipLevels.push_back(MipLevel{ offset, level_size, level_width, level_height });
+        offset += level_size;
+    }
+    m_data.resize(offset);
+}
+
+VkFormat ImageContainerLoader::getFormat() const
+{
+    return m_format;
+}
+
+uint32_t ImageContainerLoader::getWidth() const
+{
+    return m_mipLevels.front().width;
+}
+
+uint32_t ImageContainerLoader::getHeight() const
+{
+    return m_mipLevels.front().height;
+}
+
+uint32_t ImageContainerLoader::getMipLevels() const
+{
+    return static_cast<uint32_t>(m_mipLevels.size());
+}
+
+auto ImageContainerLoader::getMipLevel(uint32_t level) const -> MipLevel const&
+{
+    GHULBUS_PRECONDITION(level < m_mipLevels.size());
+    return m_mipLevels[level];
+}
+
+std::byte const* ImageContainerLoader::getData() const
+{
+    return m_data.data();
+}
+
+VkDeviceSize ImageContainerLoader::getDataSize() const
+{
+    return m_data.size();
+}
+
+ImageContainerLoader ImageContainerLoader::decompress() const
+{
+    std::optional<VkFormat> const decompressed_format = detail::getDecompressedFormat(m_format);
+    if (!decompressed_format) {
+        GHULBUS_THROW(Exceptions::NotImplemented{}, "Decompression of image format not supported.");
+    }
+    ImageContainerLoader ret(*decompressed_format, getWidth(), getHeight(), getMipLevels());
+    for (uint32_t level = 0; level < getMipLevels(); ++level) {
+        MipLevel const& src = m_mipLevels[level];
+        detail::decompressImage(m_format, m_data.data() + src.offset, src.width, src.height,
+                                ret.m_data.data() + ret.m_mipLevels[level].offset);
+    }
+    return ret;
+}
+
+void ImageContainerLoader::loadKtx2(char const* data, std::size_t size, char const* filename)
+{
+    Ktx2Header header;
+    if (size < sizeof(Ktx2Header)) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Invalid KTX2 file.");
+    }
+    std::memcpy(&header, data, sizeof(Ktx2Header));
+    if ((header.pixelWidth == 0) || (header.pixelHeight == 0) || (header.pixelDepth != 0) ||
+        (header.layerCount != 0) || (header.faceCount != 1))
+    {
+        GHULBUS_THROW(Exceptions::NotImplemented{}, "Only 2D images are supported.");
+    }
+    if (header.supercompressionScheme != 0) {
+        GHULBUS_THROW(Exceptions::NotImplemented{}, "Supercompressed KTX2 files are not supported.");
+    }
+    VkFormat const format = static_cast<VkFormat>(header.vkFormat);
+    if ((format == VK_FORMAT_UNDEFINED) || !detail::getTexelBlockInfo(format, VK_IMAGE_ASPECT_COLOR_BIT)) {
+        GHULBUS_THROW(Exceptions::NotImplemented{}, "Unsupported image format.");
+    }
+    // a level count of 0 asks for generating the mip levels at load time; only the base level is stored
+    uint32_t const mip_levels = std::max(header.levelCount, 1u);
+    // the levels are stored after the level index and do not overlap
+    if (!isValidImageSize(header.pixelWidth, header.pixelHeight, mip_levels) ||
+        (size - sizeof(Ktx2Header) < mip_levels * sizeof(Ktx2LevelIndexEntry)) ||
+        (size - sizeof(Ktx2Header) - mip_levels * sizeof(Ktx2LevelIndexEntry) <
+            getMipChainSize(format, header.pixelWidth, header.pixelHeight, mip_levels)))
+    {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Invalid KTX2 file.");
+    }
+
+    *this = ImageContainerLoader(format, header.pixelWidth, header.pixelHeight, mip_levels);
+    for (uint32_t level = 0; level < mip_levels; ++level) {
+        Ktx2LevelIndexEntry entry;
+        std::memcpy(&entry, data + sizeof(Ktx2Header) + level * sizeof(Ktx2LevelIndexEntry), sizeof(entry));
+        MipLevel const& mip_level = m_mipLevels[level];
+        if ((entry.byteLength != mip_level.size) || (entry.byteOffset > size) ||
+            (size - entry.byteOffset < entry.byteLength))
+        {
+            GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Invalid KTX2 level index.");
+        }
+        std::memcpy(m_data.data() + mip_level.offset, data + entry.byteOffset, entry.byteLength);
+    }
+}
+
+void ImageContainerLoader::loadDds(char const* data, std::size_t size, char const* filename)
+{
+    DdsHeader header;
+    if (size < sizeof(dds_magic) + sizeof(DdsHeader)) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Invalid DDS file.");
+    }
+    std::memcpy(&header, data + sizeof(dds_magic), sizeof(DdsHeader));
+    if ((header.size != sizeof(DdsHeader)) || (header.pixelFormat.size != sizeof(DdsPixelFormat))) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Invalid DDS file.");
+    }
+    if (((header.caps2 & (dds_caps2_cubemap | dds_caps2_volume)) != 0) || (header.width == 0) ||
+        (header.height == 0))
+    {
+        GHULBUS_THROW(Exceptions::NotImplemented{}, "Only 2D images are supported.");
+    }
+    std::size_t data_offset = sizeof(dds_magic) + sizeof(DdsHeader);
+    std::optional<VkFormat> format;
+    DdsPixelFormat const& pixel_format = header.pixelFormat;
+    if ((pixel_format.flags & dds_pixel_format_fourcc) != 0) {
+        if (pixel_format.fourCC == makeFourCC("DX10")) {
+            DdsHeaderDxt10 header_dxt10;
+            if (size - data_offset < sizeof(DdsHeaderDxt10)) {
+                GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Invalid DDS file.");
+            }
+            std::memcpy(&header_dxt10, data + data_offset, sizeof(DdsHeaderDxt10));
+            data_offset += sizeof(DdsHeaderDxt10);
+            if ((header_dxt10.resourceDimension != dxgi_resource_dimension_texture2d) ||
+                (header_dxt10.arraySize > 1) || ((header_dxt10.miscFlag & dxgi_misc_flag_texturecube) != 0))
+            {
+                GHULBUS_THROW(Exceptions::NotImplemented{}, "Only 2D images are supported.");
+            }
+            format = translateDxgiFormat(header_dxt10.dxgiFormat);
+        } else {
+            format = translateFourCC(pixel_format.fourCC);
+        }
+    } else if (((pixel_format.flags & dds_pixel_format_rgb) != 0) && (pixel_format.rgbBitCount == 32) &&
+               (pixel_format.gBitMask == 0x0000ff00) && (pixel_format.aBitMask == 0xff000000))
+    {
+        if ((pixel_format.rBitMask == 0x000000ff) && (pixel_format.bBitMask == 0x00ff0000)) {
+            format = VK_FORMAT_R8G8B8A8_UNORM;
+        } else if ((pixel_format.rBitMask == 0x00ff0000) && (pixel_format.bBitMask == 0x000000ff)) {
+            format = VK_FORMAT_B8G8R8A8_UNORM;
+        }
+    }
+    if (!format) {
+        GHULBUS_THROW(Exceptions::NotImplemented{}, "Unsupported image format.");
+    }
+    uint32_t const mip_levels = ((header.flags & dds_flag_mipmap_count) != 0) ? std::max(header.mipMapCount, 1u) : 1;
+    if (!isValidImageSize(header.width, header.height, mip_levels)) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Invalid DDS file.");
+    }
+
+    // DDS stores all levels tightly packed, largest level first
+    if (size - data_offset < getMipChainSize(*format, header.width, header.height, mip_levels)) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename)
+                                            << Exception_Info::io_offset(static_cast<std::streamsize>(data_offset)),
+                      "Unexpected end of file.");
+    }
+    *this = ImageContainerLoader(*format, header.width, header.height, mip_levels);
+    std::memcpy(m_data.data(), data + data_offset, m_data.size());
+}
+}
@@ -0,0 +1,107 @@
+#include <gbGraphics/InstanceBatcher.hpp>
+
+#include <gbGraphics/GraphicsInstance.hpp>
+#include <gbGraphics/Mesh.hpp>
+
+#include <gbVk/Buffer.hpp>
+#include <gbVk/CommandBuffer.hpp>
+#include <gbVk/MappedMemory.hpp>
+
+#include <gbBase/Assert.hpp>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+InstanceBatcher::InstanceBatcher(GraphicsInstance& instance, VertexFormatBase const& instance_format,
+                                 uint32_t max_instances, uint32_t frames_in_flight)
+    :m_instance(&instance), m_instanceFormat(instance_format.clone()), m_maxInstances(max_instances),
+     m_batches(instance_format.getStride())
+{
+    GHULBUS_PRECONDITION(max_instances > 0);
+    GHULBUS_PRECONDITION(frames_in_flight > 0);
+    m_instanceBuffers.reserve(frames_in_flight);
+    for (uint32_t i = 0; i < frames_in_flight; ++i) {
+        m_instanceBuffers.emplace_back(instance, m_batches.getInstanceStride() * max_instances,
+                                       VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, MemoryUsage::CpuToGpu);
+    }
+}
+
+VertexFormatBase const& InstanceBatcher::getInstanceFormat() const
+{
+    return *m_instanceFormat;
+}
+
+uint32_t InstanceBatcher::getMaxInstances() const
+{
+    return m_maxInstances;
+}
+
+uint32_t InstanceBatcher::getNumberOfInstances() const
+{
+    return m_batches.getNumberOfInstances();
+}
+
+uint32_t InstanceBatcher::getFramesInFlight() const
+{
+    return static_cast<uint32_t>(m_instanceBuffers.size());
+}
+
+void InstanceBatcher::addInstance(uint32_t pipeline_index, AnyMesh& mesh, std::byte const* instance_data)
+{
+    GHULBUS_PRECONDITION(m_batches.getNumberOfInstances() < m_maxInstances);
+    GHULBUS_PRECONDITION(!mesh.isEmpty());
+    m_batches.addInstance(pipeline_index, mesh, instance_data);
+}
+
+void InstanceBatcher::clear()
+{
+    m_batches.clear();
+}
+
+void InstanceBatcher::upload(uint32_t frame_index)
+{
+    GHULBUS_PRECONDITION(frame_index < m_instanceBuffers.size());
+    if (m_batches.getBatches().empty()) { return; }
+    GhulbusVulkan::MappedMemory mapped = m_instanceBuffers[frame_index].map();
+    m_batches.writeInstanceData(static_cast<std::byte*>(mapped));
+    mapped.flush();
+}
+
+std::span<InstanceBatcher::Batch const> InstanceBatcher::getBatches() const
+{
+    return m_batches.getBatches();
+}
+
+uint32_t InstanceBatcher::getNumberOfDrawCalls() const
+{
+    return m_batches.getNumberOfDrawCalls();
+}
+
+GhulbusGraphics::MemoryBuffer& InstanceBatcher::getInstanceBuffer(uint32_t frame_index)
+{
+    GHULBUS_PRECONDITION(frame_index < m_instanceBuffers.size());
+    return m_instanceBuffers[frame_index];
+}
+
+void InstanceBatcher::recordDrawCommands(uint32_t pipeline_index, GhulbusVulkan::CommandBuffer& command_buffer,
+                                         uint32_t frame_index, uint32_t mesh_binding, uint32_t instance_binding)
+{
+    GHULBUS_PRECONDITION(frame_index < m_instanceBuffers.size());
+    VkCommandBuffer const vk_command_buffer = command_buffer.getVkCommandBuffer();
+    VkBuffer const instance_buffer = m_instanceBuffers[frame_index].getBuffer().getVkBuffer();
+    VkDeviceSize const offset = 0;
+    vkCmdBindVertexBuffers(vk_command_buffer, instance_binding, 1, &instance_buffer, &offset);
+    AnyMesh const* bound_mesh = nullptr;
+    m_batches.forEachDraw(pipeline_index, [&](Batch const& batch, MeshDrawRange const& range) {
+            if (batch.mesh != bound_mesh) {
+                AnyMesh& mesh = *batch.mesh;
+                VkBuffer const vertex_buffer = mesh.getVertexBuffer().getBuffer().getVkBuffer();
+                vkCmdBindVertexBuffers(vk_command_buffer, mesh_binding, 1, &vertex_buffer, &offset);
+                vkCmdBindIndexBuffer(vk_command_buffer, mesh.getIndexBuffer().getBuffer().getVkBuffer(), 0,
+                                     mesh.getIndexType());
+                bound_mesh = batch.mesh;
+            }
+            vkCmdDrawIndexed(vk_command_buffer, range.indexCount, batch.instanceCount, range.firstIndex,
+                             range.vertexOffset, batch.firstInstance);
+        });
+}
+}
@@ -2,6 +2,7 @@
 
 #include <gbGraphics/CommandPoolRegistry.hpp>
 #include <gbGraphics/GraphicsInstance.hpp>
+#include <gbGraphics/StagingRing.hpp>
 
 #include <gbVk/CommandBuffer.hpp>
 #include <gbVk/CommandBuffers.hpp>
@@ -9,13 +10,40 @@
 
 #include <gbBase/Assert.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 namespace GHULBUS_GRAPHICS_NAMESPACE
 {
+namespace {
+/** Sort ranges by offset and merge the ones that overlap or touch.
+ */
+std::vector<MemoryBuffer::Range> mergeRanges(std::span<MemoryBuffer::Range const> ranges)
+{
+    std::vector<MemoryBuffer::Range> sorted(ranges.begin(), ranges.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](MemoryBuffer::Range const& lhs, MemoryBuffer::Range const& rhs) { return lhs.offset < rhs.offset; });
+    std::vector<MemoryBuffer::Range> ret;
+    for (MemoryBuffer::Range const& r : sorted) {
+        if (r.size == 0) { continue; }
+        if (!ret.empty() && (r.offset <= ret.back().offset + ret.back().size)) {
+            ret.back().size = std::max(ret.back().size, r.offset + r.size - ret.back().offset);
+        } else {
+            ret.push_back(r);
+        }
+    }
+    return ret;
+}
+}
+
 MemoryBuffer::MemoryBuffer(GraphicsInstance& instance, VkDeviceSize size,
                            VkBufferUsageFlags buffer_usage, MemoryUsage memory_usage)
     :m_buffer(instance.getVulkanDevice().createBuffer(size, buffer_usage)),
      m_deviceMemory(instance.getDeviceMemoryAllocator().allocateMemoryForBuffer(m_buffer, memory_usage)),
-     m_instance(&instance), m_size(size), m_bufferUsage(buffer_usage), m_memoryUsage(memory_usage)
+     m_instance(&instance), m_size(size), m_bufferUsage(buffer_usage), m_memoryUsage(memory_usage),
+     m_isDirectUpload((memory_usage == MemoryUsage::GpuOnlyDirectUpload) &&
+                      ((m_deviceMemory.getMemoryPropertyFlags() & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0))
 {
     m_deviceMemory.bindBuffer(m_buffer);
 }
@@ -24,7 +52,8 @@ MemoryBuffer::MemoryBuffer(GraphicsInstance& instance, VkDeviceSize size,
                            VkBufferUsageFlags buffer_usage, VkMemoryPropertyFlags required_flags)
     :m_buffer(instance.getVulkanDevice().createBuffer(size, buffer_usage)),
      m_deviceMemory(instance.getDeviceMemoryAllocator().allocateMemoryForBuffer(m_buffer, required_flags)),
-     m_instance(&instance), m_size(size), m_bufferUsage(buffer_usage), m_memoryUsage(MemoryUsage::CpuOnly)
+     m_instance(&instance), m_size(size), m_bufferUsage(buffer_usage), m_memoryUsage(MemoryUsage::CpuOnly),
+     m_isDirectUpload(false)
 {
     m_deviceMemory.bindBuffer(m_buffer);
 }
@@ -39,7 +68,13 @@ bool MemoryBuffer::isMappable() const
 {
     return (m_memoryUsage == MemoryUsage::CpuOnly) ||
            (m_memoryUsage == MemoryUsage::CpuToGpu) ||
-           (m_memoryUsage == MemoryUsage::GpuToCpu);
+           (m_memoryUsage == MemoryUsage::GpuToCpu) ||
+           m_isDirectUpload;
+}
+
+bool MemoryBuffer::isDirectUpload() const
+{
+    return m_isDirectUpload;
 }
 
 VkBufferUsageFlags MemoryBuffer::getBufferUsage() const
@@ -67,27 +102,35 @@ GhulbusVulkan::MappedMemory MemoryBuffer::map(VkDeviceSize offset, VkDeviceSize
 GhulbusVulkan::SubmitStaging MemoryBuffer::setDataAsynchronously(std::byte const* data,
                                                                  std::optional<uint32_t> target_queue)
 {
-    GhulbusGraphics::MemoryBuffer staging_buffer(*m_instance, m_size,
-                                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CpuOnly);
-    {
-        auto mapped_mem = staging_buffer.map();
-        std::memcpy(mapped_mem, data, m_size);
-    }
-    auto command_buffers = m_instance->getCommandPoolRegistry().allocateCommandBuffersTransfer_Transient(1);
-    auto& command_buffer = command_buffers.getCommandBuffer(0);
+    return setDataAsynchronously(data, 0, m_size, target_queue);
+}
 
-    command_buffer.begin();
-    VkBufferCopy buffer_copy;
-    buffer_copy.srcOffset = 0;
-    buffer_copy.dstOffset = 0;
-    buffer_copy.size = m_size;
-    vkCmdCopyBuffer(command_buffer.getVkCommandBuffer(), staging_buffer.getBuffer().getVkBuffer(),
-                    m_buffer.getVkBuffer(), 1, &buffer_copy);
-    if (target_queue) {
-        m_buffer.transitionRelease(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                   VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, *target_queue);
-    }
-    command_buffer.end();
+GhulbusVulkan::SubmitStaging MemoryBuffer::setDataAsynchronously(std::byte const* data, VkDeviceSize offset,
+                                                                 VkDeviceSize size,
+                                                                 std::optional<uint32_t> target_queue)
+{
+    GHULBUS_PRECONDITION((size > 0) && (offset + size <= m_size));
+    Range const range{ offset, size };
+    return stageRanges(data, offset, { &range, 1 }, target_queue);
+}
+
+GhulbusVulkan::SubmitStaging MemoryBuffer::setDataAsynchronously(std::byte const* data,
+                                                                 std::span<Range const> ranges,
+                                                                 std::optional<uint32_t> target_queue)
+{
+    std::vector<Range> const merged_ranges = mergeRanges(ranges);
+    GHULBUS_PRECONDITION(!merged_ranges.empty());
+    GHULBUS_PRECONDITION(merged_ranges.back().offset + merged_ranges.back().size <= m_size);
+    return stageRanges(data, 0, merged_ranges, target_queue);
+}
+
+GhulbusVulkan::SubmitStaging MemoryBuffer::setDataAsynchronously(MemoryBuffer&& staging_buffer,
+                                                                 std::optional<uint32_t> target_queue)
+{
+    GHULBUS_PRECONDITION(staging_buffer.getSize() == m_size);
+    GHULBUS_PRECONDITION((staging_buffer.getBufferUsage() & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) != 0);
+    VkBufferCopy const region{ 0, 0, m_size };
+    auto command_buffers = recordCopyFromStaging(staging_buffer.getBuffer(), { &region, 1 }, target_queue);
 
     GhulbusVulkan::SubmitStaging ret;
     ret.addCommandBuffers(command_buffers);
@@ -95,6 +138,32 @@ GhulbusVulkan::SubmitStaging MemoryBuffer::setDataAsynchronously(std::byte const
     return ret;
 }
 
+void MemoryBuffer::setDataChunked(std::byte const* data, std::optional<uint32_t> target_queue)
+{
+    if (m_isDirectUpload) {
+        setDataMapped(data, 0, m_size);
+        return;
+    }
+    m_instance->getStagingRing().uploadBuffer(m_buffer, 0, data, m_size, target_queue);
+}
+
+void MemoryBuffer::setDataMapped(std::byte const* data, std::span<Range const> ranges)
+{
+    GHULBUS_PRECONDITION(isMappable());
+    std::vector<Range> const merged_ranges = mergeRanges(ranges);
+    if (merged_ranges.empty()) { return; }
+    GHULBUS_PRECONDITION(merged_ranges.back().offset + merged_ranges.back().size <= m_size);
+    writeRangesMapped(data, 0, merged_ranges);
+}
+
+void MemoryBuffer::setDataMapped(std::byte const* data, VkDeviceSize offset, VkDeviceSize size)
+{
+    GHULBUS_PRECONDITION(isMappable());
+    GHULBUS_PRECONDITION((size > 0) && (offset + size <= m_size));
+    Range const range{ offset, size };
+    writeRangesMapped(data, offset, { &range, 1 });
+}
+
 VkDeviceSize MemoryBuffer::getSize() const
 {
     return m_size;
@@ -104,4 +173,81 @@ GhulbusVulkan::Buffer& MemoryBuffer::getBuffer()
 {
     return m_buffer;
 }
+
+void MemoryBuffer::writeRangesMapped(std::byte const* data, VkDeviceSize data_offset, std::span<Range const> ranges)
+{
+    auto mapped_mem = map();
+    for (Range const& r : ranges) {
+        std::memcpy(static_cast<std::byte*>(mapped_mem) + r.offset, data + (r.offset - data_offset), r.size);
+        mapped_mem.flush(r.offset, r.size);
+    }
+}
+
+GhulbusVulkan::SubmitStaging MemoryBuffer::stageRanges(std::byte const* data, VkDeviceSize data_offset,
+                                                       std::span<Range const> ranges,
+                                                       std::optional<uint32_t> target_queue)
+{
+    if (m_isDirectUpload) {
+        // host writes are visible to all submissions made after them, no copy or ownership transfer needed
+        writeRangesMapped(data, data_offset, ranges);
+        return GhulbusVulkan::SubmitStaging{};
+    }
+
+    // the ranges are packed tightly into the staging memory, in the order given
+    VkDeviceSize staging_size = 0;
+    for (Range const& r : ranges) { staging_size += r.size; }
+    std::vector<VkBufferCopy> regions;
+    regions.reserve(ranges.size());
+    auto const fill_staging = [data, data_offset, ranges, &regions](std::byte* staging_data,
+                                                                    VkDeviceSize staging_offset)
+    {
+        for (Range const& r : ranges) {
+            std::memcpy(staging_data, data + (r.offset - data_offset), r.size);
+            regions.push_back(VkBufferCopy{ staging_offset, r.offset, r.size });
+            staging_data += r.size;
+            staging_offset += r.size;
+        }
+    };
+
+    StagingRing& staging_ring = m_instance->getStagingRing();
+    if (std::optional<StagingRing::Allocation> const allocation = staging_ring.tryAllocate(staging_size)) {
+        fill_staging(allocation->data, allocation->offset);
+        auto command_buffers = recordCopyFromStaging(staging_ring.getBuffer().getBuffer(), regions, target_queue);
+        GhulbusVulkan::SubmitStaging ret;
+        ret.addCommandBuffers(command_buffers);
+        ret.adoptResources(std::move(command_buffers));
+        staging_ring.releaseOnCleanup(*allocation, ret);
+        return ret;
+    }
+
+    GhulbusGraphics::MemoryBuffer staging_buffer(*m_instance, staging_size,
+                                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CpuOnly);
+    {
+        auto mapped_mem = staging_buffer.map();
+        fill_staging(mapped_mem, 0);
+    }
+    auto command_buffers = recordCopyFromStaging(staging_buffer.getBuffer(), regions, target_queue);
+    GhulbusVulkan::SubmitStaging ret;
+    ret.addCommandBuffers(command_buffers);
+    ret.adoptResources(std::move(command_buffers), std::move(staging_buffer));
+    return ret;
+}
+
+GhulbusVulkan::CommandBuffers MemoryBuffer::recordCopyFromStaging(GhulbusVulkan::Buffer& staging_buffer,
+                                                                  std::span<VkBufferCopy const> regions,
+                                                                  std::optional<uint32_t> target_queue)
+{
+    auto command_buffers = m_instance->getCommandPoolRegistry().allocateCommandBuffersTransfer_Transient(1);
+    auto& command_buffer = command_buffers.getCommandBuffer(0);
+
+    command_buffer.begin();
+    vkCmdCopyBuffer(command_buffer.getVkCommandBuffer(), staging_buffer.getVkBuffer(),
+                    m_buffer.getVkBuffer(), static_cast<uint32_t>(regions.size()), regions.data());
+    if (target_queue) {
+        m_buffer.transitionRelease(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                   VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, *target_queue);
+    }
+    command_buffer.end();
+    return command_buffers;
+}
 }
@@ -0,0 +1,368 @@
+#include <gbGraphics/MeshCache.hpp>
+
+#include <gbGraphics/Exceptions.hpp>
+#include <gbGraphics/ObjParser.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace
+{
+char constexpr file_magic[8] = { 'G', 'B', 'M', 'E', 'S', 'H', '\0', '\0' };
+
+/** Alignment of all sections in the file.
+ */
+std::uint64_t constexpr section_alignment = 16;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint64_t sourceSize;
+    std::int64_t sourceTime;
+    std::uint64_t sourceHash;
+    std::uint64_t numberOfVertices;
+    std::uint64_t numberOfIndices;
+    std::uint32_t vertexStride;
+    std::uint32_t numberOfComponents;
+    std::uint32_t numberOfGroups;
+    std::uint32_t indexSize;
+    std::uint64_t componentsOffset;
+    std::uint64_t groupsOffset;
+    std::uint64_t namesOffset;
+    std::uint64_t namesSize;
+    std::uint64_t verticesOffset;
+    std::uint64_t indicesOffset;
+};
+
+struct ComponentEntry {
+    std::uint32_t size;
+    std::uint32_t offset;
+    std::uint32_t type;
+    std::uint32_t semantics;
+};
+
+struct GroupEntry {
+    std::uint64_t numberOfFaces;
+    std::uint64_t firstIndex;
+    std::uint64_t indexCount;
+    std::uint64_t firstVertex;
+    std::uint64_t vertexCount;
+    std::uint64_t nameOffset;       ///< Offset into the names section
+    std::uint32_t nameLength;
+    std::uint32_t verticesPerFace;
+    std::uint32_t flags;
+    std::uint32_t padding;
+};
+
+std::uint32_t constexpr group_flag_normal = 0x01;
+std::uint32_t constexpr group_flag_texcoord = 0x02;
+
+std::uint64_t alignSection(std::uint64_t offset)
+{
+    return (offset + section_alignment - 1) & ~(section_alignment - 1);
+}
+
+/** Hash of the complete contents of a file.
+ * Processes 8 bytes at a time, mixing each word with the MurmurHash3 finalizer, so hashing runs at
+ * memory speed for typical file sizes.
+ */
+std::uint64_t hashData(std::span<char const> data)
+{
+    auto const mix = [](std::uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    };
+    std::uint64_t constexpr k = 0x9e3779b97f4a7c15ull;
+    std::uint64_t h = data.size();
+    std::size_t i = 0;
+    for (; i + 8 <= data.size(); i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data.data() + i, 8);
+        h = (h ^ mix(word)) * k;
+    }
+    if (i != data.size()) {
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, data.data() + i, data.size() - i);
+        h = (h ^ mix(tail)) * k;
+    }
+    return mix(h);
+}
+
+struct SourceInfo {
+    std::uint64_t size;
+    std::int64_t time;
+};
+
+std::optional<SourceInfo> getSourceInfo(char const* source_filename)
+{
+    std::error_code ec;
+    std::uintmax_t const size = std::filesystem::file_size(source_filename, ec);
+    if (ec) { return std::nullopt; }
+    std::filesystem::file_time_type const time = std::filesystem::last_write_time(source_filename, ec);
+    if (ec) { return std::nullopt; }
+    return SourceInfo{ static_cast<std::uint64_t>(size), static_cast<std::int64_t>(time.time_since_epoch().count()) };
+}
+
+bool isInFile(std::uint64_t offset, std::uint64_t size, std::size_t file_size)
+{
+    return (offset <= file_size) && (size <= file_size - offset);
+}
+
+FileHeader const& getHeader(detail::MappedFile const& file)
+{
+    return *reinterpret_cast<FileHeader const*>(file.getData());
+}
+
+void validateFile(detail::MappedFile const& file, char const* filename)
+{
+    auto const invalid_file = [filename]() {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Invalid mesh cache file.");
+    };
+    if (file.getSize() < sizeof(FileHeader)) { invalid_file(); }
+    FileHeader const& header = getHeader(file);
+    if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0) { invalid_file(); }
+    if (header.version != MeshCache::formatVersion) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename),
+                      "Unsupported mesh cache version.");
+    }
+    if ((header.headerSize != sizeof(FileHeader)) ||
+        (header.indexSize != sizeof(std::uint32_t)) ||
+        (header.numberOfVertices > std::numeric_limits<std::uint64_t>::max() / std::max(header.vertexStride, 1u)) ||
+        (header.numberOfIndices > std::numeric_limits<std::uint64_t>::max() / header.indexSize) ||
+        ((header.componentsOffset | header.groupsOffset | header.verticesOffset | header.indicesOffset) %
+            section_alignment != 0) ||
+        !isInFile(header.componentsOffset, header.numberOfComponents * std::uint64_t{ sizeof(ComponentEntry) },
+                  file.getSize()) ||
+        !isInFile(header.groupsOffset, header.numberOfGroups * std::uint64_t{ sizeof(GroupEntry) }, file.getSize()) ||
+        !isInFile(header.namesOffset, header.namesSize, file.getSize()) ||
+        !isInFile(header.verticesOffset, header.numberOfVertices * header.vertexStride, file.getSize()) ||
+        !isInFile(header.indicesOffset, header.numberOfIndices * header.indexSize, file.getSize()))
+    {
+        invalid_file();
+    }
+    auto const groups = reinterpret_cast<GroupEntry const*>(file.getData() + header.groupsOffset);
+    for (std::uint32_t i = 0; i < header.numberOfGroups; ++i) {
+        if (!isInFile(groups[i].nameOffset, groups[i].nameLength, header.namesSize) ||
+            !isInFile(groups[i].firstIndex, groups[i].indexCount, header.numberOfIndices) ||
+            !isInFile(groups[i].firstVertex, groups[i].vertexCount, header.numberOfVertices))
+        {
+            invalid_file();
+        }
+    }
+}
+
+void writeSection(std::ofstream& fout, void const* data, std::uint64_t size)
+{
+    std::uint64_t const offset = static_cast<std::uint64_t>(fout.tellp());
+    char constexpr zeros[section_alignment] = {};
+    fout.write(zeros, static_cast<std::streamsize>(alignSection(offset) - offset));
+    fout.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+}
+}
+
+MeshCache::MeshCache(char const* filename)
+    :m_file(filename)
+{
+    validateFile(m_file, filename);
+}
+
+void MeshCache::write(char const* filename, ObjParser const& obj, char const* source_filename)
+{
+    std::optional<SourceInfo> const source_info = getSourceInfo(source_filename);
+    if (!source_info) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(source_filename),
+                      "Unable to access source file.");
+    }
+    detail::MappedFile const source_file(source_filename);
+
+    ObjParser::VertexDataFlat::Format const format;
+    std::vector<ComponentEntry> components;
+    for (std::size_t i = 0; i < format.getNumberOfComponents(); ++i) {
+        components.push_back(ComponentEntry{ static_cast<std::uint32_t>(format.getComponentSize(i)),
+                                             static_cast<std::uint32_t>(format.getComponentOffset(i)),
+                                             static_cast<std::uint32_t>(format.getComponentType(i)),
+                                             static_cast<std::uint32_t>(format.getComponentSemantics(i)) });
+    }
+
+    std::vector<GroupEntry> groups;
+    std::string names;
+    for (ObjParser::IndexType i = 0; i < obj.numberOfGroups(); ++i) {
+        std::string_view const name = obj.getGroupName(i);
+        ObjParser::SubmeshRange const& range = obj.getGroupRange(i);
+        groups.push_back(GroupEntry{ static_cast<std::uint64_t>(obj.numberOfFacesInGroup(i)),
+                                     static_cast<std::uint64_t>(range.firstIndex),
+                                     static_cast<std::uint64_t>(range.indexCount),
+                                     static_cast<std::uint64_t>(range.firstVertex),
+                                     static_cast<std::uint64_t>(range.vertexCount),
+                                     names.size(),
+                                     static_cast<std::uint32_t>(name.size()),
+                                     static_cast<std::uint32_t>(obj.groupVerticesPerFace(i)),
+                                     (obj.groupHasNormal(i) ? group_flag_normal : 0u) |
+                                        (obj.groupHasTexCoord(i) ? group_flag_texcoord : 0u),
+                                     0 });
+        names += name;
+    }
+
+    std::uint64_t const vertices_size = obj.getFlatVertices().size() * sizeof(ObjParser::VertexEntryFlat);
+    std::uint64_t const indices_size = obj.getFlatIndices().size() * sizeof(std::uint32_t);
+    static_assert(sizeof(ObjParser::IndexType) == sizeof(std::uint32_t), "Flat indices are stored as uint32.");
+
+    FileHeader header{};
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = formatVersion;
+    header.headerSize = sizeof(FileHeader);
+    header.sourceSize = source_info->size;
+    header.sourceTime = source_info->time;
+    header.sourceHash = hashData(source_file.getSpan());
+    header.numberOfVertices = obj.getFlatVertices().size();
+    header.numberOfIndices = obj.getFlatIndices().size();
+    header.vertexStride = static_cast<std::uint32_t>(format.getStride());
+    header.numberOfComponents = static_cast<std::uint32_t>(components.size());
+    header.numberOfGroups = static_cast<std::uint32_t>(groups.size());
+    header.indexSize = sizeof(std::uint32_t);
+    header.componentsOffset = alignSection(sizeof(FileHeader));
+    header.groupsOffset = alignSection(header.componentsOffset + components.size() * sizeof(ComponentEntry));
+    header.namesOffset = alignSection(header.groupsOffset + groups.size() * sizeof(GroupEntry));
+    header.namesSize = names.size();
+    header.verticesOffset = alignSection(header.namesOffset + header.namesSize);
+    header.indicesOffset = alignSection(header.verticesOffset + vertices_size);
+
+    std::string const tmp_filename = std::string(filename) + ".tmp";
+    {
+        std::ofstream fout(tmp_filename, std::ios_base::binary | std::ios_base::trunc);
+        if (fout.fail()) {
+            GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(tmp_filename),
+                          "Unable to open file.");
+        }
+        fout.write(reinterpret_cast<char const*>(&header), sizeof(FileHeader));
+        writeSection(fout, components.data(), components.size() * sizeof(ComponentEntry));
+        writeSection(fout, groups.data(), groups.size() * sizeof(GroupEntry));
+        writeSection(fout, names.data(), names.size());
+        writeSection(fout, obj.getFlatVertices().data(), vertices_size);
+        writeSection(fout, obj.getFlatIndices().data(), indices_size);
+        fout.close();
+        if (fout.fail()) {
+            GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(tmp_filename),
+                          "Error writing file.");
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_filename, filename, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_filename, ec);
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename),
+                      "Unable to replace file.");
+    }
+}
+
+bool MeshCache::isUpToDate(char const* source_filename, Validation validation) const
+{
+    std::optional<SourceInfo> const source_info = getSourceInfo(source_filename);
+    FileHeader const& header = getHeader(m_file);
+    if (!source_info || (source_info->size != header.sourceSize) || (source_info->time != header.sourceTime)) {
+        return false;
+    }
+    if (validation == Validation::ContentHash) {
+        detail::MappedFile const source_file(source_filename);
+        return hashData(source_file.getSpan()) == header.sourceHash;
+    }
+    return true;
+}
+
+std::uint64_t MeshCache::getNumberOfVertices() const
+{
+    return getHeader(m_file).numberOfVertices;
+}
+
+std::uint64_t MeshCache::getNumberOfIndices() const
+{
+    return getHeader(m_file).numberOfIndices;
+}
+
+std::span<std::byte const> MeshCache::getVertexData() const
+{
+    FileHeader const& header = getHeader(m_file);
+    return std::span<std::byte const>(reinterpret_cast<std::byte const*>(m_file.getData() + header.verticesOffset),
+                                      header.numberOfVertices * header.vertexStride);
+}
+
+std::span<std::uint32_t const> MeshCache::getIndexData() const
+{
+    FileHeader const& header = getHeader(m_file);
+    return std::span<std::uint32_t const>(
+        reinterpret_cast<std::uint32_t const*>(m_file.getData() + header.indicesOffset), header.numberOfIndices);
+}
+
+std::size_t MeshCache::getVertexStride() const
+{
+    return getHeader(m_file).vertexStride;
+}
+
+std::size_t MeshCache::getNumberOfComponents() const
+{
+    return getHeader(m_file).numberOfComponents;
+}
+
+VertexComponentInfo MeshCache::getComponentInfo(std::size_t index) const
+{
+    FileHeader const& header = getHeader(m_file);
+    GHULBUS_PRECONDITION(index < header.numberOfComponents);
+    ComponentEntry const& c = reinterpret_cast<ComponentEntry const*>(m_file.getData() + header.componentsOffset)[index];
+    return VertexComponentInfo{ c.size, c.offset,
+                                static_cast<VertexFormatBase::ComponentType>(c.type),
+                                static_cast<VertexFormatBase::ComponentSemantics>(c.semantics) };
+}
+
+std::size_t MeshCache::getNumberOfGroups() const
+{
+    return getHeader(m_file).numberOfGroups;
+}
+
+MeshCache::GroupInfo MeshCache::getGroup(std::size_t index) const
+{
+    FileHeader const& header = getHeader(m_file);
+    GHULBUS_PRECONDITION(index < header.numberOfGroups);
+    GroupEntry const& g = reinterpret_cast<GroupEntry const*>(m_file.getData() + header.groupsOffset)[index];
+    return GroupInfo{ std::string_view(m_file.getData() + header.namesOffset + g.nameOffset, g.nameLength),
+                      g.numberOfFaces,
+                      g.firstIndex,
+                      g.indexCount,
+                      g.firstVertex,
+                      g.vertexCount,
+                      static_cast<int>(g.verticesPerFace),
+                      (g.flags & group_flag_normal) != 0,
+                      (g.flags & group_flag_texcoord) != 0 };
+}
+
+bool MeshCache::hasVertexFormat(VertexFormatBase const& format) const
+{
+    if ((format.getStride() != getVertexStride()) || (format.getNumberOfComponents() != getNumberOfComponents())) {
+        return false;
+    }
+    for (std::size_t i = 0; i < format.getNumberOfComponents(); ++i) {
+        VertexComponentInfo const info = getComponentInfo(i);
+        if ((info.size != format.getComponentSize(i)) || (info.offset != format.getComponentOffset(i)) ||
+            (info.type != format.getComponentType(i)) || (info.semantics != format.getComponentSemantics(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
@@ -0,0 +1,334 @@
+#include <gbGraphics/MeshOptimizer.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE::MeshOptimizer
+{
+namespace {
+/** Size of the LRU cache modelled by the vertex scores of optimizeVertexCache().
+ */
+std::size_t constexpr forsyth_cache_size = 32;
+
+/** Largest remaining valence with a precomputed score.
+ */
+std::size_t constexpr forsyth_max_valence = 32;
+
+/** Score of a vertex for optimizeVertexCache().
+ * Vertices that are in the cache score higher the more recently they were used; The three vertices of the
+ * last triangle get a fixed, lower score to avoid producing strips. Vertices with few remaining triangles
+ * get a bonus, so that no lone triangles are left behind.
+ */
+class VertexScore {
+private:
+    std::array<float, forsyth_cache_size> m_cacheScore;
+    std::array<float, forsyth_max_valence + 1> m_valenceScore;
+public:
+    VertexScore()
+    {
+        float constexpr last_triangle_score = 0.75f;
+        float constexpr cache_decay_power = 1.5f;
+        for (std::size_t i = 0; i < forsyth_cache_size; ++i) {
+            m_cacheScore[i] = (i < 3) ? last_triangle_score :
+                std::pow(1.0f - static_cast<float>(i - 3) / static_cast<float>(forsyth_cache_size - 3),
+                         cache_decay_power);
+        }
+        m_valenceScore[0] = 0.0f;
+        for (std::size_t i = 1; i <= forsyth_max_valence; ++i) {
+            m_valenceScore[i] = valenceScore(i);
+        }
+    }
+
+    /** Score of a vertex.
+     * @param[in] cache_position Position in the cache; -1 if the vertex is not in the cache.
+     * @param[in] remaining_valence Number of triangles using the vertex that have not been emitted yet.
+     */
+    float operator()(int cache_position, std::size_t remaining_valence) const
+    {
+        if (remaining_valence == 0) { return -1.0f; }
+        float const cache_score = (cache_position >= 0) ? m_cacheScore[cache_position] : 0.0f;
+        return cache_score + ((remaining_valence <= forsyth_max_valence) ? m_valenceScore[remaining_valence] :
+                                                                           valenceScore(remaining_valence));
+    }
+
+private:
+    static float valenceScore(std::size_t remaining_valence)
+    {
+        float constexpr valence_boost_scale = 2.0f;
+        float constexpr valence_boost_power = 0.5f;
+        return valence_boost_scale * std::pow(static_cast<float>(remaining_valence), -valence_boost_power);
+    }
+};
+
+/** Triangles adjacent to each vertex, in compressed row storage.
+ */
+struct TriangleAdjacency {
+    std::vector<std::uint32_t> offsets;         ///< Position of the first triangle of each vertex in triangles
+    std::vector<std::uint32_t> counts;          ///< Number of triangles of each vertex
+    std::vector<std::uint32_t> triangles;       ///< Adjacent triangles of all vertices
+};
+
+template<typename Index_T>
+TriangleAdjacency buildTriangleAdjacency(std::span<Index_T const> indices, std::size_t number_of_vertices)
+{
+    TriangleAdjacency ret;
+    ret.counts.resize(number_of_vertices, 0);
+    for (Index_T i : indices) {
+        GHULBUS_PRECONDITION((i >= 0) && (static_cast<std::size_t>(i) < number_of_vertices));
+        ++ret.counts[i];
+    }
+    ret.offsets.resize(number_of_vertices);
+    std::exclusive_scan(ret.counts.begin(), ret.counts.end(), ret.offsets.begin(), std::uint32_t{ 0 });
+    ret.triangles.resize(indices.size());
+    std::vector<std::uint32_t> cursor = ret.offsets;
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        ret.triangles[cursor[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+    }
+    return ret;
+}
+}
+
+template<typename Index_T>
+VertexCacheStatistics analyzeVertexCache(std::span<Index_T const> indices, std::size_t number_of_vertices,
+                                         std::size_t cache_size)
+{
+    GHULBUS_PRECONDITION(indices.size() % 3 == 0);
+    GHULBUS_PRECONDITION(cache_size > 0);
+    // the cache is modelled with timestamps: a vertex is in the cache if it was added less than
+    // cache_size misses ago.
+    std::vector<std::size_t> cache_timestamps(number_of_vertices, 0);
+    std::size_t timestamp = cache_size + 1;
+    VertexCacheStatistics ret{ 0, indices.size() / 3, 0, 0.0f, 0.0f };
+    std::vector<bool> referenced(number_of_vertices, false);
+    for (Index_T i : indices) {
+        GHULBUS_PRECONDITION((i >= 0) && (static_cast<std::size_t>(i) < number_of_vertices));
+        if (timestamp - cache_timestamps[i] > cache_size) {
+            cache_timestamps[i] = timestamp++;
+            ++ret.verticesTransformed;
+        }
+        if (!referenced[i]) {
+            referenced[i] = true;
+            ++ret.vertices;
+        }
+    }
+    if (ret.triangles > 0) {
+        ret.acmr = static_cast<float>(ret.verticesTransformed) / static_cast<float>(ret.triangles);
+        ret.atvr = static_cast<float>(ret.verticesTransformed) / static_cast<float>(ret.vertices);
+    }
+    return ret;
+}
+
+template<typename Index_T>
+void optimizeVertexCache(std::span<Index_T> indices, std::size_t number_of_vertices)
+{
+    GHULBUS_PRECONDITION(indices.size() % 3 == 0);
+    std::size_t const number_of_triangles = indices.size() / 3;
+    if (number_of_triangles == 0) { return; }
+    VertexScore const vertex_score;
+    TriangleAdjacency adjacency = buildTriangleAdjacency<Index_T>(indices, number_of_vertices);
+
+    std::vector<float> vertex_scores(number_of_vertices);
+    for (std::size_t v = 0; v < number_of_vertices; ++v) {
+        vertex_scores[v] = vertex_score(-1, adjacency.counts[v]);
+    }
+    std::vector<float> triangle_scores(number_of_triangles);
+    for (std::size_t t = 0; t < number_of_triangles; ++t) {
+        triangle_scores[t] = vertex_scores[indices[3*t]] + vertex_scores[indices[3*t + 1]] +
+                             vertex_scores[indices[3*t + 2]];
+    }
+    std::vector<bool> emitted(number_of_triangles, false);
+    std::vector<int> cache_positions(number_of_vertices, -1);
+    std::array<std::uint32_t, forsyth_cache_size + 3> cache;
+    std::array<std::uint32_t, forsyth_cache_size + 3> new_cache;
+    std::size_t cache_fill = 0;
+    std::vector<Index_T> output;
+    output.reserve(indices.size());
+
+    std::size_t best_triangle = static_cast<std::size_t>(
+        std::distance(triangle_scores.begin(), std::max_element(triangle_scores.begin(), triangle_scores.end())));
+    std::size_t input_cursor = 0;
+    for (std::size_t n_emitted = 0; n_emitted < number_of_triangles; ++n_emitted) {
+        if (best_triangle == number_of_triangles) {
+            // no candidate among the triangles adjacent to the cache; continue with the next one in input order
+            while (emitted[input_cursor]) { ++input_cursor; }
+            best_triangle = input_cursor;
+        }
+        std::uint32_t const triangle_vertices[] = { static_cast<std::uint32_t>(indices[3*best_triangle]),
+                                                    static_cast<std::uint32_t>(indices[3*best_triangle + 1]),
+                                                    static_cast<std::uint32_t>(indices[3*best_triangle + 2]) };
+        emitted[best_triangle] = true;
+        std::size_t new_cache_fill = 0;
+        for (std::uint32_t v : triangle_vertices) {
+            output.push_back(static_cast<Index_T>(v));
+            // remove the triangle from the live triangles of the vertex
+            std::uint32_t* const first = adjacency.triangles.data() + adjacency.offsets[v];
+            std::uint32_t* const last = first + adjacency.counts[v];
+            std::uint32_t* const it = std::find(first, last, static_cast<std::uint32_t>(best_triangle));
+            if (it != last) {
+                *it = *(last - 1);
+                --adjacency.counts[v];
+            }
+            if (std::find(new_cache.begin(), new_cache.begin() + new_cache_fill, v) ==
+                new_cache.begin() + new_cache_fill)
+            {
+                new_cache[new_cache_fill++] = v;
+            }
+        }
+        for (std::size_t i = 0; i < cache_fill; ++i) {
+            std::uint32_t const v = cache[i];
+            if (std::find(triangle_vertices, triangle_vertices + 3, v) == triangle_vertices + 3) {
+                new_cache[new_cache_fill++] = v;
+            }
+        }
+        // update scores of all vertices that were in the cache before or after the triangle
+        for (std::size_t i = 0; i < new_cache_fill; ++i) {
+            std::uint32_t const v = new_cache[i];
+            cache_positions[v] = (i < forsyth_cache_size) ? static_cast<int>(i) : -1;
+            vertex_scores[v] = vertex_score(cache_positions[v], adjacency.counts[v]);
+        }
+        best_triangle = number_of_triangles;
+        float best_score = -1.0f;
+        for (std::size_t i = 0; i < new_cache_fill; ++i) {
+            std::uint32_t const v = new_cache[i];
+            std::uint32_t const* const first = adjacency.triangles.data() + adjacency.offsets[v];
+            for (std::uint32_t const* it = first; it != first + adjacency.counts[v]; ++it) {
+                std::uint32_t const t = *it;
+                float const score = vertex_scores[indices[3*t]] + vertex_scores[indices[3*t + 1]] +
+                                    vertex_scores[indices[3*t + 2]];
+                triangle_scores[t] = score;
+                if (score > best_score) {
+                    best_score = score;
+                    best_triangle = t;
+                }
+            }
+        }
+        cache_fill = std::min(new_cache_fill, forsyth_cache_size);
+        std::copy(new_cache.begin(), new_cache.begin() + cache_fill, cache.begin());
+    }
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+template<typename Index_T>
+void optimizeOverdraw(std::span<Index_T> indices, std::span<GhulbusMath::Point3f const> positions,
+                      std::size_t cache_size)
+{
+    GHULBUS_PRECONDITION(indices.size() % 3 == 0);
+    GHULBUS_PRECONDITION(cache_size > 0);
+    std::size_t const number_of_triangles = indices.size() / 3;
+    if (number_of_triangles == 0) { return; }
+
+    // split into clusters wherever a triangle misses the cache with all of its vertices
+    std::vector<std::size_t> cluster_begin;
+    std::vector<std::size_t> cache_timestamps(positions.size(), 0);
+    std::size_t timestamp = cache_size + 1;
+    for (std::size_t t = 0; t < number_of_triangles; ++t) {
+        int misses = 0;
+        for (std::size_t j = 0; j < 3; ++j) {
+            Index_T const v = indices[3*t + j];
+            GHULBUS_PRECONDITION((v >= 0) && (static_cast<std::size_t>(v) < positions.size()));
+            if (timestamp - cache_timestamps[v] > cache_size) {
+                cache_timestamps[v] = timestamp++;
+                ++misses;
+            }
+        }
+        if ((t == 0) || (misses == 3)) { cluster_begin.push_back(t); }
+    }
+    cluster_begin.push_back(number_of_triangles);
+    std::size_t const number_of_clusters = cluster_begin.size() - 1;
+    if (number_of_clusters == 1) { return; }
+
+    // area-weighted centroids and normals of the clusters and of the whole mesh
+    struct Vec { double x, y, z; };
+    std::vector<Vec> cluster_centroids(number_of_clusters, Vec{ 0.0, 0.0, 0.0 });
+    std::vector<Vec> cluster_normals(number_of_clusters, Vec{ 0.0, 0.0, 0.0 });
+    std::vector<double> cluster_areas(number_of_clusters, 0.0);
+    Vec mesh_centroid{ 0.0, 0.0, 0.0 };
+    double mesh_area = 0.0;
+    for (std::size_t c = 0; c < number_of_clusters; ++c) {
+        for (std::size_t t = cluster_begin[c]; t < cluster_begin[c + 1]; ++t) {
+            GhulbusMath::Point3f const& p0 = positions[indices[3*t]];
+            GhulbusMath::Point3f const& p1 = positions[indices[3*t + 1]];
+            GhulbusMath::Point3f const& p2 = positions[indices[3*t + 2]];
+            Vec const e1{ p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+            Vec const e2{ p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+            Vec const n{ e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+            double const area = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z) * 0.5;
+            Vec const centroid{ (p0.x + p1.x + p2.x) / 3.0, (p0.y + p1.y + p2.y) / 3.0, (p0.z + p1.z + p2.z) / 3.0 };
+            cluster_centroids[c] = Vec{ cluster_centroids[c].x + centroid.x * area,
+                                        cluster_centroids[c].y + centroid.y * area,
+                                        cluster_centroids[c].z + centroid.z * area };
+            cluster_normals[c] = Vec{ cluster_normals[c].x + n.x, cluster_normals[c].y + n.y,
+                                      cluster_normals[c].z + n.z };
+            cluster_areas[c] += area;
+        }
+        mesh_centroid = Vec{ mesh_centroid.x + cluster_centroids[c].x, mesh_centroid.y + cluster_centroids[c].y,
+                             mesh_centroid.z + cluster_centroids[c].z };
+        mesh_area += cluster_areas[c];
+    }
+    if (mesh_area > 0.0) {
+        mesh_centroid = Vec{ mesh_centroid.x / mesh_area, mesh_centroid.y / mesh_area, mesh_centroid.z / mesh_area };
+    }
+
+    // clusters that face away from the center of the mesh are likely to occlude others; draw them first
+    std::vector<double> sort_keys(number_of_clusters);
+    for (std::size_t c = 0; c < number_of_clusters; ++c) {
+        Vec const& n = cluster_normals[c];
+        double const normal_length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+        if ((cluster_areas[c] <= 0.0) || (normal_length <= 0.0)) {
+            sort_keys[c] = 0.0;
+            continue;
+        }
+        Vec const centroid{ cluster_centroids[c].x / cluster_areas[c], cluster_centroids[c].y / cluster_areas[c],
+                            cluster_centroids[c].z / cluster_areas[c] };
+        sort_keys[c] = ((centroid.x - mesh_centroid.x) * n.x + (centroid.y - mesh_centroid.y) * n.y +
+                        (centroid.z - mesh_centroid.z) * n.z) / normal_length;
+    }
+    std::vector<std::size_t> cluster_order(number_of_clusters);
+    std::iota(cluster_order.begin(), cluster_order.end(), 0);
+    std::stable_sort(cluster_order.begin(), cluster_order.end(),
+                     [&sort_keys](std::size_t lhs, std::size_t rhs) { return sort_keys[lhs] > sort_keys[rhs]; });
+
+    std::vector<Index_T> output;
+    output.reserve(indices.size());
+    for (std::size_t c : cluster_order) {
+        output.insert(output.end(), indices.begin() + 3 * cluster_begin[c], indices.begin() + 3 * cluster_begin[c + 1]);
+    }
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+template<typename Index_T>
+std::vector<std::uint32_t> optimizeVertexFetch(std::span<Index_T> indices, std::size_t number_of_vertices)
+{
+    std::vector<std::uint32_t> remap(number_of_vertices, unreferencedVertex);
+    std::uint32_t next_vertex = 0;
+    for (Index_T& i : indices) {
+        GHULBUS_PRECONDITION((i >= 0) && (static_cast<std::size_t>(i) < number_of_vertices));
+        if (remap[i] == unreferencedVertex) { remap[i] = next_vertex++; }
+        i = static_cast<Index_T>(remap[i]);
+    }
+    return remap;
+}
+
+template VertexCacheStatistics analyzeVertexCache<std::uint16_t>(std::span<std::uint16_t const>,
+                                                                 std::size_t, std::size_t);
+template VertexCacheStatistics analyzeVertexCache<std::uint32_t>(std::span<std::uint32_t const>,
+                                                                 std::size_t, std::size_t);
+template VertexCacheStatistics analyzeVertexCache<std::int32_t>(std::span<std::int32_t const>,
+                                                                std::size_t, std::size_t);
+template void optimizeVertexCache<std::uint16_t>(std::span<std::uint16_t>, std::size_t);
+template void optimizeVertexCache<std::uint32_t>(std::span<std::uint32_t>, std::size_t);
+template void optimizeVertexCache<std::int32_t>(std::span<std::int32_t>, std::size_t);
+template void optimizeOverdraw<std::uint16_t>(std::span<std::uint16_t>,
+                                              std::span<GhulbusMath::Point3f const>, std::size_t);
+template void optimizeOverdraw<std::uint32_t>(std::span<std::uint32_t>,
+                                              std::span<GhulbusMath::Point3f const>, std::size_t);
+template void optimizeOverdraw<std::int32_t>(std::span<std::int32_t>,
+                                             std::span<GhulbusMath::Point3f const>, std::size_t);
+template std::vector<std::uint32_t> optimizeVertexFetch<std::uint16_t>(std::span<std::uint16_t>, std::size_t);
+template std::vector<std::uint32_t> optimizeVertexFetch<std::uint32_t>(std::span<std::uint32_t>, std::size_t);
+template std::vector<std::uint32_t> optimizeVertexFetch<std::int32_t>(std::span<std::int32_t>, std::size_t);
+}
@@ -0,0 +1,297 @@
+#include <gbGraphics/MipmapGenerator.hpp>
+
+#include <gbGraphics/Exceptions.hpp>
+#include <gbGraphics/GenericImage.hpp>
+#include <gbGraphics/GraphicsInstance.hpp>
+#include <gbGraphics/detail/CompiledShaders.hpp>
+
+#include <gbVk/CommandBuffer.hpp>
+#include <gbVk/DescriptorPool.hpp>
+#include <gbVk/DescriptorPoolBuilder.hpp>
+#include <gbVk/DescriptorSet.hpp>
+#include <gbVk/DescriptorSetLayoutBuilder.hpp>
+#include <gbVk/DescriptorSets.hpp>
+#include <gbVk/Device.hpp>
+#include <gbVk/Image.hpp>
+#include <gbVk/ImageView.hpp>
+#include <gbVk/PhysicalDevice.hpp>
+#include <gbVk/PipelineLayoutBuilder.hpp>
+#include <gbVk/SpirvCode.hpp>
+#include <gbVk/SubmitStaging.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <array>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace
+{
+VkImageMemoryBarrier mipLevelBarrier(VkImage image, uint32_t base_level, uint32_t level_count, uint32_t layer_count,
+                                     VkAccessFlags src_access, VkAccessFlags dst_access,
+                                     VkImageLayout old_layout, VkImageLayout new_layout)
+{
+    VkImageMemoryBarrier ret;
+    ret.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    ret.pNext = nullptr;
+    ret.srcAccessMask = src_access;
+    ret.dstAccessMask = dst_access;
+    ret.oldLayout = old_layout;
+    ret.newLayout = new_layout;
+    ret.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    ret.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    ret.image = image;
+    ret.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    ret.subresourceRange.baseMipLevel = base_level;
+    ret.subresourceRange.levelCount = level_count;
+    ret.subresourceRange.baseArrayLayer = 0;
+    ret.subresourceRange.layerCount = layer_count;
+    return ret;
+}
+
+VkOffset3D mipLevelEnd(VkExtent3D const& extent, uint32_t level)
+{
+    VkExtent2D const level_extent = detail::getMipLevelExtent(extent.width, extent.height, level);
+    return VkOffset3D{ static_cast<int32_t>(level_extent.width), static_cast<int32_t>(level_extent.height), 1 };
+}
+}
+
+MipmapGenerator::MipmapGenerator(GraphicsInstance& instance)
+    :m_instance(&instance)
+{
+}
+
+uint32_t MipmapGenerator::getFullMipChainLength(uint32_t width, uint32_t height)
+{
+    return detail::getFullMipChainLength(width, height);
+}
+
+auto MipmapGenerator::selectMethod(VkFormat format) -> std::optional<Method>
+{
+    GhulbusVulkan::Device& device = m_instance->getVulkanDevice();
+    return detail::selectMipmapMethod(device.getPhysicalDevice().getFormatProperties(format).optimalTilingFeatures,
+                                      device.getEnabledFeatures().shaderStorageImageWriteWithoutFormat == VK_TRUE);
+}
+
+VkImageUsageFlags MipmapGenerator::getRequiredImageUsage(VkFormat format)
+{
+    std::optional<Method> const method = selectMethod(format);
+    if (!method) {
+        GHULBUS_THROW(Exceptions::InvalidArgument{}, "Mip levels cannot be generated for image format.");
+    }
+    switch (*method) {
+    case Method::Blit: return VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    case Method::Compute: return VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+    default: GHULBUS_UNREACHABLE();
+    }
+}
+
+void MipmapGenerator::recordGeneration(GhulbusVulkan::CommandBuffer& command_buffer, GenericImage& image,
+                                       std::optional<uint32_t> target_queue,
+                                       GhulbusVulkan::SubmitStaging& submit_staging)
+{
+    GHULBUS_PRECONDITION(image.getExtent().depth == 1);
+    VkPipelineStageFlags src_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    VkAccessFlags src_access = VK_ACCESS_TRANSFER_WRITE_BIT;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    if (image.getMipLevels() > 1) {
+        std::optional<Method> const method = selectMethod(image.getFormat());
+        if (!method) {
+            GHULBUS_THROW(Exceptions::InvalidArgument{}, "Mip levels cannot be generated for image format.");
+        }
+        if (*method == Method::Blit) {
+            recordBlitChain(command_buffer, image);
+            layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        } else {
+            recordComputeChain(command_buffer, image, submit_staging);
+            src_stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            src_access = VK_ACCESS_SHADER_WRITE_BIT;
+            layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+    }
+
+    // a single barrier for all levels that makes the image available to the consumer
+    bool const is_same_queue = (!target_queue) || (*target_queue == command_buffer.getQueueFamilyIndex());
+    VkImageMemoryBarrier image_barr = mipLevelBarrier(image.getImage().getVkImage(), 0, image.getMipLevels(),
+                                                      image.getArrayLayers(), src_access,
+                                                      is_same_queue ? VK_ACCESS_SHADER_READ_BIT : 0,
+                                                      layout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    if (!is_same_queue) {
+        image_barr.srcQueueFamilyIndex = command_buffer.getQueueFamilyIndex();
+        image_barr.dstQueueFamilyIndex = *target_queue;
+    }
+    vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), src_stage,
+                         is_same_queue ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &image_barr);
+}
+
+void MipmapGenerator::recordBlitChain(GhulbusVulkan::CommandBuffer& command_buffer, GenericImage& image)
+{
+    VkImage const vk_image = image.getImage().getVkImage();
+    VkExtent3D const extent = image.getExtent();
+    uint32_t const mip_levels = image.getMipLevels();
+    uint32_t const layers = image.getArrayLayers();
+
+    // the first level becomes the source of the first blit, all other levels are destinations
+    std::array<VkImageMemoryBarrier, 2> const initial_barriers = {
+        mipLevelBarrier(vk_image, 0, 1, layers, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL),
+        mipLevelBarrier(vk_image, 1, mip_levels - 1, layers, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+    };
+    vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                         static_cast<uint32_t>(initial_barriers.size()), initial_barriers.data());
+
+    for (uint32_t level = 1; level < mip_levels; ++level) {
+        VkImageBlit region;
+        region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.srcSubresource.mipLevel = level - 1;
+        region.srcSubresource.baseArrayLayer = 0;
+        region.srcSubresource.layerCount = layers;
+        region.srcOffsets[0] = VkOffset3D{ 0, 0, 0 };
+        region.srcOffsets[1] = mipLevelEnd(extent, level - 1);
+        region.dstSubresource = region.srcSubresource;
+        region.dstSubresource.mipLevel = level;
+        region.dstOffsets[0] = VkOffset3D{ 0, 0, 0 };
+        region.dstOffsets[1] = mipLevelEnd(extent, level);
+        vkCmdBlitImage(command_buffer.getVkCommandBuffer(), vk_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       vk_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region, VK_FILTER_LINEAR);
+        // the new level is the source of the next blit
+        VkImageMemoryBarrier const image_barr =
+            mipLevelBarrier(vk_image, level, 1, layers, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_barr);
+    }
+}
+
+void MipmapGenerator::recordComputeChain(GhulbusVulkan::CommandBuffer& command_buffer, GenericImage& image,
+                                         GhulbusVulkan::SubmitStaging& submit_staging)
+{
+    GHULBUS_PRECONDITION(image.getArrayLayers() == 1);
+    GhulbusVulkan::Device& device = m_instance->getVulkanDevice();
+    ComputePipeline& compute_pipeline = getComputePipeline();
+    GhulbusVulkan::Image& vk_image = image.getImage();
+    VkExtent3D const extent = image.getExtent();
+    uint32_t const mip_levels = image.getMipLevels();
+    uint32_t const number_of_passes = mip_levels - 1;
+
+    std::vector<GhulbusVulkan::ImageView> level_views;
+    level_views.reserve(mip_levels);
+    for (uint32_t level = 0; level < mip_levels; ++level) {
+        VkImageSubresourceRange range;
+        range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        range.baseMipLevel = level;
+        range.levelCount = 1;
+        range.baseArrayLayer = 0;
+        range.layerCount = 1;
+        level_views.emplace_back(vk_image.createImageView(VK_IMAGE_VIEW_TYPE_2D, range));
+    }
+
+    // one descriptor set per pass, reading from the previous level and writing to the next
+    GhulbusVulkan::DescriptorPool descriptor_pool = [&device, number_of_passes]() {
+            GhulbusVulkan::DescriptorPoolBuilder builder = device.createDescriptorPoolBuilder();
+            builder.addDescriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, number_of_passes);
+            builder.addDescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, number_of_passes);
+            return builder.create(number_of_passes, 0,
+                                  GhulbusVulkan::DescriptorPoolBuilder::NoImplicitFreeDescriptorFlag{});
+        }();
+    GhulbusVulkan::DescriptorSets descriptor_sets =
+        descriptor_pool.allocateDescriptorSets(number_of_passes, compute_pipeline.descriptorSetLayout);
+    std::vector<VkDescriptorImageInfo> image_infos;
+    image_infos.reserve(2 * number_of_passes);
+    std::vector<VkWriteDescriptorSet> writes;
+    writes.reserve(2 * number_of_passes);
+    for (uint32_t pass = 0; pass < number_of_passes; ++pass) {
+        VkDescriptorSet const descriptor_set = descriptor_sets.getDescriptorSet(pass).getVkDescriptorSet();
+        image_infos.push_back(VkDescriptorImageInfo{ compute_pipeline.sampler.getVkSampler(),
+                                                     level_views[pass].getVkImageView(),
+                                                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+        image_infos.push_back(VkDescriptorImageInfo{ VK_NULL_HANDLE, level_views[pass + 1].getVkImageView(),
+                                                     VK_IMAGE_LAYOUT_GENERAL });
+        for (uint32_t binding = 0; binding < 2; ++binding) {
+            VkWriteDescriptorSet write;
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.pNext = nullptr;
+            write.dstSet = descriptor_set;
+            write.dstBinding = binding;
+            write.dstArrayElement = 0;
+            write.descriptorCount = 1;
+            write.descriptorType = (binding == 0) ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER :
+                                                    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            write.pImageInfo = &image_infos[2 * pass + binding];
+            write.pBufferInfo = nullptr;
+            write.pTexelBufferView = nullptr;
+            writes.push_back(write);
+        }
+    }
+    vkUpdateDescriptorSets(device.getVkDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+    // the first level is read by the first pass, all other levels are written before they are read
+    std::array<VkImageMemoryBarrier, 2> const initial_barriers = {
+        mipLevelBarrier(vk_image.getVkImage(), 0, 1, 1, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL),
+        mipLevelBarrier(vk_image.getVkImage(), 1, mip_levels - 1, 1, 0, VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL)
+    };
+    vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+                         static_cast<uint32_t>(initial_barriers.size()), initial_barriers.data());
+
+    vkCmdBindPipeline(command_buffer.getVkCommandBuffer(), VK_PIPELINE_BIND_POINT_COMPUTE,
+                      compute_pipeline.pipeline.getVkPipeline());
+    for (uint32_t level = 1; level < mip_levels; ++level) {
+        VkDescriptorSet const descriptor_set = descriptor_sets.getDescriptorSet(level - 1).getVkDescriptorSet();
+        vkCmdBindDescriptorSets(command_buffer.getVkCommandBuffer(), VK_PIPELINE_BIND_POINT_COMPUTE,
+                                compute_pipeline.pipelineLayout.getVkPipelineLayout(), 0, 1, &descriptor_set, 0,
+                                nullptr);
+        // the shader uses 8x8 work groups
+        VkExtent2D const level_extent = detail::getMipLevelExtent(extent.width, extent.height, level);
+        uint32_t const group_count_x = (level_extent.width + 7) / 8;
+        uint32_t const group_count_y = (level_extent.height + 7) / 8;
+        vkCmdDispatch(command_buffer.getVkCommandBuffer(), group_count_x, group_count_y, 1);
+        // the new level is read by the next pass
+        VkImageMemoryBarrier const image_barr =
+            mipLevelBarrier(vk_image.getVkImage(), level, 1, 1, VK_ACCESS_SHADER_WRITE_BIT,
+                            VK_ACCESS_SHADER_READ_BIT,
+                            VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_barr);
+    }
+    // the descriptor sets are freed together with the pool
+    submit_staging.adoptResources(std::move(descriptor_pool), std::move(level_views));
+}
+
+auto MipmapGenerator::getComputePipeline() -> ComputePipeline&
+{
+    if (!m_computePipeline) {
+        GhulbusVulkan::Device& device = m_instance->getVulkanDevice();
+        detail::shader::ShaderData const shader_data = detail::shader::downsampleCompute();
+        GhulbusVulkan::ShaderModule shader_module =
+            device.createShaderModule(GhulbusVulkan::SpirvCode::load(shader_data.data, shader_data.size));
+        GhulbusVulkan::DescriptorSetLayout descriptor_set_layout = [&device]() {
+                GhulbusVulkan::DescriptorSetLayoutBuilder builder = device.createDescriptorSetLayoutBuilder();
+                builder.addSampler(0, VK_SHADER_STAGE_COMPUTE_BIT);
+                builder.addStorageImage(1, VK_SHADER_STAGE_COMPUTE_BIT);
+                return builder.create();
+            }();
+        GhulbusVulkan::PipelineLayout pipeline_layout = [&device, &descriptor_set_layout]() {
+                GhulbusVulkan::PipelineLayoutBuilder builder = device.createPipelineLayoutBuilder();
+                builder.addDescriptorSetLayout(descriptor_set_layout);
+                return builder.create();
+            }();
+        GhulbusVulkan::Pipeline pipeline = device.createComputePipeline(pipeline_layout, shader_module);
+        GhulbusVulkan::Sampler sampler =
+            device.createSampler(VK_FILTER_NEAREST, VK_FILTER_NEAREST, VK_SAMPLER_MIPMAP_MODE_NEAREST,
+                                 VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+                                 VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, 0.f, 0.f, 0.f, 0.f,
+                                 VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK);
+        m_computePipeline.emplace(ComputePipeline{ std::move(shader_module), std::move(descriptor_set_layout),
+                                                   std::move(pipeline_layout), std::move(pipeline),
+                                                   std::move(sampler) });
+    }
+    return *m_computePipeline;
+}
+}
@@ -1,78 +1,57 @@
 #include <gbGraphics/ObjParser.hpp>
 
 #include <gbGraphics/Exceptions.hpp>
+#include <gbGraphics/detail/IndexTupleMap.hpp>
+#include <gbGraphics/detail/MappedFile.hpp>
 
 #include <gbBase/Assert.hpp>
 #include <gbBase/Finally.hpp>
 #include <gbBase/Log.hpp>
 
 #include <algorithm>
+#include <array>
 #include <charconv>
-#include <fstream>
 #include <numeric>
 #include <limits>
-#include <regex>
-#include <tuple>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <list>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 
-#if WIN32
-#ifndef WIN32_LEAN_AND_MEAN
-#   define WIN32_LEAN_AND_MEAN
-#endif
-#ifndef NOMINMAX
-#   define NOMINMAX
-#endif
-#include <Windows.h>
-#endif
-
 namespace GHULBUS_GRAPHICS_NAMESPACE {
 namespace {
 
-/** Index Tuple type used for face flattening
- */
-struct IndexTuple {
-    using IndexType = ObjParser::IndexType;
-    IndexType vertexIndex;
-    IndexType normalIndex;
-    IndexType textureIndex;
-public:
-    IndexTuple()
-        : vertexIndex(0), normalIndex(0), textureIndex(0)
-    {}
-    IndexTuple(IndexType v, IndexType n, IndexType t)
-        : vertexIndex(v), normalIndex(n), textureIndex(t)
-    {}
-};
-
-inline bool operator==(IndexTuple const& lhs, IndexTuple const& rhs) {
-    return ((lhs.vertexIndex == rhs.vertexIndex) &&
-            (lhs.normalIndex == rhs.normalIndex) &&
-            (lhs.textureIndex == rhs.textureIndex));
-}
-
-inline bool operator<(IndexTuple const& lhs, IndexTuple const& rhs) {
-    return std::tie(lhs.vertexIndex, lhs.normalIndex, lhs.textureIndex) <
-           std::tie(rhs.vertexIndex, rhs.normalIndex, rhs.textureIndex);
-}
-
-struct IndexTupleHash
-{
-    inline size_t operator()(IndexTuple const& t) const {
-        return (t.vertexIndex) ^ (t.normalIndex << 16) ^ (t.textureIndex << 21);
-    }
-};
+using detail::IndexTuple;
+using detail::IndexTupleMap;
+using detail::IndexTuple64;
+using detail::IndexTupleMap64;
+static_assert(std::is_same_v<IndexTuple::IndexType, ObjParser::IndexType>);
 
-using IndexTupleMap = std::unordered_map<IndexTuple, ObjParser::IndexType, IndexTupleHash>;
+using Buffer = std::span<char const>;
+using BufferIterator = char const*;
 
-using Buffer = std::vector<char>;
-
-void readDataFromFile(char const* filename, Buffer* out_data);
-void parseData(Buffer const& data,
+void parseData(Buffer data,
+               std::size_t max_threads,
                ObjParser::VertexData& out_vertex_data,
                ObjParser::FaceGroups& out_face_groups,
                ObjParser::FaceGroupNames& out_group_names,
-               ObjParser::VertexDataFlat& out_flat_vertex_data,
-               ObjParser::IndexDataFlat& out_flat_index_data);
+               ObjParser::FaceGroupIndices& out_group_indices,
+               ObjParser::SubmeshRanges& out_submesh_ranges,
+               ObjParser::FlatStorageProvider const& flat_storage);
+
+ObjParser::StreamStatistics streamFile(std::istream& fin,
+                                       char const* filename,
+                                       ObjParser::FlatBatchSink const& sink,
+                                       std::size_t window_size,
+                                       std::uint32_t max_batch_vertices,
+                                       std::size_t max_vertex_memory);
 }
 
 ObjParser::FaceData::FaceData()
@@ -81,6 +60,7 @@ ObjParser::FaceData::FaceData()
 }
 
 ObjParser::ObjParser()
+    :m_maxThreads(0)
 {
 }
 
@@ -90,10 +70,48 @@ ObjParser::~ObjParser()
 
 void ObjParser::readFile(char const* filename)
 {
-    Buffer data;
-    readDataFromFile(filename, &data);
+    detail::MappedFile const file(filename);
+    readData(file.getSpan());
+}
+
+void ObjParser::readData(std::span<char const> obj_data)
+{
+    readData(obj_data, [this](std::size_t number_of_vertices, std::size_t number_of_indices) {
+            m_vertexDataFlat.getStorage().resize(number_of_vertices);
+            m_indexDataFlat.resize(number_of_indices);
+            return FlatStorage{ m_vertexDataFlat.getStorage(), m_indexDataFlat };
+        });
+}
+
+void ObjParser::readData(std::span<char const> obj_data, FlatStorageProvider const& flat_storage)
+{
     clearMesh();
-    parseData(data, m_vertexData, m_faceGroups, m_faceGroupNames, m_vertexDataFlat, m_indexDataFlat);
+    std::size_t const max_threads = (m_maxThreads != 0) ? m_maxThreads :
+                                                           std::max(std::thread::hardware_concurrency(), 1u);
+    parseData(obj_data, max_threads, m_vertexData, m_faceGroups, m_faceGroupNames, m_faceGroupIndices,
+              m_submeshRanges, flat_storage);
+}
+
+ObjParser::StreamStatistics ObjParser::readFileStreaming(char const* filename,
+                                                         FlatBatchSink const& sink,
+                                                         std::size_t window_size,
+                                                         std::uint32_t max_batch_vertices,
+                                                         std::size_t max_vertex_memory)
+{
+    GHULBUS_PRECONDITION(sink);
+    GHULBUS_PRECONDITION(window_size > 0);
+    GHULBUS_PRECONDITION(max_batch_vertices >= 4);
+    std::ifstream fin(filename, std::ios_base::binary);
+    if (fin.fail()) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename),
+                      "Unable to open file.");
+    }
+    return streamFile(fin, filename, sink, window_size, max_batch_vertices, max_vertex_memory);
+}
+
+void ObjParser::setMaxThreads(unsigned int max_threads)
+{
+    m_maxThreads = max_threads;
 }
 
 bool ObjParser::groupHasTexCoord(IndexType i) const
@@ -179,12 +197,94 @@ ObjParser::IndexDataFlat const& ObjParser::getFlatIndices() const
     return m_indexDataFlat;
 }
 
+ObjParser::FlatData16 ObjParser::getFlatData16() const
+{
+    std::size_t constexpr max_chunk_vertices = std::size_t{ std::numeric_limits<std::uint16_t>::max() } + 1;
+    auto const& flat_vertices = m_vertexDataFlat.getStorage();
+    GHULBUS_PRECONDITION(m_submeshRanges.empty() || !m_indexDataFlat.empty());
+    FlatData16 ret;
+    auto& out_vertices = ret.vertices.getStorage();
+    auto& out_triangles = ret.indices.getStorage();
+    out_triangles.reserve(m_indexDataFlat.size() / 3);
+    if (flat_vertices.size() <= max_chunk_vertices) {
+        out_vertices = flat_vertices;
+        for (std::size_t i = 0; i < m_indexDataFlat.size(); i += 3) {
+            out_triangles.push_back({ static_cast<std::uint16_t>(m_indexDataFlat[i]),
+                                      static_cast<std::uint16_t>(m_indexDataFlat[i + 1]),
+                                      static_cast<std::uint16_t>(m_indexDataFlat[i + 2]) });
+        }
+        for (std::size_t i = 0; i < m_submeshRanges.size(); ++i) {
+            ret.chunks.push_back(IndexChunk16{ static_cast<IndexType>(i), m_submeshRanges[i].firstIndex,
+                                               m_submeshRanges[i].indexCount, 0 });
+        }
+        return ret;
+    }
+
+    out_vertices.reserve(flat_vertices.size());
+    // position of each flat vertex in the current chunk; -1 if the chunk does not reference it
+    std::vector<IndexType> chunk_index(flat_vertices.size(), -1);
+    std::vector<IndexType> chunk_vertices;
+    chunk_vertices.reserve(max_chunk_vertices);
+    auto const finish_chunk = [&](IndexType group) {
+        std::size_t const first_index = ret.chunks.empty() ? 0 :
+            static_cast<std::size_t>(ret.chunks.back().firstIndex + ret.chunks.back().indexCount);
+        std::size_t const index_count = out_triangles.size() * 3 - first_index;
+        if (index_count == 0) { return; }
+        ret.chunks.push_back(IndexChunk16{ group, static_cast<IndexType>(first_index),
+                                           static_cast<IndexType>(index_count),
+                                           static_cast<IndexType>(out_vertices.size()) });
+        for (IndexType v : chunk_vertices) {
+            out_vertices.push_back(flat_vertices[v]);
+            chunk_index[v] = -1;
+        }
+        chunk_vertices.clear();
+    };
+    auto const chunk_vertex = [&chunk_index, &chunk_vertices](IndexType v) {
+        if (chunk_index[v] < 0) {
+            chunk_index[v] = static_cast<IndexType>(chunk_vertices.size());
+            chunk_vertices.push_back(v);
+        }
+        return static_cast<std::uint16_t>(chunk_index[v]);
+    };
+    for (std::size_t group = 0; group < m_submeshRanges.size(); ++group) {
+        SubmeshRange const& range = m_submeshRanges[group];
+        for (IndexType i = range.firstIndex; i < range.firstIndex + range.indexCount; i += 3) {
+            IndexType const* const triangle = &m_indexDataFlat[i];
+            std::size_t const new_vertices = (chunk_index[triangle[0]] < 0 ? 1 : 0) +
+                ((chunk_index[triangle[1]] < 0) && (triangle[1] != triangle[0]) ? 1 : 0) +
+                ((chunk_index[triangle[2]] < 0) && (triangle[2] != triangle[0]) && (triangle[2] != triangle[1]) ? 1 : 0);
+            if (chunk_vertices.size() + new_vertices > max_chunk_vertices) {
+                finish_chunk(static_cast<IndexType>(group));
+            }
+            std::uint16_t const i1 = chunk_vertex(triangle[0]);
+            std::uint16_t const i2 = chunk_vertex(triangle[1]);
+            std::uint16_t const i3 = chunk_vertex(triangle[2]);
+            out_triangles.push_back({ i1, i2, i3 });
+        }
+        finish_chunk(static_cast<IndexType>(group));
+    }
+    return ret;
+}
+
 char const* ObjParser::getGroupName(IndexType i) const
 {
     GHULBUS_PRECONDITION((i >= 0) && (static_cast<std::size_t>(i) < m_faceGroupNames.size()));
     return m_faceGroupNames[i].c_str();
 }
 
+std::optional<ObjParser::IndexType> ObjParser::findGroup(std::string_view name) const
+{
+    auto const it = m_faceGroupIndices.find(name);
+    if (it == m_faceGroupIndices.end()) { return std::nullopt; }
+    return it->second;
+}
+
+ObjParser::SubmeshRange const& ObjParser::getGroupRange(IndexType i) const
+{
+    GHULBUS_PRECONDITION((i >= 0) && (static_cast<std::size_t>(i) < m_submeshRanges.size()));
+    return m_submeshRanges[i];
+}
+
 void ObjParser::clearMesh()
 {
     m_vertexData.vertex.clear();
@@ -192,70 +292,44 @@ void ObjParser::clearMesh()
     m_vertexData.texCoord.clear();
     m_faceGroups.clear();
     m_faceGroupNames.clear();
+    m_faceGroupIndices.clear();
+    m_submeshRanges.clear();
     m_vertexDataFlat.getStorage().clear();
     m_indexDataFlat.clear();
 }
 
 namespace {
-void readDataFromFile(char const* filename, Buffer* out_data)
+/** Skip to the end of the current line.
+ * @param[in] position Iterator to anywhere in the file.
+ * @param[in] eof Iterator to the end of file.
+ * @return Iterator to the the next newline or eof.
+ * @note Uses memchr, which is vectorized by all major C runtimes. Lines are typically short, but
+ *       long runs of comments or unsupported entries are skipped in bulk this way.
+ */
+inline BufferIterator getEndOfLine(BufferIterator const& position,
+                                   BufferIterator const& eof)
 {
-#if WIN32
-    HANDLE fin = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, 0, nullptr);
-    if (fin == INVALID_HANDLE_VALUE) {
-        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename),
-                      "Unable to open file.");
-    }
-    auto guard_file_handle = Ghulbus::finally([fin]() { CloseHandle(fin); });
-    LARGE_INTEGER lfilesize;
-    if ((GetFileSizeEx(fin, &lfilesize) == 0) || (lfilesize.QuadPart >= std::numeric_limits<DWORD>::max())) {
-        GHULBUS_THROW(Exceptions::IOError() << Exception_Info::filename(filename),
-                      "File size error.");
-    }
-    DWORD const filesize = static_cast<DWORD>(lfilesize.QuadPart);
-    out_data->clear();
-    out_data->resize(filesize);
-    if (DWORD read; (ReadFile(fin, out_data->data(), filesize, &read, nullptr) == 0) || (read != filesize)) {
-        GHULBUS_THROW(Exceptions::IOError() << Exception_Info::filename(filename),
-                      "File read error.");
-    }
-#else
-    //open file
-    std::ifstream fin(filename, std::ios_base::binary);
-    if (fin.fail()) {
-        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename),
-                      "Unable to open file.");
-    }
+    void const* const newline = std::memchr(position, '\n', static_cast<std::size_t>(eof - position));
+    return (newline != nullptr) ? static_cast<BufferIterator>(newline) : eof;
+}
 
-    //get file size
-    fin.seekg(0, std::ios_base::end);
-    size_t filesize = static_cast<size_t>(fin.tellg());
-    fin.seekg(0, std::ios_base::beg);
-    if ((fin.fail()) || (filesize == 0)) {
-        GHULBUS_THROW(Exceptions::IOError() << Exception_Info::filename(filename),
-                      "File size error.");
-    }
-    
-    //read file
-    out_data->clear();
-    out_data->resize(filesize);
-    fin.read(reinterpret_cast<char*>(&out_data->front()), filesize);
-    if (static_cast<size_t>(fin.gcount()) != filesize) {
-        GHULBUS_THROW(Exceptions::IOError() << Exception_Info::filename(filename)
-                                            << Exception_Info::io_offset(fin.gcount()),
-                      "File read error.");
-    }
-#endif
+/** Check whether a character is whitespace that does not terminate a line.
+ */
+inline bool isBlank(char c)
+{
+    return (c == '\r') || (c == ' ') || (c == '\t');
 }
 
-/** Skip to the end of the current line.
+/** Skip whitespace within the current line.
  * @param[in] position Iterator to anywhere in the file.
  * @param[in] eof Iterator to the end of file.
- * @return Iterator to the the next newline or eof.
+ * @return Iterator to the the next non-whitespace, newline or eof.
  */
-inline Buffer::const_iterator getEndOfLine(Buffer::const_iterator const& position,
-                                           Buffer::const_iterator const& eof)
+inline BufferIterator skipBlanks(BufferIterator position,
+                                 BufferIterator const& eof)
 {
-    return std::find(position, eof, '\n');
+    while ((position != eof) && isBlank(*position)) { ++position; }
+    return position;
 }
 
 /** Skip whitespace.
@@ -264,16 +338,14 @@ inline Buffer::const_iterator getEndOfLine(Buffer::const_iterator const& positio
  * @param[in,out] line_count Line count will be incremented for every encountered newline.
  * @return Iterator to the the next non-whitespace or eof.
  */
-inline Buffer::const_iterator skipWhitespace(Buffer::const_iterator const& position,
-                                             Buffer::const_iterator const& eof,
-                                             int* line_count=NULL)
+inline BufferIterator skipWhitespace(BufferIterator const& position,
+                                     BufferIterator const& eof,
+                                     int* line_count=NULL)
 {
-    Buffer::const_iterator ret = position;
+    BufferIterator ret = position;
     //skip whitespace
     for (;;) {
-        ret = std::find_if_not(ret, eof, [](char c) {
-                return (c == '\r') || (c == ' ') || (c == '\t');
-            });
+        ret = skipBlanks(ret, eof);
         if ((ret == eof) || ((*ret) != '\n')) { break; }
         if (line_count) { ++(*line_count); }
         ++ret;
@@ -281,105 +353,182 @@ inline Buffer::const_iterator skipWhitespace(Buffer::const_iterator const& posit
     return ret;
 }
 
+/** Parse a floating point number.
+ * Accepts the same input as strtof in the C locale: Leading whitespace within the line is skipped
+ * and an optional '+' sign is allowed.
+ * @param[in] p Iterator to the start of the number.
+ * @param[in] eof Iterator to eof.
+ * @param[out] out Parsed number; 0 if no number could be parsed.
+ * @return Iterator to the first character after the number; p if no number could be parsed.
+ */
+inline BufferIterator parseFloat(BufferIterator const& p, BufferIterator const& eof, float& out)
+{
+    BufferIterator pos = skipBlanks(p, eof);
+    if ((pos != eof) && (*pos == '+')) { ++pos; }
+    auto const [pend, ec] = std::from_chars(pos, eof, out);
+    if (ec == std::errc::invalid_argument) {
+        out = 0.0f;
+        return p;
+    } else if (ec == std::errc::result_out_of_range) {
+        // from_chars leaves the result untouched on over- and underflow;
+        // defer to strtof for those, as it rounds to infinity or a denormal respectively.
+        std::string const number(pos, pend);
+        out = std::strtof(number.c_str(), nullptr);
+    }
+    return pend;
+}
+
+/** Parse an integer.
+ * Leading whitespace within the line is skipped and an optional '+' sign is allowed.
+ * @param[in] p Iterator to the start of the number.
+ * @param[in] eof Iterator to eof.
+ * @param[out] out Parsed number; 0 if no number could be parsed.
+ * @return Iterator to the first character after the number; p if no number could be parsed.
+ */
+template<typename Integer_T>
+inline BufferIterator parseInteger(BufferIterator const& p, BufferIterator const& eof, Integer_T& out)
+{
+    BufferIterator pos = skipBlanks(p, eof);
+    if ((pos != eof) && (*pos == '+')) { ++pos; }
+    auto const [pend, ec] = std::from_chars(pos, eof, out);
+    if (ec == std::errc::invalid_argument) {
+        out = 0;
+        return p;
+    } else if (ec == std::errc::result_out_of_range) {
+        GHULBUS_THROW(Exceptions::IOError{}, "Index out of range.");
+    }
+    return pend;
+}
+
 /** Parse a 2d vertex vector.
  * @param[in,out] p Iterator pointing to the first vertex coordinate;
  *                  On return, points to new location to proceed parsing from.
- * @param[out] out std::vector that will receive vertex data.
+ * @param[in] eof Iterator to eof.
+ * @param[out] out Location that will receive vertex data.
  */
-inline void parseVertex2(Buffer::const_iterator& p, std::vector<GhulbusMath::Vector2f>* out)
+inline void parseVertex2(BufferIterator& p, BufferIterator const& eof, GhulbusMath::Vector2f* out)
 {
     float f1, f2;
-    char const* pos = &(*p);
-    char* pend;
-    f1 = std::strtof(pos, &pend);
-    pos = pend;
-    f2 = std::strtof(pos, &pend);
-    out->emplace_back(f1, f2);
-    p += pend - &(*p);
+    p = parseFloat(p, eof, f1);
+    p = parseFloat(p, eof, f2);
+    *out = GhulbusMath::Vector2f(f1, f2);
 }
 
 /** Parse a 3d vertex vector.
  * @param[in,out] p Iterator pointing to the first vertex coordinate;
  *                  On return, points to new location to proceed parsing from.
- * @param[out] out std::vector that will receive vertex data.
+ * @param[in] eof Iterator to eof.
+ * @param[out] out Location that will receive vertex data.
  */
 template<typename Tag>
-inline void parseVertex3(Buffer::const_iterator& p, std::vector<GhulbusMath::Vector3Impl<float, Tag>>* out )
+inline void parseVertex3(BufferIterator& p, BufferIterator const& eof,
+                         GhulbusMath::Vector3Impl<float, Tag>* out)
 {
     float f1, f2, f3;
-    char const* pos = &(*p);
-    char* pend;
-    f1 = std::strtof(pos, &pend);
-    pos = pend;
-    f2 = std::strtof(pos, &pend);
-    pos = pend;
-    f3 = std::strtof(pos, &pend);
-    out->emplace_back(f1, f2, f3);
-    p += pend - &(*p);
+    p = parseFloat(p, eof, f1);
+    p = parseFloat(p, eof, f2);
+    p = parseFloat(p, eof, f3);
+    *out = GhulbusMath::Vector3Impl<float, Tag>(f1, f2, f3);
 }
 
 /** Determine number of vertices per face and what per-vertex data is available.
+ * The layout is taken from the first vertex of the face; the number of vertices is the number of
+ * whitespace-separated tokens preceding a trailing comment, if any.
  * @param[in] p Iterator to the beginning of a line with face data.
  * @param[in] eof Iterator to eof.
  * @param[out] out_mesh Will receive face layout.
  */
-void scanFaceLayout(Buffer::const_iterator const& p,
-                    Buffer::const_iterator const& eof,
+void scanFaceLayout(BufferIterator const& p,
+                    BufferIterator const& eof,
                     ObjParser::FaceData* const out_mesh)
 {
-    std::string const line(p, getEndOfLine(p, eof));
-    std::string tmp;        //< used to get number of vertices per face
-    if (std::regex_search(line, std::regex("(\\s)+(-)?(\\d)+//(-)?(\\d)+(\\s)+"))) {
-        // layout: v//vn
-        out_mesh->hasNormal = true;
-        out_mesh->hasTexCoord = false;
-        tmp = std::regex_replace(line, std::regex("(-)?(\\d)+//(-)?(\\d)+"), std::string("V"));
-    } else if (std::regex_search(line, std::regex("(\\s)+(-)?(\\d)+/(-)?(\\d)+(\\s)+"))) {
-        // layout: v/vt
-        out_mesh->hasNormal = false;
-        out_mesh->hasTexCoord = true;
-        tmp = std::regex_replace(line, std::regex("(-)?(\\d)+/(-)?(\\d)+"), std::string("V"));
-    } else if (std::regex_search(line, std::regex("(\\s)+(-)?(\\d)+/(-)?(\\d)+/(-)?(\\d)+(\\s)+"))) {
-        // layout: v/vt/vn
-        out_mesh->hasNormal = true;
-        out_mesh->hasTexCoord = true;
-        tmp = std::regex_replace(line, std::regex("(-)?(\\d)+/(-)?(\\d)+/(-)?(\\d)+"), std::string("V"));
-    } else {
-        // layout: v
-        out_mesh->hasNormal = false;
-        out_mesh->hasTexCoord = false;
-        tmp = std::regex_replace(line, std::regex("(-)?(\\d)+"), std::string("V"));
+    BufferIterator const eol = std::find(p, getEndOfLine(p, eof), '#');
+    //skip 'f'
+    BufferIterator it = skipBlanks(p + 1, eol);
+    int vertices_per_face = 0;
+    while (it != eol) {
+        BufferIterator const token_end = std::find_if(it, eol, isBlank);
+        if (vertices_per_face == 0) {
+            BufferIterator const first_slash = std::find(it, token_end, '/');
+            if (first_slash == token_end) {
+                // layout: v
+                out_mesh->hasNormal = false;
+                out_mesh->hasTexCoord = false;
+            } else if ((first_slash + 1 != token_end) && (*(first_slash + 1) == '/')) {
+                // layout: v//vn
+                out_mesh->hasNormal = true;
+                out_mesh->hasTexCoord = false;
+            } else if (std::find(first_slash + 1, token_end, '/') == token_end) {
+                // layout: v/vt
+                out_mesh->hasNormal = false;
+                out_mesh->hasTexCoord = true;
+            } else {
+                // layout: v/vt/vn
+                out_mesh->hasNormal = true;
+                out_mesh->hasTexCoord = true;
+            }
+        }
+        ++vertices_per_face;
+        it = skipBlanks(token_end, eol);
     }
-    //count the 'V's in tmp to get vertices per face:
-    out_mesh->verticesPerFace = static_cast<int>(std::count(tmp.begin(), tmp.end(), 'V'));
+    out_mesh->verticesPerFace = vertices_per_face;
     if ((out_mesh->verticesPerFace != 3) && (out_mesh->verticesPerFace != 4)) {
         GHULBUS_THROW(Exceptions::IOError{}, "Invalid number of vertices.");
     }
 }
 
+/** Number of vertex entries of each kind.
+ */
+struct VertexCounts {
+    std::size_t vertex = 0;
+    std::size_t normal = 0;
+    std::size_t texCoord = 0;
+};
+
+/** Determine the kind of a vertex entry.
+ * @param[in] p Iterator to beginning of a line starting with 'v'.
+ * @param[in] eof Iterator to eof.
+ * @return The label character following the 'v' (' ', 't' or 'n' for supported entries); '\0' at eof.
+ */
+inline char getVertexLabel(BufferIterator const& p, BufferIterator const& eof)
+{
+    GHULBUS_PRECONDITION(*p == 'v');
+    return ((p + 1) != eof) ? *(p + 1) : '\0';
+}
+
+/** Write location for vertex entries.
+ * The target VertexData is sized up front, so that chunks can write their vertices concurrently.
+ */
+struct VertexDataCursor {
+    ObjParser::VertexData* target;      ///< Vertex data being written to
+    VertexCounts position;              ///< Number of entries preceding the cursor in the file
+};
+
 /** Parse a vertex entry.
  * @param[in,out] p Iterator to beginning of line; On return, points to new location to proceed parsing from.
- * @param[out] out_mesh Will receive new vertex data.
+ * @param[in] eof Iterator to eof.
+ * @param[in,out] cursor Write location for the new vertex data; Will be advanced past the written entry.
  */
-inline void parseVertex(Buffer::const_iterator& p,
-                        ObjParser::VertexData* const out_mesh)
+inline void parseVertex(BufferIterator& p,
+                        BufferIterator const& eof,
+                        VertexDataCursor& cursor)
 {
-    //skip 'v' and save next char
-    char c = *(++p);
-    //skip next char
-    ++p;
+    char const c = getVertexLabel(p, eof);
     switch(c) {
         case ' ':
             // geometry vertex
-            parseVertex3(p, &out_mesh->vertex);
+            p += 2;
+            parseVertex3(p, eof, &cursor.target->vertex[cursor.position.vertex++]);
             break;
         case 't':
             // texture vertex
-            parseVertex2(p, &out_mesh->texCoord);
+            p += 2;
+            parseVertex2(p, eof, &cursor.target->texCoord[cursor.position.texCoord++]);
             break;
         case 'n':
             // vertex normal
-            parseVertex3(p, &out_mesh->normal);
+            p += 2;
+            parseVertex3(p, eof, &cursor.target->normal[cursor.position.normal++]);
             break;
         default:
             //unknown label
@@ -388,113 +537,162 @@ inline void parseVertex(Buffer::const_iterator& p,
         }
 }
 
-/** Parse a face entry line from OBJ.
- * @param[in,out] p Iterator to beginning of line; On return, points to new location to proceed parsing from.
- * @param[out] out_mesh Will receive new face data.
+/** Skip a single index separator.
+ * @param[in] p Iterator to the character following an index.
+ * @param[in] eof Iterator to eof.
+ * @return Iterator past the separator, or p if there is no separator.
  */
-inline void parseFace(Buffer::const_iterator& p,
-                      ObjParser::FaceData* const out_mesh,
-                      std::vector<IndexTuple>* const out_index_tuple,
-                      ObjParser::VertexData const& vertex_data)
+inline BufferIterator skipIndexSeparator(BufferIterator const& p, BufferIterator const& eof)
 {
-    using IndexType = ObjParser::IndexType;
-    IndexType const max_vertex_index = static_cast<IndexType>(vertex_data.vertex.size()) + 1;
-    IndexType const max_texture_index = static_cast<IndexType>(vertex_data.texCoord.size()) + 1;
-    IndexType const max_normal_index = static_cast<IndexType>(vertex_data.normal.size()) + 1;
+    return ((p != eof) && (*p == '/')) ? (p + 1) : p;
+}
+
+/** Parse the index tuples of a face entry.
+ * @param[in] p Iterator to beginning of line.
+ * @param[in] eof Iterator to eof.
+ * @param[in] layout Face layout, as determined by scanFaceLayout().
+ * @param[in] vertex_counts Number of vertex entries preceding the face in the file; Used to resolve negative indices.
+ * @param[out] out_index_tuples Receives layout.verticesPerFace index tuples. Absent indices are set to 0.
+ * @return Iterator to the first character after the last index.
+ * @throw Exceptions::IOError If an index is 0 or a negative index precedes the first vertex entry.
+ */
+template<typename Index_T>
+inline BufferIterator parseFaceTuples(BufferIterator const& p,
+                                      BufferIterator const& eof,
+                                      ObjParser::FaceData const& layout,
+                                      VertexCounts const& vertex_counts,
+                                      detail::BasicIndexTuple<Index_T>* const out_index_tuples)
+{
+    Index_T const max_vertex_index = static_cast<Index_T>(vertex_counts.vertex) + 1;
+    Index_T const max_texture_index = static_cast<Index_T>(vertex_counts.texCoord) + 1;
+    Index_T const max_normal_index = static_cast<Index_T>(vertex_counts.normal) + 1;
     //skip 'f'
-    char const* pos = &(*(++p));
+    BufferIterator pos = p + 1;
     //parse face indices
-    char* pend = NULL;
-    for (int i=0; i < out_mesh->verticesPerFace; ++i) {
+    for (int i=0; i < layout.verticesPerFace; ++i) {
         //vertex index
-        IndexType v = static_cast<IndexType>(std::strtoll(pos, &pend, 0));
+        Index_T v;
+        pos = parseInteger(pos, eof, v);
         if (v < 0) { v += max_vertex_index; }
-        GHULBUS_ASSERT(v >= 0);
-        out_mesh->faceVertex.push_back(v);
-        (*out_index_tuple)[i].vertexIndex = v;
+        if (v <= 0) { GHULBUS_THROW(Exceptions::IOError{}, "Face index out of range."); }
+        out_index_tuples[i].vertexIndex = v;
         //texcoord index (optional)
-        if (out_mesh->hasTexCoord) {
-            pos = pend + 1;
-            v = static_cast<IndexType>(std::strtoll(pos, &pend, 0));
+        if (layout.hasTexCoord) {
+            pos = parseInteger(skipIndexSeparator(pos, eof), eof, v);
             if (v < 0) { v += max_texture_index; }
-            GHULBUS_ASSERT(v >= 0);
-            out_mesh->faceTexCoord.push_back(v);
-            (*out_index_tuple)[i].textureIndex = v;
+            if (v <= 0) { GHULBUS_THROW(Exceptions::IOError{}, "Face index out of range."); }
+            out_index_tuples[i].textureIndex = v;
         } else {
-            (*out_index_tuple)[i].textureIndex = 0;
+            out_index_tuples[i].textureIndex = 0;
         }
         //normal index (optional)
-        if (out_mesh->hasNormal) {
-            pos = pend + 1;
-            if (*pos == '/') { ++pos; }
-            v = static_cast<IndexType>(std::strtoll(pos, &pend, 0));
+        if (layout.hasNormal) {
+            pos = skipIndexSeparator(pos, eof);
+            if (!layout.hasTexCoord) { pos = skipIndexSeparator(pos, eof); }
+            pos = parseInteger(pos, eof, v);
             if (v < 0) { v += max_normal_index; }
-            GHULBUS_ASSERT(v >= 0);
-            out_mesh->faceNormal.push_back(v);
-            (*out_index_tuple)[i].normalIndex = v;
+            if (v <= 0) { GHULBUS_THROW(Exceptions::IOError{}, "Face index out of range."); }
+            out_index_tuples[i].normalIndex = v;
         } else {
-            (*out_index_tuple)[i].normalIndex = 0;
+            out_index_tuples[i].normalIndex = 0;
         }
-        //adjust position
-        pos = pend + 1;
     }
-    //adjust iterator
-    if (pend != nullptr) { p += pend - &(*p); }
+    return pos;
+}
+
+/** Parse a face entry line from OBJ.
+ * @param[in,out] p Iterator to beginning of line; On return, points to new location to proceed parsing from.
+ * @param[in] eof Iterator to eof.
+ * @param[out] out_mesh Will receive new face data.
+ * @param[out] out_index_tuple Will receive the index tuples of the face.
+ * @param[in] vertex_counts Number of vertex entries preceding the face in the file; Used to resolve negative indices.
+ */
+inline void parseFace(BufferIterator& p,
+                      BufferIterator const& eof,
+                      ObjParser::FaceData* const out_mesh,
+                      std::vector<IndexTuple>* const out_index_tuple,
+                      VertexCounts const& vertex_counts)
+{
+    p = parseFaceTuples(p, eof, *out_mesh, vertex_counts, out_index_tuple->data());
+    for (int i=0; i < out_mesh->verticesPerFace; ++i) {
+        IndexTuple const& t = (*out_index_tuple)[i];
+        out_mesh->faceVertex.push_back(t.vertexIndex);
+        if (out_mesh->hasTexCoord) { out_mesh->faceTexCoord.push_back(t.textureIndex); }
+        if (out_mesh->hasNormal) { out_mesh->faceNormal.push_back(t.normalIndex); }
+    }
 }
 
-/** Retrieve a pointer to a FaceGroup from its name.
+/** Retrieve the index of a FaceGroup from its name.
  * @param[in] name Group name.
  * @param[in,out] face_groups FaceGroups list; if no group of the given name exists, it will be created.
  * @param[in,out] group_names FaceGroupNames list; if no group of the given name exists, it will be created.
+ * @param[in,out] group_indices Lookup for the FaceGroups by name; receives the index of a newly created group.
  */
-inline ObjParser::FaceData*
-    getFaceGroupByName(std::string const& name,
-                       ObjParser::FaceGroups& face_groups,
-                       ObjParser::FaceGroupNames& group_names)
+inline std::size_t getFaceGroupByName(std::string_view name,
+                                      ObjParser::FaceGroups& face_groups,
+                                      ObjParser::FaceGroupNames& group_names,
+                                      ObjParser::FaceGroupIndices& group_indices)
 {
-    //get iterator to group name list
-    auto it_name = std::find(group_names.begin(), group_names.end(), name);
-    if (it_name == group_names.end()) {
-        it_name = group_names.insert(it_name, name);
-        face_groups.push_back(ObjParser::FaceData{});
+    auto const it = group_indices.find(name);
+    if (it != group_indices.end()) {
+        GHULBUS_ASSERT(group_names[it->second] == name);
+        return static_cast<std::size_t>(it->second);
     }
-    GHULBUS_ASSERT((*it_name) == name);
-    //get iterator to mesh data
-    ObjParser::FaceGroups::iterator it_data = face_groups.begin();
-    it_data += std::distance(group_names.begin(), it_name);
-    return &(*it_data);
+    GHULBUS_ASSERT(face_groups.size() < static_cast<std::size_t>(std::numeric_limits<ObjParser::IndexType>::max()));
+    std::size_t const ret = face_groups.size();
+    group_names.emplace_back(name);
+    face_groups.emplace_back();
+    group_indices.emplace(group_names.back(), static_cast<ObjParser::IndexType>(ret));
+    return ret;
 }
 
-/** Process a group switch entry.
+/** Parse the group names of a group switch entry.
  * @param[in,out] p Iterator to beginning of line; On return, points to new location to proceed parsing from.
- * @param[in, out] face_groups Target list of FaceData.
- * @param[in, out] group_names Target GroupNameList.
- * @return A vector of pointers to all MeshData structs active in the current group.
+ * @param[in] eof Iterator to eof.
+ * @return The names of all groups active after the switch; The default group if no name is given.
  */
-inline std::vector<ObjParser::FaceData*>
-    groupSwitch(Buffer::const_iterator& p,
-                ObjParser::FaceGroups& face_groups,
-                ObjParser::FaceGroupNames& group_names)
+inline std::vector<std::string> parseGroupNames(BufferIterator& p,
+                                                BufferIterator const& eof)
 {
     //skip 'g'
     ++p;
-    std::vector<ObjParser::FaceData*> ret;
-    while ((*p) != '\n') {
+    std::vector<std::string> ret;
+    while ((p != eof) && ((*p) != '\n')) {
         //skip ' '
         ++p;
         //parse next group name
-        Buffer::const_iterator group_name_start = p;
-        while (((*p) != ' ') && ((*p) != '\n')) { 
+        BufferIterator group_name_start = p;
+        while ((p != eof) && ((*p) != ' ') && ((*p) != '\n')) { 
             ++p; 
         }
-        std::string const group_name(group_name_start, p);
-        //add mesh data to return list
-        ret.push_back(getFaceGroupByName(group_name, face_groups, group_names));
+        ret.emplace_back(group_name_start, p);
     }
     if (ret.empty()) {
         //default group
-        std::string const group_name("default");
-        ret.push_back(getFaceGroupByName(group_name, face_groups, group_names));
+        ret.emplace_back("default");
+    }
+    return ret;
+}
+
+/** Process a group switch entry.
+ * @param[in,out] p Iterator to beginning of line; On return, points to new location to proceed parsing from.
+ * @param[in] eof Iterator to eof.
+ * @param[in, out] face_groups Target list of FaceData.
+ * @param[in, out] group_names Target GroupNameList.
+ * @param[in, out] group_indices Lookup for the target FaceData by name.
+ * @return The indices of all FaceData entries active in the current group.
+ */
+inline std::vector<std::size_t>
+    groupSwitch(BufferIterator& p,
+                BufferIterator const& eof,
+                ObjParser::FaceGroups& face_groups,
+                ObjParser::FaceGroupNames& group_names,
+                ObjParser::FaceGroupIndices& group_indices)
+{
+    std::vector<std::size_t> ret;
+    for (auto const& group_name : parseGroupNames(p, eof)) {
+        //add mesh data to return list
+        ret.push_back(getFaceGroupByName(group_name, face_groups, group_names, group_indices));
     }
     return ret;
 }
@@ -502,65 +700,163 @@ inline std::vector<ObjParser::FaceData*>
 /** Remove empty group entries.
  * @param[in,out] face_groups Group list; empty group entries will be removed.
  * @param[in,out] group_names Name list; names referring to empty groups will be removed.
+ * @param[in,out] group_indices Lookup for the groups by name; rebuilt for the remaining groups.
+ * @param[in,out] submesh_ranges Flat data ranges; ranges of empty groups will be removed.
  */
 inline void removeEmptyGroups(ObjParser::FaceGroups& face_groups,
-                              ObjParser::FaceGroupNames& group_names)
+                              ObjParser::FaceGroupNames& group_names,
+                              ObjParser::FaceGroupIndices& group_indices,
+                              ObjParser::SubmeshRanges& submesh_ranges)
 {
-    ObjParser::FaceGroups::iterator it_face = face_groups.begin();
-    ObjParser::FaceGroupNames::iterator it_name = group_names.begin();
+    GHULBUS_ASSERT((face_groups.size() == group_names.size()) && (face_groups.size() == submesh_ranges.size()));
+    std::size_t n_groups = 0;
+    for (std::size_t i = 0; i < face_groups.size(); ++i) {
+        if (face_groups[i].faceVertex.empty()) { continue; }
+        if (i != n_groups) {
+            face_groups[n_groups] = std::move(face_groups[i]);
+            group_names[n_groups] = std::move(group_names[i]);
+            submesh_ranges[n_groups] = submesh_ranges[i];
+        }
+        ++n_groups;
+    }
+    if (n_groups == face_groups.size()) { return; }
+    face_groups.resize(n_groups);
+    group_names.resize(n_groups);
+    submesh_ranges.resize(n_groups);
+    group_indices.clear();
+    for (std::size_t i = 0; i < n_groups; ++i) {
+        group_indices.emplace(group_names[i], static_cast<ObjParser::IndexType>(i));
+    }
+}
 
-    while (it_name != group_names.end()) {
-        if (it_face->faceVertex.empty()) {
-            it_face = face_groups.erase(it_face);
-            it_name = group_names.erase(it_name);
-        } else {
-            ++it_face;
-            ++it_name;
+/** A run of consecutive faces of a chunk belonging to the same face group.
+ */
+struct GroupRun {
+    std::size_t group;                          ///< Index of the face group in the chunk
+    std::size_t indicesBegin;                   ///< Position of the first flat index of the run in the chunk
+    std::size_t indicesEnd;                     ///< Position one past the last flat index of the run in the chunk
+    std::size_t flatIndicesBegin;               ///< Position of the first flat index of the run in the mesh
+    ObjParser::IndexType minVertex;             ///< Smallest flat vertex index referenced by the run
+    ObjParser::IndexType maxVertex;             ///< Largest flat vertex index referenced by the run
+};
+
+/** Partial results from parsing a chunk of an OBJ file.
+ */
+struct ChunkData {
+    BufferIterator begin;                       ///< Beginning of the chunk; Always at the beginning of a line
+    BufferIterator end;                         ///< End of the chunk; Always after a newline or at eof
+    VertexCounts vertexCounts;                  ///< Number of vertex entries in the chunk
+    std::size_t faceCount = 0;                  ///< Number of face entries in the chunk
+    BufferIterator lastGroupSwitch = nullptr;   ///< Beginning of the last group switch entry in the chunk, if any
+    ObjParser::FaceGroups faceGroups;           ///< Face data for all groups referenced in the chunk
+    ObjParser::FaceGroupNames groupNames;       ///< Names of the groups, in order of first reference
+    ObjParser::FaceGroupIndices groupIndices;   ///< Lookup for the groups of the chunk by name
+    std::vector<std::size_t> meshGroups;        ///< Index of the face group in the mesh for each group of the chunk
+    std::vector<GroupRun> groupRuns;            ///< Runs of faces of the same group, in file order
+    IndexTupleMap indexTupleMap;                ///< Map from index tuples to their position in uniqueTuples
+    std::vector<IndexTuple> uniqueTuples;       ///< Distinct index tuples, in order of first occurrence
+    ObjParser::IndexDataFlat localIndices;      ///< Flattened indices into uniqueTuples
+    std::vector<ObjParser::IndexType> globalIndices;    ///< Flat vertex index for each entry in uniqueTuples
+    int lineCount = 0;                          ///< Number of lines in the chunk, not counting the last one
+};
+
+/** Minimum size in bytes of a chunk processed by a single thread.
+ * Smaller files are parsed on the calling thread only.
+ */
+std::size_t constexpr minimum_chunk_size = 1 << 20;
+
+/** Split data into chunks at line boundaries.
+ * @param[in] data Buffer holding a complete OBJ file.
+ * @param[in] max_chunks Upper bound for the number of chunks.
+ * @return Non-empty chunks, in file order, covering the complete data.
+ */
+std::vector<ChunkData> splitIntoChunks(Buffer data, std::size_t max_chunks)
+{
+    std::size_t const n_chunks = std::clamp<std::size_t>(data.size() / minimum_chunk_size, 1, max_chunks);
+    BufferIterator const eof = data.data() + data.size();
+    std::vector<ChunkData> ret;
+    ret.reserve(n_chunks);
+    BufferIterator chunk_begin = data.data();
+    for (std::size_t i = 1; (i <= n_chunks) && (chunk_begin != eof); ++i) {
+        BufferIterator chunk_end = eof;
+        if (i != n_chunks) {
+            BufferIterator const split_point = std::max(data.data() + (data.size() / n_chunks) * i, chunk_begin);
+            chunk_end = getEndOfLine(split_point, eof);
+            if (chunk_end != eof) { ++chunk_end; }
+        }
+        if (chunk_end != chunk_begin) {
+            ret.emplace_back();
+            ret.back().begin = chunk_begin;
+            ret.back().end = chunk_end;
         }
+        chunk_begin = chunk_end;
+    }
+    return ret;
+}
+
+/** Invoke a function once for every chunk, distributing the invocations across threads.
+ * @param[in] n_chunks Number of chunks.
+ * @param[in] f Function invoked with the index of a chunk.
+ * @throw Rethrows the first exception thrown by any of the invocations, after all invocations have finished.
+ */
+template<typename F>
+void forEachChunk(std::size_t n_chunks, F const& f)
+{
+    std::vector<std::future<void>> workers;
+    workers.reserve(n_chunks);
+    auto const guard_workers = Ghulbus::finally([&workers]() {
+            for (auto& w : workers) { if (w.valid()) { w.wait(); } }
+        });
+    for (std::size_t i = 1; i < n_chunks; ++i) {
+        workers.push_back(std::async(std::launch::async, [&f, i]() { f(i); }));
     }
+    if (n_chunks > 0) { f(0); }
+    for (auto& w : workers) { w.get(); }
 }
 
+/** Count lines, vertex and face entries and find the last group switch in a chunk.
+ * @param[in,out] chunk Chunk to scan.
+ */
+void scanChunk(ChunkData& chunk)
+{
+    BufferIterator position = skipWhitespace(chunk.begin, chunk.end, &chunk.lineCount);
+    while (position != chunk.end) {
+        if (*position == 'v') {
+            switch (getVertexLabel(position, chunk.end)) {
+            case ' ': ++chunk.vertexCounts.vertex; break;
+            case 't': ++chunk.vertexCounts.texCoord; break;
+            case 'n': ++chunk.vertexCounts.normal; break;
+            }
+        } else if (*position == 'f') {
+            ++chunk.faceCount;
+        } else if (*position == 'g') {
+            chunk.lastGroupSwitch = position;
+        }
+        position = skipWhitespace(getEndOfLine(position, chunk.end), chunk.end, &chunk.lineCount);
+    }
+}
+
+/** Add a face to the flattened index data of a chunk.
+ * @param[in] index_tuples Index tuples of the face.
+ * @param[in,out] index_tuple_map Map from index tuples of the chunk to their position in unique_tuples.
+ * @param[in,out] unique_tuples Distinct index tuples of the chunk; New tuples will be appended.
+ * @param[in,out] out_flat_index_data Flat index data of the chunk, referring to entries in unique_tuples.
+ */
 inline void addFlattenedFaces(std::vector<IndexTuple> const& index_tuples,
                               IndexTupleMap& index_tuple_map,
-                              ObjParser::VertexData const& vertex_data,
-                              ObjParser::VertexDataFlat& out_flat_vertex_data,
+                              std::vector<IndexTuple>& unique_tuples,
                               ObjParser::IndexDataFlat& out_flat_index_data)
 {
     auto const it_end = index_tuples.end();
     for (auto it = index_tuples.begin(); it != it_end; ++it) {
-        GHULBUS_ASSERT((it->vertexIndex > 0) && (static_cast<std::size_t>(it->vertexIndex) <= vertex_data.vertex.size()));
-        GHULBUS_ASSERT((vertex_data.normal.empty()) ||
-                       ((it->normalIndex >= 0) && (static_cast<std::size_t>(it->normalIndex) <= vertex_data.normal.size())));
-        GHULBUS_ASSERT((vertex_data.texCoord.empty()) ||
-                       ((it->textureIndex >= 0) && (static_cast<std::size_t>(it->textureIndex) <= vertex_data.texCoord.size())));
-        IndexTupleMap::iterator map_it = index_tuple_map.find(*it);
-        if (map_it == index_tuple_map.end()) {
-            /// index tuple does not exist; create a new vertex
-            ObjParser::VertexEntryFlat v;
-            size_t constexpr position = *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Position);
-            size_t constexpr normal = *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Normal);
-            size_t constexpr texture = *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Texture);
-            get<position>(v) = vertex_data.vertex[it->vertexIndex - 1];
-            if (vertex_data.normal.empty()) {
-                get<normal>(v) = GhulbusMath::Normal3f(1.0f, 0.0f, 0.0f);
-            } else {
-                get<normal>(v) = vertex_data.normal[it->normalIndex - 1];
-            }
-            if (vertex_data.texCoord.empty()) {
-                get<texture>(v) = GhulbusMath::Vector2f(0.0f, 0.0f);
-            } else {
-                get<texture>(v) = vertex_data.texCoord[it->textureIndex - 1];
-            }
-            // add new vertex to flat data structures
-            out_flat_vertex_data.getStorage().push_back(v);
-            GHULBUS_ASSERT(out_flat_vertex_data.size() < std::numeric_limits<ObjParser::IndexType>::max());
-            auto const index = static_cast<ObjParser::IndexType>(out_flat_vertex_data.size()) - 1;
-            index_tuple_map[(*it)] = index;
-            out_flat_index_data.push_back(index);
-        } else {
-            /// index tuple does exist; reuse existing flat vertex
-            out_flat_index_data.push_back(map_it->second);
+        GHULBUS_ASSERT(unique_tuples.size() < std::numeric_limits<ObjParser::IndexType>::max());
+        auto const [index, was_inserted] =
+            index_tuple_map.tryEmplace(*it, static_cast<ObjParser::IndexType>(unique_tuples.size()));
+        if (was_inserted) {
+            /// index tuple does not exist yet; it will become a new vertex
+            unique_tuples.push_back(*it);
         }
+        out_flat_index_data.push_back(index);
     }
     if (index_tuples.size() == 4) {
         ///Quad mesh; Add second triangle
@@ -569,61 +865,766 @@ inline void addFlattenedFaces(std::vector<IndexTuple> const& index_tuples,
     }
 }
 
-/**
- * @param[in] data Buffer holding a complete OBJ file.
- * @param[out] out_mesh Processed mesh data.
+/** Parse all entries in a chunk.
+ * @param[in,out] chunk Chunk to parse; Receives the chunk-local face data.
+ * @param[in] eof Iterator to eof.
+ * @param[in] initial_group_switch Last group switch entry preceding the chunk in the file, if any.
+ * @param[in] cursor Write location for the vertex entries of the chunk.
+ * @param[in] first_line Line number of the beginning of the chunk.
  */
-void parseData(Buffer const& data,
-               ObjParser::VertexData& out_vertex_data,
-               ObjParser::FaceGroups& out_face_groups,
-               ObjParser::FaceGroupNames& out_group_names,
-               ObjParser::VertexDataFlat& out_flat_vertex_data,
-               ObjParser::IndexDataFlat& out_flat_index_data)
+void parseChunk(ChunkData& chunk,
+                BufferIterator const& eof,
+                BufferIterator initial_group_switch,
+                VertexDataCursor cursor,
+                int first_line)
 {
-    Buffer::const_iterator const eof = data.end();
-    Buffer::const_iterator position = data.begin();
-    std::vector<ObjParser::FaceData*> face_target_groups;
-    IndexTupleMap index_tuple_map;
+    int line_index = first_line;
+    std::vector<std::size_t> face_target_groups;
     std::vector<IndexTuple> tmp_tuple;
-    int line_index = 1;
-    while (position != eof) {
+    // a rough estimate: closed triangle meshes have about half as many vertices as faces,
+    // quad meshes and meshes with split normals or texture seams have more.
+    chunk.indexTupleMap.reserve(chunk.faceCount);
+    chunk.uniqueTuples.reserve(chunk.faceCount);
+    chunk.localIndices.reserve(chunk.faceCount * 3);
+    if (initial_group_switch) {
+        face_target_groups = groupSwitch(initial_group_switch, eof, chunk.faceGroups, chunk.groupNames,
+                                         chunk.groupIndices);
+    }
+    BufferIterator position = skipWhitespace(chunk.begin, chunk.end, &line_index);
+    while (position != chunk.end) {
         switch (*position) {
         case '#': /* comment; skip line */  break;
         case '\0': /* end of string */  break;
         case 'g':
-            face_target_groups = groupSwitch(position, out_face_groups, out_group_names);
+            face_target_groups = groupSwitch(position, chunk.end, chunk.faceGroups, chunk.groupNames,
+                                             chunk.groupIndices);
             if (face_target_groups.size() != 1) {
                 GHULBUS_THROW(Exceptions::NotImplemented(), "Multiple target groups not supported.");
             }
             break;
         case 'v':
-            parseVertex(position, &out_vertex_data);
+            parseVertex(position, chunk.end, cursor);
             break;
         case 'f':
+        {
             if (face_target_groups.empty()) {
-                face_target_groups.push_back(getFaceGroupByName("default", out_face_groups, out_group_names));
+                face_target_groups.push_back(getFaceGroupByName("default", chunk.faceGroups, chunk.groupNames,
+                                                                chunk.groupIndices));
             }
-            if (face_target_groups.front()->verticesPerFace <= 0) {
-                scanFaceLayout(position, eof, face_target_groups.front());
-                tmp_tuple.resize(face_target_groups.front()->verticesPerFace, IndexTuple { 0, 0, 0 });
+            std::size_t const group = face_target_groups.front();
+            ObjParser::FaceData* const face_data = &chunk.faceGroups[group];
+            if (face_data->verticesPerFace <= 0) {
+                scanFaceLayout(position, chunk.end, face_data);
             }
-            parseFace(position, face_target_groups.front(), &tmp_tuple, out_vertex_data);
-            GHULBUS_ASSERT( ((*position) == '\n') ||
-                            ((*position) == '\r') ||
-                            ((*skipWhitespace(position, eof)) == '\n') );
-            addFlattenedFaces( tmp_tuple, index_tuple_map, out_vertex_data,
-                               out_flat_vertex_data, out_flat_index_data );
+            tmp_tuple.resize(face_data->verticesPerFace, IndexTuple { 0, 0, 0 });
+            parseFace(position, chunk.end, face_data, &tmp_tuple, cursor.position);
+            GHULBUS_ASSERT( (skipBlanks(position, chunk.end) == chunk.end) ||
+                            ((*skipBlanks(position, chunk.end)) == '\n') ||
+                            ((*skipBlanks(position, chunk.end)) == '#') );
+            if (chunk.groupRuns.empty() || (chunk.groupRuns.back().group != group)) {
+                if (!chunk.groupRuns.empty()) { chunk.groupRuns.back().indicesEnd = chunk.localIndices.size(); }
+                chunk.groupRuns.push_back(GroupRun{ group, chunk.localIndices.size(), 0, 0, 0, 0 });
+            }
+            addFlattenedFaces(tmp_tuple, chunk.indexTupleMap, chunk.uniqueTuples, chunk.localIndices);
             break;
+        }
         default:
             GHULBUS_LOG(Warning, "Unknown label: \'" << (*position) << "\' at line " << line_index);
             break;
         }
         //advance to next line
-        position = skipWhitespace(getEndOfLine(position, eof), eof, &line_index);
+        position = skipWhitespace(getEndOfLine(position, chunk.end), chunk.end, &line_index);
     }
+    if (!chunk.groupRuns.empty()) { chunk.groupRuns.back().indicesEnd = chunk.localIndices.size(); }
+    GHULBUS_ASSERT(line_index == first_line + chunk.lineCount);
+}
+
+/** Append the face data of a chunk to the face groups of the mesh.
+ * @param[in,out] chunk Parsed chunk; Receives the index of the face group in the mesh for each of its groups.
+ * @param[in,out] out_face_groups Face groups of the mesh.
+ * @param[in,out] out_group_names Group names of the mesh.
+ * @param[in,out] out_group_indices Lookup for the face groups of the mesh by name.
+ */
+void mergeChunkFaceGroups(ChunkData& chunk,
+                          ObjParser::FaceGroups& out_face_groups,
+                          ObjParser::FaceGroupNames& out_group_names,
+                          ObjParser::FaceGroupIndices& out_group_indices)
+{
+    chunk.meshGroups.reserve(chunk.groupNames.size());
+    for (std::size_t i = 0; i < chunk.groupNames.size(); ++i) {
+        ObjParser::FaceData const& src = chunk.faceGroups[i];
+        chunk.meshGroups.push_back(getFaceGroupByName(chunk.groupNames[i], out_face_groups, out_group_names,
+                                                      out_group_indices));
+        ObjParser::FaceData* dst = &out_face_groups[chunk.meshGroups.back()];
+        if (src.verticesPerFace <= 0) { continue; }
+        if (dst->verticesPerFace <= 0) {
+            dst->verticesPerFace = src.verticesPerFace;
+            dst->hasNormal = src.hasNormal;
+            dst->hasTexCoord = src.hasTexCoord;
+        } else if ((dst->verticesPerFace != src.verticesPerFace) ||
+                   (dst->hasNormal != src.hasNormal) ||
+                   (dst->hasTexCoord != src.hasTexCoord))
+        {
+            GHULBUS_THROW(Exceptions::IOError{}, "Inconsistent face layout within group.");
+        }
+        dst->faceVertex.insert(dst->faceVertex.end(), src.faceVertex.begin(), src.faceVertex.end());
+        dst->faceNormal.insert(dst->faceNormal.end(), src.faceNormal.begin(), src.faceNormal.end());
+        dst->faceTexCoord.insert(dst->faceTexCoord.end(), src.faceTexCoord.begin(), src.faceTexCoord.end());
+    }
+}
+
+/** Build a flat vertex from an index tuple.
+ * @param[in] t Index tuple.
+ * @throw Exceptions::IOError If an index does not refer to an entry of vertex_data.
+ * @param[in] vertex_data Vertex data of the mesh.
+ * @param[out] out Receives the flat vertex.
+ */
+template<typename Index_T>
+inline void buildFlatVertex(detail::BasicIndexTuple<Index_T> const& t,
+                            ObjParser::VertexData const& vertex_data,
+                            ObjParser::VertexEntryFlat& out)
+{
+    if ((t.vertexIndex <= 0) || (static_cast<std::uint64_t>(t.vertexIndex) > vertex_data.vertex.size()) ||
+        (t.normalIndex < 0) || (static_cast<std::uint64_t>(t.normalIndex) > vertex_data.normal.size()) ||
+        (t.textureIndex < 0) || (static_cast<std::uint64_t>(t.textureIndex) > vertex_data.texCoord.size()))
+    {
+        GHULBUS_THROW(Exceptions::IOError{}, "Face index out of range.");
+    }
+    size_t constexpr position = *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Position);
+    size_t constexpr normal = *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Normal);
+    size_t constexpr texture = *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Texture);
+    get<position>(out) = vertex_data.vertex[t.vertexIndex - 1];
+    if (t.normalIndex == 0) {
+        get<normal>(out) = GhulbusMath::Normal3f(1.0f, 0.0f, 0.0f);
+    } else {
+        get<normal>(out) = vertex_data.normal[t.normalIndex - 1];
+    }
+    if (t.textureIndex == 0) {
+        get<texture>(out) = GhulbusMath::Vector2f(0.0f, 0.0f);
+    } else {
+        get<texture>(out) = vertex_data.texCoord[t.textureIndex - 1];
+    }
+}
+
+/**
+ * @param[in] data Buffer holding a complete OBJ file.
+ * @param[in] max_threads Maximum number of threads to use for parsing.
+ * @param[out] out_mesh Processed mesh data.
+ * @param[out] out_submesh_ranges Flat data ranges of the face groups.
+ * @param[in] flat_storage Provides the destination for the flattened mesh data.
+ * @note The file is split into chunks at line boundaries, which are processed in three concurrent passes:
+ *       A scan counting the vertex entries, the actual parse, and the construction of the flattened data.
+ *       Only merging the distinct index tuples of the chunks into the flat vertex list runs sequentially.
+ *       The results are identical to parsing the whole file in one go.
+ *       Flat indices are sorted by face group and keep their file order within each group.
+ */
+void parseData(Buffer data,
+               std::size_t max_threads,
+               ObjParser::VertexData& out_vertex_data,
+               ObjParser::FaceGroups& out_face_groups,
+               ObjParser::FaceGroupNames& out_group_names,
+               ObjParser::FaceGroupIndices& out_group_indices,
+               ObjParser::SubmeshRanges& out_submesh_ranges,
+               ObjParser::FlatStorageProvider const& flat_storage)
+{
+    BufferIterator const eof = data.data() + data.size();
+    std::vector<ChunkData> chunks = splitIntoChunks(data, max_threads);
+
+    // count vertex entries, so that every chunk knows where its vertex entries go
+    forEachChunk(chunks.size(), [&chunks](std::size_t i) { scanChunk(chunks[i]); });
+    std::vector<VertexDataCursor> cursors;
+    std::vector<BufferIterator> initial_group_switches;
+    std::vector<int> first_lines;
+    VertexDataCursor cursor{ &out_vertex_data, VertexCounts{} };
+    BufferIterator group_switch = nullptr;
+    int line_count = 1;
+    for (auto const& chunk : chunks) {
+        cursors.push_back(cursor);
+        initial_group_switches.push_back(group_switch);
+        first_lines.push_back(line_count);
+        line_count += chunk.lineCount;
+        cursor.position.vertex += chunk.vertexCounts.vertex;
+        cursor.position.normal += chunk.vertexCounts.normal;
+        cursor.position.texCoord += chunk.vertexCounts.texCoord;
+        if (chunk.lastGroupSwitch) { group_switch = chunk.lastGroupSwitch; }
+    }
+    if (std::max({cursor.position.vertex, cursor.position.normal, cursor.position.texCoord}) >=
+        static_cast<std::size_t>(std::numeric_limits<ObjParser::IndexType>::max()))
+    {
+        GHULBUS_THROW(Exceptions::IOError{}, "Too many vertices.");
+    }
+    out_vertex_data.vertex.resize(cursor.position.vertex);
+    out_vertex_data.normal.resize(cursor.position.normal);
+    out_vertex_data.texCoord.resize(cursor.position.texCoord);
+
+    // parse
+    forEachChunk(chunks.size(), [&](std::size_t i) {
+            parseChunk(chunks[i], eof, initial_group_switches[i], cursors[i], first_lines[i]);
+        });
+
+    // merge face groups and assign flat vertex indices in file order
+    std::size_t const total_unique_tuples = std::accumulate(chunks.begin(), chunks.end(), std::size_t{ 0 },
+        [](std::size_t acc, ChunkData const& chunk) { return acc + chunk.uniqueTuples.size(); });
+    IndexTupleMap index_tuple_map;
+    std::vector<IndexTuple> flat_tuples;
+    std::size_t flat_index_count = 0;
+    for (auto& chunk : chunks) {
+        mergeChunkFaceGroups(chunk, out_face_groups, out_group_names, out_group_indices);
+        if (&chunk == &chunks.front()) {
+            // all tuples of the first chunk are new; its local indices are already the global ones
+            chunk.globalIndices.resize(chunk.uniqueTuples.size());
+            std::iota(chunk.globalIndices.begin(), chunk.globalIndices.end(), 0);
+            index_tuple_map = std::move(chunk.indexTupleMap);
+            flat_tuples = std::move(chunk.uniqueTuples);
+            index_tuple_map.reserve(total_unique_tuples);
+            flat_tuples.reserve(total_unique_tuples);
+        } else {
+            chunk.globalIndices.reserve(chunk.uniqueTuples.size());
+            for (auto const& t : chunk.uniqueTuples) {
+                auto const [index, was_inserted] =
+                    index_tuple_map.tryEmplace(t, static_cast<ObjParser::IndexType>(flat_tuples.size()));
+                if (was_inserted) {
+                    flat_tuples.push_back(t);
+                    GHULBUS_ASSERT(flat_tuples.size() < std::numeric_limits<ObjParser::IndexType>::max());
+                }
+                chunk.globalIndices.push_back(index);
+            }
+        }
+        flat_index_count += chunk.localIndices.size();
+    }
+
+    // place the flat indices of each face group consecutively, in order of the groups
+    std::vector<std::size_t> group_index_cursors(out_face_groups.size(), 0);
+    for (auto const& chunk : chunks) {
+        for (auto const& run : chunk.groupRuns) {
+            group_index_cursors[chunk.meshGroups[run.group]] += run.indicesEnd - run.indicesBegin;
+        }
+    }
+    out_submesh_ranges.resize(out_face_groups.size());
+    std::size_t group_first_index = 0;
+    for (std::size_t i = 0; i < out_face_groups.size(); ++i) {
+        std::size_t const group_index_count = group_index_cursors[i];
+        out_submesh_ranges[i] = ObjParser::SubmeshRange{ static_cast<ObjParser::IndexType>(group_first_index),
+                                                         static_cast<ObjParser::IndexType>(group_index_count),
+                                                         0, 0 };
+        group_index_cursors[i] = group_first_index;
+        group_first_index += group_index_count;
+    }
+    GHULBUS_ASSERT(group_first_index == flat_index_count);
+    for (auto& chunk : chunks) {
+        for (auto& run : chunk.groupRuns) {
+            std::size_t& cursor = group_index_cursors[chunk.meshGroups[run.group]];
+            run.flatIndicesBegin = cursor;
+            cursor += run.indicesEnd - run.indicesBegin;
+        }
+    }
+
+    // build flat vertices and indices
+    ObjParser::FlatStorage const out_flat = flat_storage(flat_tuples.size(), flat_index_count);
+    GHULBUS_PRECONDITION((out_flat.vertices.size() >= flat_tuples.size()) &&
+                         (out_flat.indices.size() >= flat_index_count));
+    forEachChunk(chunks.size(), [&](std::size_t i) {
+            std::size_t const vertices_begin = (flat_tuples.size() / chunks.size()) * i;
+            std::size_t const vertices_end =
+                (i == chunks.size() - 1) ? flat_tuples.size() : ((flat_tuples.size() / chunks.size()) * (i + 1));
+            for (std::size_t j = vertices_begin; j < vertices_end; ++j) {
+                buildFlatVertex(flat_tuples[j], out_vertex_data, out_flat.vertices[j]);
+            }
+            ChunkData& chunk = chunks[i];
+            for (GroupRun& run : chunk.groupRuns) {
+                ObjParser::IndexType min_vertex = std::numeric_limits<ObjParser::IndexType>::max();
+                ObjParser::IndexType max_vertex = 0;
+                std::transform(chunk.localIndices.begin() + run.indicesBegin,
+                               chunk.localIndices.begin() + run.indicesEnd,
+                               out_flat.indices.begin() + run.flatIndicesBegin,
+                               [&chunk, &min_vertex, &max_vertex](ObjParser::IndexType local_index) {
+                                   ObjParser::IndexType const global_index = chunk.globalIndices[local_index];
+                                   min_vertex = std::min(min_vertex, global_index);
+                                   max_vertex = std::max(max_vertex, global_index);
+                                   return global_index;
+                               });
+                run.minVertex = min_vertex;
+                run.maxVertex = max_vertex;
+            }
+        });
+
+    // vertex ranges of the groups
+    std::vector<ObjParser::IndexType> group_max_vertex(out_face_groups.size(), 0);
+    for (auto& range : out_submesh_ranges) { range.firstVertex = std::numeric_limits<ObjParser::IndexType>::max(); }
+    for (auto const& chunk : chunks) {
+        for (auto const& run : chunk.groupRuns) {
+            std::size_t const group = chunk.meshGroups[run.group];
+            out_submesh_ranges[group].firstVertex = std::min(out_submesh_ranges[group].firstVertex, run.minVertex);
+            group_max_vertex[group] = std::max(group_max_vertex[group], run.maxVertex);
+        }
+    }
+    for (std::size_t i = 0; i < out_submesh_ranges.size(); ++i) {
+        ObjParser::SubmeshRange& range = out_submesh_ranges[i];
+        if (range.indexCount == 0) {
+            range.firstVertex = 0;
+        } else {
+            range.vertexCount = group_max_vertex[i] - range.firstVertex + 1;
+        }
+    }
+
     //remove empty groups
-    removeEmptyGroups(out_face_groups, out_group_names);
-    GHULBUS_LOG(Debug, "OBJ Loader processed total of " << line_index << " lines.");
+    removeEmptyGroups(out_face_groups, out_group_names, out_group_indices, out_submesh_ranges);
+    GHULBUS_LOG(Debug, "OBJ Loader processed total of " << line_count << " lines in " << chunks.size() << " chunks.");
+}
+
+/** Kind of a supported vertex entry.
+ */
+enum class VertexEntryKind {
+    Vertex = 0,
+    TexCoord = 1,
+    Normal = 2
+};
+
+/** Determine the kind of a vertex entry from its label.
+ * @param[in] label Label character following the 'v', see getVertexLabel().
+ * @return The kind of entry or std::nullopt for unsupported labels.
+ */
+inline std::optional<VertexEntryKind> getVertexEntryKind(char label)
+{
+    switch (label) {
+    case ' ': return VertexEntryKind::Vertex;
+    case 't': return VertexEntryKind::TexCoord;
+    case 'n': return VertexEntryKind::Normal;
+    default:  return std::nullopt;
+    }
+}
+
+/** Read a stream in windows of complete lines.
+ * @param[in] fin Stream positioned at the first line to read.
+ * @param[in,out] buffer Read buffer; Its size is the size of a window. Grows if a single line does not fit.
+ * @param[in] window_cb Invoked with each window and its offset relative to the initial stream position.
+ *                      Reading stops early if it returns false.
+ * @note Every window is cut at the last newline it contains; the incomplete line at its end is moved to
+ *       the front of the buffer before reading the next window.
+ */
+template<typename WindowCallback_T>
+void readWindows(std::istream& fin, std::vector<char>& buffer, WindowCallback_T const& window_cb)
+{
+    std::uint64_t window_offset = 0;
+    std::size_t carry = 0;
+    for (;;) {
+        if (carry == buffer.size()) {
+            // a single line does not fit into the window
+            buffer.resize(buffer.size() * 2);
+        }
+        fin.read(buffer.data() + carry, static_cast<std::streamsize>(buffer.size() - carry));
+        std::size_t const window_end = carry + static_cast<std::size_t>(fin.gcount());
+        if (fin.bad()) {
+            GHULBUS_THROW(Exceptions::IOError{}, "Error reading file.");
+        }
+        if (!fin) {
+            window_cb(Buffer(buffer.data(), window_end), window_offset);
+            return;
+        }
+        auto const it_last_newline = std::find(std::make_reverse_iterator(buffer.begin() + window_end),
+                                               buffer.rend(), '\n');
+        std::size_t const lines_end = static_cast<std::size_t>(buffer.rend() - it_last_newline);
+        if (!window_cb(Buffer(buffer.data(), lines_end), window_offset)) { return; }
+        carry = window_end - lines_end;
+        std::memmove(buffer.data(), buffer.data() + lines_end, carry);
+        window_offset += lines_end;
+    }
+}
+
+/** Vertex entries of a streamed file that are all kept in memory.
+ */
+class RetainedVertexEntries {
+private:
+    ObjParser::VertexData m_vertexData;                 ///< All vertex entries read so far
+public:
+    VertexCounts getCounts() const
+    {
+        return VertexCounts{ m_vertexData.vertex.size(), m_vertexData.normal.size(), m_vertexData.texCoord.size() };
+    }
+
+    /** Read the entry at p.
+     * @param[in,out] p Iterator to the first coordinate of the entry.
+     */
+    void addEntry(VertexEntryKind kind, BufferIterator& p, BufferIterator const& eof)
+    {
+        switch (kind) {
+        case VertexEntryKind::Vertex:   parseVertex3(p, eof, &m_vertexData.vertex.emplace_back());   break;
+        case VertexEntryKind::TexCoord: parseVertex2(p, eof, &m_vertexData.texCoord.emplace_back()); break;
+        case VertexEntryKind::Normal:   parseVertex3(p, eof, &m_vertexData.normal.emplace_back());   break;
+        }
+    }
+
+    void buildFlat(IndexTuple64 const& t, ObjParser::VertexEntryFlat& out)
+    {
+        buildFlatVertex(t, m_vertexData, out);
+    }
+};
+
+/** Vertex entries of a streamed file that are read again from the file when a face refers to them.
+ * A first pass over the file records the file offset of every entriesPerBlock-th entry of each kind.
+ * Faces look up their entries in blocks of entriesPerBlock consecutive entries of a kind, which are parsed
+ * from the file on demand and kept in a least recently used cache. The offsets and the cache together
+ * stay within the memory limit, no matter how many entries the file has.
+ */
+class FileVertexEntries {
+public:
+    static constexpr std::size_t entriesPerBlock = 1024;
+    static constexpr std::size_t blockReadSize = 64u << 10;
+    /// Size of the largest block, for the kinds with three components
+    static constexpr std::size_t maxBlockBytes = entriesPerBlock * 3 * sizeof(float);
+private:
+    struct Block {
+        std::uint64_t key;                              ///< Block index times 3 plus kind
+        std::vector<float> values;                      ///< Components of the entries of the block
+    };
+    std::ifstream m_fin;
+    std::vector<char> m_buffer;                         ///< Read buffer for blocks
+    std::array<std::vector<std::uint64_t>, 3> m_blockOffsets;   ///< Indexed by kind, then by block
+    std::array<std::uint64_t, 3> m_totalCounts;         ///< Number of entries in the file, indexed by kind
+    VertexCounts m_counts;                              ///< Number of entries read so far by the second pass
+    std::list<Block> m_blocks;                          ///< Cached blocks, most recently used first
+    std::unordered_map<std::uint64_t, std::list<Block>::iterator> m_blockLookup;
+    std::size_t m_maxBlocks;
+public:
+    /** Constructor.
+     * Runs the first pass over the file.
+     * @throw Exceptions::IOError If the offsets and a single block exceed max_memory.
+     */
+    FileVertexEntries(char const* filename, std::size_t window_size, std::size_t max_memory)
+        :m_fin(filename, std::ios_base::binary), m_buffer(blockReadSize), m_totalCounts{}, m_maxBlocks(0)
+    {
+        if (m_fin.fail()) {
+            GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename), "Unable to open file.");
+        }
+        std::vector<char> buffer(window_size);
+        readWindows(m_fin, buffer, [this, max_memory](Buffer window, std::uint64_t window_offset) {
+                BufferIterator const eof = window.data() + window.size();
+                BufferIterator position = skipWhitespace(window.data(), eof);
+                while (position != eof) {
+                    if (*position == 'v') {
+                        if (auto const kind = getVertexEntryKind(getVertexLabel(position, eof))) {
+                            std::size_t const k = static_cast<std::size_t>(*kind);
+                            if (m_totalCounts[k] % entriesPerBlock == 0) {
+                                m_blockOffsets[k].push_back(window_offset +
+                                                            static_cast<std::uint64_t>(position - window.data()));
+                            }
+                            ++m_totalCounts[k];
+                        }
+                    }
+                    position = skipWhitespace(getEndOfLine(position, eof), eof);
+                }
+                if (getOffsetsMemory() + maxBlockBytes > max_memory) {
+                    GHULBUS_THROW(Exceptions::IOError{}, "Vertex data exceeds memory limit.");
+                }
+                return true;
+            });
+        if (getOffsetsMemory() + maxBlockBytes > max_memory) {
+            GHULBUS_THROW(Exceptions::IOError{}, "Vertex data exceeds memory limit.");
+        }
+        m_maxBlocks = (max_memory - getOffsetsMemory()) / maxBlockBytes;
+    }
+
+    VertexCounts getCounts() const
+    {
+        return m_counts;
+    }
+
+    /** Account for the entry at p.
+     * The entry is not parsed; it is read from the file once a face refers to it.
+     */
+    void addEntry(VertexEntryKind kind, BufferIterator&, BufferIterator const&)
+    {
+        std::size_t& count = (kind == VertexEntryKind::Vertex) ? m_counts.vertex :
+                               ((kind == VertexEntryKind::TexCoord) ? m_counts.texCoord : m_counts.normal);
+        if (count == m_totalCounts[static_cast<std::size_t>(kind)]) {
+            GHULBUS_THROW(Exceptions::IOError{}, "File was modified while reading.");
+        }
+        ++count;
+    }
+
+    void buildFlat(IndexTuple64 const& t, ObjParser::VertexEntryFlat& out)
+    {
+        if ((t.vertexIndex <= 0) || (static_cast<std::uint64_t>(t.vertexIndex) > m_counts.vertex) ||
+            (t.normalIndex < 0) || (static_cast<std::uint64_t>(t.normalIndex) > m_counts.normal) ||
+            (t.textureIndex < 0) || (static_cast<std::uint64_t>(t.textureIndex) > m_counts.texCoord))
+        {
+            GHULBUS_THROW(Exceptions::IOError{}, "Face index out of range.");
+        }
+        std::size_t constexpr position =
+            *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Position);
+        std::size_t constexpr normal =
+            *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Normal);
+        std::size_t constexpr texture =
+            *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Texture);
+        float const* const v = getEntry(VertexEntryKind::Vertex, t.vertexIndex - 1);
+        get<position>(out) = GhulbusMath::Point3f(v[0], v[1], v[2]);
+        if (t.normalIndex == 0) {
+            get<normal>(out) = GhulbusMath::Normal3f(1.0f, 0.0f, 0.0f);
+        } else {
+            float const* const n = getEntry(VertexEntryKind::Normal, t.normalIndex - 1);
+            get<normal>(out) = GhulbusMath::Normal3f(n[0], n[1], n[2]);
+        }
+        if (t.textureIndex == 0) {
+            get<texture>(out) = GhulbusMath::Vector2f(0.0f, 0.0f);
+        } else {
+            float const* const vt = getEntry(VertexEntryKind::TexCoord, t.textureIndex - 1);
+            get<texture>(out) = GhulbusMath::Vector2f(vt[0], vt[1]);
+        }
+    }
+
+private:
+    static std::size_t getComponentCount(VertexEntryKind kind)
+    {
+        return (kind == VertexEntryKind::TexCoord) ? 2 : 3;
+    }
+
+    std::size_t getOffsetsMemory() const
+    {
+        return (m_blockOffsets[0].size() + m_blockOffsets[1].size() + m_blockOffsets[2].size()) *
+            sizeof(std::uint64_t);
+    }
+
+    /** Get the components of an entry.
+     * @param[in] index Zero-based index of the entry among the entries of its kind.
+     * @return Pointer to the components, valid until the next call.
+     */
+    float const* getEntry(VertexEntryKind kind, std::uint64_t index)
+    {
+        std::uint64_t const block_index = index / entriesPerBlock;
+        std::uint64_t const key = block_index * 3 + static_cast<std::uint64_t>(kind);
+        auto it = m_blockLookup.find(key);
+        if (it == m_blockLookup.end()) {
+            if (m_blocks.size() == m_maxBlocks) {
+                m_blockLookup.erase(m_blocks.back().key);
+                m_blocks.pop_back();
+            }
+            m_blocks.push_front(Block{ key, readBlock(kind, block_index) });
+            it = m_blockLookup.emplace(key, m_blocks.begin()).first;
+        } else {
+            m_blocks.splice(m_blocks.begin(), m_blocks, it->second);
+        }
+        std::vector<float> const& values = it->second->values;
+        std::size_t const component_count = getComponentCount(kind);
+        std::size_t const first_component = static_cast<std::size_t>(index % entriesPerBlock) * component_count;
+        if (first_component + component_count > values.size()) {
+            GHULBUS_THROW(Exceptions::IOError{}, "File was modified while reading.");
+        }
+        return values.data() + first_component;
+    }
+
+    std::vector<float> readBlock(VertexEntryKind kind, std::uint64_t block_index)
+    {
+        std::size_t const component_count = getComponentCount(kind);
+        std::vector<float> ret;
+        ret.reserve(entriesPerBlock * component_count);
+        m_fin.clear();
+        m_fin.seekg(static_cast<std::streamoff>(m_blockOffsets[static_cast<std::size_t>(kind)][block_index]));
+        std::size_t n_entries = 0;
+        readWindows(m_fin, m_buffer, [&ret, &n_entries, kind, component_count](Buffer window, std::uint64_t) {
+                BufferIterator const eof = window.data() + window.size();
+                BufferIterator position = skipWhitespace(window.data(), eof);
+                while ((position != eof) && (n_entries < entriesPerBlock)) {
+                    if ((*position == 'v') && (getVertexEntryKind(getVertexLabel(position, eof)) == kind)) {
+                        BufferIterator p = position + 2;
+                        for (std::size_t i = 0; i < component_count; ++i) {
+                            p = parseFloat(p, eof, ret.emplace_back());
+                        }
+                        ++n_entries;
+                    }
+                    position = skipWhitespace(getEndOfLine(position, eof), eof);
+                }
+                return n_entries < entriesPerBlock;
+            });
+        return ret;
+    }
+};
+
+/** State of a streamed OBJ file.
+ * @tparam VertexEntries_T Storage for the vertex entries; RetainedVertexEntries or FileVertexEntries.
+ */
+template<typename VertexEntries_T>
+class StreamingParser {
+private:
+    ObjParser::FlatBatchSink const& m_sink;
+    std::uint32_t m_maxBatchVertices;
+    VertexEntries_T& m_vertexEntries;
+    IndexTupleMap64 m_indexTupleMap;                    ///< Map from index tuples to their position in m_batchVertices
+    std::vector<ObjParser::VertexEntryFlat> m_batchVertices;
+    std::vector<std::uint32_t> m_batchIndices;
+    std::string m_groupName;                            ///< Face group of the current batch
+    std::uint64_t m_lineCount;                          ///< Number of lines preceding the current window
+    ObjParser::StreamStatistics m_statistics;
+public:
+    StreamingParser(ObjParser::FlatBatchSink const& sink, std::uint32_t max_batch_vertices,
+                    VertexEntries_T& vertex_entries)
+        :m_sink(sink), m_maxBatchVertices(max_batch_vertices), m_vertexEntries(vertex_entries),
+         m_indexTupleMap(max_batch_vertices), m_groupName("default"), m_lineCount(1)
+    {
+        m_batchVertices.reserve(max_batch_vertices);
+        m_batchIndices.reserve(maxBatchIndices());
+    }
+
+    /** Parse a window of the file.
+     * @param[in] window Buffer holding complete lines only.
+     */
+    void parseWindow(Buffer window)
+    {
+        BufferIterator const eof = window.data() + window.size();
+        int line_index = 0;
+        BufferIterator position = skipWhitespace(window.data(), eof, &line_index);
+        while (position != eof) {
+            switch (*position) {
+            case '#': /* comment; skip line */  break;
+            case '\0': /* end of string */  break;
+            case 'g':
+                groupSwitch(position, eof);
+                break;
+            case 'v':
+                parseVertex(position, eof);
+                break;
+            case 'f':
+                parseFace(position, eof);
+                break;
+            default:
+                GHULBUS_LOG(Warning, "Unknown label: \'" << (*position) << "\' at line " << (m_lineCount + line_index));
+                break;
+            }
+            //advance to next line
+            position = skipWhitespace(getEndOfLine(position, eof), eof, &line_index);
+        }
+        m_lineCount += line_index;
+    }
+
+    /** Pass the remaining data to the sink.
+     * @return Totals for the complete file.
+     */
+    ObjParser::StreamStatistics finish()
+    {
+        flushBatch();
+        GHULBUS_LOG(Debug, "OBJ Loader streamed total of " << m_lineCount << " lines in " <<
+                           m_statistics.batches << " batches.");
+        return m_statistics;
+    }
+
+private:
+    std::size_t maxBatchIndices() const
+    {
+        return static_cast<std::size_t>(m_maxBatchVertices) * 6;
+    }
+
+    void groupSwitch(BufferIterator& p, BufferIterator const& eof)
+    {
+        std::vector<std::string> group_names = parseGroupNames(p, eof);
+        if (group_names.size() != 1) {
+            GHULBUS_THROW(Exceptions::NotImplemented(), "Multiple target groups not supported.");
+        }
+        if (group_names.front() != m_groupName) {
+            flushBatch();
+            m_groupName = std::move(group_names.front());
+        }
+    }
+
+    void parseVertex(BufferIterator& p, BufferIterator const& eof)
+    {
+        char const c = getVertexLabel(p, eof);
+        std::optional<VertexEntryKind> const kind = getVertexEntryKind(c);
+        if (!kind) {
+            GHULBUS_LOG(Warning, "OBJ Parser encountered unknown vertex label: \'v" << c << "\'");
+            return;
+        }
+        p += 2;
+        m_vertexEntries.addEntry(*kind, p, eof);
+        switch (*kind) {
+        case VertexEntryKind::Vertex:   ++m_statistics.vertices;  break;
+        case VertexEntryKind::TexCoord: ++m_statistics.texCoords; break;
+        case VertexEntryKind::Normal:   ++m_statistics.normals;   break;
+        }
+    }
+
+    void parseFace(BufferIterator& p, BufferIterator const& eof)
+    {
+        // the layout is determined per face, as there is no group data to attach it to
+        ObjParser::FaceData layout;
+        scanFaceLayout(p, eof, &layout);
+        IndexTuple64 tuples[4];
+        p = parseFaceTuples(p, eof, layout, m_vertexEntries.getCounts(), tuples);
+        GHULBUS_ASSERT((skipBlanks(p, eof) == eof) || ((*skipBlanks(p, eof)) == '\n') ||
+                       ((*skipBlanks(p, eof)) == '#'));
+        ++m_statistics.faces;
+
+        int new_vertices = 0;
+        for (int i = 0; i < layout.verticesPerFace; ++i) {
+            if (m_indexTupleMap.find(tuples[i]) < 0) { ++new_vertices; }
+        }
+        if ((m_batchVertices.size() + new_vertices > m_maxBatchVertices) ||
+            (m_batchIndices.size() + 6 > maxBatchIndices()))
+        {
+            flushBatch();
+        }
+        std::size_t const first_index = m_batchIndices.size();
+        for (int i = 0; i < layout.verticesPerFace; ++i) {
+            auto const [index, was_inserted] =
+                m_indexTupleMap.tryEmplace(tuples[i], static_cast<std::int64_t>(m_batchVertices.size()));
+            if (was_inserted) {
+                m_vertexEntries.buildFlat(tuples[i], m_batchVertices.emplace_back());
+            }
+            m_batchIndices.push_back(static_cast<std::uint32_t>(index));
+        }
+        if (layout.verticesPerFace == 4) {
+            ///Quad mesh; Add second triangle
+            m_batchIndices.push_back(m_batchIndices[first_index]);
+            m_batchIndices.push_back(m_batchIndices[first_index + 2]);
+        }
+    }
+
+    void flushBatch()
+    {
+        if (m_batchIndices.empty()) { return; }
+        ObjParser::FlatBatch const batch{ m_batchVertices, m_batchIndices,
+                                          m_statistics.flatVertices, m_statistics.flatIndices, m_groupName };
+        m_sink(batch);
+        m_statistics.flatVertices += m_batchVertices.size();
+        m_statistics.flatIndices += m_batchIndices.size();
+        ++m_statistics.batches;
+        m_batchVertices.clear();
+        m_batchIndices.clear();
+        m_indexTupleMap.clear();
+    }
+};
+
+/**
+ * @param[in] fin Stream positioned at the beginning of an OBJ file.
+ * @param[in] filename Name of the file read by fin.
+ * @param[in] sink Receives the flattened mesh data.
+ * @param[in] window_size Initial size of the read buffer.
+ * @param[in] max_batch_vertices Maximum number of vertices passed to the sink at once.
+ * @param[in] max_vertex_memory Maximum size in bytes of the memory used for vertex entries;
+ *                              std::numeric_limits<std::size_t>::max() for retaining all entries.
+ * @note Reads the file front to back in windows, see readWindows(). With a memory limit, the file is read
+ *       twice and the vertex entries referenced by the faces are read again from the file, see FileVertexEntries.
+ */
+ObjParser::StreamStatistics streamFile(std::istream& fin,
+                                       char const* filename,
+                                       ObjParser::FlatBatchSink const& sink,
+                                       std::size_t window_size,
+                                       std::uint32_t max_batch_vertices,
+                                       std::size_t max_vertex_memory)
+{
+    auto const stream_faces = [&](auto& vertex_entries) {
+        StreamingParser parser(sink, max_batch_vertices, vertex_entries);
+        std::vector<char> buffer(window_size);
+        readWindows(fin, buffer, [&parser](Buffer window, std::uint64_t) {
+                parser.parseWindow(window);
+                return true;
+            });
+        return parser.finish();
+    };
+    if (max_vertex_memory == std::numeric_limits<std::size_t>::max()) {
+        RetainedVertexEntries vertex_entries;
+        return stream_faces(vertex_entries);
+    }
+    FileVertexEntries vertex_entries(filename, window_size, max_vertex_memory);
+    return stream_faces(vertex_entries);
 }
 }
 }
@@ -152,6 +152,30 @@ VkFormat determineAttributeFormat(VertexFormatBase::ComponentType type, VertexFo
         return VK_FORMAT_R32G32B32_SFLOAT;
     case VertexFormatBase::ComponentType::t_vec4:
         return VK_FORMAT_R32G32B32A32_SFLOAT;
+    case VertexFormatBase::ComponentType::t_half2:
+        return VK_FORMAT_R16G16_SFLOAT;
+    case VertexFormatBase::ComponentType::t_half4:
+        return VK_FORMAT_R16G16B16A16_SFLOAT;
+    case VertexFormatBase::ComponentType::t_snorm8x2:
+        return VK_FORMAT_R8G8_SNORM;
+    case VertexFormatBase::ComponentType::t_snorm8x4:
+        return VK_FORMAT_R8G8B8A8_SNORM;
+    case VertexFormatBase::ComponentType::t_unorm8x2:
+        return VK_FORMAT_R8G8_UNORM;
+    case VertexFormatBase::ComponentType::t_unorm8x4:
+        return VK_FORMAT_R8G8B8A8_UNORM;
+    case VertexFormatBase::ComponentType::t_snorm16x2:
+        return VK_FORMAT_R16G16_SNORM;
+    case VertexFormatBase::ComponentType::t_snorm16x4:
+        return VK_FORMAT_R16G16B16A16_SNORM;
+    case VertexFormatBase::ComponentType::t_unorm16x2:
+        return VK_FORMAT_R16G16_UNORM;
+    case VertexFormatBase::ComponentType::t_unorm16x4:
+        return VK_FORMAT_R16G16B16A16_UNORM;
+    case VertexFormatBase::ComponentType::t_snorm10_10_10_2:
+        return VK_FORMAT_A2B10G10R10_SNORM_PACK32;
+    case VertexFormatBase::ComponentType::t_unorm10_10_10_2:
+        return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
     default:
         GHULBUS_THROW(Exceptions::NotImplemented(), "Attribute detection for type not implemented.");
     }
@@ -177,21 +201,53 @@ VertexFormatBase::ComponentType getMatchingComponentType(spirv_cross::SPIRType c
     GHULBUS_THROW(Exceptions::NotImplemented(), "Spir type not supported.");
 }
 
+/** The type a vertex component appears as in the shader.
+ * Half and normalized components are converted to float vectors by the vertex input stage.
+ */
+VertexFormatBase::ComponentType getShaderInputType(VertexFormatBase::ComponentType component_type)
+{
+    switch (component_type) {
+    case VertexFormatBase::ComponentType::t_half2:
+    case VertexFormatBase::ComponentType::t_snorm8x2:
+    case VertexFormatBase::ComponentType::t_unorm8x2:
+    case VertexFormatBase::ComponentType::t_snorm16x2:
+    case VertexFormatBase::ComponentType::t_unorm16x2:
+        return VertexFormatBase::ComponentType::t_vec2;
+    case VertexFormatBase::ComponentType::t_half4:
+    case VertexFormatBase::ComponentType::t_snorm8x4:
+    case VertexFormatBase::ComponentType::t_unorm8x4:
+    case VertexFormatBase::ComponentType::t_snorm16x4:
+    case VertexFormatBase::ComponentType::t_unorm16x4:
+    case VertexFormatBase::ComponentType::t_snorm10_10_10_2:
+    case VertexFormatBase::ComponentType::t_unorm10_10_10_2:
+        return VertexFormatBase::ComponentType::t_vec4;
+    default:
+        return component_type;
+    }
+}
+
 void checkTypeMatch(spirv_cross::SPIRType const& spir_type, VertexFormatBase::ComponentType component_type)
 {
-    if (getMatchingComponentType(spir_type) != component_type) {
+    VertexFormatBase::ComponentType const shader_type = getMatchingComponentType(spir_type);
+    VertexFormatBase::ComponentType const input_type = getShaderInputType(component_type);
+    // packed four component types commonly store a 3d vector and are consumed as vec3 in the shader
+    bool const is_truncated_input = (input_type != component_type) &&
+                                    (input_type == VertexFormatBase::ComponentType::t_vec4) &&
+                                    (shader_type == VertexFormatBase::ComponentType::t_vec3);
+    if ((shader_type != input_type) && (!is_truncated_input)) {
         GHULBUS_THROW(Exceptions::ShaderError(), "Vertex Attribute type mismatch.");
     }
 }
 }
 
-void Program::addVertexBinding(uint32_t binding, VertexFormatBase const& vertex_input_format)
+void Program::addVertexBinding(uint32_t binding, VertexFormatBase const& vertex_input_format,
+                               VkVertexInputRate input_rate)
 {
     m_vertexInputFormat.emplace_back(vertex_input_format.clone());
     VkVertexInputBindingDescription vertex_binding;
     vertex_binding.binding = binding;
     vertex_binding.stride = static_cast<uint32_t>(vertex_input_format.getStride());
-    vertex_binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    vertex_binding.inputRate = input_rate;
     m_vertexInputBinding.push_back(vertex_binding);
 }
 
@@ -0,0 +1,250 @@
+#include <gbGraphics/Readback.hpp>
+
+#include <gbGraphics/CommandPoolRegistry.hpp>
+#include <gbGraphics/GenericImage.hpp>
+#include <gbGraphics/GraphicsInstance.hpp>
+#include <gbGraphics/detail/FormatInfo.hpp>
+
+#include <gbVk/Buffer.hpp>
+#include <gbVk/CommandBuffer.hpp>
+#include <gbVk/Device.hpp>
+#include <gbVk/Image.hpp>
+#include <gbVk/MappedMemory.hpp>
+#include <gbVk/Queue.hpp>
+#include <gbVk/SubmitStaging.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <cstring>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace {
+/** Makes the transfer writes to the readback buffer visible to the host once the fence has signaled.
+ */
+VkBufferMemoryBarrier hostReadBarrier(MemoryBuffer& buffer, VkDeviceSize size)
+{
+    VkBufferMemoryBarrier ret;
+    ret.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    ret.pNext = nullptr;
+    ret.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    ret.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    ret.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    ret.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    ret.buffer = buffer.getBuffer().getVkBuffer();
+    ret.offset = 0;
+    ret.size = size;
+    return ret;
+}
+}
+
+Readback::Readback(GraphicsInstance& instance)
+    :m_instance(&instance)
+{
+}
+
+Readback::~Readback()
+{
+    waitIdle();
+}
+
+std::future<Readback::Data> Readback::readBuffer(MemoryBuffer& source, VkDeviceSize offset, VkDeviceSize size)
+{
+    GHULBUS_PRECONDITION((source.getBufferUsage() & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) != 0);
+    GHULBUS_PRECONDITION((size > 0) && (offset + size <= source.getSize()));
+    MemoryBuffer buffer = acquireBuffer(size);
+    auto command_buffers = m_instance->getCommandPoolRegistry().allocateCommandBuffersGraphics_Transient(1);
+    auto& command_buffer = command_buffers.getCommandBuffer(0);
+    command_buffer.begin();
+
+    // wait for all prior writes to the source, by shaders as well as by transfers
+    VkBufferMemoryBarrier source_barr;
+    source_barr.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    source_barr.pNext = nullptr;
+    source_barr.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    source_barr.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    source_barr.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    source_barr.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    source_barr.buffer = source.getBuffer().getVkBuffer();
+    source_barr.offset = offset;
+    source_barr.size = size;
+    vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1, &source_barr, 0, nullptr);
+
+    VkBufferCopy buffer_copy;
+    buffer_copy.srcOffset = offset;
+    buffer_copy.dstOffset = 0;
+    buffer_copy.size = size;
+    vkCmdCopyBuffer(command_buffer.getVkCommandBuffer(), source.getBuffer().getVkBuffer(),
+                    buffer.getBuffer().getVkBuffer(), 1, &buffer_copy);
+
+    VkBufferMemoryBarrier const host_barr = hostReadBarrier(buffer, size);
+    vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &host_barr, 0, nullptr);
+    command_buffer.end();
+    return stage(std::move(command_buffers), std::move(buffer), size);
+}
+
+std::future<Readback::Data> Readback::readImage(GenericImage& source, VkImageLayout layout, VkOffset3D offset,
+                                                VkExtent3D extent, uint32_t mip_level, uint32_t array_layer,
+                                                VkImageAspectFlags aspect)
+{
+    GHULBUS_PRECONDITION((source.getUsage() & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0);
+    GHULBUS_PRECONDITION(layout != VK_IMAGE_LAYOUT_UNDEFINED);
+    GHULBUS_PRECONDITION((mip_level < source.getMipLevels()) && (array_layer < source.getArrayLayers()));
+    VkDeviceSize const size = detail::getImageRegionSize(source.getFormat(), aspect, extent);
+    MemoryBuffer buffer = acquireBuffer(size);
+    GhulbusVulkan::Image& image = source.getImage();
+    auto command_buffers = m_instance->getCommandPoolRegistry().allocateCommandBuffersGraphics_Transient(1);
+    auto& command_buffer = command_buffers.getCommandBuffer(0);
+    command_buffer.begin();
+
+    VkImageMemoryBarrier image_barr;
+    image_barr.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_barr.pNext = nullptr;
+    image_barr.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    image_barr.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    image_barr.oldLayout = layout;
+    image_barr.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    image_barr.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barr.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barr.image = image.getVkImage();
+    image_barr.subresourceRange.aspectMask = aspect;
+    image_barr.subresourceRange.baseMipLevel = mip_level;
+    image_barr.subresourceRange.levelCount = 1;
+    image_barr.subresourceRange.baseArrayLayer = array_layer;
+    image_barr.subresourceRange.layerCount = 1;
+    vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_barr);
+
+    VkBufferImageCopy region;
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = aspect;
+    region.imageSubresource.mipLevel = mip_level;
+    region.imageSubresource.baseArrayLayer = array_layer;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = offset;
+    region.imageExtent = extent;
+    vkCmdCopyImageToBuffer(command_buffer.getVkCommandBuffer(), image.getVkImage(),
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer.getBuffer().getVkBuffer(), 1, &region);
+
+    // return the image to its layout for subsequent commands, which only have to wait for the copy
+    image_barr.srcAccessMask = 0;
+    image_barr.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    image_barr.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    image_barr.newLayout = layout;
+    VkBufferMemoryBarrier const host_barr = hostReadBarrier(buffer, size);
+    vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                         0, nullptr, 1, &host_barr, 1, &image_barr);
+    command_buffer.end();
+    return stage(std::move(command_buffers), std::move(buffer), size);
+}
+
+std::future<Readback::Data> Readback::readImage(GenericImage& source, VkImageLayout layout)
+{
+    return readImage(source, layout, VkOffset3D{ 0, 0, 0 }, source.getExtent());
+}
+
+void Readback::poll()
+{
+    submitFences();
+    // the queue executes the readbacks in order, but fences may still be observed to signal out of order
+    for (auto it = m_pending.begin(); it != m_pending.end(); ) {
+        if (it->fence.getStatus() == GhulbusVulkan::Fence::Status::Ready) {
+            complete(*it);
+            it = m_pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+uint32_t Readback::getNumberOfPendingReadbacks() const
+{
+    return static_cast<uint32_t>(m_pending.size());
+}
+
+void Readback::waitIdle()
+{
+    if (!m_pending.empty() && !*m_pending.back().isSubmitted) {
+        GhulbusVulkan::Queue& queue = m_instance->getGraphicsQueue();
+        queue.submitAllStaged();
+        queue.clearAllStaged();
+    }
+    submitFences();
+    while (!m_pending.empty()) {
+        m_pending.front().fence.wait();
+        complete(m_pending.front());
+        m_pending.pop_front();
+    }
+}
+
+MemoryBuffer Readback::acquireBuffer(VkDeviceSize size)
+{
+    auto best_fit = m_freeBuffers.end();
+    for (auto it = m_freeBuffers.begin(); it != m_freeBuffers.end(); ++it) {
+        if ((it->getSize() >= size) && ((best_fit == m_freeBuffers.end()) || (it->getSize() < best_fit->getSize()))) {
+            best_fit = it;
+        }
+    }
+    if (best_fit != m_freeBuffers.end()) {
+        MemoryBuffer ret(std::move(*best_fit));
+        m_freeBuffers.erase(best_fit);
+        return ret;
+    }
+    return MemoryBuffer(*m_instance, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, MemoryUsage::GpuToCpu);
+}
+
+GhulbusVulkan::Fence Readback::acquireFence()
+{
+    if (m_freeFences.empty()) {
+        return m_instance->getVulkanDevice().createFence();
+    }
+    GhulbusVulkan::Fence ret(std::move(m_freeFences.front()));
+    m_freeFences.pop_front();
+    ret.reset();
+    return ret;
+}
+
+std::future<Readback::Data> Readback::stage(GhulbusVulkan::CommandBuffers&& command_buffers, MemoryBuffer&& buffer,
+                                            VkDeviceSize size)
+{
+    auto is_submitted = std::make_shared<bool>(false);
+    GhulbusVulkan::SubmitStaging staging;
+    staging.addCommandBuffers(command_buffers);
+    staging.addCleanupCallback([is_submitted]() { *is_submitted = true; });
+    m_instance->getGraphicsQueue().stageSubmission(std::move(staging));
+    m_pending.push_back(Pending{ acquireFence(), false, std::move(is_submitted), std::move(command_buffers),
+                                 std::move(buffer), size, {} });
+    return m_pending.back().promise.get_future();
+}
+
+void Readback::submitFences()
+{
+    // an empty submission signals its fence once all previously submitted work on the queue has completed
+    for (Pending& pending : m_pending) {
+        if (pending.fenceSubmitted) { continue; }
+        if (!*pending.isSubmitted) { break; }
+        m_instance->getGraphicsQueue().submit(GhulbusVulkan::SubmitStaging{}, pending.fence);
+        pending.fenceSubmitted = true;
+    }
+}
+
+void Readback::complete(Pending& pending)
+{
+    {
+        auto mapped_mem = pending.buffer.map();
+        mapped_mem.invalidate(0, pending.size);
+        std::byte const* data = static_cast<std::byte*>(mapped_mem);
+        pending.promise.set_value(Data(data, data + pending.size));
+    }
+    m_freeFences.emplace_back(std::move(pending.fence));
+    if (m_freeBuffers.size() == maxFreeBuffers) {
+        m_freeBuffers.pop_front();
+    }
+    m_freeBuffers.emplace_back(std::move(pending.buffer));
+}
+}
@@ -0,0 +1,250 @@
+#include <gbGraphics/ResidencyManager.hpp>
+
+#include <gbGraphics/CommandPoolRegistry.hpp>
+#include <gbGraphics/GraphicsInstance.hpp>
+#include <gbGraphics/detail/DeviceMemoryAllocator_VMA.hpp>
+
+#include <gbVk/CommandBuffers.hpp>
+#include <gbVk/Device.hpp>
+#include <gbVk/Exceptions.hpp>
+#include <gbVk/Image.hpp>
+#include <gbVk/PhysicalDevice.hpp>
+#include <gbVk/Queue.hpp>
+#include <gbVk/Semaphore.hpp>
+
+#include <algorithm>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+ResidencyManager::ResidencyManager(GraphicsInstance& instance, uint32_t frames_in_flight)
+    :m_instance(&instance), m_framesInFlight(frames_in_flight)
+{
+    GHULBUS_PRECONDITION(frames_in_flight > 0);
+}
+
+ResidencyManager::~ResidencyManager()
+{
+    for (auto& r : m_pendingRestores) {
+        r.fence.wait();
+        r.submitStaging.performCleanup();
+    }
+}
+
+auto ResidencyManager::add(std::unique_ptr<Resource> resource) -> ResourceId
+{
+    GHULBUS_PRECONDITION(resource);
+    ResourceId const ret = m_tracker.add();
+    if (ret == m_resources.size()) {
+        m_resources.push_back(std::move(resource));
+    } else {
+        m_resources[ret] = std::move(resource);
+    }
+    return ret;
+}
+
+void ResidencyManager::remove(ResourceId id)
+{
+    m_tracker.remove(id);
+    m_resources[id].reset();
+}
+
+auto ResidencyManager::use(ResourceId id) -> Resource&
+{
+    m_tracker.markUsed(id);
+    if (!m_tracker.isResident(id)) {
+        restore(id);
+    }
+    return *m_resources[id];
+}
+
+bool ResidencyManager::isResident(ResourceId id) const
+{
+    return m_tracker.isResident(id);
+}
+
+void ResidencyManager::beginFrame()
+{
+    retireCompletedRestores();
+    m_tracker.nextFrame();
+    evict(m_tracker.selectEvictions(getBudget(), m_framesInFlight));
+}
+
+void ResidencyManager::setBudget(std::optional<VkDeviceSize> budget)
+{
+    m_budget = budget;
+}
+
+VkDeviceSize ResidencyManager::getBudget()
+{
+    DeviceBudget const device_budget = queryDeviceBudget();
+    // memory that is used by anything other than the resources of the manager is not available to them
+    VkDeviceSize const resident_size = getResidentSize();
+    VkDeviceSize const other_usage = device_budget.usage - std::min(device_budget.usage, resident_size);
+    VkDeviceSize const available = device_budget.budget - std::min(device_budget.budget, other_usage);
+    return (m_budget) ? std::min(*m_budget, available) : available;
+}
+
+VkDeviceSize ResidencyManager::getResidentSize() const
+{
+    return m_tracker.getResidentSize();
+}
+
+auto ResidencyManager::queryDeviceBudget() -> DeviceBudget
+{
+    DeviceBudget ret{ 0, 0 };
+    auto const* const vma_allocator =
+        dynamic_cast<detail::DeviceMemoryAllocator_VMA const*>(&m_instance->getDeviceMemoryAllocator());
+    if (vma_allocator) {
+        for (auto const& heap : vma_allocator->getHeapBudgets()) {
+            if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0) {
+                ret.usage += heap.usage;
+                ret.budget += heap.budget;
+            }
+        }
+    } else {
+        // no usage information available; assume that only the manager allocates and leave some headroom,
+        // like VMA does without VK_EXT_memory_budget
+        auto const mem_props = m_instance->getVulkanDevice().getPhysicalDevice().getMemoryProperties();
+        for (uint32_t i = 0; i < mem_props.memoryHeapCount; ++i) {
+            VkMemoryHeap const& heap = mem_props.memoryHeaps[i];
+            if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0) {
+                ret.budget += heap.size / 5 * 4;
+            }
+        }
+        ret.usage = getResidentSize();
+    }
+    return ret;
+}
+
+void ResidencyManager::restore(ResourceId id)
+{
+    Resource& resource = *m_resources[id];
+    auto const do_restore = [this, &resource]() {
+            UploadBatch upload_batch(*m_instance, m_instance->getGraphicsQueueFamilyIndex());
+            resource.restore(upload_batch);
+            submitRestore(resource, upload_batch);
+        };
+    try {
+        do_restore();
+    } catch (GhulbusVulkan::Exceptions::VulkanError const& e) {
+        VkResult const* const res = Ghulbus::getErrorInfo<GhulbusVulkan::Exception_Info::vulkan_error_code>(e);
+        if (!res || (*res != VK_ERROR_OUT_OF_DEVICE_MEMORY)) { throw; }
+        // make room by evicting everything that the device is done with and try again
+        std::vector<ResourceId> const evictions = m_tracker.selectEvictions(0, m_framesInFlight);
+        if (evictions.empty()) { throw; }
+        evict(evictions);
+        do_restore();
+    }
+    m_tracker.setResident(id, resource.getDeviceMemorySize());
+}
+
+void ResidencyManager::submitRestore(Resource& resource, UploadBatch& upload_batch)
+{
+    GhulbusVulkan::Device& device = m_instance->getVulkanDevice();
+    GhulbusVulkan::Semaphore upload_completed = device.createSemaphore();
+    GhulbusVulkan::SubmitStaging transfer_staging = upload_batch.finish();
+    transfer_staging.addSignalingSemaphore(upload_completed, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    GhulbusVulkan::Fence fence = device.createFence();
+    m_instance->getTransferQueue().submit(transfer_staging, fence);
+    m_pendingRestores.push_back(PendingRestore{ std::move(fence), std::move(transfer_staging) });
+
+    // the semaphore wait only covers the batch it belongs to; the barriers in the batch extend the
+    // dependency to all graphics work submitted after it
+    auto command_buffers = m_instance->getCommandPoolRegistry().allocateCommandBuffersGraphics_Transient(1);
+    auto& command_buffer = command_buffers.getCommandBuffer(0);
+    command_buffer.begin();
+    uint32_t const transfer_queue_family = m_instance->getTransferQueueFamilyIndex();
+    if (transfer_queue_family != m_instance->getGraphicsQueueFamilyIndex()) {
+        resource.recordAcquire(command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, transfer_queue_family);
+    } else {
+        VkMemoryBarrier memory_barr;
+        memory_barr.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memory_barr.pNext = nullptr;
+        memory_barr.srcAccessMask = 0;
+        memory_barr.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                                    VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                             1, &memory_barr, 0, nullptr, 0, nullptr);
+    }
+    command_buffer.end();
+
+    GhulbusVulkan::SubmitStaging graphics_staging;
+    graphics_staging.addWaitingSemaphore(upload_completed, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    graphics_staging.addCommandBuffers(command_buffers);
+    // the semaphore is destroyed on cleanup, after the graphics queue has waited for it
+    graphics_staging.adoptResources(std::move(command_buffers), std::move(upload_completed));
+    m_instance->getGraphicsQueue().stageSubmission(std::move(graphics_staging));
+}
+
+void ResidencyManager::retireCompletedRestores()
+{
+    for (auto it = m_pendingRestores.begin(); it != m_pendingRestores.end(); ) {
+        if (it->fence.getStatus() == GhulbusVulkan::Fence::Status::Ready) {
+            it->submitStaging.performCleanup();
+            it = m_pendingRestores.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ResidencyManager::evict(std::vector<ResourceId> const& ids)
+{
+    for (ResourceId const id : ids) {
+        m_resources[id]->evict();
+        m_tracker.setEvicted(id);
+    }
+}
+
+ResidentImage::ResidentImage(ImageLoader image_data)
+    :m_hostData(std::move(image_data)), m_deviceMemorySize(0)
+{
+}
+
+ResidentImage::ResidentImage(std::string filename)
+    :m_filename(std::move(filename)), m_deviceMemorySize(0)
+{
+}
+
+Image2d& ResidentImage::getImage()
+{
+    GHULBUS_PRECONDITION(m_image);
+    return *m_image;
+}
+
+VkDeviceSize ResidentImage::getDeviceMemorySize() const
+{
+    GHULBUS_PRECONDITION(m_image);
+    return m_deviceMemorySize;
+}
+
+void ResidentImage::evict()
+{
+    GHULBUS_PRECONDITION(m_image);
+    m_image.reset();
+}
+
+void ResidentImage::restore(UploadBatch& upload_batch)
+{
+    GHULBUS_PRECONDITION(!m_image);
+    std::optional<ImageLoader> file_data;
+    if (!m_hostData) { file_data.emplace(m_filename.c_str()); }
+    ImageLoader const& image_data = (m_hostData) ? *m_hostData : *file_data;
+    Image2d image(upload_batch.getInstance(), image_data.getWidth(), image_data.getHeight());
+    upload_batch.addImageUpload(image, image_data.getData());
+    m_deviceMemorySize = image.getImage().getMemoryRequirements().size;
+    m_image.emplace(std::move(image));
+}
+
+void ResidentImage::recordAcquire(GhulbusVulkan::CommandBuffer& command_buffer, VkPipelineStageFlags src_stage,
+                                  uint32_t src_queue_family)
+{
+    GHULBUS_PRECONDITION(m_image);
+    m_image->getImage().transitionAcquire(command_buffer, src_stage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                          VK_ACCESS_SHADER_READ_BIT, src_queue_family,
+                                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+}
@@ -0,0 +1,260 @@
+#include <gbGraphics/StagingRing.hpp>
+
+#include <gbGraphics/CommandPoolRegistry.hpp>
+#include <gbGraphics/GraphicsInstance.hpp>
+
+#include <gbVk/Buffer.hpp>
+#include <gbVk/CommandBuffers.hpp>
+#include <gbVk/CommandBuffer.hpp>
+#include <gbVk/Device.hpp>
+#include <gbVk/Queue.hpp>
+
+#include <gbBase/Assert.hpp>
+#include <gbBase/Finally.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace
+{
+VkDeviceSize alignUp(VkDeviceSize offset, VkDeviceSize alignment)
+{
+    return ((offset + alignment - 1) / alignment) * alignment;
+}
+}
+
+StagingRing::StagingRing(GraphicsInstance& instance, VkDeviceSize capacity)
+    :m_instance(&instance), m_buffer(instance, capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CpuOnly),
+     m_mappedMemory(m_buffer.map()), m_head(0), m_nextId(0)
+{
+}
+
+StagingRing::~StagingRing()
+{
+    waitIdle();
+}
+
+StagingRing::ReleaseGuard::ReleaseGuard(StagingRing& ring, Allocation const& allocation)
+    :m_ring(&ring), m_allocation(allocation)
+{
+}
+
+StagingRing::ReleaseGuard::~ReleaseGuard()
+{
+    if (m_ring) { m_ring->release(m_allocation); }
+}
+
+StagingRing::ReleaseGuard::ReleaseGuard(ReleaseGuard&& rhs) noexcept
+    :m_ring(rhs.m_ring), m_allocation(rhs.m_allocation)
+{
+    rhs.m_ring = nullptr;
+}
+
+VkDeviceSize StagingRing::getCapacity() const
+{
+    return m_buffer.getSize();
+}
+
+MemoryBuffer& StagingRing::getBuffer()
+{
+    return m_buffer;
+}
+
+std::optional<StagingRing::Allocation> StagingRing::tryAllocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    std::scoped_lock lk(m_mtx);
+    retireCompletedRegions();
+    return allocateRegion(size, alignment);
+}
+
+std::optional<StagingRing::Allocation> StagingRing::allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    std::unique_lock lk(m_mtx);
+    for (;;) {
+        retireCompletedRegions();
+        if (auto ret = allocateRegion(size, alignment); ret || (size > getCapacity())) {
+            return ret;
+        }
+        GHULBUS_ASSERT(!m_regions.empty());
+        std::shared_ptr<GhulbusVulkan::Fence> const oldest_fence = m_regions.front().fence;
+        if (!oldest_fence) {
+            // region is waiting for a cleanup that is not under our control
+            return std::nullopt;
+        }
+        // other uploaders must not be blocked for the duration of the wait;
+        // the region is retired on the next iteration, unless another thread got to it first
+        lk.unlock();
+        oldest_fence->wait();
+        lk.lock();
+    }
+}
+
+void StagingRing::release(Allocation const& allocation)
+{
+    std::scoped_lock lk(m_mtx);
+    auto it = std::find_if(m_regions.begin(), m_regions.end(),
+                           [id = allocation.id](Region const& r) { return r.id == id; });
+    GHULBUS_PRECONDITION_MESSAGE(it != m_regions.end(), "Allocation is not live.");
+    it->isReleased = true;
+    retireCompletedRegions();
+}
+
+void StagingRing::releaseOnCleanup(Allocation const& allocation, GhulbusVulkan::SubmitStaging& submit_staging)
+{
+    submit_staging.adoptResources(ReleaseGuard(*this, allocation));
+}
+
+void StagingRing::uploadBuffer(GhulbusVulkan::Buffer& target_buffer, VkDeviceSize target_offset,
+                               std::byte const* data, VkDeviceSize size,
+                               std::optional<uint32_t> target_queue)
+{
+    // chunks of a quarter of the ring allow copying the next chunk while the previous ones are in flight
+    VkDeviceSize const chunk_size = std::max<VkDeviceSize>(alignUp(getCapacity() / 4, defaultAlignment),
+                                                           defaultAlignment);
+    GhulbusVulkan::Queue& transfer_queue = m_instance->getTransferQueue();
+    // chunks in flight; the command buffers stay on this thread, as they belong to its transient pool
+    struct Chunk {
+        std::shared_ptr<GhulbusVulkan::Fence> fence;
+        GhulbusVulkan::CommandBuffers commandBuffers;
+    };
+    std::deque<Chunk> chunks_in_flight;
+    auto const retire_chunks = [&chunks_in_flight](bool wait) {
+        while (!chunks_in_flight.empty()) {
+            Chunk& oldest = chunks_in_flight.front();
+            if (wait) {
+                oldest.fence->wait();
+            } else if (oldest.fence->getStatus() != GhulbusVulkan::Fence::Status::Ready) {
+                break;
+            }
+            chunks_in_flight.pop_front();
+        }
+    };
+    // command buffers must not be freed while pending, even if recording a later chunk throws
+    auto const guard_chunks = Ghulbus::finally([&retire_chunks]() { retire_chunks(true); });
+    for (VkDeviceSize chunk_offset = 0; chunk_offset < size; chunk_offset += chunk_size) {
+        VkDeviceSize const chunk_bytes = std::min(chunk_size, size - chunk_offset);
+        bool const is_last_chunk = (chunk_offset + chunk_bytes == size);
+
+        retire_chunks(false);
+        std::optional<Allocation> const allocation = allocate(chunk_bytes);
+        std::optional<MemoryBuffer> dedicated_staging;
+        VkBuffer source_buffer;
+        VkDeviceSize source_offset;
+        if (allocation) {
+            std::memcpy(allocation->data, data + chunk_offset, chunk_bytes);
+            source_buffer = m_buffer.getBuffer().getVkBuffer();
+            source_offset = allocation->offset;
+        } else {
+            dedicated_staging.emplace(*m_instance, chunk_bytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                      MemoryUsage::CpuOnly);
+            {
+                auto mapped_mem = dedicated_staging->map();
+                std::memcpy(mapped_mem, data + chunk_offset, chunk_bytes);
+            }
+            source_buffer = dedicated_staging->getBuffer().getVkBuffer();
+            source_offset = 0;
+        }
+
+        auto command_buffers = m_instance->getCommandPoolRegistry().allocateCommandBuffersTransfer_Transient(1);
+        auto& command_buffer = command_buffers.getCommandBuffer(0);
+        command_buffer.begin();
+        VkBufferCopy buffer_copy;
+        buffer_copy.srcOffset = source_offset;
+        buffer_copy.dstOffset = target_offset + chunk_offset;
+        buffer_copy.size = chunk_bytes;
+        vkCmdCopyBuffer(command_buffer.getVkCommandBuffer(), source_buffer,
+                        target_buffer.getVkBuffer(), 1, &buffer_copy);
+        if (is_last_chunk && target_queue) {
+            // the barrier also covers the copies of all previous chunks submitted to the same queue
+            target_buffer.transitionRelease(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                            *target_queue);
+        }
+        command_buffer.end();
+
+        auto fence = std::make_shared<GhulbusVulkan::Fence>(m_instance->getVulkanDevice().createFence());
+        transfer_queue.submit(command_buffers, *fence);
+        if (allocation) {
+            attachFence(*allocation, fence);
+            chunks_in_flight.push_back(Chunk{ std::move(fence), std::move(command_buffers) });
+        } else {
+            fence->wait();
+        }
+    }
+}
+
+void StagingRing::waitIdle()
+{
+    std::unique_lock lk(m_mtx);
+    std::vector<std::shared_ptr<GhulbusVulkan::Fence>> fences;
+    for (Region const& r : m_regions) {
+        if (r.fence) { fences.push_back(r.fence); }
+    }
+    lk.unlock();
+    for (auto const& f : fences) { f->wait(); }
+    lk.lock();
+    retireCompletedRegions();
+}
+
+std::optional<StagingRing::Allocation> StagingRing::allocateRegion(VkDeviceSize size, VkDeviceSize alignment)
+{
+    GHULBUS_PRECONDITION((size > 0) && (alignment > 0));
+    VkDeviceSize const capacity = getCapacity();
+    if (size > capacity) { return std::nullopt; }
+    VkDeviceSize region_begin = m_head;
+    VkDeviceSize offset;
+    if (m_regions.empty()) {
+        region_begin = 0;
+        offset = 0;
+    } else {
+        VkDeviceSize const tail = m_regions.front().begin;
+        VkDeviceSize const aligned_head = alignUp(m_head, alignment);
+        if (m_head == tail) {
+            // ring is full
+            return std::nullopt;
+        } else if (m_head > tail) {
+            // free space is [head, capacity) and [0, tail)
+            if (aligned_head + size <= capacity) {
+                offset = aligned_head;
+            } else if (size <= tail) {
+                // skip the remainder of the ring; it is retired together with this region
+                offset = 0;
+            } else {
+                return std::nullopt;
+            }
+        } else {
+            // free space is [head, tail)
+            if (aligned_head + size > tail) { return std::nullopt; }
+            offset = aligned_head;
+        }
+    }
+    uint64_t const id = m_nextId++;
+    m_regions.push_back(Region{ id, region_begin, offset + size, false, nullptr });
+    m_head = offset + size;
+    return Allocation{ id, offset, size, static_cast<std::byte*>(m_mappedMemory) + offset };
+}
+
+void StagingRing::retireCompletedRegions()
+{
+    while (!m_regions.empty()) {
+        Region& oldest = m_regions.front();
+        if (!oldest.isReleased) {
+            if ((!oldest.fence) || (oldest.fence->getStatus() != GhulbusVulkan::Fence::Status::Ready)) { break; }
+        }
+        m_regions.pop_front();
+    }
+    if (m_regions.empty()) { m_head = 0; }
+}
+
+void StagingRing::attachFence(Allocation const& allocation, std::shared_ptr<GhulbusVulkan::Fence> const& fence)
+{
+    std::scoped_lock lk(m_mtx);
+    auto it = std::find_if(m_regions.begin(), m_regions.end(),
+                           [id = allocation.id](Region const& r) { return r.id == id; });
+    GHULBUS_ASSERT(it != m_regions.end());
+    it->fence = fence;
+}
+}
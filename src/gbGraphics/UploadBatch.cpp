@@ -0,0 +1,275 @@
+#include <gbGraphics/UploadBatch.hpp>
+
+#include <gbGraphics/CommandPoolRegistry.hpp>
+#include <gbGraphics/GraphicsInstance.hpp>
+#include <gbGraphics/Image2d.hpp>
+#include <gbGraphics/ImageContainerLoader.hpp>
+
+#include <gbVk/Buffer.hpp>
+#include <gbVk/CommandBuffer.hpp>
+#include <gbVk/Fence.hpp>
+#include <gbVk/Image.hpp>
+#include <gbVk/Queue.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <cstring>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+UploadBatch::UploadBatch(GraphicsInstance& instance, std::optional<uint32_t> target_queue)
+    :m_instance(&instance), m_targetQueue(target_queue),
+     m_commandBuffers(instance.getCommandPoolRegistry().allocateCommandBuffersTransfer_Transient(1)),
+     m_numberOfUploads(0), m_isFinished(false)
+{
+    m_commandBuffers.getCommandBuffer(0).begin();
+}
+
+UploadBatch::~UploadBatch()
+{
+    if (!m_isFinished) {
+        // never submitted; nothing reads from the staging memory
+        StagingRing& staging_ring = m_instance->getStagingRing();
+        for (auto const& allocation : m_ringAllocations) {
+            staging_ring.release(allocation);
+        }
+    }
+}
+
+GraphicsInstance& UploadBatch::getInstance()
+{
+    return *m_instance;
+}
+
+uint32_t UploadBatch::getNumberOfUploads() const
+{
+    return m_numberOfUploads;
+}
+
+void UploadBatch::addBufferUpload(MemoryBuffer& target, std::byte const* data)
+{
+    addBufferUpload(target, 0, data, target.getSize());
+}
+
+void UploadBatch::addBufferUpload(MemoryBuffer& target, VkDeviceSize target_offset,
+                                  std::byte const* data, VkDeviceSize size)
+{
+    GHULBUS_PRECONDITION(!m_isFinished);
+    GHULBUS_PRECONDITION(target_offset + size <= target.getSize());
+    if (target.isDirectUpload()) {
+        target.setDataMapped(data, target_offset, size);
+        ++m_numberOfUploads;
+        return;
+    }
+    StagingRange const staging = stageData(data, size);
+    recordBufferCopy(target, target_offset, size, *staging.buffer, staging.offset);
+}
+
+void UploadBatch::addBufferUpload(MemoryBuffer& target, MemoryBuffer&& staging_buffer)
+{
+    GHULBUS_PRECONDITION(!m_isFinished);
+    GHULBUS_PRECONDITION(staging_buffer.getSize() == target.getSize());
+    GHULBUS_PRECONDITION((staging_buffer.getBufferUsage() & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) != 0);
+    m_stagingBuffers.emplace_back(std::move(staging_buffer));
+    recordBufferCopy(target, 0, target.getSize(), m_stagingBuffers.back().getBuffer(), 0);
+}
+
+void UploadBatch::addImageUpload(Image2d& target, std::byte const* data)
+{
+    GHULBUS_PRECONDITION(!m_isFinished);
+    GHULBUS_PRECONDITION(target.getMipLevels() == 1);
+    GhulbusVulkan::Image& image = target.getImage();
+    GHULBUS_ASSERT(image.getFormat() == VK_FORMAT_R8G8B8A8_UNORM);
+    VkDeviceSize const texture_size = static_cast<VkDeviceSize>(target.getWidth()) * target.getHeight() * 4;
+    StagingRange const staging = stageData(data, texture_size);
+
+    auto& command_buffer = m_commandBuffers.getCommandBuffer(0);
+    image.transitionLayout(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                           VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    GhulbusVulkan::Image::copy(command_buffer, *staging.buffer, staging.offset, image);
+
+    addImageBarrier(image, 1);
+    ++m_numberOfUploads;
+}
+
+void UploadBatch::addImageUpload(Image2d& target, ImageContainerLoader const& image_data)
+{
+    GHULBUS_PRECONDITION(!m_isFinished);
+    GHULBUS_PRECONDITION((target.getWidth() == image_data.getWidth()) &&
+                         (target.getHeight() == image_data.getHeight()) &&
+                         (target.getMipLevels() == image_data.getMipLevels()));
+    // the image was created with the decompressed format if the device does not support the original one
+    std::optional<ImageContainerLoader> decompressed_data;
+    if (target.getFormat() != image_data.getFormat()) {
+        decompressed_data.emplace(image_data.decompress());
+        GHULBUS_PRECONDITION(target.getFormat() == decompressed_data->getFormat());
+    }
+    ImageContainerLoader const& source = (decompressed_data) ? *decompressed_data : image_data;
+    StagingRange const staging = stageData(source.getData(), source.getDataSize());
+
+    auto& command_buffer = m_commandBuffers.getCommandBuffer(0);
+    GhulbusVulkan::Image& image = target.getImage();
+    VkImageMemoryBarrier image_barr;
+    image_barr.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_barr.pNext = nullptr;
+    image_barr.srcAccessMask = 0;
+    image_barr.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    image_barr.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    image_barr.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    image_barr.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barr.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barr.image = image.getVkImage();
+    image_barr.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_barr.subresourceRange.baseMipLevel = 0;
+    image_barr.subresourceRange.levelCount = source.getMipLevels();
+    image_barr.subresourceRange.baseArrayLayer = 0;
+    image_barr.subresourceRange.layerCount = 1;
+    vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_barr);
+
+    // a single copy command with one region per mip level
+    std::vector<VkBufferImageCopy> regions;
+    regions.reserve(source.getMipLevels());
+    for (uint32_t level = 0; level < source.getMipLevels(); ++level) {
+        ImageContainerLoader::MipLevel const& mip_level = source.getMipLevel(level);
+        VkBufferImageCopy region;
+        region.bufferOffset = staging.offset + mip_level.offset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = level;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = VkOffset3D{ 0, 0, 0 };
+        region.imageExtent = VkExtent3D{ mip_level.width, mip_level.height, 1 };
+        regions.push_back(region);
+    }
+    vkCmdCopyBufferToImage(command_buffer.getVkCommandBuffer(), staging.buffer->getVkBuffer(), image.getVkImage(),
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+
+    addImageBarrier(image, source.getMipLevels());
+    ++m_numberOfUploads;
+}
+
+GhulbusVulkan::SubmitStaging UploadBatch::finish()
+{
+    GHULBUS_PRECONDITION(!m_isFinished);
+    m_isFinished = true;
+    auto& command_buffer = m_commandBuffers.getCommandBuffer(0);
+    if (!m_bufferBarriers.empty() || !m_imageBarriers.empty()) {
+        // a single barrier for the ownership transfers and layout transitions of all resources;
+        // if the resources stay on the transfer queue, it also makes them visible to the draws reading them
+        VkPipelineStageFlags dst_stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        if (isTargetQueueSameAsTransferQueue()) {
+            dst_stage = isTransferQueueGraphicsQueue() ?
+                (VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) :
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        }
+        vkCmdPipelineBarrier(command_buffer.getVkCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, dst_stage, 0,
+                             0, nullptr,
+                             static_cast<uint32_t>(m_bufferBarriers.size()), m_bufferBarriers.data(),
+                             static_cast<uint32_t>(m_imageBarriers.size()), m_imageBarriers.data());
+    }
+    command_buffer.end();
+
+    GhulbusVulkan::SubmitStaging ret;
+    ret.addCommandBuffers(m_commandBuffers);
+    StagingRing& staging_ring = m_instance->getStagingRing();
+    for (auto const& allocation : m_ringAllocations) {
+        staging_ring.releaseOnCleanup(allocation, ret);
+    }
+    ret.adoptResources(std::move(m_commandBuffers), std::move(m_stagingBuffers));
+    m_ringAllocations.clear();
+    return ret;
+}
+
+GhulbusVulkan::SubmitStaging UploadBatch::submit(GhulbusVulkan::Fence& fence)
+{
+    GhulbusVulkan::SubmitStaging ret = finish();
+    m_instance->getTransferQueue().submit(ret, fence);
+    return ret;
+}
+
+void UploadBatch::recordBufferCopy(MemoryBuffer& target, VkDeviceSize target_offset, VkDeviceSize size,
+                                   GhulbusVulkan::Buffer& source, VkDeviceSize source_offset)
+{
+    auto& command_buffer = m_commandBuffers.getCommandBuffer(0);
+    VkBufferCopy buffer_copy;
+    buffer_copy.srcOffset = source_offset;
+    buffer_copy.dstOffset = target_offset;
+    buffer_copy.size = size;
+    vkCmdCopyBuffer(command_buffer.getVkCommandBuffer(), source.getVkBuffer(),
+                    target.getBuffer().getVkBuffer(), 1, &buffer_copy);
+
+    if (m_targetQueue) {
+        bool const is_same_queue = isTargetQueueSameAsTransferQueue();
+        VkBufferMemoryBarrier buffer_barr;
+        buffer_barr.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        buffer_barr.pNext = nullptr;
+        buffer_barr.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        buffer_barr.dstAccessMask = (is_same_queue && isTransferQueueGraphicsQueue()) ?
+            (VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT |
+             VK_ACCESS_SHADER_READ_BIT) :
+            0;
+        buffer_barr.srcQueueFamilyIndex = is_same_queue ? VK_QUEUE_FAMILY_IGNORED :
+                                                          command_buffer.getQueueFamilyIndex();
+        buffer_barr.dstQueueFamilyIndex = is_same_queue ? VK_QUEUE_FAMILY_IGNORED : *m_targetQueue;
+        buffer_barr.buffer = target.getBuffer().getVkBuffer();
+        buffer_barr.offset = target_offset;
+        buffer_barr.size = size;
+        m_bufferBarriers.push_back(buffer_barr);
+    }
+    ++m_numberOfUploads;
+}
+
+void UploadBatch::addImageBarrier(GhulbusVulkan::Image& image, uint32_t mip_levels)
+{
+    bool const is_same_queue = isTargetQueueSameAsTransferQueue();
+    auto& command_buffer = m_commandBuffers.getCommandBuffer(0);
+    VkImageMemoryBarrier image_barr;
+    image_barr.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_barr.pNext = nullptr;
+    image_barr.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    image_barr.dstAccessMask = (is_same_queue && isTransferQueueGraphicsQueue()) ? VK_ACCESS_SHADER_READ_BIT : 0;
+    image_barr.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    image_barr.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    image_barr.srcQueueFamilyIndex = is_same_queue ? VK_QUEUE_FAMILY_IGNORED : command_buffer.getQueueFamilyIndex();
+    image_barr.dstQueueFamilyIndex = is_same_queue ? VK_QUEUE_FAMILY_IGNORED : *m_targetQueue;
+    image_barr.image = image.getVkImage();
+    image_barr.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_barr.subresourceRange.baseMipLevel = 0;
+    image_barr.subresourceRange.levelCount = mip_levels;
+    image_barr.subresourceRange.baseArrayLayer = 0;
+    image_barr.subresourceRange.layerCount = 1;
+    m_imageBarriers.push_back(image_barr);
+}
+
+bool UploadBatch::isTargetQueueSameAsTransferQueue()
+{
+    return (!m_targetQueue) || (*m_targetQueue == m_commandBuffers.getCommandBuffer(0).getQueueFamilyIndex());
+}
+
+bool UploadBatch::isTransferQueueGraphicsQueue()
+{
+    // graphics stages and accesses may only be used in barriers on queues supporting graphics
+    return m_commandBuffers.getCommandBuffer(0).getQueueFamilyIndex() == m_instance->getGraphicsQueueFamilyIndex();
+}
+
+UploadBatch::StagingRange UploadBatch::stageData(std::byte const* data, VkDeviceSize size)
+{
+    StagingRing& staging_ring = m_instance->getStagingRing();
+    if (std::optional<StagingRing::Allocation> const allocation = staging_ring.tryAllocate(size)) {
+        std::memcpy(allocation->data, data, size);
+        m_ringAllocations.push_back(*allocation);
+        return StagingRange{ &staging_ring.getBuffer().getBuffer(), allocation->offset };
+    }
+    m_stagingBuffers.emplace_back(*m_instance, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CpuOnly);
+    {
+        auto mapped_mem = m_stagingBuffers.back().map();
+        std::memcpy(mapped_mem, data, size);
+    }
+    return StagingRange{ &m_stagingBuffers.back().getBuffer(), 0 };
+}
+}
@@ -0,0 +1,153 @@
+#include <gbGraphics/VertexEncoding.hpp>
+
+#include <bit>
+#include <cmath>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace VertexEncoding
+{
+namespace {
+/** Round a float in [-1, 1] (signed) or [0, 1] (unsigned) to a normalized integer of the given bit width.
+ * The result is returned in two's complement, truncated to bits.
+ */
+std::uint32_t encodePackedNormalized(float f, int bits, bool is_signed)
+{
+    float const max_value = static_cast<float>((1u << (is_signed ? (bits - 1) : bits)) - 1u);
+    float const clamped = std::clamp(f, is_signed ? -1.f : 0.f, 1.f);
+    auto const v = static_cast<std::int32_t>(std::round(clamped * max_value));
+    return static_cast<std::uint32_t>(v) & ((1u << bits) - 1u);
+}
+
+float decodePackedNormalized(std::uint32_t v, int bits, bool is_signed)
+{
+    if (is_signed) {
+        // sign extend from bits to 32 bits
+        std::int32_t const sv = static_cast<std::int32_t>(v << (32 - bits)) >> (32 - bits);
+        float const max_value = static_cast<float>((1 << (bits - 1)) - 1);
+        return std::max(static_cast<float>(sv) / max_value, -1.f);
+    } else {
+        return static_cast<float>(v) / static_cast<float>((1u << bits) - 1u);
+    }
+}
+
+std::uint32_t pack10_10_10_2(GhulbusMath::Vector4<float> const& v, bool is_signed)
+{
+    return encodePackedNormalized(v.x, 10, is_signed) |
+           (encodePackedNormalized(v.y, 10, is_signed) << 10) |
+           (encodePackedNormalized(v.z, 10, is_signed) << 20) |
+           (encodePackedNormalized(v.w, 2, is_signed) << 30);
+}
+
+GhulbusMath::Vector4<float> unpack10_10_10_2(std::uint32_t v, bool is_signed)
+{
+    return GhulbusMath::Vector4<float>(decodePackedNormalized(v & 0x3FFu, 10, is_signed),
+                                       decodePackedNormalized((v >> 10) & 0x3FFu, 10, is_signed),
+                                       decodePackedNormalized((v >> 20) & 0x3FFu, 10, is_signed),
+                                       decodePackedNormalized(v >> 30, 2, is_signed));
+}
+
+float signNotZero(float f)
+{
+    return (f >= 0.f) ? 1.f : -1.f;
+}
+}
+
+std::uint16_t floatToHalf(float f)
+{
+    std::uint32_t const bits = std::bit_cast<std::uint32_t>(f);
+    std::uint32_t const sign = (bits >> 16) & 0x8000u;
+    std::uint32_t const exponent = (bits >> 23) & 0xFFu;
+    std::uint32_t const mantissa = bits & 0x7FFFFFu;
+
+    if (exponent == 0xFFu) {
+        // infinity or nan; keep nans quiet
+        return static_cast<std::uint16_t>(sign | 0x7C00u | ((mantissa != 0) ? 0x200u : 0u));
+    }
+    int const half_exponent = static_cast<int>(exponent) - 127 + 15;
+    if (half_exponent >= 31) {
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    }
+    if (half_exponent <= 0) {
+        // subnormal half or zero
+        if (half_exponent < -10) { return static_cast<std::uint16_t>(sign); }
+        std::uint32_t const full_mantissa = mantissa | 0x800000u;
+        int const shift = 14 - half_exponent;
+        std::uint32_t const half_mantissa = full_mantissa >> shift;
+        std::uint32_t const remainder = full_mantissa & ((1u << shift) - 1u);
+        std::uint32_t const halfway = 1u << (shift - 1);
+        std::uint32_t ret = sign | half_mantissa;
+        if ((remainder > halfway) || ((remainder == halfway) && ((half_mantissa & 1u) != 0))) { ++ret; }
+        return static_cast<std::uint16_t>(ret);
+    }
+    // a carry out of the mantissa correctly increments the exponent, up to infinity
+    std::uint32_t ret = sign | (static_cast<std::uint32_t>(half_exponent) << 10) | (mantissa >> 13);
+    std::uint32_t const remainder = mantissa & 0x1FFFu;
+    if ((remainder > 0x1000u) || ((remainder == 0x1000u) && ((ret & 1u) != 0))) { ++ret; }
+    return static_cast<std::uint16_t>(ret);
+}
+
+float halfToFloat(std::uint16_t h)
+{
+    std::uint32_t const sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+    std::uint32_t const exponent = (h >> 10) & 0x1Fu;
+    std::uint32_t const mantissa = h & 0x3FFu;
+    if (exponent == 0) {
+        float const magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return (sign != 0) ? -magnitude : magnitude;
+    } else if (exponent == 0x1Fu) {
+        return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+}
+
+VertexComponentLayout::SNorm10_10_10_2 encodeSNorm10_10_10_2(GhulbusMath::Vector4<float> const& v)
+{
+    return VertexComponentLayout::SNorm10_10_10_2{ pack10_10_10_2(v, true) };
+}
+
+VertexComponentLayout::UNorm10_10_10_2 encodeUNorm10_10_10_2(GhulbusMath::Vector4<float> const& v)
+{
+    return VertexComponentLayout::UNorm10_10_10_2{ pack10_10_10_2(v, false) };
+}
+
+GhulbusMath::Vector4<float> decode(VertexComponentLayout::SNorm10_10_10_2 const& v)
+{
+    return unpack10_10_10_2(v.value, true);
+}
+
+GhulbusMath::Vector4<float> decode(VertexComponentLayout::UNorm10_10_10_2 const& v)
+{
+    return unpack10_10_10_2(v.value, false);
+}
+
+VertexComponentLayout::Normalized<std::int16_t, 2> encodeOctahedral(GhulbusMath::Normal3f const& n)
+{
+    float const l1_norm = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (l1_norm == 0.f) { return VertexComponentLayout::Normalized<std::int16_t, 2>{ 0, 0 }; }
+    float x = n.x / l1_norm;
+    float y = n.y / l1_norm;
+    if (n.z < 0.f) {
+        // fold the lower hemisphere over the diagonals
+        float const folded_x = (1.f - std::abs(y)) * signNotZero(x);
+        float const folded_y = (1.f - std::abs(x)) * signNotZero(y);
+        x = folded_x;
+        y = folded_y;
+    }
+    return VertexComponentLayout::Normalized<std::int16_t, 2>{ encodeNormalized<std::int16_t>(x),
+                                                               encodeNormalized<std::int16_t>(y) };
+}
+
+GhulbusMath::Normal3f decodeOctahedral(VertexComponentLayout::Normalized<std::int16_t, 2> const& e)
+{
+    float x = decodeNormalized(e.value[0]);
+    float y = decodeNormalized(e.value[1]);
+    float const z = 1.f - std::abs(x) - std::abs(y);
+    float const t = std::max(-z, 0.f);
+    x += (x >= 0.f) ? -t : t;
+    y += (y >= 0.f) ? -t : t;
+    float const length = std::sqrt(x*x + y*y + z*z);
+    return GhulbusMath::Normal3f(x / length, y / length, z / length);
+}
+}
+}
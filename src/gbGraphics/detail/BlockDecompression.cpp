@@ -0,0 +1,428 @@
+#include <gbGraphics/detail/BlockDecompression.hpp>
+
+#include <gbGraphics/detail/FormatInfo.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+namespace
+{
+using Texel = std::array<uint8_t, 4>;
+using TexelBlock = std::array<Texel, 16>;
+
+uint16_t readUint16(std::byte const* data)
+{
+    return static_cast<uint16_t>(static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8));
+}
+
+uint64_t readUint64(std::byte const* data)
+{
+    uint64_t ret = 0;
+    for (int i = 7; i >= 0; --i) { ret = (ret << 8) | static_cast<uint64_t>(data[i]); }
+    return ret;
+}
+
+/** Decodes the 8 byte color block of BC1, BC2 and BC3.
+ * @param[in] has_punch_through_alpha Whether blocks with color0 <= color1 use the three color mode with
+ *                                    transparent black. BC2 and BC3 always use the four color mode.
+ */
+void decodeColorBlock(std::byte const* block, bool has_punch_through_alpha, bool is_opaque, TexelBlock& texels)
+{
+    uint16_t const c0 = readUint16(block);
+    uint16_t const c1 = readUint16(block + 2);
+    auto const expand565 = [](uint16_t c) -> Texel {
+            uint8_t const r = static_cast<uint8_t>((c >> 11) & 0x1f);
+            uint8_t const g = static_cast<uint8_t>((c >> 5) & 0x3f);
+            uint8_t const b = static_cast<uint8_t>(c & 0x1f);
+            return Texel{ static_cast<uint8_t>((r << 3) | (r >> 2)), static_cast<uint8_t>((g << 2) | (g >> 4)),
+                          static_cast<uint8_t>((b << 3) | (b >> 2)), 255 };
+        };
+    std::array<Texel, 4> palette;
+    palette[0] = expand565(c0);
+    palette[1] = expand565(c1);
+    if ((c0 > c1) || (!has_punch_through_alpha)) {
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+            palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+        }
+        palette[2][3] = 255;
+        palette[3][3] = 255;
+    } else {
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c] + 1) / 2);
+        }
+        palette[2][3] = 255;
+        palette[3] = Texel{ 0, 0, 0, static_cast<uint8_t>(is_opaque ? 255 : 0) };
+    }
+    uint32_t const indices = static_cast<uint32_t>(readUint16(block + 4)) |
+                             (static_cast<uint32_t>(readUint16(block + 6)) << 16);
+    for (int i = 0; i < 16; ++i) {
+        texels[i] = palette[(indices >> (2 * i)) & 0x03];
+    }
+}
+
+/** Decodes the 8 byte interpolated single channel block of BC3, BC4 and BC5.
+ */
+void decodeChannelBlock(std::byte const* block, int channel, TexelBlock& texels)
+{
+    uint8_t const a0 = static_cast<uint8_t>(block[0]);
+    uint8_t const a1 = static_cast<uint8_t>(block[1]);
+    std::array<uint8_t, 8> palette;
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1) {
+        for (int i = 1; i < 7; ++i) {
+            palette[i + 1] = static_cast<uint8_t>(((7 - i) * a0 + i * a1 + 3) / 7);
+        }
+    } else {
+        for (int i = 1; i < 5; ++i) {
+            palette[i + 1] = static_cast<uint8_t>(((5 - i) * a0 + i * a1 + 2) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t const indices = readUint64(block) >> 16;
+    for (int i = 0; i < 16; ++i) {
+        texels[i][channel] = palette[(indices >> (3 * i)) & 0x07];
+    }
+}
+
+/** Decodes the 8 byte explicit alpha block of BC2.
+ */
+void decodeExplicitAlphaBlock(std::byte const* block, TexelBlock& texels)
+{
+    uint64_t const alpha = readUint64(block);
+    for (int i = 0; i < 16; ++i) {
+        texels[i][3] = static_cast<uint8_t>(((alpha >> (4 * i)) & 0x0f) * 17);
+    }
+}
+
+/** Subset of each texel for the BC7 partitions with two subsets, one bit per texel.
+ */
+constexpr std::array<uint16_t, 64> bc7_partitions2 = {
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22
+};
+
+/** Subset of each texel for the BC7 partitions with three subsets.
+ */
+constexpr uint8_t bc7_partitions3[64][16] = {
+    { 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2 }, { 0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1 }, { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2 }, { 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1 }, { 0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2 }, { 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2 },
+    { 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2 }, { 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2 }, { 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0 },
+    { 0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2 }, { 0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0 },
+    { 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2 }, { 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1 },
+    { 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2 }, { 0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2 }, { 0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0 },
+    { 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0 }, { 0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2 },
+    { 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0 }, { 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1 },
+    { 0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2 }, { 0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1 }, { 0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2 }, { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2 }, { 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0 }, { 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0 },
+    { 0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0 }, { 0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1 }, { 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1 }, { 0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1 }, { 0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1 }, { 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1 },
+    { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2 }, { 0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1 },
+    { 0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2 }, { 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2 }, { 0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2 }, { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2 },
+    { 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1 }, { 0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0 }
+};
+
+/** Anchor texel of the second subset of the BC7 partitions with two subsets.
+ */
+constexpr uint8_t bc7_anchors2_1[64] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15
+};
+
+/** Anchor texel of the second subset of the BC7 partitions with three subsets.
+ */
+constexpr uint8_t bc7_anchors3_1[64] = {
+     3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+     3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+     8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+     3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3
+};
+
+/** Anchor texel of the third subset of the BC7 partitions with three subsets.
+ */
+constexpr uint8_t bc7_anchors3_2[64] = {
+    15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+    15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+    15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+    15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8
+};
+
+struct Bc7Mode {
+    int numberOfSubsets;
+    int partitionBits;
+    int rotationBits;
+    int indexSelectionBits;
+    int colorBits;
+    int alphaBits;
+    int endpointPBits;          ///< One p-bit per endpoint
+    int sharedPBits;            ///< One p-bit per subset
+    int indexBits;
+    int secondaryIndexBits;
+};
+
+constexpr Bc7Mode bc7_modes[8] = {
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 }
+};
+
+class BitReader {
+private:
+    uint64_t m_low;
+    uint64_t m_high;
+    int m_position;
+public:
+    explicit BitReader(std::byte const* block)
+        :m_low(readUint64(block)), m_high(readUint64(block + 8)), m_position(0)
+    {}
+
+    uint32_t read(int number_of_bits)
+    {
+        if (number_of_bits == 0) { return 0; }
+        GHULBUS_ASSERT(m_position + number_of_bits <= 128);
+        uint64_t value;
+        if (m_position >= 64) {
+            value = m_high >> (m_position - 64);
+        } else if (m_position + number_of_bits <= 64) {
+            value = m_low >> m_position;
+        } else {
+            value = (m_low >> m_position) | (m_high << (64 - m_position));
+        }
+        m_position += number_of_bits;
+        return static_cast<uint32_t>(value & ((uint64_t(1) << number_of_bits) - 1));
+    }
+};
+
+uint8_t bc7Interpolate(uint8_t e0, uint8_t e1, uint32_t index, int index_bits)
+{
+    constexpr uint8_t weights2[4] = { 0, 21, 43, 64 };
+    constexpr uint8_t weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+    constexpr uint8_t weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+    uint32_t const w = (index_bits == 2) ? weights2[index] : ((index_bits == 3) ? weights3[index] : weights4[index]);
+    return static_cast<uint8_t>(((64 - w) * e0 + w * e1 + 32) >> 6);
+}
+
+void decodeBc7Block(std::byte const* block, TexelBlock& texels)
+{
+    BitReader bits(block);
+    int mode_index = 0;
+    while ((mode_index < 8) && (bits.read(1) == 0)) { ++mode_index; }
+    if (mode_index == 8) {
+        // reserved mode
+        texels.fill(Texel{ 0, 0, 0, 0 });
+        return;
+    }
+    Bc7Mode const& mode = bc7_modes[mode_index];
+    uint32_t const partition = bits.read(mode.partitionBits);
+    uint32_t const rotation = bits.read(mode.rotationBits);
+    uint32_t const index_selection = bits.read(mode.indexSelectionBits);
+
+    // endpoints are stored channel by channel, each with both endpoints of all subsets
+    int const number_of_endpoints = 2 * mode.numberOfSubsets;
+    std::array<Texel, 6> endpoints = {};
+    for (int c = 0; c < 3; ++c) {
+        for (int e = 0; e < number_of_endpoints; ++e) {
+            endpoints[e][c] = static_cast<uint8_t>(bits.read(mode.colorBits));
+        }
+    }
+    for (int e = 0; e < number_of_endpoints; ++e) {
+        endpoints[e][3] = static_cast<uint8_t>(bits.read(mode.alphaBits));
+    }
+    std::array<uint32_t, 6> p_bits = {};
+    if (mode.endpointPBits != 0) {
+        for (int e = 0; e < number_of_endpoints; ++e) { p_bits[e] = bits.read(1); }
+    } else if (mode.sharedPBits != 0) {
+        for (int s = 0; s < mode.numberOfSubsets; ++s) { p_bits[2 * s] = p_bits[2 * s + 1] = bits.read(1); }
+    }
+    bool const has_p_bits = (mode.endpointPBits != 0) || (mode.sharedPBits != 0);
+    auto const unquantize = [](uint32_t value, int precision) -> uint8_t {
+            value <<= (8 - precision);
+            return static_cast<uint8_t>(value | (value >> precision));
+        };
+    for (int e = 0; e < number_of_endpoints; ++e) {
+        for (int c = 0; c < 4; ++c) {
+            int const channel_bits = (c == 3) ? mode.alphaBits : mode.colorBits;
+            if (channel_bits == 0) {
+                endpoints[e][c] = 255;
+            } else if (has_p_bits) {
+                endpoints[e][c] = unquantize((endpoints[e][c] << 1) | p_bits[e], channel_bits + 1);
+            } else {
+                endpoints[e][c] = unquantize(endpoints[e][c], channel_bits);
+            }
+        }
+    }
+
+    auto const get_subset = [&mode, partition](int texel) -> int {
+            if (mode.numberOfSubsets == 2) { return (bc7_partitions2[partition] >> texel) & 0x01; }
+            if (mode.numberOfSubsets == 3) { return bc7_partitions3[partition][texel]; }
+            return 0;
+        };
+    // the most significant index bit of the anchor texel of each subset is implicitly zero
+    auto const is_anchor = [&mode, partition](int texel) -> bool {
+            if (texel == 0) { return true; }
+            if (mode.numberOfSubsets == 2) { return texel == bc7_anchors2_1[partition]; }
+            if (mode.numberOfSubsets == 3) {
+                return (texel == bc7_anchors3_1[partition]) || (texel == bc7_anchors3_2[partition]);
+            }
+            return false;
+        };
+    std::array<uint32_t, 16> indices;
+    for (int i = 0; i < 16; ++i) {
+        indices[i] = bits.read(is_anchor(i) ? (mode.indexBits - 1) : mode.indexBits);
+    }
+    std::array<uint32_t, 16> secondary_indices = {};
+    if (mode.secondaryIndexBits != 0) {
+        for (int i = 0; i < 16; ++i) {
+            secondary_indices[i] = bits.read((i == 0) ? (mode.secondaryIndexBits - 1) : mode.secondaryIndexBits);
+        }
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        int const subset = get_subset(i);
+        Texel const& e0 = endpoints[2 * subset];
+        Texel const& e1 = endpoints[2 * subset + 1];
+        uint32_t color_index = indices[i];
+        int color_index_bits = mode.indexBits;
+        uint32_t alpha_index = indices[i];
+        int alpha_index_bits = mode.indexBits;
+        if (mode.secondaryIndexBits != 0) {
+            // the index selection bit swaps which of the two index sets is used for color and alpha
+            if (index_selection == 0) {
+                alpha_index = secondary_indices[i];
+                alpha_index_bits = mode.secondaryIndexBits;
+            } else {
+                color_index = secondary_indices[i];
+                color_index_bits = mode.secondaryIndexBits;
+            }
+        }
+        Texel& t = texels[i];
+        for (int c = 0; c < 3; ++c) { t[c] = bc7Interpolate(e0[c], e1[c], color_index, color_index_bits); }
+        t[3] = bc7Interpolate(e0[3], e1[3], alpha_index, alpha_index_bits);
+        if (rotation != 0) { std::swap(t[3], t[rotation - 1]); }
+    }
+}
+}
+
+std::optional<VkFormat> getDecompressedFormat(VkFormat format)
+{
+    switch (format) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC2_UNORM_BLOCK:
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC4_UNORM_BLOCK:
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+        return VK_FORMAT_R8G8B8A8_UNORM;
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case VK_FORMAT_BC2_SRGB_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+        return VK_FORMAT_R8G8B8A8_SRGB;
+    default: return std::nullopt;
+    }
+}
+
+void decompressBlock(VkFormat format, std::byte const* block, std::byte* texels)
+{
+    TexelBlock decoded;
+    decoded.fill(Texel{ 0, 0, 0, 255 });
+    switch (format) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        decodeColorBlock(block, true, true, decoded);
+        break;
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        decodeColorBlock(block, true, false, decoded);
+        break;
+    case VK_FORMAT_BC2_UNORM_BLOCK:
+    case VK_FORMAT_BC2_SRGB_BLOCK:
+        decodeColorBlock(block + 8, false, true, decoded);
+        decodeExplicitAlphaBlock(block, decoded);
+        break;
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+        decodeColorBlock(block + 8, false, true, decoded);
+        decodeChannelBlock(block, 3, decoded);
+        break;
+    case VK_FORMAT_BC4_UNORM_BLOCK:
+        decodeChannelBlock(block, 0, decoded);
+        break;
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+        decodeChannelBlock(block, 0, decoded);
+        decodeChannelBlock(block + 8, 1, decoded);
+        break;
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+        decodeBc7Block(block, decoded);
+        break;
+    default:
+        GHULBUS_UNREACHABLE_MESSAGE("Unsupported format for block decompression.");
+    }
+    std::memcpy(texels, decoded.data(), sizeof(decoded));
+}
+
+void decompressImage(VkFormat format, std::byte const* blocks, uint32_t width, uint32_t height, std::byte* texels)
+{
+    std::optional<TexelBlockInfo> const block_info = getTexelBlockInfo(format, VK_IMAGE_ASPECT_COLOR_BIT);
+    GHULBUS_PRECONDITION(block_info && (block_info->width == 4) && (block_info->height == 4));
+    std::size_t const block_size = block_info->size;
+    uint32_t const blocks_x = (width + 3) / 4;
+    uint32_t const blocks_y = (height + 3) / 4;
+    std::array<std::byte, 16 * 4> decoded;
+    for (uint32_t by = 0; by < blocks_y; ++by) {
+        for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+            decompressBlock(format, blocks, decoded.data());
+            blocks += block_size;
+            uint32_t const texels_x = std::min(4u, width - 4 * bx);
+            uint32_t const texels_y = std::min(4u, height - 4 * by);
+            for (uint32_t y = 0; y < texels_y; ++y) {
+                std::memcpy(texels + ((static_cast<std::size_t>(4 * by + y) * width) + 4 * bx) * 4,
+                            decoded.data() + y * 16, texels_x * 4);
+            }
+        }
+    }
+}
+}
+}
@@ -8,6 +8,10 @@ std::uint32_t g_draw2dVertex[] =
 std::uint32_t g_draw2dFragment[] =
 #   include <gbGraphics/detail/shader/draw2d.frag.h>
 ;
+
+std::uint32_t g_downsampleCompute[] =
+#   include <gbGraphics/detail/shader/downsample.comp.h>
+;
 }
 
 namespace GHULBUS_GRAPHICS_NAMESPACE::detail
@@ -23,5 +27,10 @@ ShaderData draw2dFragment()
 {
     return ShaderData{ reinterpret_cast<std::byte const*>(g_draw2dFragment), sizeof(g_draw2dFragment) };
 }
+
+ShaderData downsampleCompute()
+{
+    return ShaderData{ reinterpret_cast<std::byte const*>(g_downsampleCompute), sizeof(g_downsampleCompute) };
+}
 }
 }
@@ -42,6 +42,13 @@ VkDeviceSize DeviceMemoryAllocator_VMA::HandleModel::getSize() const
     return m_allocationInfo.size;
 }
 
+VkMemoryPropertyFlags DeviceMemoryAllocator_VMA::HandleModel::getMemoryPropertyFlags() const
+{
+    VkMemoryPropertyFlags ret;
+    vmaGetMemoryTypeProperties(m_allocator, m_allocationInfo.memoryType, &ret);
+    return ret;
+}
+
 void* DeviceMemoryAllocator_VMA::HandleModel::mapMemory(VkDeviceSize offset, VkDeviceSize size)
 {
     GHULBUS_UNUSED_VARIABLE(size);
@@ -79,11 +86,12 @@ void DeviceMemoryAllocator_VMA::HandleModel::bindImage(VkImage image)
     GhulbusVulkan::checkVulkanError(res, "Error in vmaBindImageMemory.");
 }
 
-DeviceMemoryAllocator_VMA::DeviceMemoryAllocator_VMA(GhulbusVulkan::Instance& instance, GhulbusVulkan::Device& device)
-    :m_allocator(nullptr)
+DeviceMemoryAllocator_VMA::DeviceMemoryAllocator_VMA(GhulbusVulkan::Instance& instance, GhulbusVulkan::Device& device,
+                                                     bool enable_memory_budget)
+    :m_allocator(nullptr), m_isDeviceLocalMemoryHostVisible(device.getPhysicalDevice().isDeviceLocalMemoryHostVisible())
 {
     VmaAllocatorCreateInfo create_info;
-    create_info.flags = 0;
+    create_info.flags = (enable_memory_budget) ? VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT : 0;
     create_info.physicalDevice = device.getPhysicalDevice().getVkPhysicalDevice();
     create_info.device = device.getVkDevice();
     create_info.preferredLargeHeapBlockSize = 0;
@@ -106,7 +114,7 @@ DeviceMemoryAllocator_VMA::~DeviceMemoryAllocator_VMA()
 }
 
 DeviceMemoryAllocator_VMA::DeviceMemoryAllocator_VMA(DeviceMemoryAllocator_VMA&& rhs)
-    :m_allocator(rhs.m_allocator)
+    :m_allocator(rhs.m_allocator), m_isDeviceLocalMemoryHostVisible(rhs.m_isDeviceLocalMemoryHostVisible)
 {
     rhs.m_allocator = nullptr;
 }
@@ -116,6 +124,7 @@ DeviceMemoryAllocator_VMA& DeviceMemoryAllocator_VMA::operator=(DeviceMemoryAllo
     if (this != &rhs) {
         if (m_allocator) { vmaDestroyAllocator(m_allocator); }
         m_allocator = rhs.m_allocator;
+        m_isDeviceLocalMemoryHostVisible = rhs.m_isDeviceLocalMemoryHostVisible;
         rhs.m_allocator = nullptr;
     }
     return *this;
@@ -125,6 +134,7 @@ VmaMemoryUsage DeviceMemoryAllocator_VMA::translateUsage(MemoryUsage usage)
 {
     switch (usage) {
     case MemoryUsage::GpuOnly: return VMA_MEMORY_USAGE_GPU_ONLY;
+    case MemoryUsage::GpuOnlyDirectUpload: return VMA_MEMORY_USAGE_GPU_ONLY;
     case MemoryUsage::CpuOnly: return VMA_MEMORY_USAGE_CPU_ONLY;
     case MemoryUsage::CpuToGpu: return VMA_MEMORY_USAGE_CPU_TO_GPU;
     case MemoryUsage::GpuToCpu: return VMA_MEMORY_USAGE_GPU_TO_CPU;
@@ -163,6 +173,24 @@ auto DeviceMemoryAllocator_VMA::allocateMemory(VkMemoryRequirements const& requi
 auto DeviceMemoryAllocator_VMA::allocateMemoryForBuffer(GhulbusVulkan::Buffer& buffer,
                                                         MemoryUsage usage) -> DeviceMemory
 {
+    if ((usage == MemoryUsage::GpuOnlyDirectUpload) && m_isDeviceLocalMemoryHostVisible) {
+        VmaAllocationCreateInfo create_info;
+        create_info.flags = 0;
+        create_info.usage = VMA_MEMORY_USAGE_UNKNOWN;
+        create_info.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+        create_info.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        create_info.memoryTypeBits = 0;
+        create_info.pool = VK_NULL_HANDLE;
+        create_info.pUserData = this;
+        VmaAllocation allocation;
+        VmaAllocationInfo allocation_info;
+        VkResult const res =
+            vmaAllocateMemoryForBuffer(m_allocator, buffer.getVkBuffer(), &create_info, &allocation, &allocation_info);
+        if (res == VK_SUCCESS) {
+            return DeviceMemory(std::make_unique<HandleModel>(m_allocator, allocation, allocation_info));
+        }
+        // host-visible device memory is exhausted; fall back to memory that is uploaded through staging
+    }
     VmaAllocationCreateInfo create_info;
     create_info.flags = 0;
     create_info.usage = translateUsage(usage);
@@ -237,4 +265,18 @@ auto DeviceMemoryAllocator_VMA::allocateMemoryForImage(GhulbusVulkan::Image& ima
     GhulbusVulkan::checkVulkanError(res, "Error in vmaAllocateMemoryForImage.");
     return DeviceMemory(std::make_unique<HandleModel>(m_allocator, allocation, allocation_info));
 }
+
+auto DeviceMemoryAllocator_VMA::getHeapBudgets() const -> std::vector<HeapBudget>
+{
+    VkPhysicalDeviceMemoryProperties const* mem_props;
+    vmaGetMemoryProperties(m_allocator, &mem_props);
+    VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+    vmaGetHeapBudgets(m_allocator, budgets);
+    std::vector<HeapBudget> ret;
+    ret.reserve(mem_props->memoryHeapCount);
+    for (uint32_t i = 0; i < mem_props->memoryHeapCount; ++i) {
+        ret.push_back(HeapBudget{ budgets[i].usage, budgets[i].budget, mem_props->memoryHeaps[i].flags });
+    }
+    return ret;
+}
 }
@@ -0,0 +1,80 @@
+#include <gbGraphics/detail/IndexTupleMap.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE::detail
+{
+namespace {
+/** Smallest number of slots for holding n elements below the maximum load factor of 3/4.
+ */
+std::size_t slotsForSize(std::size_t n)
+{
+    return std::bit_ceil(std::max<std::size_t>((n * 4 + 2) / 3 + 1, 16));
+}
+}
+
+template<typename Index_T>
+BasicIndexTupleMap<Index_T>::BasicIndexTupleMap()
+    :m_size(0)
+{}
+
+template<typename Index_T>
+BasicIndexTupleMap<Index_T>::BasicIndexTupleMap(std::size_t expected_size)
+    :m_size(0)
+{
+    reserve(expected_size);
+}
+
+template<typename Index_T>
+void BasicIndexTupleMap<Index_T>::reserve(std::size_t expected_size)
+{
+    std::size_t const n_slots = slotsForSize(expected_size);
+    if (n_slots > m_slots.size()) { rehash(n_slots); }
+}
+
+template<typename Index_T>
+std::size_t BasicIndexTupleMap<Index_T>::size() const
+{
+    return m_size;
+}
+
+template<typename Index_T>
+bool BasicIndexTupleMap<Index_T>::empty() const
+{
+    return m_size == 0;
+}
+
+template<typename Index_T>
+void BasicIndexTupleMap<Index_T>::clear()
+{
+    std::fill(m_slots.begin(), m_slots.end(), Slot{ IndexTuple{}, -1 });
+    m_size = 0;
+}
+
+template<typename Index_T>
+void BasicIndexTupleMap<Index_T>::rehash(std::size_t n_slots)
+{
+    GHULBUS_PRECONDITION(std::has_single_bit(n_slots) && (n_slots * 3 >= m_size * 4));
+    std::vector<Slot> old_slots(n_slots, Slot{ IndexTuple{}, -1 });
+    old_slots.swap(m_slots);
+    std::size_t const mask = n_slots - 1;
+    for (Slot const& s : old_slots) {
+        if (s.value < 0) { continue; }
+        std::size_t i = IndexTupleHash{}(s.key) & mask;
+        while (m_slots[i].value >= 0) { i = (i + 1) & mask; }
+        m_slots[i] = s;
+    }
+}
+
+template<typename Index_T>
+void BasicIndexTupleMap<Index_T>::grow()
+{
+    rehash(m_slots.empty() ? slotsForSize(0) : (m_slots.size() * 2));
+}
+
+template class BasicIndexTupleMap<std::int32_t>;
+template class BasicIndexTupleMap<std::int64_t>;
+}
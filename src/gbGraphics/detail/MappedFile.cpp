@@ -0,0 +1,116 @@
+#include <gbGraphics/detail/MappedFile.hpp>
+
+#include <gbGraphics/Exceptions.hpp>
+
+#include <gbBase/Finally.hpp>
+
+#include <limits>
+
+#if WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#   define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#   define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GHULBUS_GRAPHICS_NAMESPACE::detail
+{
+MappedFile::MappedFile(char const* filename)
+    :m_data(nullptr), m_size(0)
+{
+#if WIN32
+    HANDLE fin = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fin == INVALID_HANDLE_VALUE) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename),
+                      "Unable to open file.");
+    }
+    auto guard_file_handle = Ghulbus::finally([fin]() { CloseHandle(fin); });
+    LARGE_INTEGER lfilesize;
+    if ((GetFileSizeEx(fin, &lfilesize) == 0) || (lfilesize.QuadPart == 0) ||
+        (static_cast<unsigned long long>(lfilesize.QuadPart) > std::numeric_limits<std::size_t>::max()))
+    {
+        GHULBUS_THROW(Exceptions::IOError() << Exception_Info::filename(filename),
+                      "File size error.");
+    }
+    HANDLE mapping = CreateFileMappingA(fin, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        GHULBUS_THROW(Exceptions::IOError() << Exception_Info::filename(filename),
+                      "Unable to map file.");
+    }
+    // the view keeps the mapping object alive; both handles can be closed once the view exists
+    auto guard_mapping_handle = Ghulbus::finally([mapping]() { CloseHandle(mapping); });
+    void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        GHULBUS_THROW(Exceptions::IOError() << Exception_Info::filename(filename),
+                      "Unable to map file.");
+    }
+    m_data = static_cast<char const*>(view);
+    m_size = static_cast<std::size_t>(lfilesize.QuadPart);
+#else
+    int const fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        GHULBUS_THROW(Exceptions::IOError{} << Exception_Info::filename(filename),
+                      "Unable to open file.");
+    }
+    // the mapping holds its own reference to the file; the descriptor can be closed once the mapping exists
+    auto guard_file_handle = Ghulbus::finally([fd]() { close(fd); });
+    struct stat file_stat;
+    if ((fstat(fd, &file_stat) != 0) || (file_stat.st_size <= 0)) {
+        GHULBUS_THROW(Exceptions::IOError() << Exception_Info::filename(filename),
+                      "File size error.");
+    }
+    std::size_t const filesize = static_cast<std::size_t>(file_stat.st_size);
+    void* const mapped = mmap(nullptr, filesize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        GHULBUS_THROW(Exceptions::IOError() << Exception_Info::filename(filename),
+                      "Unable to map file.");
+    }
+    // hint only; the data is usually consumed front to back
+    madvise(mapped, filesize, MADV_SEQUENTIAL);
+    m_data = static_cast<char const*>(mapped);
+    m_size = filesize;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data) {
+#if WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    :m_data(rhs.m_data), m_size(rhs.m_size)
+{
+    rhs.m_data = nullptr;
+    rhs.m_size = 0;
+}
+
+char const* MappedFile::getData() const
+{
+    return m_data;
+}
+
+std::size_t MappedFile::getSize() const
+{
+    return m_size;
+}
+
+std::span<char const> MappedFile::getSpan() const
+{
+    return std::span<char const>(m_data, m_size);
+}
+}
@@ -0,0 +1,38 @@
+#include <gbGraphics/detail/MipChain.hpp>
+
+#include <algorithm>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+uint32_t getFullMipChainLength(uint32_t width, uint32_t height)
+{
+    uint32_t ret = 1;
+    for (uint32_t d = std::max(width, height); d > 1; d >>= 1) { ++ret; }
+    return ret;
+}
+
+VkExtent2D getMipLevelExtent(uint32_t width, uint32_t height, uint32_t level)
+{
+    if (level >= 32) { return VkExtent2D{ 1, 1 }; }
+    return VkExtent2D{ std::max(width >> level, 1u), std::max(height >> level, 1u) };
+}
+
+std::optional<MipmapMethod> selectMipmapMethod(VkFormatFeatureFlags optimal_tiling_features,
+                                               bool storage_write_without_format)
+{
+    VkFormatFeatureFlags const blit_features = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                               VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    if ((optimal_tiling_features & blit_features) == blit_features) {
+        return MipmapMethod::Blit;
+    }
+    VkFormatFeatureFlags const compute_features =
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
+    if (((optimal_tiling_features & compute_features) == compute_features) && storage_write_without_format) {
+        return MipmapMethod::Compute;
+    }
+    return std::nullopt;
+}
+}
+}
@@ -0,0 +1,112 @@
+#include <gbGraphics/detail/RangeAllocator.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <iterator>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+RangeAllocator::RangeAllocator(uint64_t capacity)
+    :m_capacity(capacity), m_freeSize(0)
+{
+    reset();
+}
+
+std::optional<uint64_t> RangeAllocator::allocate(uint64_t size)
+{
+    GHULBUS_PRECONDITION(size > 0);
+    auto const it_size = m_freeBySize.lower_bound(size);
+    if (it_size == m_freeBySize.end()) { return std::nullopt; }
+    uint64_t const offset = it_size->second;
+    uint64_t const free_size = it_size->first;
+    eraseFreeRange(m_freeByOffset.find(offset));
+    if (free_size > size) {
+        insertFreeRange(offset + size, free_size - size);
+    }
+    m_freeSize -= size;
+    return offset;
+}
+
+void RangeAllocator::free(uint64_t offset, uint64_t size)
+{
+    GHULBUS_PRECONDITION((size > 0) && (offset + size <= m_capacity));
+    uint64_t range_begin = offset;
+    uint64_t range_end = offset + size;
+    auto it_next = m_freeByOffset.lower_bound(offset);
+    GHULBUS_PRECONDITION_MESSAGE((it_next == m_freeByOffset.end()) || (it_next->first >= range_end),
+                                 "Range overlaps a free range.");
+    if (it_next != m_freeByOffset.begin()) {
+        auto const it_prev = std::prev(it_next);
+        GHULBUS_PRECONDITION_MESSAGE(it_prev->first + it_prev->second <= range_begin,
+                                     "Range overlaps a free range.");
+        if (it_prev->first + it_prev->second == range_begin) {
+            range_begin = it_prev->first;
+            eraseFreeRange(it_prev);
+        }
+    }
+    if ((it_next != m_freeByOffset.end()) && (it_next->first == range_end)) {
+        range_end += it_next->second;
+        eraseFreeRange(it_next);
+    }
+    insertFreeRange(range_begin, range_end - range_begin);
+    m_freeSize += size;
+}
+
+void RangeAllocator::reset()
+{
+    m_freeByOffset.clear();
+    m_freeBySize.clear();
+    m_freeSize = 0;
+    if (m_capacity > 0) {
+        insertFreeRange(0, m_capacity);
+        m_freeSize = m_capacity;
+    }
+}
+
+uint64_t RangeAllocator::getCapacity() const
+{
+    return m_capacity;
+}
+
+uint64_t RangeAllocator::getFreeSize() const
+{
+    return m_freeSize;
+}
+
+uint64_t RangeAllocator::getLargestFreeRange() const
+{
+    return m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first;
+}
+
+uint64_t RangeAllocator::getNumberOfFreeRanges() const
+{
+    return m_freeByOffset.size();
+}
+
+float RangeAllocator::getFragmentation() const
+{
+    if (m_freeSize == 0) { return 0.f; }
+    return 1.f - (static_cast<float>(getLargestFreeRange()) / static_cast<float>(m_freeSize));
+}
+
+void RangeAllocator::insertFreeRange(uint64_t offset, uint64_t size)
+{
+    m_freeByOffset.emplace(offset, size);
+    m_freeBySize.emplace(size, offset);
+}
+
+void RangeAllocator::eraseFreeRange(std::map<uint64_t, uint64_t>::iterator it)
+{
+    auto [first, last] = m_freeBySize.equal_range(it->second);
+    for (; first != last; ++first) {
+        if (first->second == it->first) {
+            m_freeBySize.erase(first);
+            break;
+        }
+    }
+    m_freeByOffset.erase(it);
+}
+}
+}
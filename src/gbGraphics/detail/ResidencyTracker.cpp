@@ -0,0 +1,118 @@
+#include <gbGraphics/detail/ResidencyTracker.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <algorithm>
+
+namespace GHULBUS_GRAPHICS_NAMESPACE
+{
+namespace detail
+{
+ResidencyTracker::ResidencyTracker()
+    :m_currentFrame(0), m_residentSize(0)
+{
+}
+
+auto ResidencyTracker::add() -> ResourceId
+{
+    Entry const entry{ 0, m_currentFrame, false, true };
+    if (!m_freeIds.empty()) {
+        ResourceId const ret = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_entries[ret] = entry;
+        return ret;
+    }
+    m_entries.push_back(entry);
+    return static_cast<ResourceId>(m_entries.size() - 1);
+}
+
+void ResidencyTracker::remove(ResourceId id)
+{
+    Entry& entry = getEntry(id);
+    if (entry.isResident) { m_residentSize -= entry.size; }
+    entry.isLive = false;
+    m_freeIds.push_back(id);
+}
+
+void ResidencyTracker::markUsed(ResourceId id)
+{
+    getEntry(id).lastUseFrame = m_currentFrame;
+}
+
+void ResidencyTracker::setResident(ResourceId id, uint64_t size)
+{
+    Entry& entry = getEntry(id);
+    GHULBUS_PRECONDITION(!entry.isResident);
+    entry.size = size;
+    entry.isResident = true;
+    m_residentSize += size;
+}
+
+void ResidencyTracker::setEvicted(ResourceId id)
+{
+    Entry& entry = getEntry(id);
+    GHULBUS_PRECONDITION(entry.isResident);
+    entry.isResident = false;
+    m_residentSize -= entry.size;
+}
+
+bool ResidencyTracker::isResident(ResourceId id) const
+{
+    return getEntry(id).isResident;
+}
+
+uint64_t ResidencyTracker::getLastUseFrame(ResourceId id) const
+{
+    return getEntry(id).lastUseFrame;
+}
+
+uint64_t ResidencyTracker::getResidentSize() const
+{
+    return m_residentSize;
+}
+
+uint64_t ResidencyTracker::getCurrentFrame() const
+{
+    return m_currentFrame;
+}
+
+void ResidencyTracker::nextFrame()
+{
+    ++m_currentFrame;
+}
+
+auto ResidencyTracker::selectEvictions(uint64_t budget, uint32_t frames_in_flight) const -> std::vector<ResourceId>
+{
+    std::vector<ResourceId> ret;
+    if (m_residentSize <= budget) { return ret; }
+    for (ResourceId i = 0; i < m_entries.size(); ++i) {
+        Entry const& entry = m_entries[i];
+        if (entry.isLive && entry.isResident && (entry.lastUseFrame + frames_in_flight <= m_currentFrame)) {
+            ret.push_back(i);
+        }
+    }
+    std::stable_sort(ret.begin(), ret.end(), [this](ResourceId lhs, ResourceId rhs) {
+            return m_entries[lhs].lastUseFrame < m_entries[rhs].lastUseFrame;
+        });
+    uint64_t resident_size = m_residentSize;
+    auto it = ret.begin();
+    for (; (it != ret.end()) && (resident_size > budget); ++it) {
+        resident_size -= m_entries[*it].size;
+    }
+    ret.erase(it, ret.end());
+    return ret;
+}
+
+auto ResidencyTracker::getEntry(ResourceId id) -> Entry&
+{
+    GHULBUS_PRECONDITION((id < m_entries.size()) && (m_entries[id].isLive));
+    return m_entries[id];
+}
+
+auto ResidencyTracker::getEntry(ResourceId id) const -> Entry const&
+{
+    GHULBUS_PRECONDITION((id < m_entries.size()) && (m_entries[id].isLive));
+    return m_entries[id];
+}
+}
+}
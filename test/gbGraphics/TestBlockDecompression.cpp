@@ -0,0 +1,189 @@
+#include <gbGraphics/detail/BlockDecompression.hpp>
+
+#include <catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+using Block = std::array<std::byte, 16>;
+using Texels = std::array<std::byte, 16 * 4>;
+
+/** Writes the fields of a BC7 block, least significant bit first.
+ */
+class Bc7BlockWriter {
+private:
+    Block m_block = {};
+    int m_position = 0;
+public:
+    Bc7BlockWriter& write(uint32_t value, int number_of_bits)
+    {
+        for (int i = 0; i < number_of_bits; ++i, ++m_position) {
+            if ((value >> i) & 0x01) {
+                m_block[m_position / 8] |= std::byte(1 << (m_position % 8));
+            }
+        }
+        return *this;
+    }
+
+    Block const& getBlock() const
+    {
+        REQUIRE(m_position == 128);
+        return m_block;
+    }
+};
+
+std::array<uint8_t, 4> getTexel(Texels const& texels, int index)
+{
+    return { static_cast<uint8_t>(texels[4 * index]), static_cast<uint8_t>(texels[4 * index + 1]),
+             static_cast<uint8_t>(texels[4 * index + 2]), static_cast<uint8_t>(texels[4 * index + 3]) };
+}
+
+using Texel = std::array<uint8_t, 4>;
+}
+
+TEST_CASE("Block Decompression")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE::detail;
+
+    SECTION("Decompressed formats")
+    {
+        CHECK(getDecompressedFormat(VK_FORMAT_BC1_RGBA_UNORM_BLOCK) == VK_FORMAT_R8G8B8A8_UNORM);
+        CHECK(getDecompressedFormat(VK_FORMAT_BC3_SRGB_BLOCK) == VK_FORMAT_R8G8B8A8_SRGB);
+        CHECK(getDecompressedFormat(VK_FORMAT_BC5_UNORM_BLOCK) == VK_FORMAT_R8G8B8A8_UNORM);
+        CHECK(getDecompressedFormat(VK_FORMAT_BC7_SRGB_BLOCK) == VK_FORMAT_R8G8B8A8_SRGB);
+        CHECK(!getDecompressedFormat(VK_FORMAT_BC5_SNORM_BLOCK));
+        CHECK(!getDecompressedFormat(VK_FORMAT_BC6H_UFLOAT_BLOCK));
+        CHECK(!getDecompressedFormat(VK_FORMAT_R8G8B8A8_UNORM));
+    }
+
+    SECTION("BC1 four color mode")
+    {
+        // red and blue endpoints; indices 0, 1, 2, 3 in the first row, 0 everywhere else
+        Block const block = { std::byte(0x00), std::byte(0xf8), std::byte(0x1f), std::byte(0x00),
+                              std::byte(0xe4), std::byte(0x00), std::byte(0x00), std::byte(0x00) };
+        Texels texels;
+        decompressBlock(VK_FORMAT_BC1_RGBA_UNORM_BLOCK, block.data(), texels.data());
+        CHECK(getTexel(texels, 0) == Texel{ 255, 0, 0, 255 });
+        CHECK(getTexel(texels, 1) == Texel{ 0, 0, 255, 255 });
+        CHECK(getTexel(texels, 2) == Texel{ 170, 0, 85, 255 });
+        CHECK(getTexel(texels, 3) == Texel{ 85, 0, 170, 255 });
+        CHECK(getTexel(texels, 15) == Texel{ 255, 0, 0, 255 });
+    }
+
+    SECTION("BC1 three color mode")
+    {
+        // black and white endpoints with color0 <= color1; indices 2 and 3 in the first row
+        Block const block = { std::byte(0x00), std::byte(0x00), std::byte(0xff), std::byte(0xff),
+                              std::byte(0x0e), std::byte(0x00), std::byte(0x00), std::byte(0x00) };
+        Texels texels;
+        decompressBlock(VK_FORMAT_BC1_RGBA_UNORM_BLOCK, block.data(), texels.data());
+        CHECK(getTexel(texels, 0) == Texel{ 128, 128, 128, 255 });
+        CHECK(getTexel(texels, 1) == Texel{ 0, 0, 0, 0 });
+        CHECK(getTexel(texels, 2) == Texel{ 0, 0, 0, 255 });
+        // formats without alpha ignore the transparency
+        decompressBlock(VK_FORMAT_BC1_RGB_UNORM_BLOCK, block.data(), texels.data());
+        CHECK(getTexel(texels, 1) == Texel{ 0, 0, 0, 255 });
+    }
+
+    SECTION("BC3 alpha")
+    {
+        // alpha 255 to 0 with indices 0, 1, 2 in the first row; opaque white color block
+        Block const block = { std::byte(0xff), std::byte(0x00), std::byte(0x88), std::byte(0x00),
+                              std::byte(0x00), std::byte(0x00), std::byte(0x00), std::byte(0x00),
+                              std::byte(0xff), std::byte(0xff), std::byte(0xff), std::byte(0xff),
+                              std::byte(0x00), std::byte(0x00), std::byte(0x00), std::byte(0x00) };
+        Texels texels;
+        decompressBlock(VK_FORMAT_BC3_UNORM_BLOCK, block.data(), texels.data());
+        CHECK(getTexel(texels, 0) == Texel{ 255, 255, 255, 255 });
+        CHECK(getTexel(texels, 1) == Texel{ 255, 255, 255, 0 });
+        CHECK(getTexel(texels, 2) == Texel{ 255, 255, 255, 219 });
+    }
+
+    SECTION("BC4 and BC5 channels")
+    {
+        // 0 to 255 in six value mode with indices 2, 6, 7 in the first row
+        Block const block = { std::byte(0x00), std::byte(0xff), std::byte(0xf2), std::byte(0x01),
+                              std::byte(0x00), std::byte(0x00), std::byte(0x00), std::byte(0x00),
+                              std::byte(0x40), std::byte(0x40), std::byte(0x00), std::byte(0x00),
+                              std::byte(0x00), std::byte(0x00), std::byte(0x00), std::byte(0x00) };
+        Texels texels;
+        decompressBlock(VK_FORMAT_BC4_UNORM_BLOCK, block.data(), texels.data());
+        CHECK(getTexel(texels, 0) == Texel{ 51, 0, 0, 255 });
+        CHECK(getTexel(texels, 1) == Texel{ 0, 0, 0, 255 });
+        CHECK(getTexel(texels, 2) == Texel{ 255, 0, 0, 255 });
+        CHECK(getTexel(texels, 3) == Texel{ 0, 0, 0, 255 });
+        decompressBlock(VK_FORMAT_BC5_UNORM_BLOCK, block.data(), texels.data());
+        CHECK(getTexel(texels, 0) == Texel{ 51, 64, 0, 255 });
+        CHECK(getTexel(texels, 2) == Texel{ 255, 64, 0, 255 });
+    }
+
+    SECTION("BC7 mode 6")
+    {
+        Bc7BlockWriter writer;
+        writer.write(0x40, 7);
+        // endpoints 255 and 0 for all channels, with the p-bit as the least significant bit
+        for (int c = 0; c < 4; ++c) { writer.write(0x7f, 7).write(0x00, 7); }
+        writer.write(1, 1).write(0, 1);
+        // anchor texel has one bit less
+        writer.write(0, 3).write(15, 4).write(8, 4);
+        for (int i = 3; i < 16; ++i) { writer.write(0, 4); }
+        Texels texels;
+        decompressBlock(VK_FORMAT_BC7_UNORM_BLOCK, writer.getBlock().data(), texels.data());
+        CHECK(getTexel(texels, 0) == Texel{ 255, 255, 255, 255 });
+        CHECK(getTexel(texels, 1) == Texel{ 0, 0, 0, 0 });
+        CHECK(getTexel(texels, 2) == Texel{ 120, 120, 120, 120 });
+        CHECK(getTexel(texels, 15) == Texel{ 255, 255, 255, 255 });
+    }
+
+    SECTION("BC7 mode 1 partitions")
+    {
+        Bc7BlockWriter writer;
+        // partition 0 puts the two right columns into the second subset
+        writer.write(0x02, 2).write(0, 6);
+        writer.write(0x3f, 6).write(0x3f, 6).write(0, 6).write(0, 6);     // red
+        writer.write(0, 6).write(0, 6).write(0x3f, 6).write(0x3f, 6);     // green
+        writer.write(0, 6).write(0, 6).write(0, 6).write(0, 6);           // blue
+        writer.write(1, 1).write(0, 1);                                   // shared p-bits
+        for (int i = 0; i < 16; ++i) { writer.write(0, ((i == 0) || (i == 15)) ? 2 : 3); }
+        Texels texels;
+        decompressBlock(VK_FORMAT_BC7_UNORM_BLOCK, writer.getBlock().data(), texels.data());
+        // the p-bit also applies to the zero channels
+        CHECK(getTexel(texels, 0) == Texel{ 255, 2, 2, 255 });
+        CHECK(getTexel(texels, 1) == Texel{ 255, 2, 2, 255 });
+        CHECK(getTexel(texels, 2) == Texel{ 0, 253, 0, 255 });
+        CHECK(getTexel(texels, 15) == Texel{ 0, 253, 0, 255 });
+    }
+
+    SECTION("BC7 reserved mode")
+    {
+        Block const block = {};
+        Texels texels;
+        decompressBlock(VK_FORMAT_BC7_UNORM_BLOCK, block.data(), texels.data());
+        CHECK(getTexel(texels, 0) == Texel{ 0, 0, 0, 0 });
+    }
+
+    SECTION("Images with partial blocks")
+    {
+        // 5x5 image with four blocks of different solid colors
+        std::vector<std::byte> blocks(4 * 8, std::byte(0x00));
+        uint16_t const colors[] = { 0xf800, 0x07e0, 0x001f, 0xffff };
+        for (int i = 0; i < 4; ++i) {
+            blocks[8 * i] = std::byte(colors[i] & 0xff);
+            blocks[8 * i + 1] = std::byte(colors[i] >> 8);
+        }
+        std::vector<std::byte> texels(5 * 5 * 4);
+        decompressImage(VK_FORMAT_BC1_RGB_UNORM_BLOCK, blocks.data(), 5, 5, texels.data());
+        auto const texel_at = [&texels](int x, int y) -> Texel {
+                std::byte const* t = texels.data() + (y * 5 + x) * 4;
+                return { static_cast<uint8_t>(t[0]), static_cast<uint8_t>(t[1]),
+                         static_cast<uint8_t>(t[2]), static_cast<uint8_t>(t[3]) };
+            };
+        CHECK(texel_at(3, 3) == Texel{ 255, 0, 0, 255 });
+        CHECK(texel_at(4, 0) == Texel{ 0, 255, 0, 255 });
+        CHECK(texel_at(0, 4) == Texel{ 0, 0, 255, 255 });
+        CHECK(texel_at(4, 4) == Texel{ 255, 255, 255, 255 });
+    }
+}
@@ -0,0 +1,93 @@
+#include <gbGraphics/detail/FormatInfo.hpp>
+
+#include <gbGraphics/Exceptions.hpp>
+
+#include <catch.hpp>
+
+TEST_CASE("Format Info")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+    using detail::getImageRegionSize;
+    using detail::getTexelBlockInfo;
+
+    SECTION("Uncompressed formats have single texel blocks")
+    {
+        auto const r8 = getTexelBlockInfo(VK_FORMAT_R8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT);
+        REQUIRE(r8);
+        CHECK(r8->size == 1);
+        CHECK(r8->width == 1);
+        CHECK(r8->height == 1);
+        auto const rgba8 = getTexelBlockInfo(VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT);
+        REQUIRE(rgba8);
+        CHECK(rgba8->size == 4);
+        CHECK(rgba8->width == 1);
+        CHECK(rgba8->height == 1);
+        CHECK(getTexelBlockInfo(VK_FORMAT_R16G16B16A16_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT)->size == 8);
+        CHECK(getTexelBlockInfo(VK_FORMAT_R32G32B32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT)->size == 12);
+        CHECK(getTexelBlockInfo(VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT)->size == 16);
+    }
+
+    SECTION("Block compressed formats have 4x4 blocks")
+    {
+        auto const bc1 = getTexelBlockInfo(VK_FORMAT_BC1_RGBA_UNORM_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT);
+        REQUIRE(bc1);
+        CHECK(bc1->size == 8);
+        CHECK(bc1->width == 4);
+        CHECK(bc1->height == 4);
+        CHECK(getTexelBlockInfo(VK_FORMAT_BC4_UNORM_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT)->size == 8);
+        auto const bc7 = getTexelBlockInfo(VK_FORMAT_BC7_SRGB_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT);
+        REQUIRE(bc7);
+        CHECK(bc7->size == 16);
+        CHECK(bc7->width == 4);
+        CHECK(bc7->height == 4);
+        CHECK(getTexelBlockInfo(VK_FORMAT_BC3_UNORM_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT)->size == 16);
+        CHECK(getTexelBlockInfo(VK_FORMAT_BC6H_UFLOAT_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT)->size == 16);
+    }
+
+    SECTION("Depth and stencil aspects are sized separately")
+    {
+        CHECK(getTexelBlockInfo(VK_FORMAT_D24_UNORM_S8_UINT, VK_IMAGE_ASPECT_DEPTH_BIT)->size == 4);
+        CHECK(getTexelBlockInfo(VK_FORMAT_D24_UNORM_S8_UINT, VK_IMAGE_ASPECT_STENCIL_BIT)->size == 1);
+        CHECK(getTexelBlockInfo(VK_FORMAT_D32_SFLOAT_S8_UINT, VK_IMAGE_ASPECT_DEPTH_BIT)->size == 4);
+        CHECK(getTexelBlockInfo(VK_FORMAT_D16_UNORM, VK_IMAGE_ASPECT_DEPTH_BIT)->size == 2);
+        CHECK(getTexelBlockInfo(VK_FORMAT_S8_UINT, VK_IMAGE_ASPECT_STENCIL_BIT)->size == 1);
+        CHECK_FALSE(getTexelBlockInfo(VK_FORMAT_D32_SFLOAT, VK_IMAGE_ASPECT_STENCIL_BIT));
+    }
+
+    SECTION("Unsupported formats")
+    {
+        CHECK_FALSE(getTexelBlockInfo(VK_FORMAT_UNDEFINED, VK_IMAGE_ASPECT_COLOR_BIT));
+        CHECK_FALSE(getTexelBlockInfo(VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT));
+        CHECK_THROWS_AS(getImageRegionSize(VK_FORMAT_UNDEFINED, VK_IMAGE_ASPECT_COLOR_BIT, VkExtent3D{ 1, 1, 1 }),
+                        Exceptions::InvalidArgument);
+    }
+
+    SECTION("Region size of uncompressed formats")
+    {
+        CHECK(getImageRegionSize(VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT, VkExtent3D{ 1, 1, 1 }) == 4);
+        CHECK(getImageRegionSize(VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT, VkExtent3D{ 17, 3, 1 }) ==
+              17 * 3 * 4);
+        CHECK(getImageRegionSize(VK_FORMAT_R32G32B32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, VkExtent3D{ 5, 7, 2 }) ==
+              5 * 7 * 2 * 12);
+        CHECK(getImageRegionSize(VK_FORMAT_D32_SFLOAT_S8_UINT, VK_IMAGE_ASPECT_STENCIL_BIT, VkExtent3D{ 8, 8, 1 }) ==
+              64);
+    }
+
+    SECTION("Region size of block compressed formats rounds up to whole blocks")
+    {
+        CHECK(getImageRegionSize(VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT, VkExtent3D{ 4, 4, 1 }) ==
+              8);
+        CHECK(getImageRegionSize(VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT, VkExtent3D{ 1, 1, 1 }) ==
+              8);
+        CHECK(getImageRegionSize(VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT, VkExtent3D{ 5, 9, 1 }) ==
+              2 * 3 * 8);
+        CHECK(getImageRegionSize(VK_FORMAT_BC7_UNORM_BLOCK, VK_IMAGE_ASPECT_COLOR_BIT, VkExtent3D{ 256, 128, 1 }) ==
+              64 * 32 * 16);
+    }
+
+    SECTION("Large regions do not overflow")
+    {
+        CHECK(getImageRegionSize(VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT,
+                                 VkExtent3D{ 65536, 65536, 1 }) == VkDeviceSize{ 65536 } * 65536 * 16);
+    }
+}
@@ -0,0 +1,225 @@
+#include <gbGraphics/ImageContainerLoader.hpp>
+
+#include <gbGraphics/Exceptions.hpp>
+
+#include <gbBase/Finally.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+void appendUint32(std::vector<char>& data, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) { data.push_back(static_cast<char>((value >> (8 * i)) & 0xff)); }
+}
+
+void appendUint64(std::vector<char>& data, std::uint64_t value)
+{
+    appendUint32(data, static_cast<std::uint32_t>(value));
+    appendUint32(data, static_cast<std::uint32_t>(value >> 32));
+}
+
+/** A BC1 block of a single color.
+ */
+void appendBc1Block(std::vector<char>& data, std::uint16_t color)
+{
+    data.push_back(static_cast<char>(color & 0xff));
+    data.push_back(static_cast<char>(color >> 8));
+    for (int i = 0; i < 6; ++i) { data.push_back(0); }
+}
+
+std::vector<char> makeDdsHeader(std::uint32_t width, std::uint32_t height, std::uint32_t mip_levels,
+                                char const* fourcc, std::uint32_t caps2 = 0)
+{
+    std::vector<char> ret = { 'D', 'D', 'S', ' ' };
+    appendUint32(ret, 124);
+    appendUint32(ret, 0x1007 | 0x20000);        // caps, height, width, pixel format, mip map count
+    appendUint32(ret, height);
+    appendUint32(ret, width);
+    appendUint32(ret, 0);
+    appendUint32(ret, 0);
+    appendUint32(ret, mip_levels);
+    for (int i = 0; i < 11; ++i) { appendUint32(ret, 0); }
+    appendUint32(ret, 32);
+    appendUint32(ret, 0x04);
+    ret.insert(ret.end(), fourcc, fourcc + 4);
+    for (int i = 0; i < 5; ++i) { appendUint32(ret, 0); }
+    appendUint32(ret, 0x1000);
+    appendUint32(ret, caps2);
+    for (int i = 0; i < 3; ++i) { appendUint32(ret, 0); }
+    return ret;
+}
+}
+
+TEST_CASE("Image Container Loader")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+
+    auto const write_file = [](std::string const& filename, std::vector<char> const& contents) {
+        std::ofstream fout(filename, std::ios_base::binary | std::ios_base::trunc);
+        fout.write(contents.data(), contents.size());
+    };
+    std::string const filename =
+        (std::filesystem::temp_directory_path() / "gbGraphics_TestImageContainerLoader.bin").string();
+    auto const guard_file = Ghulbus::finally([&]() { std::filesystem::remove(filename); });
+
+    SECTION("KTX2")
+    {
+        // 8x4 BC7 image with two levels, stored smallest level first
+        std::vector<char> file = { '\xAB', 'K', 'T', 'X', ' ', '2', '0', '\xBB', '\r', '\n', '\x1A', '\n' };
+        appendUint32(file, VK_FORMAT_BC7_UNORM_BLOCK);
+        appendUint32(file, 1);
+        appendUint32(file, 8);
+        appendUint32(file, 4);
+        appendUint32(file, 0);
+        appendUint32(file, 0);
+        appendUint32(file, 1);
+        appendUint32(file, 2);
+        appendUint32(file, 0);
+        for (int i = 0; i < 4; ++i) { appendUint32(file, 0); }
+        appendUint64(file, 0);
+        appendUint64(file, 0);
+        std::uint64_t const level1_offset = 80 + 2 * 24;
+        std::uint64_t const level0_offset = level1_offset + 16;
+        appendUint64(file, level0_offset);
+        appendUint64(file, 32);
+        appendUint64(file, 32);
+        appendUint64(file, level1_offset);
+        appendUint64(file, 16);
+        appendUint64(file, 16);
+        file.insert(file.end(), 16, '\x01');
+        file.insert(file.end(), 32, '\x02');
+        write_file(filename, file);
+
+        ImageContainerLoader const loader(filename.c_str());
+        CHECK(loader.getFormat() == VK_FORMAT_BC7_UNORM_BLOCK);
+        CHECK(loader.getWidth() == 8);
+        CHECK(loader.getHeight() == 4);
+        REQUIRE(loader.getMipLevels() == 2);
+        CHECK(loader.getDataSize() == 48);
+        CHECK(loader.getMipLevel(0).offset == 0);
+        CHECK(loader.getMipLevel(0).size == 32);
+        CHECK(loader.getMipLevel(1).offset == 32);
+        CHECK(loader.getMipLevel(1).size == 16);
+        CHECK(loader.getMipLevel(1).width == 4);
+        CHECK(loader.getMipLevel(1).height == 2);
+        // levels are reordered largest first
+        CHECK(loader.getData()[0] == std::byte(0x02));
+        CHECK(loader.getData()[31] == std::byte(0x02));
+        CHECK(loader.getData()[32] == std::byte(0x01));
+
+        // level sizes have to match the format
+        std::memset(file.data() + 80 + 8, 31, 1);
+        write_file(filename, file);
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::IOError);
+    }
+
+    SECTION("DDS")
+    {
+        // 4x4 BC1 image with a full mip chain of one block per level
+        std::vector<char> file = makeDdsHeader(4, 4, 3, "DXT1");
+        appendBc1Block(file, 0xf800);
+        appendBc1Block(file, 0x07e0);
+        appendBc1Block(file, 0x001f);
+        write_file(filename, file);
+
+        ImageContainerLoader const loader(filename.c_str());
+        CHECK(loader.getFormat() == VK_FORMAT_BC1_RGBA_UNORM_BLOCK);
+        CHECK(loader.getWidth() == 4);
+        CHECK(loader.getHeight() == 4);
+        REQUIRE(loader.getMipLevels() == 3);
+        CHECK(loader.getDataSize() == 24);
+        CHECK(loader.getMipLevel(2).offset == 16);
+        CHECK(loader.getMipLevel(2).width == 1);
+
+        ImageContainerLoader const decompressed = loader.decompress();
+        CHECK(decompressed.getFormat() == VK_FORMAT_R8G8B8A8_UNORM);
+        REQUIRE(decompressed.getMipLevels() == 3);
+        CHECK(decompressed.getDataSize() == (16 + 4 + 1) * 4);
+        CHECK(decompressed.getMipLevel(1).offset == 64);
+        CHECK(decompressed.getMipLevel(2).offset == 80);
+        std::byte const* const level1 = decompressed.getData() + decompressed.getMipLevel(1).offset;
+        CHECK(level1[0] == std::byte(0));
+        CHECK(level1[1] == std::byte(255));
+        std::byte const* const level2 = decompressed.getData() + decompressed.getMipLevel(2).offset;
+        CHECK(level2[0] == std::byte(0));
+        CHECK(level2[2] == std::byte(255));
+        CHECK(level2[3] == std::byte(255));
+    }
+
+    SECTION("Truncated DDS")
+    {
+        std::vector<char> file = makeDdsHeader(4, 4, 3, "DXT1");
+        appendBc1Block(file, 0xf800);
+        write_file(filename, file);
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::IOError);
+    }
+
+    SECTION("Unsupported DDS")
+    {
+        std::vector<char> file = makeDdsHeader(4, 4, 1, "DXT1", 0x200);
+        appendBc1Block(file, 0xf800);
+        write_file(filename, file);
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::NotImplemented);
+        file = makeDdsHeader(4, 4, 1, "ETC1");
+        appendBc1Block(file, 0xf800);
+        write_file(filename, file);
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::NotImplemented);
+    }
+
+    SECTION("Oversized images")
+    {
+        // rejected based on the header, before any memory is allocated for the texels
+        std::vector<char> file = makeDdsHeader(0x40000000, 0x40000000, 1, "DXT1");
+        appendBc1Block(file, 0xf800);
+        write_file(filename, file);
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::IOError);
+        file = makeDdsHeader(16385, 4, 1, "DXT1");
+        appendBc1Block(file, 0xf800);
+        write_file(filename, file);
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::IOError);
+        // more levels than the full chain
+        file = makeDdsHeader(4, 4, 4, "DXT1");
+        for (int i = 0; i < 4; ++i) { appendBc1Block(file, 0xf800); }
+        write_file(filename, file);
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::IOError);
+        // a valid size that exceeds the contents of the file
+        file = makeDdsHeader(16384, 16384, 15, "DXT1");
+        appendBc1Block(file, 0xf800);
+        write_file(filename, file);
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::IOError);
+
+        std::vector<char> ktx2 = { '\xAB', 'K', 'T', 'X', ' ', '2', '0', '\xBB', '\r', '\n', '\x1A', '\n' };
+        appendUint32(ktx2, VK_FORMAT_R32G32B32A32_SFLOAT);
+        appendUint32(ktx2, 4);
+        appendUint32(ktx2, 0xffffffff);
+        appendUint32(ktx2, 0xffffffff);
+        appendUint32(ktx2, 0);
+        appendUint32(ktx2, 0);
+        appendUint32(ktx2, 1);
+        appendUint32(ktx2, 1);
+        appendUint32(ktx2, 0);
+        for (int i = 0; i < 4; ++i) { appendUint32(ktx2, 0); }
+        appendUint64(ktx2, 0);
+        appendUint64(ktx2, 0);
+        appendUint64(ktx2, 80 + 24);
+        appendUint64(ktx2, 16);
+        appendUint64(ktx2, 16);
+        ktx2.insert(ktx2.end(), 16, '\x01');
+        write_file(filename, ktx2);
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::IOError);
+    }
+
+    SECTION("Unknown container")
+    {
+        write_file(filename, std::vector<char>(128, 'x'));
+        CHECK_THROWS_AS(ImageContainerLoader(filename.c_str()), Exceptions::IOError);
+    }
+}
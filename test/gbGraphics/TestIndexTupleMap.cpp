@@ -0,0 +1,56 @@
+#include <gbGraphics/detail/IndexTupleMap.hpp>
+
+#include <catch.hpp>
+
+TEST_CASE("Index Tuple Map")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE::detail;
+
+    SECTION("Default construction")
+    {
+        IndexTupleMap map;
+        CHECK(map.empty());
+        CHECK(map.size() == 0);
+        CHECK(map.find(IndexTuple(1, 2, 3)) == -1);
+    }
+
+    SECTION("Insertion")
+    {
+        IndexTupleMap map;
+        CHECK(map.tryEmplace(IndexTuple(1, 2, 3), 0) == std::make_pair(0, true));
+        CHECK(map.tryEmplace(IndexTuple(3, 2, 1), 1) == std::make_pair(1, true));
+        CHECK(map.tryEmplace(IndexTuple(1, 2, 3), 2) == std::make_pair(0, false));
+        CHECK(map.size() == 2);
+        CHECK(map.find(IndexTuple(1, 2, 3)) == 0);
+        CHECK(map.find(IndexTuple(3, 2, 1)) == 1);
+        CHECK(map.find(IndexTuple(1, 2, 4)) == -1);
+    }
+
+    SECTION("Growing keeps all elements")
+    {
+        IndexTupleMap map(4);
+        int const n = 100000;
+        bool all_inserted = true;
+        for (int i = 0; i < n; ++i) {
+            all_inserted = all_inserted && map.tryEmplace(IndexTuple(i + 1, i % 17, i % 3), i).second;
+        }
+        CHECK(all_inserted);
+        CHECK(map.size() == n);
+        bool all_found = true;
+        for (int i = 0; i < n; ++i) {
+            all_found = all_found && (map.find(IndexTuple(i + 1, i % 17, i % 3)) == i);
+        }
+        CHECK(all_found);
+        CHECK(map.find(IndexTuple(n + 1, 0, 0)) == -1);
+    }
+
+    SECTION("Clear")
+    {
+        IndexTupleMap map;
+        map.tryEmplace(IndexTuple(1, 1, 1), 5);
+        map.clear();
+        CHECK(map.empty());
+        CHECK(map.find(IndexTuple(1, 1, 1)) == -1);
+        CHECK(map.tryEmplace(IndexTuple(1, 1, 1), 7) == std::make_pair(7, true));
+    }
+}
@@ -0,0 +1,109 @@
+#include <gbGraphics/detail/InstanceBatchList.hpp>
+
+#include <catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace
+{
+struct DrawRange {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int32_t vertexOffset;
+};
+
+struct TestMesh {
+    std::vector<DrawRange> drawRanges;
+
+    std::vector<DrawRange> const& getDrawRanges() const { return drawRanges; }
+};
+}
+
+TEST_CASE("Instance Batch List")
+{
+    using GHULBUS_GRAPHICS_NAMESPACE::detail::InstanceBatchList;
+    using BatchList = InstanceBatchList<TestMesh>;
+
+    TestMesh mesh_a{ { DrawRange{ 0, 6, 0 } } };
+    TestMesh mesh_b{ { DrawRange{ 0, 3, 0 }, DrawRange{ 3, 9, 100 } } };
+    auto const instance = [](uint16_t value) {
+        return std::vector<std::byte>{ std::byte(value & 0xff), std::byte(value >> 8) };
+    };
+
+    BatchList batches(2);
+    CHECK(batches.getInstanceStride() == 2);
+    batches.addInstance(0, mesh_a, instance(1).data());
+    batches.addInstance(0, mesh_b, instance(2).data());
+    batches.addInstance(1, mesh_a, instance(3).data());
+    batches.addInstance(0, mesh_a, instance(4).data());
+    batches.addInstance(0, mesh_b, instance(5).data());
+    batches.addInstance(0, mesh_a, instance(6).data());
+
+    SECTION("Instances are grouped by pipeline and mesh")
+    {
+        CHECK(batches.getNumberOfInstances() == 6);
+        auto const b = batches.getBatches();
+        REQUIRE(b.size() == 3);
+        CHECK(b[0].pipelineIndex == 0);
+        CHECK(b[0].mesh == &mesh_a);
+        CHECK(b[0].instanceCount == 3);
+        CHECK(b[1].pipelineIndex == 0);
+        CHECK(b[1].mesh == &mesh_b);
+        CHECK(b[1].instanceCount == 2);
+        CHECK(b[2].pipelineIndex == 1);
+        CHECK(b[2].mesh == &mesh_a);
+        CHECK(b[2].instanceCount == 1);
+        CHECK(batches.getNumberOfDrawCalls() == 4);
+    }
+
+    SECTION("Instance data of each batch is contiguous")
+    {
+        std::vector<std::byte> data(batches.getNumberOfInstances() * batches.getInstanceStride());
+        batches.writeInstanceData(data.data());
+        auto const b = batches.getBatches();
+        CHECK(b[0].firstInstance == 0);
+        CHECK(b[1].firstInstance == 3);
+        CHECK(b[2].firstInstance == 5);
+        std::vector<std::byte> expected;
+        for (uint16_t v : { 1, 4, 6, 2, 5, 3 }) {
+            auto const i = instance(v);
+            expected.insert(expected.end(), i.begin(), i.end());
+        }
+        CHECK(data == expected);
+    }
+
+    SECTION("Draws of a pipeline in batch and draw range order")
+    {
+        std::vector<std::byte> data(batches.getNumberOfInstances() * batches.getInstanceStride());
+        batches.writeInstanceData(data.data());
+        std::vector<std::pair<TestMesh const*, uint32_t>> draws;
+        std::vector<uint32_t> first_instances;
+        batches.forEachDraw(0, [&](BatchList::Batch const& batch, DrawRange const& range) {
+                draws.emplace_back(batch.mesh, range.firstIndex);
+                first_instances.push_back(batch.firstInstance);
+            });
+        CHECK(draws == std::vector<std::pair<TestMesh const*, uint32_t>>{ { &mesh_a, 0 }, { &mesh_b, 0 },
+                                                                          { &mesh_b, 3 } });
+        CHECK(first_instances == std::vector<uint32_t>{ 0, 3, 3 });
+        int pipeline1_draws = 0;
+        batches.forEachDraw(1, [&](BatchList::Batch const& batch, DrawRange const&) {
+                CHECK(batch.firstInstance == 5);
+                ++pipeline1_draws;
+            });
+        CHECK(pipeline1_draws == 1);
+        batches.forEachDraw(2, [](BatchList::Batch const&, DrawRange const&) { FAIL(); });
+    }
+
+    SECTION("Clear")
+    {
+        batches.clear();
+        CHECK(batches.getNumberOfInstances() == 0);
+        CHECK(batches.getBatches().empty());
+        batches.addInstance(1, mesh_b, instance(7).data());
+        REQUIRE(batches.getBatches().size() == 1);
+        CHECK(batches.getBatches()[0].instanceCount == 1);
+    }
+}
@@ -0,0 +1,116 @@
+#include <gbGraphics/MeshCache.hpp>
+
+#include <gbGraphics/Exceptions.hpp>
+#include <gbGraphics/ObjParser.hpp>
+
+#include <gbBase/Finally.hpp>
+
+#include <catch.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+TEST_CASE("Mesh Cache")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+
+    auto const write_file = [](std::string const& filename, std::string_view contents) {
+        std::ofstream fout(filename, std::ios_base::binary | std::ios_base::trunc);
+        fout.write(contents.data(), contents.size());
+    };
+    std::filesystem::path const tmp_dir = std::filesystem::temp_directory_path();
+    std::string const obj_filename = (tmp_dir / "gbGraphics_TestMeshCache.obj").string();
+    std::string const cache_filename = (tmp_dir / "gbGraphics_TestMeshCache.gbmesh").string();
+    auto const guard_files = Ghulbus::finally([&]() {
+            std::filesystem::remove(obj_filename);
+            std::filesystem::remove(cache_filename);
+        });
+
+    write_file(obj_filename, "v 0.0 0.0 0.0\n"
+                             "v 1.0 0.0 0.0\n"
+                             "v 1.0 1.0 0.0\n"
+                             "v 0.0 1.0 0.0\n"
+                             "vt 0.0 0.0\n"
+                             "vt 1.0 1.0\n"
+                             "vn 0.0 0.0 1.0\n"
+                             "g quad\n"
+                             "f 1/1/1 2/1/1 3/2/1 4/2/1\n"
+                             "g triangles\n"
+                             "f 1 2 3\n"
+                             "f 1 3 4\n");
+    ObjParser obj;
+    obj.readFile(obj_filename.c_str());
+    MeshCache::write(cache_filename.c_str(), obj, obj_filename.c_str());
+
+    SECTION("Round trip")
+    {
+        MeshCache const cache(cache_filename.c_str());
+        REQUIRE(cache.getNumberOfVertices() == static_cast<std::uint64_t>(obj.numberOfFlatVertices()));
+        REQUIRE(cache.getNumberOfIndices() == obj.getFlatIndices().size());
+        CHECK(cache.getVertexStride() == sizeof(ObjParser::VertexEntryFlat));
+        CHECK(std::memcmp(cache.getVertexData().data(), obj.getFlatVertices().data(),
+                          cache.getVertexData().size()) == 0);
+        CHECK(std::memcmp(cache.getIndexData().data(), obj.getFlatIndices().data(),
+                          cache.getIndexData().size_bytes()) == 0);
+        CHECK(cache.hasVertexFormat<ObjParser::VertexDataFlat::Format>());
+        CHECK(!cache.hasVertexFormat<VertexFormat<VertexComponent<GhulbusMath::Point3f,
+                                                                  VertexComponentSemantics::Position>>>());
+        REQUIRE(cache.getNumberOfComponents() == 3);
+        CHECK(cache.getComponentInfo(1).semantics == VertexFormatBase::ComponentSemantics::Normal);
+        CHECK(cache.getComponentInfo(1).type == VertexFormatBase::ComponentType::t_vec3);
+        REQUIRE(cache.getNumberOfGroups() == 2);
+        CHECK(cache.getGroup(0).name == "quad");
+        CHECK(cache.getGroup(0).numberOfFaces == 1);
+        CHECK(cache.getGroup(0).verticesPerFace == 4);
+        CHECK(cache.getGroup(0).firstIndex == 0);
+        CHECK(cache.getGroup(0).indexCount == 6);
+        CHECK(cache.getGroup(0).firstVertex == 0);
+        CHECK(cache.getGroup(0).vertexCount == 4);
+        CHECK(cache.getGroup(0).hasNormal);
+        CHECK(cache.getGroup(0).hasTexCoord);
+        CHECK(cache.getGroup(1).name == "triangles");
+        CHECK(cache.getGroup(1).numberOfFaces == 2);
+        CHECK(cache.getGroup(1).verticesPerFace == 3);
+        CHECK(cache.getGroup(1).firstIndex == 6);
+        CHECK(cache.getGroup(1).indexCount == 6);
+        CHECK(cache.getGroup(1).firstVertex == 4);
+        CHECK(cache.getGroup(1).vertexCount == 4);
+        CHECK(!cache.getGroup(1).hasNormal);
+        CHECK(!cache.getGroup(1).hasTexCoord);
+    }
+
+    SECTION("Invalidation")
+    {
+        MeshCache const cache(cache_filename.c_str());
+        CHECK(cache.isUpToDate(obj_filename.c_str()));
+        CHECK(cache.isUpToDate(obj_filename.c_str(), MeshCache::Validation::ContentHash));
+        CHECK(!cache.isUpToDate((obj_filename + ".missing").c_str()));
+
+        // same size and timestamp, different content
+        auto const time = std::filesystem::last_write_time(obj_filename);
+        std::string contents;
+        {
+            std::ifstream fin(obj_filename, std::ios_base::binary);
+            contents.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        }
+        contents[contents.find("1.0")] = '2';
+        write_file(obj_filename, contents);
+        std::filesystem::last_write_time(obj_filename, time);
+        CHECK(cache.isUpToDate(obj_filename.c_str()));
+        CHECK(!cache.isUpToDate(obj_filename.c_str(), MeshCache::Validation::ContentHash));
+
+        write_file(obj_filename, contents + "\n");
+        CHECK(!cache.isUpToDate(obj_filename.c_str()));
+    }
+
+    SECTION("Invalid files are rejected")
+    {
+        write_file(cache_filename, "v 0.0 0.0 0.0\nv 1.0 0.0 0.0\nv 0.0 1.0 0.0\nf 1 2 3\n"
+                                   "padding padding padding padding padding padding padding padding\n");
+        CHECK_THROWS_AS(MeshCache(cache_filename.c_str()), Exceptions::IOError);
+    }
+}
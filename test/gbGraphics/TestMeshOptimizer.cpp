@@ -0,0 +1,89 @@
+#include <gbGraphics/MeshOptimizer.hpp>
+
+#include <gbGraphics/MeshPrimitives.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace {
+using namespace GHULBUS_GRAPHICS_NAMESPACE;
+
+using VertexData3d = VertexData<VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>>;
+
+/** The triangles of a mesh as vertex positions, rotated so that each triangle starts with its smallest vertex.
+ * Independent of triangle and vertex order.
+ */
+template<typename IndexData_T>
+std::vector<std::array<std::tuple<float, float, float>, 3>> getTriangles(VertexData3d const& vertex_data,
+                                                                         IndexData_T const& index_data)
+{
+    std::vector<std::array<std::tuple<float, float, float>, 3>> ret;
+    for (auto const& t : index_data.getStorage()) {
+        std::array<std::tuple<float, float, float>, 3> triangle;
+        std::size_t const triangle_indices[] = { t.i1, t.i2, t.i3 };
+        for (std::size_t j = 0; j < 3; ++j) {
+            auto const& p = get<VertexFormatBase::ComponentSemantics::Position>(vertex_data, triangle_indices[j]);
+            triangle[j] = std::make_tuple(p.x, p.y, p.z);
+        }
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        ret.push_back(triangle);
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+}
+
+TEST_CASE("Mesh Optimizer")
+{
+    SECTION("Vertex cache analysis")
+    {
+        std::vector<std::uint32_t> const indices = { 0, 1, 2,   2, 1, 3,   4, 5, 6 };
+        MeshOptimizer::VertexCacheStatistics const stats =
+            MeshOptimizer::analyzeVertexCache<std::uint32_t>(indices, 7);
+        CHECK(stats.triangles == 3);
+        CHECK(stats.vertices == 7);
+        CHECK(stats.verticesTransformed == 7);
+        CHECK(stats.acmr == Approx(7.0f / 3.0f));
+        CHECK(stats.atvr == Approx(1.0f));
+
+        MeshOptimizer::VertexCacheStatistics const stats_small_cache =
+            MeshOptimizer::analyzeVertexCache<std::uint32_t>(indices, 7, 1);
+        CHECK(stats_small_cache.verticesTransformed == 8);
+    }
+
+    SECTION("Vertex fetch remapping")
+    {
+        std::vector<std::uint16_t> indices = { 4, 2, 0,   0, 2, 3 };
+        std::vector<std::uint32_t> const remap = MeshOptimizer::optimizeVertexFetch<std::uint16_t>(indices, 5);
+        CHECK(indices == std::vector<std::uint16_t>{ 0, 1, 2,   2, 1, 3 });
+        CHECK(remap == std::vector<std::uint32_t>{ 2, MeshOptimizer::unreferencedVertex, 1, 3, 0 });
+    }
+
+    SECTION("Optimizing a mesh keeps its triangles and reduces cache misses")
+    {
+        Primitives::Sphere<VertexData3d, std::uint32_t> sphere(1.0f, 64, 48);
+        VertexData3d vertex_data = sphere.m_vertexData;
+        auto index_data = sphere.m_indexData;
+        // emission order is already fairly cache-friendly for primitives; shuffle the triangles
+        std::vector<std::size_t> order(index_data.size());
+        for (std::size_t i = 0; i < order.size(); ++i) { order[i] = (i * 7919) % order.size(); }
+        REQUIRE(order.size() % 7919 != 0);
+        auto shuffled = index_data;
+        for (std::size_t i = 0; i < order.size(); ++i) { shuffled.getStorage()[i] = index_data.getStorage()[order[i]]; }
+        index_data = shuffled;
+        auto const triangles_before = getTriangles(vertex_data, index_data);
+
+        MeshOptimizer::OptimizationReport const report = MeshOptimizer::optimizeMesh(vertex_data, index_data);
+        CHECK(report.before.triangles == report.after.triangles);
+        CHECK(report.after.acmr < report.before.acmr);
+        CHECK(report.after.acmr < 0.9f);
+        CHECK(report.after.atvr < report.before.atvr);
+        CHECK(report.after.vertices == vertex_data.size());
+        CHECK(getTriangles(vertex_data, index_data) == triangles_before);
+    }
+}
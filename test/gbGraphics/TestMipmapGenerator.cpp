@@ -0,0 +1,94 @@
+#include <gbGraphics/MipmapGenerator.hpp>
+
+#include <gbGraphics/detail/MipChain.hpp>
+
+#include <catch.hpp>
+
+TEST_CASE("Mipmap Generator")
+{
+    using GHULBUS_GRAPHICS_NAMESPACE::MipmapGenerator;
+
+    SECTION("Full mip chain length")
+    {
+        CHECK(MipmapGenerator::getFullMipChainLength(1, 1) == 1);
+        CHECK(MipmapGenerator::getFullMipChainLength(2, 2) == 2);
+        CHECK(MipmapGenerator::getFullMipChainLength(3, 3) == 2);
+        CHECK(MipmapGenerator::getFullMipChainLength(4, 4) == 3);
+        CHECK(MipmapGenerator::getFullMipChainLength(1024, 1024) == 11);
+        // the larger dimension determines the length
+        CHECK(MipmapGenerator::getFullMipChainLength(1024, 1) == 11);
+        CHECK(MipmapGenerator::getFullMipChainLength(1, 1023) == 10);
+        CHECK(MipmapGenerator::getFullMipChainLength(640, 480) == 10);
+    }
+}
+
+TEST_CASE("Mip Chain")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE::detail;
+
+    SECTION("Mip level extent")
+    {
+        auto check_extent = [](VkExtent2D const& extent, uint32_t width, uint32_t height) {
+            CHECK(extent.width == width);
+            CHECK(extent.height == height);
+        };
+        check_extent(getMipLevelExtent(640, 480, 0), 640, 480);
+        check_extent(getMipLevelExtent(640, 480, 1), 320, 240);
+        check_extent(getMipLevelExtent(640, 480, 4), 40, 30);
+        // odd sizes round down
+        check_extent(getMipLevelExtent(5, 3, 1), 2, 1);
+        // the smaller dimension stays at 1 texel
+        check_extent(getMipLevelExtent(1024, 4, 5), 32, 1);
+        check_extent(getMipLevelExtent(1, 1023, 9), 1, 1);
+        check_extent(getMipLevelExtent(1024, 1024, 10), 1, 1);
+        check_extent(getMipLevelExtent(1024, 1024, 40), 1, 1);
+    }
+
+    SECTION("Last level of a full chain is 1x1")
+    {
+        for (uint32_t const size : { 1u, 2u, 3u, 17u, 640u, 1023u, 1024u }) {
+            uint32_t const last_level = getFullMipChainLength(size, size / 2 + 1) - 1;
+            VkExtent2D const last = getMipLevelExtent(size, size / 2 + 1, last_level);
+            CHECK(last.width == 1);
+            CHECK(last.height == 1);
+            if (last_level > 0) {
+                VkExtent2D const previous = getMipLevelExtent(size, size / 2 + 1, last_level - 1);
+                CHECK(previous.width + previous.height > 2);
+            }
+        }
+    }
+
+    SECTION("Formats with linear blits use the blit path")
+    {
+        VkFormatFeatureFlags const blit_features = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                                   VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT |
+                                                   VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+        CHECK(selectMipmapMethod(blit_features, false) == MipmapMethod::Blit);
+        CHECK(selectMipmapMethod(blit_features, true) == MipmapMethod::Blit);
+        // blits are preferred, even if the compute path is available
+        CHECK(selectMipmapMethod(blit_features | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT, true) == MipmapMethod::Blit);
+    }
+
+    SECTION("Formats without linear filtering fall back to the compute path")
+    {
+        VkFormatFeatureFlags const compute_features = VK_FORMAT_FEATURE_BLIT_SRC_BIT |
+                                                      VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                                      VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                                      VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
+        CHECK(selectMipmapMethod(compute_features, true) == MipmapMethod::Compute);
+        CHECK(selectMipmapMethod(VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT, true) ==
+              MipmapMethod::Compute);
+    }
+
+    SECTION("Formats without either path are rejected")
+    {
+        // the compute path requires storage image writes without a format in the shader
+        VkFormatFeatureFlags const storage_features =
+            VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
+        CHECK_FALSE(selectMipmapMethod(storage_features, false));
+        CHECK_FALSE(selectMipmapMethod(VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT, true));
+        CHECK_FALSE(selectMipmapMethod(VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                       VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT, true));
+        CHECK_FALSE(selectMipmapMethod(0, true));
+    }
+}
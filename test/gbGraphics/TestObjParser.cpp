@@ -0,0 +1,549 @@
+#include <gbGraphics/ObjParser.hpp>
+
+#include <gbGraphics/Exceptions.hpp>
+
+#include <gbBase/Finally.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Obj Parser")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+    using GhulbusMath::Point3f;
+    using GhulbusMath::Normal3f;
+    using GhulbusMath::Vector2f;
+
+    auto const parse = [](ObjParser& parser, std::string_view obj) {
+        parser.readData(std::span<char const>(obj.data(), obj.size()));
+    };
+    using FlatFormat = ObjParser::VertexDataFlat::Format;
+    std::size_t constexpr position = *FlatFormat::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Position);
+    std::size_t constexpr normal = *FlatFormat::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Normal);
+    std::size_t constexpr texture = *FlatFormat::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Texture);
+
+    ObjParser parser;
+
+    SECTION("Triangle")
+    {
+        parse(parser, "v 0.0 0.0 0.0\n"
+                      "v 1.0 0.0 0.0\n"
+                      "v 0.0 1.0 0.0\n"
+                      "f 1 2 3\n");
+        CHECK(parser.numberOfVertices() == 3);
+        CHECK(parser.numberOfNormals() == 0);
+        CHECK(parser.numberOfTextureVertices() == 0);
+        REQUIRE(parser.numberOfGroups() == 1);
+        CHECK(std::string_view(parser.getGroupName(0)) == "default");
+        CHECK(parser.groupVerticesPerFace(0) == 3);
+        CHECK(!parser.groupHasNormal(0));
+        CHECK(!parser.groupHasTexCoord(0));
+        CHECK(parser.numberOfFlatFaces() == 1);
+        REQUIRE(parser.numberOfFlatVertices() == 3);
+        CHECK(parser.getFlatIndices() == ObjParser::IndexDataFlat{ 0, 1, 2 });
+        CHECK(get<position>(parser.getFlatVertices().getStorage()[1]) == Point3f(1.0f, 0.0f, 0.0f));
+        CHECK(get<normal>(parser.getFlatVertices().getStorage()[1]) == Normal3f(1.0f, 0.0f, 0.0f));
+        CHECK(get<texture>(parser.getFlatVertices().getStorage()[1]) == Vector2f(0.0f, 0.0f));
+    }
+
+    SECTION("Quad with texture coordinates and normals")
+    {
+        parse(parser, "v 0.0 0.0 0.0\n"
+                      "v 1.0 0.0 0.0\n"
+                      "v 1.0 1.0 0.0\n"
+                      "v 0.0 1.0 0.0\n"
+                      "vt 0.0 0.0\n"
+                      "vt 1.0 1.0\n"
+                      "vn 0.0 0.0 1.0\n"
+                      "f 1/1/1 2/1/1 3/2/1 4/2/1\n");
+        REQUIRE(parser.numberOfGroups() == 1);
+        CHECK(parser.groupVerticesPerFace(0) == 4);
+        CHECK(parser.groupHasNormal(0));
+        CHECK(parser.groupHasTexCoord(0));
+        CHECK(parser.numberOfFacesTotal() == 1);
+        CHECK(parser.numberOfFlatFaces() == 2);
+        REQUIRE(parser.numberOfFlatVertices() == 4);
+        CHECK(parser.getFlatIndices() == ObjParser::IndexDataFlat{ 0, 1, 2, 3, 0, 2 });
+        CHECK(get<normal>(parser.getFlatVertices().getStorage()[3]) == Normal3f(0.0f, 0.0f, 1.0f));
+        CHECK(get<texture>(parser.getFlatVertices().getStorage()[3]) == Vector2f(1.0f, 1.0f));
+    }
+
+    SECTION("Shared vertices are deduplicated")
+    {
+        parse(parser, "v 0.0 0.0 0.0\n"
+                      "v 1.0 0.0 0.0\n"
+                      "v 1.0 1.0 0.0\n"
+                      "v 0.0 1.0 0.0\n"
+                      "vn 0.0 0.0 1.0\n"
+                      "f 1//1 2//1 3//1\n"
+                      "f 1//1 3//1 4//1\n");
+        CHECK(parser.groupHasNormal(0));
+        CHECK(!parser.groupHasTexCoord(0));
+        CHECK(parser.numberOfFlatVertices() == 4);
+        CHECK(parser.getFlatIndices() == ObjParser::IndexDataFlat{ 0, 1, 2, 0, 2, 3 });
+    }
+
+    SECTION("Negative indices are relative to the current end of the vertex list")
+    {
+        parse(parser, "v 0.0 0.0 0.0\n"
+                      "v 1.0 0.0 0.0\n"
+                      "v 0.0 1.0 0.0\n"
+                      "vt 0.5 0.5\n"
+                      "f -3/-1 -2/-1 -1/-1\n");
+        CHECK(!parser.groupHasNormal(0));
+        CHECK(parser.groupHasTexCoord(0));
+        REQUIRE(parser.numberOfFlatVertices() == 3);
+        CHECK(get<position>(parser.getFlatVertices().getStorage()[0]) == Point3f(0.0f, 0.0f, 0.0f));
+        CHECK(get<position>(parser.getFlatVertices().getStorage()[2]) == Point3f(0.0f, 1.0f, 0.0f));
+        CHECK(get<texture>(parser.getFlatVertices().getStorage()[2]) == Vector2f(0.5f, 0.5f));
+    }
+
+    SECTION("Face indices out of range are rejected")
+    {
+        CHECK_THROWS_AS(parse(parser, "v 0.0 0.0 0.0\n"
+                                      "v 1.0 0.0 0.0\n"
+                                      "v 0.0 1.0 0.0\n"
+                                      "f 1 2 9\n"), Exceptions::IOError);
+        CHECK_THROWS_AS(parse(parser, "v 0.0 0.0 0.0\n"
+                                      "v 1.0 0.0 0.0\n"
+                                      "v 0.0 1.0 0.0\n"
+                                      "f 0 1 2\n"), Exceptions::IOError);
+        CHECK_THROWS_AS(parse(parser, "v 0.0 0.0 0.0\n"
+                                      "v 1.0 0.0 0.0\n"
+                                      "v 0.0 1.0 0.0\n"
+                                      "f -4 -2 -1\n"), Exceptions::IOError);
+        CHECK_THROWS_AS(parse(parser, "v 0.0 0.0 0.0\n"
+                                      "v 1.0 0.0 0.0\n"
+                                      "v 0.0 1.0 0.0\n"
+                                      "vn 0.0 0.0 1.0\n"
+                                      "f 1//1 2//1 3//2\n"), Exceptions::IOError);
+    }
+
+    SECTION("Missing newline at end of data and CRLF line endings")
+    {
+        parse(parser, "v 0.0 0.0 0.0\r\n"
+                      "v 1.0 0.0 0.0\r\n"
+                      "v 0.0 1.0 0.0\r\n"
+                      "f 1 2 3");
+        CHECK(parser.numberOfVertices() == 3);
+        CHECK(parser.numberOfFlatFaces() == 1);
+        CHECK(parser.getFlatIndices() == ObjParser::IndexDataFlat{ 0, 1, 2 });
+    }
+
+    SECTION("Comments at the end of a line")
+    {
+        parse(parser, "v 0.0 0.0 0.0 # origin\n"
+                      "v 1.0 0.0 0.0\n"
+                      "v 0.0 1.0 0.0\n"
+                      "v 1.0 1.0 0.0\n"
+                      "f 1 2 3 # tri\n"
+                      "f 2 4 3#tri\n");
+        CHECK(parser.groupVerticesPerFace(0) == 3);
+        CHECK(parser.numberOfFlatFaces() == 2);
+        CHECK(parser.getFlatIndices() == ObjParser::IndexDataFlat{ 0, 1, 2, 1, 3, 2 });
+    }
+
+    SECTION("Number formats")
+    {
+        parse(parser, "v  +1.5\t-2.25e1   3E-2 \n"
+                      "v .5 -0 1e-50\n"
+                      "v 1 2 3 1.0\n"
+                      "vt 0.25 +.75 0.0\n"
+                      "f\t1/1  +2/1 \t3/+1 \r\n");
+        REQUIRE(parser.numberOfVertices() == 3);
+        REQUIRE(parser.numberOfTextureVertices() == 1);
+        REQUIRE(parser.numberOfFlatVertices() == 3);
+        CHECK(get<position>(parser.getFlatVertices().getStorage()[0]) == Point3f(1.5f, -22.5f, 0.03f));
+        CHECK(get<position>(parser.getFlatVertices().getStorage()[1]) == Point3f(0.5f, 0.0f, 0.0f));
+        CHECK(get<position>(parser.getFlatVertices().getStorage()[2]) == Point3f(1.0f, 2.0f, 3.0f));
+        CHECK(get<texture>(parser.getFlatVertices().getStorage()[2]) == Vector2f(0.25f, 0.75f));
+    }
+
+    SECTION("Face groups")
+    {
+        parse(parser, "# comment\n"
+                      "v 0.0 0.0 0.0\n"
+                      "v 1.0 0.0 0.0\n"
+                      "v 0.0 1.0 0.0\n"
+                      "v 1.0 1.0 0.0\n"
+                      "g empty\n"
+                      "g first\n"
+                      "f 1 2 3\n"
+                      "g second\n"
+                      "f 2 4 3\n"
+                      "f 1 2 4\n");
+        REQUIRE(parser.numberOfGroups() == 2);
+        CHECK(std::string_view(parser.getGroupName(0)) == "first");
+        CHECK(std::string_view(parser.getGroupName(1)) == "second");
+        CHECK(parser.numberOfFacesInGroup(0) == 1);
+        CHECK(parser.numberOfFacesInGroup(1) == 2);
+        CHECK(parser.numberOfFacesTotal() == 3);
+        CHECK(parser.numberOfFlatFaces() == 3);
+    }
+
+    SECTION("Flat indices are sorted into submesh ranges by face group")
+    {
+        parse(parser, "v 0.0 0.0 0.0\n"
+                      "v 1.0 0.0 0.0\n"
+                      "v 0.0 1.0 0.0\n"
+                      "v 1.0 1.0 0.0\n"
+                      "v 2.0 1.0 0.0\n"
+                      "g first\n"
+                      "f 1 2 3\n"
+                      "g second\n"
+                      "f 2 4 3\n"
+                      "g first\n"
+                      "f 2 4 5\n"
+                      "g unused\n"
+                      "g second\n"
+                      "f 4 5 3\n");
+        REQUIRE(parser.numberOfGroups() == 2);
+        CHECK(parser.getFlatIndices() == ObjParser::IndexDataFlat{ 0, 1, 2, 1, 3, 4,   1, 3, 2, 3, 4, 2 });
+        ObjParser::SubmeshRange const& first = parser.getGroupRange(0);
+        CHECK(first.firstIndex == 0);
+        CHECK(first.indexCount == 6);
+        CHECK(first.firstVertex == 0);
+        CHECK(first.vertexCount == 5);
+        ObjParser::SubmeshRange const& second = parser.getGroupRange(1);
+        CHECK(second.firstIndex == 6);
+        CHECK(second.indexCount == 6);
+        CHECK(second.firstVertex == 1);
+        CHECK(second.vertexCount == 4);
+        CHECK(parser.findGroup("first") == 0);
+        CHECK(parser.findGroup("second") == 1);
+        CHECK(!parser.findGroup("unused"));
+        CHECK(!parser.findGroup("default"));
+    }
+
+    SECTION("Flat data can be written to external storage")
+    {
+        std::string_view const obj = "v 0.0 0.0 0.0\n"
+                                     "v 1.0 0.0 0.0\n"
+                                     "v 1.0 1.0 0.0\n"
+                                     "v 0.0 1.0 0.0\n"
+                                     "f 1 2 3 4\n"
+                                     "g triangles\n"
+                                     "f 1 2 3\n";
+        std::vector<ObjParser::VertexEntryFlat> vertices;
+        std::vector<ObjParser::IndexType> indices;
+        int calls = 0;
+        parser.readData(std::span<char const>(obj.data(), obj.size()),
+            [&](std::size_t number_of_vertices, std::size_t number_of_indices) {
+                ++calls;
+                vertices.resize(number_of_vertices);
+                indices.resize(number_of_indices);
+                return ObjParser::FlatStorage{ vertices, indices };
+            });
+        CHECK(calls == 1);
+        CHECK(parser.numberOfFacesTotal() == 2);
+        CHECK(parser.getFlatVertices().empty());
+        CHECK(parser.getFlatIndices().empty());
+        CHECK(indices == std::vector<ObjParser::IndexType>{ 0, 1, 2, 3, 0, 2, 0, 1, 2 });
+        REQUIRE(vertices.size() == 4);
+        CHECK(get<position>(vertices[3]) == Point3f(0.0f, 1.0f, 0.0f));
+    }
+
+    SECTION("Reading new data replaces previous mesh")
+    {
+        parse(parser, "v 0.0 0.0 0.0\nv 1.0 0.0 0.0\nv 0.0 1.0 0.0\nf 1 2 3\n");
+        parse(parser, "v 0.0 0.0 0.0\nv 1.0 0.0 0.0\nv 0.0 1.0 0.0\nv 1.0 1.0 0.0\nf 1 2 3 4\n");
+        CHECK(parser.numberOfVertices() == 4);
+        CHECK(parser.numberOfGroups() == 1);
+        CHECK(parser.numberOfFlatFaces() == 2);
+    }
+}
+
+TEST_CASE("Obj Parser 16-bit Indices")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+
+    auto const make_grid = [](int grid_size) {
+        std::string obj;
+        for (int y = 0; y <= grid_size; ++y) {
+            for (int x = 0; x <= grid_size; ++x) {
+                obj += "v " + std::to_string(x) + " " + std::to_string(y) + " 0\n";
+            }
+        }
+        for (int y = 0; y < grid_size; ++y) {
+            if (y == grid_size / 2) { obj += "g second_half\n"; }
+            for (int x = 0; x < grid_size; ++x) {
+                int const i = y * (grid_size + 1) + x + 1;
+                obj += "f " + std::to_string(i) + " " + std::to_string(i + 1) + " " +
+                       std::to_string(i + grid_size + 2) + " " + std::to_string(i + grid_size + 1) + "\n";
+            }
+        }
+        return obj;
+    };
+    auto const check_flat_data16 = [](ObjParser const& parser, ObjParser::FlatData16 const& flat16) {
+        auto const& flat_vertices = parser.getFlatVertices().getStorage();
+        auto const& flat_indices = parser.getFlatIndices();
+        auto const& triangles = flat16.indices.getStorage();
+        REQUIRE(triangles.size() * 3 == flat_indices.size());
+        ObjParser::IndexType next_index = 0;
+        for (auto const& chunk : flat16.chunks) {
+            CHECK(chunk.firstIndex == next_index);
+            next_index += chunk.indexCount;
+            auto const& vertices = flat16.vertices.getStorage();
+            int mismatches = 0;
+            for (ObjParser::IndexType i = chunk.firstIndex; i < chunk.firstIndex + chunk.indexCount; i += 3) {
+                auto const& t = triangles[i / 3];
+                ObjParser::IndexType const chunk_indices[] = { t.i1, t.i2, t.i3 };
+                for (int j = 0; j < 3; ++j) {
+                    if (std::memcmp(&vertices[chunk_indices[j] + chunk.vertexOffset], &flat_vertices[flat_indices[i + j]],
+                                    sizeof(ObjParser::VertexEntryFlat)) != 0)
+                    {
+                        ++mismatches;
+                    }
+                }
+            }
+            CHECK(mismatches == 0);
+        }
+        CHECK(static_cast<std::size_t>(next_index) == flat_indices.size());
+    };
+
+    ObjParser parser;
+
+    SECTION("Small meshes are not split")
+    {
+        std::string const obj = make_grid(100);
+        parser.readData(std::span<char const>(obj.data(), obj.size()));
+        ObjParser::FlatData16 const flat16 = parser.getFlatData16();
+        CHECK(flat16.vertices.size() == parser.getFlatVertices().size());
+        REQUIRE(flat16.chunks.size() == 2);
+        CHECK(flat16.chunks[0].group == 0);
+        CHECK(flat16.chunks[1].group == 1);
+        CHECK(flat16.chunks[1].vertexOffset == 0);
+        check_flat_data16(parser, flat16);
+    }
+
+    SECTION("Large meshes are split into chunks")
+    {
+        std::string const obj = make_grid(400);
+        parser.readData(std::span<char const>(obj.data(), obj.size()));
+        REQUIRE(parser.numberOfFlatVertices() > 65536);
+        ObjParser::FlatData16 const flat16 = parser.getFlatData16();
+        CHECK(flat16.chunks.size() >= 4);
+        CHECK(flat16.vertices.size() > parser.getFlatVertices().size());
+        for (std::size_t i = 1; i < flat16.chunks.size(); ++i) {
+            CHECK(flat16.chunks[i].group >= flat16.chunks[i - 1].group);
+            CHECK(flat16.chunks[i].vertexOffset - flat16.chunks[i - 1].vertexOffset <= 65536);
+        }
+        CHECK(flat16.vertices.size() - flat16.chunks.back().vertexOffset <= 65536);
+        check_flat_data16(parser, flat16);
+    }
+}
+
+TEST_CASE("Obj Parser Multi-threaded")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+
+    // large enough to be split into multiple chunks
+    std::string obj;
+    int const n_blocks = 25000;
+    for (int i = 0; i < n_blocks; ++i) {
+        if (i % 1500 == 0) { obj += "g group" + std::to_string((i / 1500) % 3) + "\n"; }
+        int const f = i % 7;
+        obj += "v " + std::to_string(i) + ".5 " + std::to_string(f) + " -1.25\n";
+        obj += "v " + std::to_string(f) + " " + std::to_string(i) + ".25 0.5\n";
+        obj += "v 1.0 1.0 " + std::to_string(i) + "\n";
+        obj += "v 0.0 " + std::to_string(f) + ".75 " + std::to_string(i) + "\n";
+        obj += "vt 0." + std::to_string(f) + " 0.25\n";
+        obj += "vn 0.0 0.0 1.0\n";
+        obj += "# comment line\n";
+        obj += "f -4/-1/-1 -3/-1/-1 -2/-1/-1 -1/-1/-1\n";
+        if (i > 0) {
+            // shares vertices with the previous block
+            std::string const prev = std::to_string(4 * i - 1);
+            obj += "f " + prev + "/" + std::to_string(i) + "/1 -3/-1/-1 -2/-1/-1 -1/-1/-1\n";
+        }
+    }
+    REQUIRE(obj.size() > 4 * (1 << 20));
+
+    ObjParser parser_single;
+    parser_single.setMaxThreads(1);
+    parser_single.readData(std::span<char const>(obj.data(), obj.size()));
+
+    ObjParser parser_multi;
+    parser_multi.setMaxThreads(4);
+    parser_multi.readData(std::span<char const>(obj.data(), obj.size()));
+
+    CHECK(parser_single.numberOfVertices() == 4 * n_blocks);
+    CHECK(parser_single.numberOfFacesTotal() == 2 * n_blocks - 1);
+    CHECK(parser_multi.numberOfVertices() == parser_single.numberOfVertices());
+    CHECK(parser_multi.numberOfNormals() == parser_single.numberOfNormals());
+    CHECK(parser_multi.numberOfTextureVertices() == parser_single.numberOfTextureVertices());
+    REQUIRE(parser_multi.numberOfGroups() == 3);
+    REQUIRE(parser_single.numberOfGroups() == 3);
+    for (ObjParser::IndexType i = 0; i < parser_single.numberOfGroups(); ++i) {
+        CHECK(std::string_view(parser_multi.getGroupName(i)) == parser_single.getGroupName(i));
+        CHECK(parser_multi.numberOfFacesInGroup(i) == parser_single.numberOfFacesInGroup(i));
+        CHECK(parser_multi.groupVerticesPerFace(i) == 4);
+        CHECK(parser_multi.groupHasNormal(i));
+        CHECK(parser_multi.groupHasTexCoord(i));
+    }
+    CHECK(parser_multi.getFlatIndices() == parser_single.getFlatIndices());
+    ObjParser::IndexType group_first_index = 0;
+    for (ObjParser::IndexType i = 0; i < parser_multi.numberOfGroups(); ++i) {
+        ObjParser::SubmeshRange const& range = parser_multi.getGroupRange(i);
+        CHECK(range.firstIndex == group_first_index);
+        CHECK(range.indexCount == parser_multi.numberOfFacesInGroup(i) * 6);
+        CHECK(range.firstVertex == parser_single.getGroupRange(i).firstVertex);
+        CHECK(range.vertexCount == parser_single.getGroupRange(i).vertexCount);
+        CHECK(parser_multi.findGroup(parser_multi.getGroupName(i)) == i);
+        group_first_index += range.indexCount;
+    }
+    CHECK(static_cast<std::size_t>(group_first_index) == parser_multi.getFlatIndices().size());
+    auto const& flat_single = parser_single.getFlatVertices().getStorage();
+    auto const& flat_multi = parser_multi.getFlatVertices().getStorage();
+    REQUIRE(flat_multi.size() == flat_single.size());
+    CHECK(std::memcmp(flat_multi.data(), flat_single.data(), flat_single.size() * sizeof(flat_single[0])) == 0);
+}
+
+TEST_CASE("Obj Parser Streaming")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+
+    auto const write_file = [](std::string const& filename, std::string_view contents) {
+        std::ofstream fout(filename, std::ios_base::binary);
+        fout.write(contents.data(), contents.size());
+    };
+    std::string const filename = (std::filesystem::temp_directory_path() / "gbGraphics_TestObjParser.obj").string();
+    auto const guard_file = Ghulbus::finally([&filename]() { std::filesystem::remove(filename); });
+
+    struct Batch {
+        std::vector<ObjParser::VertexEntryFlat> vertices;
+        std::vector<std::uint32_t> indices;
+        std::uint64_t firstVertex;
+        std::uint64_t firstIndex;
+        std::string groupName;
+    };
+    std::vector<Batch> batches;
+    auto const sink = [&batches](ObjParser::FlatBatch const& b) {
+        batches.push_back(Batch{ std::vector<ObjParser::VertexEntryFlat>(b.vertices.begin(), b.vertices.end()),
+                                 std::vector<std::uint32_t>(b.indices.begin(), b.indices.end()),
+                                 b.firstVertex, b.firstIndex, std::string(b.groupName) });
+    };
+
+    SECTION("Batches are split at group switches and batch size")
+    {
+        write_file(filename, "v 0.0 0.0 0.0\n"
+                             "v 1.0 0.0 0.0\n"
+                             "v 1.0 1.0 0.0\n"
+                             "v 0.0 1.0 0.0\n"
+                             "v 2.0 0.0 0.0\n"
+                             "v 2.0 1.0 0.0\n"
+                             "f 1 2 3\n"
+                             "f 1 3 4\n"
+                             "g second\n"
+                             "f 1 2 3 4\n"
+                             "f 4 3 2 1\n"
+                             "f 3 5 6\n"
+                             "f -4 -3 -2");
+        // tiny window forces carrying over and growing the buffer
+        ObjParser::StreamStatistics const stats = ObjParser::readFileStreaming(filename.c_str(), sink, 8, 4);
+        CHECK(stats.vertices == 6);
+        CHECK(stats.normals == 0);
+        CHECK(stats.texCoords == 0);
+        CHECK(stats.faces == 6);
+        CHECK(stats.batches == 3);
+        CHECK(stats.flatVertices == 12);
+        CHECK(stats.flatIndices == 24);
+        REQUIRE(batches.size() == 3);
+        CHECK(batches[0].groupName == "default");
+        CHECK(batches[0].indices == std::vector<std::uint32_t>{ 0, 1, 2, 0, 2, 3 });
+        CHECK(batches[0].vertices.size() == 4);
+        CHECK(batches[1].groupName == "second");
+        CHECK(batches[1].indices == std::vector<std::uint32_t>{ 0, 1, 2, 3, 0, 2, 3, 2, 1, 0, 3, 1 });
+        CHECK(batches[1].firstVertex == 4);
+        CHECK(batches[1].firstIndex == 6);
+        CHECK(batches[2].groupName == "second");
+        CHECK(batches[2].indices == std::vector<std::uint32_t>{ 0, 1, 2, 0, 3, 1 });
+        CHECK(batches[2].firstVertex == 8);
+        CHECK(batches[2].firstIndex == 18);
+        REQUIRE(batches[2].vertices.size() == 4);
+        std::size_t constexpr position =
+            *ObjParser::VertexDataFlat::Format::getIndexForSemantics(VertexFormatBase::ComponentSemantics::Position);
+        CHECK(get<position>(batches[2].vertices[3]) == GhulbusMath::Point3f(0.0f, 1.0f, 0.0f));
+    }
+
+    SECTION("Vertex memory is bounded")
+    {
+        std::string obj;
+        for (int i = 0; i < 3000; ++i) {
+            obj += "v " + std::to_string(i) + ".5 " + std::to_string(i % 7) + " -1.25\n";
+            obj += "v 1.0 " + std::to_string(i) + ".25 0.5\n";
+            obj += "v 0.0 0.75 " + std::to_string(i) + "\n";
+            obj += "vt 0." + std::to_string(i % 7) + " 0.25\n";
+            obj += "vn 0.0 " + std::to_string(i % 5) + " 1.0\n";
+            obj += "f -3/-1/-1 -2/-1/-1 -1/-1/-1\n";
+            if (i > 0) { obj += "f " + std::to_string(3 * i) + "/" + std::to_string(i) + "/1 -3/-1/-1 -1/-1/-1\n"; }
+        }
+        write_file(filename, obj);
+        ObjParser::StreamStatistics const stats_retained =
+            ObjParser::readFileStreaming(filename.c_str(), sink, 4096, 256);
+        std::vector<Batch> const batches_retained = std::move(batches);
+        batches.clear();
+
+        // room for two blocks of entries, so that entries are evicted and read again
+        std::size_t const max_vertex_memory = 2 * 1024 * 3 * sizeof(float) + 1024;
+        ObjParser::StreamStatistics const stats =
+            ObjParser::readFileStreaming(filename.c_str(), sink, 4096, 256, max_vertex_memory);
+        CHECK(stats.vertices == 9000);
+        CHECK(stats.texCoords == 3000);
+        CHECK(stats.normals == 3000);
+        CHECK(stats.faces == stats_retained.faces);
+        CHECK(stats.flatIndices == stats_retained.flatIndices);
+        REQUIRE(batches.size() == batches_retained.size());
+        for (std::size_t i = 0; i < batches.size(); ++i) {
+            CHECK(batches[i].indices == batches_retained[i].indices);
+            REQUIRE(batches[i].vertices.size() == batches_retained[i].vertices.size());
+            CHECK(std::memcmp(batches[i].vertices.data(), batches_retained[i].vertices.data(),
+                              batches[i].vertices.size() * sizeof(ObjParser::VertexEntryFlat)) == 0);
+        }
+
+        CHECK_THROWS_AS(ObjParser::readFileStreaming(filename.c_str(), sink, 4096, 256, 1024),
+                        Exceptions::IOError);
+    }
+
+    SECTION("Streamed faces match the in-memory parser")
+    {
+        std::string obj;
+        for (int i = 0; i < 2000; ++i) {
+            obj += "v " + std::to_string(i) + ".5 " + std::to_string(i % 7) + " -1.25\n";
+            obj += "v 1.0 " + std::to_string(i) + ".25 0.5\n";
+            obj += "v 0.0 0.75 " + std::to_string(i) + "\n";
+            obj += "vt 0." + std::to_string(i % 7) + " 0.25\n";
+            obj += "vn 0.0 0.0 1.0\n";
+            obj += "f -3/-1/-1 -2/-1/-1 -1/-1/-1\n";
+            if (i > 0) { obj += "f " + std::to_string(3 * i) + "/" + std::to_string(i) + "/1 -3/-1/-1 -1/-1/-1\n"; }
+        }
+        write_file(filename, obj);
+        ObjParser::StreamStatistics const stats = ObjParser::readFileStreaming(filename.c_str(), sink, 4096, 256);
+
+        ObjParser parser;
+        parser.readData(std::span<char const>(obj.data(), obj.size()));
+        CHECK(stats.vertices == static_cast<std::uint64_t>(parser.numberOfVertices()));
+        CHECK(stats.faces == static_cast<std::uint64_t>(parser.numberOfFacesTotal()));
+        REQUIRE(stats.flatIndices == parser.getFlatIndices().size());
+        CHECK(stats.batches == batches.size());
+        CHECK(stats.batches > 1);
+        auto const& flat_vertices = parser.getFlatVertices().getStorage();
+        std::size_t i = 0;
+        for (auto const& b : batches) {
+            CHECK(b.vertices.size() <= 256);
+            CHECK(b.firstIndex == i);
+            for (auto const index : b.indices) {
+                auto const& expected = flat_vertices[parser.getFlatIndices()[i]];
+                CHECK(std::memcmp(&b.vertices[index], &expected, sizeof(expected)) == 0);
+                ++i;
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#include <gbGraphics/detail/RangeAllocator.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+TEST_CASE("Range Allocator")
+{
+    using GHULBUS_GRAPHICS_NAMESPACE::detail::RangeAllocator;
+
+    SECTION("Construction")
+    {
+        RangeAllocator allocator(100);
+        CHECK(allocator.getCapacity() == 100);
+        CHECK(allocator.getFreeSize() == 100);
+        CHECK(allocator.getLargestFreeRange() == 100);
+        CHECK(allocator.getNumberOfFreeRanges() == 1);
+        CHECK(allocator.getFragmentation() == 0.f);
+    }
+
+    SECTION("Allocation")
+    {
+        RangeAllocator allocator(100);
+        CHECK(allocator.allocate(10) == 0);
+        CHECK(allocator.allocate(20) == 10);
+        CHECK(allocator.getFreeSize() == 70);
+        CHECK(allocator.allocate(71) == std::nullopt);
+        CHECK(allocator.allocate(70) == 30);
+        CHECK(allocator.getFreeSize() == 0);
+        CHECK(allocator.getNumberOfFreeRanges() == 0);
+        CHECK(allocator.allocate(1) == std::nullopt);
+    }
+
+    SECTION("Freeing merges adjacent ranges")
+    {
+        RangeAllocator allocator(100);
+        std::vector<uint64_t> offsets;
+        for (int i = 0; i < 10; ++i) { offsets.push_back(*allocator.allocate(10)); }
+        allocator.free(offsets[1], 10);
+        allocator.free(offsets[3], 10);
+        CHECK(allocator.getNumberOfFreeRanges() == 2);
+        CHECK(allocator.getLargestFreeRange() == 10);
+        CHECK(allocator.getFragmentation() == 0.5f);
+        // fills the gap between the two free ranges
+        allocator.free(offsets[2], 10);
+        CHECK(allocator.getNumberOfFreeRanges() == 1);
+        CHECK(allocator.getLargestFreeRange() == 30);
+        CHECK(allocator.getFreeSize() == 30);
+        for (int i : { 0, 4, 5, 6, 7, 8, 9 }) { allocator.free(offsets[i], 10); }
+        CHECK(allocator.getNumberOfFreeRanges() == 1);
+        CHECK(allocator.getLargestFreeRange() == 100);
+    }
+
+    SECTION("Allocation picks the best fitting range")
+    {
+        RangeAllocator allocator(100);
+        auto const a = *allocator.allocate(30);
+        auto const b = *allocator.allocate(10);
+        auto const c = *allocator.allocate(15);
+        auto const d = *allocator.allocate(10);
+        allocator.free(a, 30);
+        allocator.free(c, 15);
+        // free ranges: [0, 30), [40, 55), [65, 100)
+        CHECK(allocator.allocate(12) == 40);
+        CHECK(allocator.allocate(32) == 65);
+        CHECK(allocator.allocate(30) == 0);
+        allocator.free(b, 10);
+        allocator.free(d, 10);
+    }
+
+    SECTION("Reset")
+    {
+        RangeAllocator allocator(100);
+        CHECK(allocator.allocate(40) == 0);
+        CHECK(allocator.allocate(60) == 40);
+        CHECK(allocator.getFreeSize() == 0);
+        allocator.reset();
+        CHECK(allocator.getFreeSize() == 100);
+        CHECK(allocator.getNumberOfFreeRanges() == 1);
+        CHECK(allocator.allocate(100) == 0);
+    }
+}
@@ -0,0 +1,77 @@
+#include <gbGraphics/detail/ResidencyTracker.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+TEST_CASE("Residency Tracker")
+{
+    using GHULBUS_GRAPHICS_NAMESPACE::detail::ResidencyTracker;
+    using ResourceId = ResidencyTracker::ResourceId;
+
+    SECTION("Tracking resident size")
+    {
+        ResidencyTracker tracker;
+        CHECK(tracker.getResidentSize() == 0);
+        CHECK(tracker.getCurrentFrame() == 0);
+        auto const a = tracker.add();
+        auto const b = tracker.add();
+        CHECK(a != b);
+        CHECK(!tracker.isResident(a));
+        tracker.setResident(a, 100);
+        tracker.setResident(b, 50);
+        CHECK(tracker.isResident(a));
+        CHECK(tracker.getResidentSize() == 150);
+        tracker.setEvicted(a);
+        CHECK(!tracker.isResident(a));
+        CHECK(tracker.getResidentSize() == 50);
+        tracker.remove(b);
+        CHECK(tracker.getResidentSize() == 0);
+        // ids of removed resources are reused
+        CHECK(tracker.add() == b);
+    }
+
+    SECTION("Nothing is evicted within budget")
+    {
+        ResidencyTracker tracker;
+        tracker.setResident(tracker.add(), 100);
+        for (int i = 0; i < 5; ++i) { tracker.nextFrame(); }
+        CHECK(tracker.selectEvictions(100, 2).empty());
+    }
+
+    SECTION("Least recently used resources are evicted first")
+    {
+        ResidencyTracker tracker;
+        std::vector<ResourceId> ids;
+        for (int i = 0; i < 4; ++i) {
+            ids.push_back(tracker.add());
+            tracker.setResident(ids.back(), 10);
+        }
+        tracker.markUsed(ids[2]);
+        tracker.nextFrame();
+        tracker.markUsed(ids[0]);
+        tracker.nextFrame();
+        tracker.markUsed(ids[3]);
+        for (int i = 0; i < 3; ++i) { tracker.nextFrame(); }
+        CHECK(tracker.getLastUseFrame(ids[3]) == 2);
+        CHECK(tracker.selectEvictions(40, 2).empty());
+        CHECK(tracker.selectEvictions(25, 2) == std::vector<ResourceId>{ ids[1], ids[2] });
+        CHECK(tracker.selectEvictions(0, 2) == std::vector<ResourceId>{ ids[1], ids[2], ids[0], ids[3] });
+    }
+
+    SECTION("Resources used by frames in flight are not evicted")
+    {
+        ResidencyTracker tracker;
+        auto const a = tracker.add();
+        auto const b = tracker.add();
+        tracker.setResident(a, 10);
+        tracker.setResident(b, 10);
+        tracker.nextFrame();
+        tracker.markUsed(b);
+        tracker.nextFrame();
+        // frame 0 has completed, frame 1 may still be executing
+        CHECK(tracker.selectEvictions(0, 2) == std::vector<ResourceId>{ a });
+        tracker.nextFrame();
+        CHECK(tracker.selectEvictions(0, 2) == std::vector<ResourceId>{ a, b });
+    }
+}
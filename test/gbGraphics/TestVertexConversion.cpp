@@ -0,0 +1,119 @@
+#include <gbGraphics/VertexConversion.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+TEST_CASE("Vertex Conversion")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+
+    using FullVertexData = VertexData<
+        VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>,
+        VertexComponent<GhulbusMath::Normal3f, VertexComponentSemantics::Normal>,
+        VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Texture>>;
+    FullVertexData const full_data{
+        { GhulbusMath::Point3f(1.f, 2.f, 3.f), GhulbusMath::Normal3f(0.f, 0.f, 1.f), GhulbusMath::Vector2f(0.5f, 0.25f) },
+        { GhulbusMath::Point3f(-4.f, 0.5f, 8.f), GhulbusMath::Normal3f(0.f, -1.f, 0.f), GhulbusMath::Vector2f(1.f, 0.f) },
+    };
+
+    SECTION("Identical formats are copied")
+    {
+        FullVertexData const converted = VertexConversion::convertVertexData<FullVertexData>(full_data);
+        REQUIRE(converted.size() == 2);
+        CHECK(get<VertexFormatBase::ComponentSemantics::Position>(converted, 1).x == -4.f);
+        CHECK(get<VertexFormatBase::ComponentSemantics::Texture>(converted, 0) == GhulbusMath::Vector2f(0.5f, 0.25f));
+    }
+
+    SECTION("Reordering and dropping components")
+    {
+        using Reordered = VertexData<
+            VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Texture>,
+            VertexComponent<VertexComponentLayout::Padding<4>, VertexComponentSemantics::Padding>,
+            VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>>;
+        Reordered const converted = VertexConversion::convertVertexData<Reordered>(full_data);
+        REQUIRE(converted.size() == 2);
+        CHECK(get<VertexFormatBase::ComponentSemantics::Texture>(converted, 1) == GhulbusMath::Vector2f(1.f, 0.f));
+        CHECK(get<VertexFormatBase::ComponentSemantics::Position>(converted, 1).z == 8.f);
+        CHECK(get<1>(converted.getStorage()[0]).padding[0] == std::byte{ 0 });
+    }
+
+    SECTION("Missing components get default values")
+    {
+        using Colored = VertexData<
+            VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>,
+            VertexComponent<VertexComponentLayout::Normalized<std::uint8_t, 4>, VertexComponentSemantics::Color>,
+            VertexComponent<GhulbusMath::Vector4f, VertexComponentSemantics::Generic<0>>>;
+        Colored const converted = VertexConversion::convertVertexData<Colored>(full_data);
+        auto const& color = get<VertexFormatBase::ComponentSemantics::Color>(converted, 0);
+        CHECK(color.value[0] == 255);
+        CHECK(color.value[3] == 255);
+        auto const& generic = get<VertexFormatBase::ComponentSemantics::Generic>(converted, 1);
+        CHECK(generic.x == 0.f);
+        CHECK(generic.w == 0.f);
+    }
+
+    SECTION("Identical layouts with different semantics are not copied")
+    {
+        using TextureFirst = VertexData<
+            VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>,
+            VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Texture>,
+            VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Generic<0>>>;
+        using GenericFirst = VertexData<
+            VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>,
+            VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Generic<0>>,
+            VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Texture>>;
+        static_assert(std::is_same_v<TextureFirst::Storage, GenericFirst::Storage>);
+        TextureFirst const source{
+            { GhulbusMath::Point3f(1.f, 2.f, 3.f), GhulbusMath::Vector2f(0.5f, 0.25f), GhulbusMath::Vector2f(7.f, 9.f) },
+        };
+        GenericFirst const converted = VertexConversion::convertVertexData<GenericFirst>(source);
+        REQUIRE(converted.size() == 1);
+        CHECK(get<VertexFormatBase::ComponentSemantics::Texture>(converted, 0) == GhulbusMath::Vector2f(0.5f, 0.25f));
+        CHECK(get<VertexFormatBase::ComponentSemantics::Generic>(converted, 0) == GhulbusMath::Vector2f(7.f, 9.f));
+
+        using GenericOnly = VertexData<
+            VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>,
+            VertexComponent<GhulbusMath::Normal3f, VertexComponentSemantics::Normal>,
+            VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Generic<0>>>;
+        static_assert(std::is_same_v<FullVertexData::Storage, GenericOnly::Storage>);
+        GenericOnly const defaulted = VertexConversion::convertVertexData<GenericOnly>(full_data);
+        REQUIRE(defaulted.size() == 2);
+        CHECK(get<VertexFormatBase::ComponentSemantics::Normal>(defaulted, 1).y == -1.f);
+        CHECK(get<VertexFormatBase::ComponentSemantics::Generic>(defaulted, 0) == GhulbusMath::Vector2f(0.f, 0.f));
+    }
+
+    SECTION("Conversion to compact layouts and back")
+    {
+        using CompactVertexData = VertexData<
+            VertexComponent<VertexComponentLayout::Half<4>, VertexComponentSemantics::Position>,
+            VertexComponent<VertexComponentLayout::Normalized<std::int16_t, 2>, VertexComponentSemantics::Normal>,
+            VertexComponent<VertexComponentLayout::Normalized<std::uint16_t, 2>, VertexComponentSemantics::Texture>>;
+        static_assert(sizeof(CompactVertexData::Storage) == 16);
+        CompactVertexData const compact = VertexConversion::convertVertexData<CompactVertexData>(full_data);
+        REQUIRE(compact.size() == 2);
+        auto const& position = get<VertexFormatBase::ComponentSemantics::Position>(compact, 0);
+        CHECK(VertexEncoding::halfToFloat(position.value[2]) == 3.f);
+        CHECK(VertexEncoding::halfToFloat(position.value[3]) == 1.f);
+
+        FullVertexData const restored = VertexConversion::convertVertexData<FullVertexData>(compact);
+        REQUIRE(restored.size() == 2);
+        for (std::size_t i = 0; i < restored.size(); ++i) {
+            auto const& p = get<VertexFormatBase::ComponentSemantics::Position>(restored, i);
+            auto const& p_expected = get<VertexFormatBase::ComponentSemantics::Position>(full_data, i);
+            CHECK(p.x == p_expected.x);
+            CHECK(p.y == p_expected.y);
+            CHECK(p.z == p_expected.z);
+            auto const& n = get<VertexFormatBase::ComponentSemantics::Normal>(restored, i);
+            auto const& n_expected = get<VertexFormatBase::ComponentSemantics::Normal>(full_data, i);
+            CHECK(n.x == Approx(n_expected.x).margin(1e-4));
+            CHECK(n.y == Approx(n_expected.y).margin(1e-4));
+            CHECK(n.z == Approx(n_expected.z).margin(1e-4));
+            auto const& t = get<VertexFormatBase::ComponentSemantics::Texture>(restored, i);
+            auto const& t_expected = get<VertexFormatBase::ComponentSemantics::Texture>(full_data, i);
+            CHECK(t.x == Approx(t_expected.x).margin(1e-4));
+            CHECK(t.y == Approx(t_expected.y).margin(1e-4));
+        }
+    }
+}
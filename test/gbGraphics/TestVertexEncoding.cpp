@@ -0,0 +1,115 @@
+#include <gbGraphics/VertexEncoding.hpp>
+
+#include <gbMath/NumberTypeTraits.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+TEST_CASE("Vertex Encoding")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+
+    SECTION("Half floats")
+    {
+        CHECK(VertexEncoding::floatToHalf(0.f) == 0x0000);
+        CHECK(VertexEncoding::floatToHalf(-0.f) == 0x8000);
+        CHECK(VertexEncoding::floatToHalf(1.f) == 0x3C00);
+        CHECK(VertexEncoding::floatToHalf(-2.f) == 0xC000);
+        CHECK(VertexEncoding::floatToHalf(65504.f) == 0x7BFF);
+        CHECK(VertexEncoding::floatToHalf(65536.f) == 0x7C00);
+        CHECK(VertexEncoding::floatToHalf(std::numeric_limits<float>::infinity()) == 0x7C00);
+        CHECK(std::isnan(VertexEncoding::halfToFloat(
+            VertexEncoding::floatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+        // smallest subnormal
+        CHECK(VertexEncoding::floatToHalf(std::ldexp(1.f, -24)) == 0x0001);
+        CHECK(VertexEncoding::floatToHalf(std::ldexp(1.f, -26)) == 0x0000);
+        // round to nearest even
+        CHECK(VertexEncoding::floatToHalf(1.f + std::ldexp(1.f, -11)) == 0x3C00);
+        CHECK(VertexEncoding::floatToHalf(1.f + 3.f * std::ldexp(1.f, -11)) == 0x3C02);
+
+        // every finite half survives a round trip through float
+        int mismatches = 0;
+        for (std::uint32_t h = 0; h < 0x10000; ++h) {
+            if ((h & 0x7C00u) == 0x7C00u) { continue; }
+            auto const half = static_cast<std::uint16_t>(h);
+            if (VertexEncoding::floatToHalf(VertexEncoding::halfToFloat(half)) != half) { ++mismatches; }
+        }
+        CHECK(mismatches == 0);
+        CHECK(VertexEncoding::halfToFloat(0x3555) == Approx(1.f / 3.f).epsilon(0.001));
+    }
+
+    SECTION("Normalized integers")
+    {
+        CHECK(VertexEncoding::encodeNormalized<std::int8_t>(1.f) == 127);
+        CHECK(VertexEncoding::encodeNormalized<std::int8_t>(-1.f) == -127);
+        CHECK(VertexEncoding::encodeNormalized<std::int8_t>(-5.f) == -127);
+        CHECK(VertexEncoding::encodeNormalized<std::uint8_t>(-1.f) == 0);
+        CHECK(VertexEncoding::encodeNormalized<std::uint8_t>(0.5f) == 128);
+        CHECK(VertexEncoding::encodeNormalized<std::uint16_t>(1.f) == 65535);
+        CHECK(VertexEncoding::encodeNormalized<std::int16_t>(0.f) == 0);
+        CHECK(VertexEncoding::decodeNormalized<std::int8_t>(-128) == -1.f);
+        CHECK(VertexEncoding::decodeNormalized<std::int16_t>(32767) == 1.f);
+        CHECK(VertexEncoding::decodeNormalized<std::uint8_t>(255) == 1.f);
+
+        auto const uv = VertexEncoding::encodeNormalized<std::uint16_t>(GhulbusMath::Vector2f(0.25f, 0.75f));
+        CHECK(VertexEncoding::decodeNormalized(uv.value[0]) == Approx(0.25f).margin(1.f / 65535.f));
+        CHECK(VertexEncoding::decodeNormalized(uv.value[1]) == Approx(0.75f).margin(1.f / 65535.f));
+    }
+
+    SECTION("Packed 10:10:10:2")
+    {
+        auto const snorm = VertexEncoding::encodeSNorm10_10_10_2(GhulbusMath::Vector4f(1.f, -1.f, 0.f, -1.f));
+        CHECK(snorm.value == ((0x1FFu) | (0x201u << 10) | (0x000u << 20) | (0x3u << 30)));
+        auto const snorm_decoded = VertexEncoding::decode(snorm);
+        CHECK(snorm_decoded.x == 1.f);
+        CHECK(snorm_decoded.y == -1.f);
+        CHECK(snorm_decoded.z == 0.f);
+        CHECK(snorm_decoded.w == -1.f);
+
+        auto const unorm = VertexEncoding::encodeUNorm10_10_10_2(GhulbusMath::Vector4f(1.f, 0.5f, 0.f, 2.f / 3.f));
+        auto const unorm_decoded = VertexEncoding::decode(unorm);
+        CHECK(unorm_decoded.x == 1.f);
+        CHECK(unorm_decoded.y == Approx(0.5f).margin(1.f / 1023.f));
+        CHECK(unorm_decoded.z == 0.f);
+        CHECK(unorm_decoded.w == Approx(2.f / 3.f));
+    }
+
+    SECTION("Octahedral normals")
+    {
+        double max_error_degrees = 0.0;
+        int const steps = 64;
+        for (int i = 0; i <= steps; ++i) {
+            float const theta = GhulbusMath::traits::Pi<float>::value * static_cast<float>(i) / steps;
+            for (int j = 0; j < 2 * steps; ++j) {
+                float const phi = GhulbusMath::traits::Pi<float>::value * static_cast<float>(j) / steps;
+                GhulbusMath::Normal3f const n(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+                                              std::cos(theta));
+                GhulbusMath::Normal3f const d = VertexEncoding::decodeOctahedral(VertexEncoding::encodeOctahedral(n));
+                double const dx = n.x - d.x;
+                double const dy = n.y - d.y;
+                double const dz = n.z - d.z;
+                double const angle = 2.0 * std::asin(std::sqrt(dx*dx + dy*dy + dz*dz) / 2.0);
+                max_error_degrees = std::max(max_error_degrees, angle * 180.0 / GhulbusMath::traits::Pi<double>::value);
+            }
+        }
+        CHECK(max_error_degrees < 0.01);
+    }
+
+    SECTION("Compact vertex layout")
+    {
+        using CompactFormat = VertexFormat<
+            VertexComponent<VertexComponentLayout::Half<4>, VertexComponentSemantics::Position>,
+            VertexComponent<VertexComponentLayout::Normalized<std::int16_t, 2>, VertexComponentSemantics::Normal>,
+            VertexComponent<VertexComponentLayout::Normalized<std::uint16_t, 2>, VertexComponentSemantics::Texture>>;
+        static_assert(CompactFormat::getStrideStatic() == 16);
+        CompactFormat const format;
+        CHECK(format.getComponentType(0) == VertexFormatBase::ComponentType::t_half4);
+        CHECK(format.getComponentType(1) == VertexFormatBase::ComponentType::t_snorm16x2);
+        CHECK(format.getComponentType(2) == VertexFormatBase::ComponentType::t_unorm16x2);
+        CHECK(format.getComponentOffset(2) == 12);
+    }
+}
@@ -0,0 +1,76 @@
+#include <gbGraphics/VertexStreams.hpp>
+
+#include <catch.hpp>
+
+#include <cstring>
+
+TEST_CASE("Vertex Streams")
+{
+    using namespace GHULBUS_GRAPHICS_NAMESPACE;
+
+    using Interleaved = VertexData<VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>,
+                                   VertexComponent<GhulbusMath::Normal3f, VertexComponentSemantics::Normal>,
+                                   VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Texture>>;
+    using PositionStream = VertexData<VertexComponent<GhulbusMath::Point3f, VertexComponentSemantics::Position>>;
+    using AttributeStream = VertexData<VertexComponent<GhulbusMath::Vector2f, VertexComponentSemantics::Texture>,
+                                       VertexComponent<GhulbusMath::Normal3f, VertexComponentSemantics::Normal>>;
+    using Streams = VertexStreams<PositionStream, AttributeStream>;
+
+    static_assert(Streams::numberOfStreams == 2);
+    static_assert(*Streams::getStreamIndexForSemantics(VertexFormatBase::ComponentSemantics::Position) == 0);
+    static_assert(*Streams::getStreamIndexForSemantics(VertexFormatBase::ComponentSemantics::Normal) == 1);
+    static_assert(*Streams::getStreamIndexForSemantics(VertexFormatBase::ComponentSemantics::Texture) == 1);
+    static_assert(!Streams::getStreamIndexForSemantics(VertexFormatBase::ComponentSemantics::Color));
+
+    SECTION("Stream formats")
+    {
+        CHECK(Streams::getStreamFormat(0).getStride() == 12);
+        CHECK(Streams::getStreamFormat(1).getStride() == 20);
+        CHECK(Streams::getStreamFormat(1).getComponentSemantics(0) == VertexFormatBase::ComponentSemantics::Texture);
+        CHECK(Streams::getStreamFormat(1).getComponentOffset(1) == 8);
+    }
+
+    SECTION("Default construction")
+    {
+        Streams streams;
+        CHECK(streams.empty());
+        streams.resize(5);
+        CHECK(streams.size() == 5);
+        CHECK(streams.getStream<0>().size() == 5);
+        CHECK(streams.getStream<1>().size() == 5);
+        CHECK(streams.getStreamSize(0) == 5 * 12);
+        CHECK(streams.getStreamSize(1) == 5 * 20);
+    }
+
+    SECTION("Split interleaved data")
+    {
+        Interleaved interleaved{
+            { GhulbusMath::Point3f(1.f, 2.f, 3.f), GhulbusMath::Normal3f(0.f, 0.f, 1.f), GhulbusMath::Vector2f(0.5f, 0.25f) },
+            { GhulbusMath::Point3f(4.f, 5.f, 6.f), GhulbusMath::Normal3f(0.f, 1.f, 0.f), GhulbusMath::Vector2f(0.75f, 1.f) },
+        };
+        Streams const streams = Streams::fromInterleaved(interleaved);
+        REQUIRE(streams.size() == 2);
+        for (std::size_t i = 0; i < streams.size(); ++i) {
+            auto const& p = get<VertexFormatBase::ComponentSemantics::Position>(streams, i);
+            auto const& p_expected = get<VertexFormatBase::ComponentSemantics::Position>(interleaved, i);
+            CHECK(p.x == p_expected.x);
+            CHECK(p.y == p_expected.y);
+            CHECK(p.z == p_expected.z);
+            auto const& n = get<VertexFormatBase::ComponentSemantics::Normal>(streams, i);
+            auto const& n_expected = get<VertexFormatBase::ComponentSemantics::Normal>(interleaved, i);
+            CHECK(n.x == n_expected.x);
+            CHECK(n.y == n_expected.y);
+            CHECK(n.z == n_expected.z);
+            CHECK(get<VertexFormatBase::ComponentSemantics::Texture>(streams, i) ==
+                  get<VertexFormatBase::ComponentSemantics::Texture>(interleaved, i));
+        }
+
+        // position stream is tightly packed
+        float positions[6];
+        REQUIRE(streams.getStreamSize(0) == sizeof(positions));
+        std::memcpy(positions, streams.data(0), sizeof(positions));
+        CHECK(positions[0] == 1.f);
+        CHECK(positions[3] == 4.f);
+        CHECK(positions[5] == 6.f);
+    }
+}
@@ -0,0 +1,79 @@
+#include <gbGraphics/Exceptions.hpp>
+#include <gbGraphics/MeshCache.hpp>
+#include <gbGraphics/ObjParser.hpp>
+
+#include <gbBase/Log.hpp>
+#include <gbBase/LogHandlers.hpp>
+#include <gbBase/PerfLog.hpp>
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace {
+void printUsage(char const* executable)
+{
+    std::cerr << "Usage: " << executable << " [--force] <input.obj> [<output.gbmesh>]\n"
+                 "Converts an OBJ file to a binary mesh cache for GhulbusGraphics::MeshCache.\n"
+                 "The output defaults to the input filename with .gbmesh appended.\n"
+                 "Existing output is only rewritten if it is out of date, unless --force is given.\n";
+}
+}
+
+int main(int argc, char* argv[])
+{
+    auto const gblog_init_guard = Ghulbus::Log::initializeLoggingWithGuard();
+    Ghulbus::Log::Handlers::LogSynchronizeMutex logger(Ghulbus::Log::Handlers::logToCout);
+    Ghulbus::Log::setLogHandler(logger);
+    Ghulbus::Log::setLogLevel(Ghulbus::LogLevel::Info);
+
+    bool force = false;
+    std::string input;
+    std::string output;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const arg = argv[i];
+        if (arg == "--force") {
+            force = true;
+        } else if (input.empty()) {
+            input = arg;
+        } else if (output.empty()) {
+            output = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (input.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (output.empty()) { output = input + ".gbmesh"; }
+
+    try {
+        if (!force) {
+            try {
+                GhulbusGraphics::MeshCache const existing(output.c_str());
+                if (existing.isUpToDate(input.c_str(), GhulbusGraphics::MeshCache::Validation::ContentHash)) {
+                    GHULBUS_LOG(Info, output << " is up to date.");
+                    return 0;
+                }
+            } catch (GhulbusGraphics::Exceptions::IOError const&) {
+                // missing or invalid output; cook it from scratch
+            }
+        }
+
+        Ghulbus::PerfLog perflog;
+        GhulbusGraphics::ObjParser obj;
+        obj.readFile(input.c_str());
+        perflog.tick(Ghulbus::LogLevel::Info, "Parsing " + input);
+        GhulbusGraphics::MeshCache::write(output.c_str(), obj, input.c_str());
+        perflog.tick(Ghulbus::LogLevel::Info, "Writing " + output);
+        GHULBUS_LOG(Info, "Cooked " << obj.numberOfFlatVertices() << " vertices and " << obj.numberOfFlatFaces() <<
+                          " faces in " << obj.numberOfGroups() << " groups.");
+    } catch (std::exception const& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}